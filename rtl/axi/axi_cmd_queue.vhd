@@ -0,0 +1,377 @@
+-- =============================================================================
+-- Command Queue: DDR Descriptor Ring (AXI4 Master)
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Consumes inference descriptors from a ring in DDR, back to back
+--   - Driver queues work by advancing the tail index; hardware advances the
+--     head index as each job completes
+--   - Starts the pipeline for each descriptor and writes the result map to
+--     the descriptor's output address (4 pixels per beat)
+--   - Writes a completion status and the job's cycle count back into the
+--     descriptor so the driver can reap finished jobs from memory
+--
+-- Descriptor (64 bytes, 64-byte aligned, little-endian words):
+--   +0x00 input address     +0x04 output address (128-byte aligned)
+--   +0x08 model address     +0x0C flags
+--   +0x10 reserved          +0x14 reserved
+--   +0x18 status (written)  +0x1C cycles (written)
+--   +0x20..+0x3C reserved (pads each descriptor to its own cache line, so
+--   the driver's clean of one never overwrites another's written status)
+-- Status: bit 0 = done, bits 7:4 = error code.
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+library work;
+use work.cnn_pkg.all;
+
+entity axi_cmd_queue is
+    generic (
+        C_M_AXI_DATA_WIDTH  : integer := 64;
+        C_M_AXI_ADDR_WIDTH  : integer := 32;
+        BURST_LEN           : integer := 16
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+
+        -- Configuration
+        cfg_enable      : in  std_logic;
+        cfg_ring_base   : in  std_logic_vector(31 downto 0);
+        cfg_ring_size   : in  std_logic_vector(15 downto 0);  -- Entries
+        cfg_tail        : in  std_logic_vector(15 downto 0);  -- Producer index
+        ring_head       : out std_logic_vector(15 downto 0);  -- Consumer index
+
+        -- Job control (to / from the main FSM)
+        job_start       : out std_logic;
+        job_input_addr  : out std_logic_vector(31 downto 0);
+        job_model_addr  : out std_logic_vector(31 downto 0);
+        job_flags       : out std_logic_vector(31 downto 0);
+        job_done        : in  std_logic;
+        job_error       : in  std_logic_vector(3 downto 0);
+        job_cycles      : in  std_logic_vector(31 downto 0);
+        job_complete    : out std_logic;   -- Pulse once the status is in DDR
+
+        -- AXI-Stream Input (result map of the running job)
+        s_axis_tdata    : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;
+
+        -- AXI4 Master
+        m_axi_awaddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_awlen     : out std_logic_vector(7 downto 0);
+        m_axi_awsize    : out std_logic_vector(2 downto 0);
+        m_axi_awburst   : out std_logic_vector(1 downto 0);
+        m_axi_awvalid   : out std_logic;
+        m_axi_awready   : in  std_logic;
+        m_axi_wdata     : out std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        m_axi_wstrb     : out std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+        m_axi_wlast     : out std_logic;
+        m_axi_wvalid    : out std_logic;
+        m_axi_wready    : in  std_logic;
+        m_axi_bresp     : in  std_logic_vector(1 downto 0);
+        m_axi_bvalid    : in  std_logic;
+        m_axi_bready    : out std_logic;
+        m_axi_araddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_arlen     : out std_logic_vector(7 downto 0);
+        m_axi_arsize    : out std_logic_vector(2 downto 0);
+        m_axi_arburst   : out std_logic_vector(1 downto 0);
+        m_axi_arvalid   : out std_logic;
+        m_axi_arready   : in  std_logic;
+        m_axi_rdata     : in  std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        m_axi_rresp     : in  std_logic_vector(1 downto 0);
+        m_axi_rlast     : in  std_logic;
+        m_axi_rvalid    : in  std_logic;
+        m_axi_rready    : out std_logic;
+
+        -- Status
+        busy            : out std_logic;
+        dma_error       : out std_logic
+    );
+end axi_cmd_queue;
+
+architecture rtl of axi_cmd_queue is
+
+    constant PX_PER_BEAT : integer := C_M_AXI_DATA_WIDTH / DATA_WIDTH;
+    constant BEAT_BYTES  : integer := C_M_AXI_DATA_WIDTH / 8;
+    constant DESC_BEATS  : integer := 4;
+    constant DESC_SHIFT  : integer := 6;    -- 64-byte descriptors (one cache line)
+
+    -- ==========================================================================
+    -- Descriptor sequencer
+    -- ==========================================================================
+    type q_state_t is (Q_IDLE, Q_FETCH_ADDR, Q_FETCH_DATA, Q_START, Q_RUN,
+                       Q_FLUSH, Q_WB_ADDR, Q_WB_DATA, Q_WB_RESP);
+    signal q_state      : q_state_t;
+
+    signal head         : unsigned(15 downto 0);
+    signal desc_addr    : unsigned(31 downto 0);
+    signal fetch_beat   : unsigned(1 downto 0);
+    signal d_input      : std_logic_vector(31 downto 0);
+    signal d_output     : std_logic_vector(31 downto 0);
+    signal d_model      : std_logic_vector(31 downto 0);
+    signal d_flags      : std_logic_vector(31 downto 0);
+    signal wb_data      : std_logic_vector(63 downto 0);
+    signal job_ran      : std_logic;   -- Pipeline finished the current job
+
+    -- ==========================================================================
+    -- Result writer
+    -- ==========================================================================
+    type wr_state_t is (W_FILL, W_ADDR, W_DATA, W_RESP);
+    signal wr_state     : wr_state_t;
+
+    type burst_buf_t is array (0 to BURST_LEN-1) of std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+    signal burst_buf    : burst_buf_t;
+    signal pack_word    : std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+    signal pack_lane    : unsigned(1 downto 0);
+    signal fill_beats   : unsigned(7 downto 0);
+    signal send_beat    : unsigned(7 downto 0);
+    signal last_strb    : std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+    signal wr_addr      : unsigned(31 downto 0);
+    signal wr_final     : std_logic;   -- Burst in flight holds the last pixel
+    signal map_written  : std_logic;
+    signal in_accept    : std_logic;
+
+    signal axi_error    : std_logic;
+
+begin
+
+    -- ==========================================================================
+    -- Descriptor Sequencer: fetch, run, write back status, advance head
+    -- ==========================================================================
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            q_state <= Q_IDLE;
+            head <= (others => '0');
+            desc_addr <= (others => '0');
+            fetch_beat <= (others => '0');
+            d_input <= (others => '0');
+            d_output <= (others => '0');
+            d_model <= (others => '0');
+            d_flags <= (others => '0');
+            wb_data <= (others => '0');
+            job_ran <= '0';
+            axi_error <= '0';
+        elsif rising_edge(clk) then
+            if cfg_enable = '0' then
+                -- Disabling the ring rewinds it
+                q_state <= Q_IDLE;
+                head <= (others => '0');
+                job_ran <= '0';
+            else
+                if job_done = '1' then
+                    job_ran <= '1';
+                    wb_data <= job_cycles & x"000000" & job_error & "0001";
+                end if;
+
+                case q_state is
+                    when Q_IDLE =>
+                        if head /= unsigned(cfg_tail) then
+                            desc_addr <= unsigned(cfg_ring_base) + shift_left(resize(head, 32), DESC_SHIFT);
+                            q_state <= Q_FETCH_ADDR;
+                        end if;
+
+                    when Q_FETCH_ADDR =>
+                        if m_axi_arready = '1' then
+                            fetch_beat <= (others => '0');
+                            q_state <= Q_FETCH_DATA;
+                        end if;
+
+                    when Q_FETCH_DATA =>
+                        if m_axi_rvalid = '1' then
+                            if m_axi_rresp /= "00" then
+                                axi_error <= '1';
+                            end if;
+                            case to_integer(fetch_beat) is
+                                when 0 =>
+                                    d_input <= m_axi_rdata(31 downto 0);
+                                    d_output <= m_axi_rdata(63 downto 32);
+                                when 1 =>
+                                    d_model <= m_axi_rdata(31 downto 0);
+                                    d_flags <= m_axi_rdata(63 downto 32);
+                                when others =>
+                                    null;
+                            end case;
+                            fetch_beat <= fetch_beat + 1;
+                            if m_axi_rlast = '1' then
+                                q_state <= Q_START;
+                            end if;
+                        end if;
+
+                    when Q_START =>
+                        job_ran <= '0';
+                        q_state <= Q_RUN;
+
+                    when Q_RUN =>
+                        if job_ran = '1' then
+                            q_state <= Q_FLUSH;
+                        end if;
+
+                    when Q_FLUSH =>
+                        -- Result map fully in DDR before the status is
+                        if map_written = '1' then
+                            q_state <= Q_WB_ADDR;
+                        end if;
+
+                    when Q_WB_ADDR =>
+                        if m_axi_awready = '1' then
+                            q_state <= Q_WB_DATA;
+                        end if;
+
+                    when Q_WB_DATA =>
+                        if m_axi_wready = '1' then
+                            q_state <= Q_WB_RESP;
+                        end if;
+
+                    when Q_WB_RESP =>
+                        if m_axi_bvalid = '1' then
+                            if head = unsigned(cfg_ring_size) - 1 then
+                                head <= (others => '0');
+                            else
+                                head <= head + 1;
+                            end if;
+                            q_state <= Q_IDLE;
+                        end if;
+
+                    when others =>
+                        q_state <= Q_IDLE;
+                end case;
+
+                if wr_state = W_RESP and m_axi_bvalid = '1' and m_axi_bresp /= "00" then
+                    axi_error <= '1';
+                end if;
+            end if;
+        end if;
+    end process;
+
+    job_start <= '1' when q_state = Q_START else '0';
+    job_complete <= '1' when q_state = Q_WB_RESP and m_axi_bvalid = '1' else '0';
+    job_input_addr <= d_input;
+    job_model_addr <= d_model;
+    job_flags <= d_flags;
+    ring_head <= std_logic_vector(head);
+
+    m_axi_araddr <= std_logic_vector(resize(desc_addr, C_M_AXI_ADDR_WIDTH));
+    m_axi_arlen <= std_logic_vector(to_unsigned(DESC_BEATS-1, 8));
+    m_axi_arsize <= "011";  -- 8 bytes per beat
+    m_axi_arburst <= "01";  -- INCR
+    m_axi_arvalid <= '1' when q_state = Q_FETCH_ADDR else '0';
+    m_axi_rready <= '1' when q_state = Q_FETCH_DATA else '0';
+
+    -- ==========================================================================
+    -- Result Writer: pack 4 pixels per beat, write bursts of BURST_LEN beats
+    -- ==========================================================================
+    in_accept <= s_axis_tvalid when wr_state = W_FILL and map_written = '0' and
+                                    (q_state = Q_RUN or q_state = Q_FLUSH) else '0';
+
+    process(clk, rst_n)
+        variable word   : std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        variable strb   : std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+    begin
+        if rst_n = '0' then
+            wr_state <= W_FILL;
+            pack_word <= (others => '0');
+            pack_lane <= (others => '0');
+            fill_beats <= (others => '0');
+            send_beat <= (others => '0');
+            last_strb <= (others => '1');
+            wr_addr <= (others => '0');
+            wr_final <= '0';
+            map_written <= '0';
+        elsif rising_edge(clk) then
+            case wr_state is
+                when W_FILL =>
+                    if q_state = Q_START then
+                        wr_addr <= unsigned(d_output);
+                        pack_lane <= (others => '0');
+                        map_written <= '0';
+                    end if;
+
+                    if in_accept = '1' then
+                        word := pack_word;
+                        word(DATA_WIDTH*to_integer(pack_lane)+DATA_WIDTH-1 downto
+                             DATA_WIDTH*to_integer(pack_lane)) := s_axis_tdata;
+                        pack_word <= word;
+                        pack_lane <= pack_lane + 1;
+
+                        if pack_lane = PX_PER_BEAT-1 or s_axis_tlast = '1' then
+                            burst_buf(to_integer(fill_beats)) <= word;
+                            fill_beats <= fill_beats + 1;
+                            pack_lane <= (others => '0');
+
+                            -- Byte strobes for a partial final beat
+                            strb := (others => '0');
+                            for i in 0 to PX_PER_BEAT-1 loop
+                                if i <= to_integer(pack_lane) then
+                                    strb(2*i+1 downto 2*i) := "11";
+                                end if;
+                            end loop;
+                            last_strb <= strb;
+
+                            wr_final <= s_axis_tlast;
+                            if fill_beats = BURST_LEN-1 or s_axis_tlast = '1' then
+                                wr_state <= W_ADDR;
+                            end if;
+                        end if;
+                    end if;
+
+                when W_ADDR =>
+                    if m_axi_awready = '1' then
+                        send_beat <= (others => '0');
+                        wr_state <= W_DATA;
+                    end if;
+
+                when W_DATA =>
+                    if m_axi_wready = '1' then
+                        send_beat <= send_beat + 1;
+                        if send_beat = fill_beats - 1 then
+                            wr_state <= W_RESP;
+                        end if;
+                    end if;
+
+                when W_RESP =>
+                    if m_axi_bvalid = '1' then
+                        wr_addr <= wr_addr + resize(resize(fill_beats, 24) * BEAT_BYTES, 32);
+                        fill_beats <= (others => '0');
+                        last_strb <= (others => '1');
+                        if wr_final = '1' then
+                            map_written <= '1';
+                            wr_final <= '0';
+                        end if;
+                        wr_state <= W_FILL;
+                    end if;
+
+                when others =>
+                    wr_state <= W_FILL;
+            end case;
+        end if;
+    end process;
+
+    s_axis_tready <= in_accept;
+
+    -- Write channels: result bursts, then the one-beat status write-back
+    m_axi_awaddr <= std_logic_vector(resize(desc_addr + 24, C_M_AXI_ADDR_WIDTH)) when q_state = Q_WB_ADDR else
+                    std_logic_vector(resize(wr_addr, C_M_AXI_ADDR_WIDTH));
+    m_axi_awlen <= (others => '0') when q_state = Q_WB_ADDR else std_logic_vector(fill_beats - 1);
+    m_axi_awsize <= "011";
+    m_axi_awburst <= "01";
+    m_axi_awvalid <= '1' when wr_state = W_ADDR or q_state = Q_WB_ADDR else '0';
+    m_axi_wdata <= wb_data when q_state = Q_WB_DATA else burst_buf(to_integer(send_beat) mod BURST_LEN);
+    m_axi_wstrb <= (others => '1') when q_state = Q_WB_DATA else
+                   last_strb when send_beat = fill_beats - 1 else (others => '1');
+    m_axi_wlast <= '1' when q_state = Q_WB_DATA or send_beat = fill_beats - 1 else '0';
+    m_axi_wvalid <= '1' when wr_state = W_DATA or q_state = Q_WB_DATA else '0';
+    m_axi_bready <= '1' when wr_state = W_RESP or q_state = Q_WB_RESP else '0';
+
+    -- ==========================================================================
+    -- Status
+    -- ==========================================================================
+    busy <= '1' when q_state /= Q_IDLE or head /= unsigned(cfg_tail) else '0';
+    dma_error <= axi_error;
+
+end rtl;
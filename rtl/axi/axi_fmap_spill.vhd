@@ -0,0 +1,548 @@
+-- =============================================================================
+-- Feature-Map Spill/Refill Engine (AXI4 Master)
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Spills a channel-planar feature map stream to DDR (C_M_AXI_DATA_WIDTH /
+--     DATA_WIDTH pixels per beat)
+--   - Refills it as horizontal row bands (stripes) that overlap by 2*HALO
+--     rows, so the next layer only holds one stripe on chip
+--   - Stripe height set at runtime per layer by the driver
+--   - Optional repeat of each stripe's channel walk, for a consumer that
+--     makes several passes over its input (the GEMM backend)
+--   - Incrementing bursts of up to BURST_LEN beats, never crossing 4KB
+--
+-- Memory layout: [channel][row][column], 16-bit pixels, at cfg_base_addr.
+-- Refill order:  for each stripe, cfg_passes times (0 = once), for each
+--                channel, rows y0..r1-1 where r1 = y0 + stripe_rows + 2*HALO
+--                (clamped), y0 = 0, stripe_rows, 2*stripe_rows, ...
+-- Stripe k thus yields exactly the valid-conv output rows k*stripe_rows ..
+-- (k+1)*stripe_rows-1, so with an even stripe height every stripe starts on
+-- an even output row and a fused 2x2 pool pairs rows as in the untiled pass.
+-- Requires cfg_width to be a multiple of the pixels per beat.
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+library work;
+use work.cnn_pkg.all;
+
+entity axi_fmap_spill is
+    generic (
+        C_M_AXI_DATA_WIDTH  : integer := 64;
+        C_M_AXI_ADDR_WIDTH  : integer := 32;
+        BURST_LEN           : integer := 16;
+        MAX_OUTSTANDING     : integer := 4;
+        HALO                : integer := 1     -- Rows of overlap (kernel / 2)
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+
+        -- Configuration
+        cfg_enable      : in  std_logic;
+        cfg_base_addr   : in  std_logic_vector(31 downto 0);
+        cfg_width       : in  std_logic_vector(11 downto 0);
+        cfg_height      : in  std_logic_vector(11 downto 0);
+        cfg_channels    : in  std_logic_vector(9 downto 0);
+        cfg_stripe_rows : in  std_logic_vector(7 downto 0);
+        cfg_passes      : in  std_logic_vector(7 downto 0);   -- Refills per stripe (0 = 1)
+
+        -- AXI-Stream Input (feature map to spill)
+        s_axis_tdata    : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;
+        s_axis_tuser    : in  std_logic;
+
+        -- AXI-Stream Output (refilled stripes, tuser = start of stripe)
+        m_axis_tdata    : out std_logic_vector(DATA_WIDTH-1 downto 0);
+        m_axis_tvalid   : out std_logic;
+        m_axis_tready   : in  std_logic;
+        m_axis_tlast    : out std_logic;
+        m_axis_tuser    : out std_logic;
+
+        -- Current stripe geometry (for the consuming layer)
+        stripe_rows     : out std_logic_vector(11 downto 0);
+        last_stripe     : out std_logic;
+
+        -- AXI4 Master
+        m_axi_awaddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_awlen     : out std_logic_vector(7 downto 0);
+        m_axi_awsize    : out std_logic_vector(2 downto 0);
+        m_axi_awburst   : out std_logic_vector(1 downto 0);
+        m_axi_awvalid   : out std_logic;
+        m_axi_awready   : in  std_logic;
+        m_axi_wdata     : out std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        m_axi_wstrb     : out std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+        m_axi_wlast     : out std_logic;
+        m_axi_wvalid    : out std_logic;
+        m_axi_wready    : in  std_logic;
+        m_axi_bresp     : in  std_logic_vector(1 downto 0);
+        m_axi_bvalid    : in  std_logic;
+        m_axi_bready    : out std_logic;
+        m_axi_araddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_arlen     : out std_logic_vector(7 downto 0);
+        m_axi_arsize    : out std_logic_vector(2 downto 0);
+        m_axi_arburst   : out std_logic_vector(1 downto 0);
+        m_axi_arvalid   : out std_logic;
+        m_axi_arready   : in  std_logic;
+        m_axi_rdata     : in  std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        m_axi_rresp     : in  std_logic_vector(1 downto 0);
+        m_axi_rlast     : in  std_logic;
+        m_axi_rvalid    : in  std_logic;
+        m_axi_rready    : out std_logic;
+
+        -- Status
+        busy            : out std_logic;
+        dma_error       : out std_logic
+    );
+end axi_fmap_spill;
+
+architecture rtl of axi_fmap_spill is
+
+    function clog2(n : integer) return integer is
+        variable r : integer := 0;
+    begin
+        while 2**r < n loop
+            r := r + 1;
+        end loop;
+        return r;
+    end function;
+
+    constant PX_PER_BEAT : integer := C_M_AXI_DATA_WIDTH / DATA_WIDTH;
+    constant BEAT_BYTES  : integer := C_M_AXI_DATA_WIDTH / 8;
+    constant LANE_W      : integer := clog2(PX_PER_BEAT);
+    constant PX_BYTES    : integer := DATA_WIDTH / 8;
+    constant AXI_SIZE    : std_logic_vector(2 downto 0) :=
+        std_logic_vector(to_unsigned(clog2(BEAT_BYTES), 3));
+
+    -- ==========================================================================
+    -- Spill (write) path
+    -- ==========================================================================
+    type wr_state_t is (W_FILL, W_ADDR, W_DATA, W_RESP, W_DONE);
+    signal wr_state     : wr_state_t;
+
+    type burst_buf_t is array (0 to BURST_LEN-1) of std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+    signal burst_buf    : burst_buf_t;
+    signal pack_word    : std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+    signal pack_lane    : unsigned(LANE_W-1 downto 0);
+    signal fill_beats   : unsigned(7 downto 0);
+    signal send_beat    : unsigned(7 downto 0);
+    signal last_strb    : std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+    signal wr_addr      : unsigned(31 downto 0);
+    signal wr_remain    : unsigned(31 downto 0);   -- Pixels left in the map
+    signal map_written  : std_logic;
+
+    -- ==========================================================================
+    -- Refill (read address) path
+    -- ==========================================================================
+    type ar_state_t is (AR_IDLE, AR_SEGMENT, AR_ISSUE, AR_NEXT, AR_DONE);
+    signal ar_state     : ar_state_t;
+
+    signal plane_bytes  : unsigned(31 downto 0);
+    signal row_bytes    : unsigned(15 downto 0);
+    signal ar_y0        : unsigned(11 downto 0);   -- First row of the band
+    signal ar_ch        : unsigned(9 downto 0);
+    signal ar_pass      : unsigned(7 downto 0);
+    signal ar_plane     : unsigned(31 downto 0);   -- Base of the current channel
+    signal ar_addr      : unsigned(31 downto 0);
+    signal ar_remain    : unsigned(19 downto 0);   -- Beats left in the segment
+    signal ar_len       : unsigned(7 downto 0);
+    signal outstanding  : unsigned(3 downto 0);
+
+    -- ==========================================================================
+    -- Refill (read data) path
+    -- ==========================================================================
+    signal rd_word      : std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+    signal rd_lane      : unsigned(LANE_W-1 downto 0);
+    signal rd_full      : std_logic;
+    signal rd_x         : unsigned(11 downto 0);
+    signal rd_row       : unsigned(11 downto 0);
+    signal rd_ch        : unsigned(9 downto 0);
+    signal rd_pass      : unsigned(7 downto 0);
+    signal rd_y0        : unsigned(11 downto 0);
+    signal rd_r0        : unsigned(11 downto 0);
+    signal rd_r1        : unsigned(11 downto 0);
+    signal rd_first     : std_logic;
+    signal rd_ready     : std_logic;
+    signal beat_take    : std_logic;
+    signal refill_done  : std_logic;
+    signal out_accept   : std_logic;
+
+    signal axi_error    : std_logic;
+
+    -- End of the row band starting at y0: the stripe's rows plus the 2*HALO
+    -- rows its last outputs reach below, clamped to the map
+    function band_end(y0 : unsigned; rows : unsigned;
+                      height : unsigned) return unsigned is
+        variable r1 : unsigned(12 downto 0);
+    begin
+        r1 := resize(y0, 13) + resize(rows, 13) + 2*HALO;
+        if r1 > resize(height, 13) then
+            return height;
+        else
+            return r1(11 downto 0);
+        end if;
+    end function;
+
+    -- The band starting at y0 reaches the bottom of the map
+    function band_last(y0 : unsigned; rows : unsigned;
+                       height : unsigned) return boolean is
+    begin
+        return resize(y0, 13) + resize(rows, 13) + 2*HALO >= resize(height, 13);
+    end function;
+
+begin
+
+    assert DATA_WIDTH mod 8 = 0 and PX_PER_BEAT >= 2 and 2**LANE_W = PX_PER_BEAT and
+           C_M_AXI_DATA_WIDTH = PX_PER_BEAT * DATA_WIDTH and BEAT_BYTES <= 128
+        report "axi_fmap_spill: C_M_AXI_DATA_WIDTH must be a power-of-two multiple (>= 2) of DATA_WIDTH"
+        severity failure;
+
+    -- ==========================================================================
+    -- Map Geometry
+    -- ==========================================================================
+    process(clk)
+    begin
+        if rising_edge(clk) then
+            row_bytes <= resize(resize(unsigned(cfg_width), 16) * PX_BYTES, 16);
+            plane_bytes <= resize(resize(unsigned(cfg_width) * unsigned(cfg_height), 32) * PX_BYTES, 32);
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Spill: pack PX_PER_BEAT pixels per beat, write bursts of BURST_LEN beats
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable word   : std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        variable strb   : std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+    begin
+        if rst_n = '0' then
+            wr_state <= W_FILL;
+            pack_word <= (others => '0');
+            pack_lane <= (others => '0');
+            fill_beats <= (others => '0');
+            send_beat <= (others => '0');
+            last_strb <= (others => '1');
+            wr_addr <= (others => '0');
+            wr_remain <= (others => '0');
+            map_written <= '0';
+        elsif rising_edge(clk) then
+            case wr_state is
+                when W_FILL =>
+                    if s_axis_tvalid = '1' and cfg_enable = '1' then
+                        -- Start of map: rewind to the scratch base
+                        if s_axis_tuser = '1' then
+                            wr_addr <= unsigned(cfg_base_addr);
+                            wr_remain <= resize(unsigned(cfg_width) * unsigned(cfg_height) *
+                                                unsigned(cfg_channels), 32) - 1;
+                        else
+                            wr_remain <= wr_remain - 1;
+                        end if;
+
+                        word := pack_word;
+                        word(DATA_WIDTH*to_integer(pack_lane)+DATA_WIDTH-1 downto
+                             DATA_WIDTH*to_integer(pack_lane)) := s_axis_tdata;
+                        pack_word <= word;
+                        pack_lane <= pack_lane + 1;
+
+                        if pack_lane = PX_PER_BEAT-1 or (wr_remain = 1 and s_axis_tuser = '0') then
+                            burst_buf(to_integer(fill_beats)) <= word;
+                            fill_beats <= fill_beats + 1;
+                            pack_lane <= (others => '0');
+
+                            -- Byte strobes for a partial final beat
+                            strb := (others => '0');
+                            for i in 0 to PX_PER_BEAT-1 loop
+                                if i <= to_integer(pack_lane) then
+                                    strb((i+1)*PX_BYTES-1 downto i*PX_BYTES) := (others => '1');
+                                end if;
+                            end loop;
+                            last_strb <= strb;
+
+                            if fill_beats = BURST_LEN-1 or (wr_remain = 1 and s_axis_tuser = '0') then
+                                wr_state <= W_ADDR;
+                            end if;
+                        end if;
+                    end if;
+
+                when W_ADDR =>
+                    if m_axi_awready = '1' then
+                        send_beat <= (others => '0');
+                        wr_state <= W_DATA;
+                    end if;
+
+                when W_DATA =>
+                    if m_axi_wready = '1' then
+                        send_beat <= send_beat + 1;
+                        if send_beat = fill_beats - 1 then
+                            wr_state <= W_RESP;
+                        end if;
+                    end if;
+
+                when W_RESP =>
+                    if m_axi_bvalid = '1' then
+                        wr_addr <= wr_addr + resize(resize(fill_beats, 24) * BEAT_BYTES, 32);
+                        fill_beats <= (others => '0');
+                        last_strb <= (others => '1');
+                        if wr_remain = 0 then
+                            map_written <= '1';
+                            wr_state <= W_DONE;
+                        else
+                            wr_state <= W_FILL;
+                        end if;
+                    end if;
+
+                when W_DONE =>
+                    -- Hold the map until it has been refilled
+                    if refill_done = '1' then
+                        map_written <= '0';
+                        wr_state <= W_FILL;
+                    end if;
+
+                when others =>
+                    wr_state <= W_FILL;
+            end case;
+        end if;
+    end process;
+
+    s_axis_tready <= '1' when wr_state = W_FILL and cfg_enable = '1' else '0';
+
+    m_axi_awaddr <= std_logic_vector(resize(wr_addr, C_M_AXI_ADDR_WIDTH));
+    m_axi_awlen <= std_logic_vector(fill_beats - 1);
+    m_axi_awsize <= AXI_SIZE;  -- BEAT_BYTES per beat
+    m_axi_awburst <= "01";  -- INCR
+    m_axi_awvalid <= '1' when wr_state = W_ADDR else '0';
+    m_axi_wdata <= burst_buf(to_integer(send_beat) mod BURST_LEN);
+    m_axi_wstrb <= last_strb when send_beat = fill_beats - 1 else (others => '1');
+    m_axi_wlast <= '1' when send_beat = fill_beats - 1 else '0';
+    m_axi_wvalid <= '1' when wr_state = W_DATA else '0';
+    m_axi_bready <= '1' when wr_state = W_RESP else '0';
+
+    -- ==========================================================================
+    -- Refill: read address generation, one segment per (stripe, channel)
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable to_4k : unsigned(12 downto 0);
+        variable len   : unsigned(19 downto 0);
+    begin
+        if rst_n = '0' then
+            ar_state <= AR_IDLE;
+            ar_y0 <= (others => '0');
+            ar_ch <= (others => '0');
+            ar_pass <= (others => '0');
+            ar_plane <= (others => '0');
+            ar_addr <= (others => '0');
+            ar_remain <= (others => '0');
+            ar_len <= (others => '0');
+        elsif rising_edge(clk) then
+            case ar_state is
+                when AR_IDLE =>
+                    if map_written = '1' and refill_done = '0' then
+                        ar_y0 <= (others => '0');
+                        ar_ch <= (others => '0');
+                        ar_pass <= (others => '0');
+                        ar_plane <= unsigned(cfg_base_addr);
+                        ar_state <= AR_SEGMENT;
+                    end if;
+
+                when AR_SEGMENT =>
+                    -- Segment = rows y0..r1-1 of the current channel plane
+                    ar_addr <= ar_plane + resize(ar_y0 * row_bytes, 32);
+                    ar_remain <= resize((band_end(ar_y0, unsigned(cfg_stripe_rows), unsigned(cfg_height)) -
+                                         ar_y0) * row_bytes / BEAT_BYTES, 20);
+                    ar_state <= AR_NEXT;
+
+                when AR_NEXT =>
+                    if ar_remain = 0 then
+                        -- Next channel, then next pass, then next stripe
+                        if ar_ch = unsigned(cfg_channels) - 1 then
+                            ar_ch <= (others => '0');
+                            ar_plane <= unsigned(cfg_base_addr);
+                            if ar_pass + 1 < unsigned(cfg_passes) then
+                                ar_pass <= ar_pass + 1;
+                                ar_state <= AR_SEGMENT;
+                            elsif band_last(ar_y0, unsigned(cfg_stripe_rows), unsigned(cfg_height)) then
+                                ar_state <= AR_DONE;
+                            else
+                                ar_pass <= (others => '0');
+                                ar_y0 <= ar_y0 + resize(unsigned(cfg_stripe_rows), 12);
+                                ar_state <= AR_SEGMENT;
+                            end if;
+                        else
+                            ar_ch <= ar_ch + 1;
+                            ar_plane <= ar_plane + plane_bytes;
+                            ar_state <= AR_SEGMENT;
+                        end if;
+                    elsif outstanding < MAX_OUTSTANDING then
+                        -- Burst length: remaining beats, capped by BURST_LEN and 4KB
+                        to_4k := resize((4096 - resize(ar_addr(11 downto 0), 13)) / BEAT_BYTES, 13);
+                        len := ar_remain;
+                        if len > BURST_LEN then
+                            len := to_unsigned(BURST_LEN, 20);
+                        end if;
+                        if len > resize(to_4k, 20) then
+                            len := resize(to_4k, 20);
+                        end if;
+                        ar_len <= len(7 downto 0);
+                        ar_state <= AR_ISSUE;
+                    end if;
+
+                when AR_ISSUE =>
+                    if m_axi_arready = '1' then
+                        ar_addr <= ar_addr + resize(resize(ar_len, 24) * BEAT_BYTES, 32);
+                        ar_remain <= ar_remain - ar_len;
+                        ar_state <= AR_NEXT;
+                    end if;
+
+                when AR_DONE =>
+                    if refill_done = '1' then
+                        ar_state <= AR_IDLE;
+                    end if;
+
+                when others =>
+                    ar_state <= AR_IDLE;
+            end case;
+        end if;
+    end process;
+
+    -- Outstanding read bursts (issued minus completed)
+    process(clk, rst_n)
+        variable issued    : std_logic;
+        variable completed : std_logic;
+    begin
+        if rst_n = '0' then
+            outstanding <= (others => '0');
+        elsif rising_edge(clk) then
+            issued := '0';
+            completed := '0';
+            if ar_state = AR_ISSUE and m_axi_arready = '1' then
+                issued := '1';
+            end if;
+            if beat_take = '1' and m_axi_rlast = '1' then
+                completed := '1';
+            end if;
+            if issued = '1' and completed = '0' then
+                outstanding <= outstanding + 1;
+            elsif issued = '0' and completed = '1' then
+                outstanding <= outstanding - 1;
+            end if;
+        end if;
+    end process;
+
+    m_axi_araddr <= std_logic_vector(resize(ar_addr, C_M_AXI_ADDR_WIDTH));
+    m_axi_arlen <= std_logic_vector(ar_len - 1);
+    m_axi_arsize <= AXI_SIZE;
+    m_axi_arburst <= "01";
+    m_axi_arvalid <= '1' when ar_state = AR_ISSUE else '0';
+
+    -- ==========================================================================
+    -- Refill: unpack beats into pixels, track stripe/channel/row position
+    -- ==========================================================================
+    out_accept <= rd_full and m_axis_tready;
+    
+    -- Take the next beat as the last pixel of the current one leaves
+    rd_ready <= '1' when rd_full = '0' or (m_axis_tready = '1' and rd_lane = PX_PER_BEAT-1) else '0';
+    beat_take <= m_axi_rvalid and rd_ready;
+
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            rd_word <= (others => '0');
+            rd_lane <= (others => '0');
+            rd_full <= '0';
+            rd_x <= (others => '0');
+            rd_row <= (others => '0');
+            rd_ch <= (others => '0');
+            rd_pass <= (others => '0');
+            rd_y0 <= (others => '0');
+            rd_r0 <= (others => '0');
+            rd_r1 <= (others => '0');
+            rd_first <= '1';
+            refill_done <= '0';
+            axi_error <= '0';
+        elsif rising_edge(clk) then
+            refill_done <= '0';
+
+            -- New map: reset the stripe walk
+            if ar_state = AR_IDLE and map_written = '1' then
+                rd_y0 <= (others => '0');
+                rd_ch <= (others => '0');
+                rd_pass <= (others => '0');
+                rd_r0 <= (others => '0');
+                rd_row <= (others => '0');
+                rd_r1 <= band_end(to_unsigned(0, 12), unsigned(cfg_stripe_rows), unsigned(cfg_height));
+                rd_x <= (others => '0');
+                rd_first <= '1';
+            end if;
+
+            if out_accept = '1' then
+                rd_first <= '0';
+                if rd_lane = PX_PER_BEAT-1 then
+                    rd_full <= '0';
+                end if;
+                rd_lane <= rd_lane + 1;
+
+                -- Advance x / row / channel / stripe
+                if rd_x = unsigned(cfg_width) - 1 then
+                    rd_x <= (others => '0');
+                    if rd_row = rd_r1 - 1 then
+                        rd_row <= rd_r0;
+                        if rd_ch = unsigned(cfg_channels) - 1 then
+                            rd_ch <= (others => '0');
+                            rd_first <= '1';
+                            if rd_pass + 1 < unsigned(cfg_passes) then
+                                rd_pass <= rd_pass + 1;
+                            elsif band_last(rd_y0, unsigned(cfg_stripe_rows), unsigned(cfg_height)) then
+                                refill_done <= '1';
+                            else
+                                rd_pass <= (others => '0');
+                                rd_y0 <= rd_y0 + resize(unsigned(cfg_stripe_rows), 12);
+                                rd_r0 <= rd_y0 + resize(unsigned(cfg_stripe_rows), 12);
+                                rd_row <= rd_y0 + resize(unsigned(cfg_stripe_rows), 12);
+                                rd_r1 <= band_end(rd_y0 + resize(unsigned(cfg_stripe_rows), 12),
+                                                  unsigned(cfg_stripe_rows), unsigned(cfg_height));
+                            end if;
+                        else
+                            rd_ch <= rd_ch + 1;
+                        end if;
+                    else
+                        rd_row <= rd_row + 1;
+                    end if;
+                else
+                    rd_x <= rd_x + 1;
+                end if;
+            end if;
+
+            -- Load the next beat (overrides the lane/full update above)
+            if beat_take = '1' then
+                rd_word <= m_axi_rdata;
+                rd_lane <= (others => '0');
+                rd_full <= '1';
+                if m_axi_rresp /= "00" then
+                    axi_error <= '1';
+                end if;
+            end if;
+        end if;
+    end process;
+
+    m_axi_rready <= rd_ready;
+
+    m_axis_tdata <= rd_word(DATA_WIDTH*to_integer(rd_lane)+DATA_WIDTH-1 downto DATA_WIDTH*to_integer(rd_lane));
+    m_axis_tvalid <= rd_full;
+    m_axis_tlast <= '1' when rd_x = unsigned(cfg_width) - 1 else '0';
+    m_axis_tuser <= rd_first;
+
+    stripe_rows <= std_logic_vector(rd_r1 - rd_r0);
+    last_stripe <= '1' when band_last(rd_y0, unsigned(cfg_stripe_rows), unsigned(cfg_height)) else '0';
+
+    -- ==========================================================================
+    -- Status
+    -- ==========================================================================
+    busy <= '1' when wr_state /= W_FILL or ar_state /= AR_IDLE or rd_full = '1' else '0';
+    dma_error <= axi_error;
+
+end rtl;
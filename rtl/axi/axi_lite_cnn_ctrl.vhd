@@ -2,10 +2,12 @@
 -- AXI-Lite Register Interface for CNN Accelerator Control
 -- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
 -- 
--- Register Map:
---   0x00: Control Register (start, stop, reset)
+-- Register Map (4KB window, banked by address bits [11:8]):
+--
+-- Bank 0 - global control:
+--   0x00: Control Register (start, stop, reset, commit)
 --   0x04: Status Register (busy, done, error)
---   0x08: Configuration (layer enables, activation type)
+--   0x08: Configuration (layer enables, activation type, pool type, BN enable)
 --   0x0C: Input dimensions (width, height)
 --   0x10: Weight base address
 --   0x14: Bias base address
@@ -15,16 +17,77 @@
 --   0x24: Interrupt status
 --   0x28: Performance counter (cycles)
 --   0x2C: Performance counter (operations)
+--   0x30: Feature-map scratch base address (DDR spill)
+--   0x34: Tiling (enable, stripe height)
+--   0x38: Frame buffer control (enable, latest-frame-wins policy)
+--   0x3C: Frame buffer statistics (drops, overruns; write clears)
+--   0x40: Source frame dimensions (0 = same as input dimensions)
+--   0x44: Crop origin (x, y)
+--   0x48: Crop dimensions (width, height; 0 = no crop/scale)
+--   0x4C: Horizontal scale step (Q16.16, 0 = crop only)
+--   0x50: Vertical scale step (Q16.16, 0 = crop only)
+--   0x54: Red normalization (mean Q8.8, scale Q1.15)
+--   0x58: Green normalization (mean Q8.8, scale Q1.15)
+--   0x5C: Blue normalization (mean Q8.8, scale Q1.15)
+--   0x60: Input format (RGB888 / YUV422 stream / NV12 from memory, matrix)
+--   0x64: Command ring base address
+--   0x68: Command ring configuration (entries, enable)
+--   0x6C: Command ring head (read-only, next descriptor to consume)
+--   0x70: Command ring tail (next free descriptor)
+--   0x74: Completion counter (read-only, write clears)
+--   0x78: Interrupt coalescing count (IRQ after N completions)
+--   0x7C: Interrupt coalescing timeout (cycles after the first pending one)
+--   0x80: Streaming control (every video SOF starts an inference, overlap)
+--   0x84: Frame tags (read-only: last completed, frame in the front stage)
+--   0x88: Top-K status (read-only: logits in the last frame, entries in use)
+--   0x8C: Top-K entries, TOPK_K words (read-only: class, logit), best first
+--   0xA0: Detection config (enable, grid width)
+--   0xA4: Detection cell size (width, height; Q0.16 image fractions)
+--   0xA8: Detection anchor size (width, height; Q0.16 image fractions)
+--   0xAC: Detection thresholds (score Q8.8, IoU Q0.8)
+--   0xB0: Detection output base address
+--   0xB4: Detection status (read-only: boxes, candidates over threshold)
+--
+-- Bank 1 - identification (read-only):
+--   0x100: Core ID ("CNNA")
+--   0x104: Core version (major, minor, patch)
+--   0x108: Capability bits (CAP_* in cnn_pkg)
+--   0x10C: Engine (conv layers, MACs per layer, data width, fraction bits)
+--   0x110: Build input dimensions (width, height)
+--
+-- Bank 2 - per conv layer, 0x200 + layer * 0x20:
+--   +0x00: Layer config (activation, BN enable, pool type, int8, sparse,
+--          GEMM backend, override)
+--   +0x04: Busy cycles in the last run (read-only)
+--   +0x08: Output stall cycles in the last run (read-only)
+--   +0x0C: Output beats in the last run (read-only)
+--   +0x10: Input FIFO high-water mark (read-only, write clears)
+--   +0x14: Int8 quantization (input / output zero point, activation clamp)
+--
+-- CONFIG, INPUT_DIM, the DMA / scratch addresses, TILE_CFG, the crop / scale
+-- and normalization registers, INPUT_FMT, the detection registers and the
+-- layer config / quantization registers are shadowed:
+-- writes take effect when CONTROL.commit is set, at the next frame boundary.
 -- =============================================================================
 
 library IEEE;
 use IEEE.STD_LOGIC_1164.ALL;
 use IEEE.NUMERIC_STD.ALL;
 
+library work;
+use work.cnn_pkg.all;
+
 entity axi_lite_cnn_ctrl is
     generic (
         C_S_AXI_DATA_WIDTH  : integer := 32;
-        C_S_AXI_ADDR_WIDTH  : integer := 6
+        C_S_AXI_ADDR_WIDTH  : integer := 12;
+        
+        -- Build description reported in the identification bank
+        NUM_LAYERS      : integer := 2;    -- Conv layers (max 8)
+        NUM_MAC_UNITS   : integer := 9;
+        BUILD_WIDTH     : integer := 128;
+        BUILD_HEIGHT    : integer := 128;
+        CAPABILITIES    : std_logic_vector(31 downto 0) := (others => '0')
     );
     port (
         -- AXI-Lite Slave Interface
@@ -69,19 +132,101 @@ entity axi_lite_cnn_ctrl is
         stat_busy       : in  std_logic;
         stat_done       : in  std_logic;
         stat_error      : in  std_logic_vector(3 downto 0);
+        job_complete    : in  std_logic;    -- One pulse per finished inference
         
         -- CNN Configuration
         cfg_layer_enable: out std_logic_vector(7 downto 0);
-        cfg_activation  : out std_logic_vector(2 downto 0);
-        cfg_pool_type   : out std_logic;
         cfg_input_width : out std_logic_vector(11 downto 0);
         cfg_input_height: out std_logic_vector(11 downto 0);
         
+        -- Per conv layer (CONFIG fields unless the layer overrides them)
+        cfg_layer_act   : out std_logic_vector(3*NUM_LAYERS-1 downto 0);
+        cfg_layer_bn    : out std_logic_vector(NUM_LAYERS-1 downto 0);
+        cfg_layer_pool  : out std_logic_vector(NUM_LAYERS-1 downto 0);
+        cfg_layer_int8  : out std_logic_vector(NUM_LAYERS-1 downto 0);
+        cfg_layer_sparse: out std_logic_vector(NUM_LAYERS-1 downto 0);
+        cfg_layer_gemm  : out std_logic_vector(NUM_LAYERS-1 downto 0);
+        cfg_layer_quant : out std_logic_vector(32*NUM_LAYERS-1 downto 0);
+        
+        -- Per conv layer telemetry (32 bits each, cleared at run start)
+        layer_cycles    : in  std_logic_vector(32*NUM_LAYERS-1 downto 0);
+        layer_stalls    : in  std_logic_vector(32*NUM_LAYERS-1 downto 0);
+        layer_beats     : in  std_logic_vector(32*NUM_LAYERS-1 downto 0);
+        
+        -- Per conv layer input FIFO high-water mark (16 bits each)
+        layer_fifo_hwm  : in  std_logic_vector(16*NUM_LAYERS-1 downto 0);
+        layer_hwm_clear : out std_logic_vector(NUM_LAYERS-1 downto 0);
+        
         -- DMA Addresses
         dma_weight_addr : out std_logic_vector(31 downto 0);
         dma_bias_addr   : out std_logic_vector(31 downto 0);
         dma_input_addr  : out std_logic_vector(31 downto 0);
         dma_output_addr : out std_logic_vector(31 downto 0);
+        dma_fmap_addr   : out std_logic_vector(31 downto 0);
+        
+        -- Tiling
+        cfg_tile_enable : out std_logic;
+        cfg_stripe_rows : out std_logic_vector(7 downto 0);
+        
+        -- Frame buffer
+        cfg_fb_enable   : out std_logic;
+        cfg_fb_latest   : out std_logic;
+        fb_stats_clear  : out std_logic;
+        fb_drop_count   : in  std_logic_vector(15 downto 0);
+        fb_overrun_count: in  std_logic_vector(15 downto 0);
+        
+        -- Input crop / scale
+        cfg_src_width   : out std_logic_vector(11 downto 0);
+        cfg_src_height  : out std_logic_vector(11 downto 0);
+        cfg_scale_enable: out std_logic;
+        cfg_crop_x      : out std_logic_vector(11 downto 0);
+        cfg_crop_y      : out std_logic_vector(11 downto 0);
+        cfg_crop_width  : out std_logic_vector(11 downto 0);
+        cfg_crop_height : out std_logic_vector(11 downto 0);
+        cfg_step_x      : out std_logic_vector(31 downto 0);
+        cfg_step_y      : out std_logic_vector(31 downto 0);
+        
+        -- Input normalization ([15:0] mean, [31:16] scale)
+        cfg_norm_r      : out std_logic_vector(31 downto 0);
+        cfg_norm_g      : out std_logic_vector(31 downto 0);
+        cfg_norm_b      : out std_logic_vector(31 downto 0);
+        
+        -- Input format
+        cfg_input_fmt   : out std_logic_vector(1 downto 0);
+        cfg_yuv_bt709   : out std_logic;
+        cfg_yuv_full    : out std_logic;
+        
+        -- Command ring
+        cfg_ring_enable : out std_logic;
+        cfg_ring_base   : out std_logic_vector(31 downto 0);
+        cfg_ring_size   : out std_logic_vector(15 downto 0);
+        cfg_ring_tail   : out std_logic_vector(15 downto 0);
+        ring_head       : in  std_logic_vector(15 downto 0);
+        
+        -- Streaming mode
+        cfg_stream_enable: out std_logic;
+        cfg_stream_overlap: out std_logic;
+        frame_tag_done  : in  std_logic_vector(15 downto 0);
+        frame_tag_front : in  std_logic_vector(15 downto 0);
+        cfg_commit_pending: out std_logic;
+        
+        -- Top-K result registers (last completed frame)
+        topk_entries    : in  std_logic_vector(32*TOPK_K-1 downto 0);
+        topk_valid      : in  std_logic_vector(3 downto 0);
+        topk_classes    : in  std_logic_vector(15 downto 0);
+        
+        -- Detection post-processing
+        cfg_det_enable  : out std_logic;
+        cfg_det_grid_w  : out std_logic_vector(7 downto 0);
+        cfg_det_cell_w  : out std_logic_vector(15 downto 0);
+        cfg_det_cell_h  : out std_logic_vector(15 downto 0);
+        cfg_det_anchor_w: out std_logic_vector(15 downto 0);
+        cfg_det_anchor_h: out std_logic_vector(15 downto 0);
+        cfg_det_score_thr: out std_logic_vector(15 downto 0);
+        cfg_det_iou_thr : out std_logic_vector(7 downto 0);
+        cfg_det_addr    : out std_logic_vector(31 downto 0);
+        det_count       : in  std_logic_vector(7 downto 0);
+        det_candidates  : in  std_logic_vector(15 downto 0);
         
         -- Interrupt
         irq             : out std_logic;
@@ -99,18 +244,87 @@ architecture rtl of axi_lite_cnn_ctrl is
     signal axi_state : axi_state_t;
     
     -- Register addresses
-    constant REG_CONTROL        : std_logic_vector(5 downto 0) := "000000";  -- 0x00
-    constant REG_STATUS         : std_logic_vector(5 downto 0) := "000100";  -- 0x04
-    constant REG_CONFIG         : std_logic_vector(5 downto 0) := "001000";  -- 0x08
-    constant REG_INPUT_DIM      : std_logic_vector(5 downto 0) := "001100";  -- 0x0C
-    constant REG_WEIGHT_ADDR    : std_logic_vector(5 downto 0) := "010000";  -- 0x10
-    constant REG_BIAS_ADDR      : std_logic_vector(5 downto 0) := "010100";  -- 0x14
-    constant REG_INPUT_ADDR     : std_logic_vector(5 downto 0) := "011000";  -- 0x18
-    constant REG_OUTPUT_ADDR    : std_logic_vector(5 downto 0) := "011100";  -- 0x1C
-    constant REG_IRQ_ENABLE     : std_logic_vector(5 downto 0) := "100000";  -- 0x20
-    constant REG_IRQ_STATUS     : std_logic_vector(5 downto 0) := "100100";  -- 0x24
-    constant REG_PERF_CYCLES    : std_logic_vector(5 downto 0) := "101000";  -- 0x28
-    constant REG_PERF_OPS       : std_logic_vector(5 downto 0) := "101100";  -- 0x2C
+    constant REG_CONTROL        : std_logic_vector(11 downto 0) := x"000";  -- 0x00
+    constant REG_STATUS         : std_logic_vector(11 downto 0) := x"004";  -- 0x04
+    constant REG_CONFIG         : std_logic_vector(11 downto 0) := x"008";  -- 0x08
+    constant REG_INPUT_DIM      : std_logic_vector(11 downto 0) := x"00C";  -- 0x0C
+    constant REG_WEIGHT_ADDR    : std_logic_vector(11 downto 0) := x"010";  -- 0x10
+    constant REG_BIAS_ADDR      : std_logic_vector(11 downto 0) := x"014";  -- 0x14
+    constant REG_INPUT_ADDR     : std_logic_vector(11 downto 0) := x"018";  -- 0x18
+    constant REG_OUTPUT_ADDR    : std_logic_vector(11 downto 0) := x"01C";  -- 0x1C
+    constant REG_IRQ_ENABLE     : std_logic_vector(11 downto 0) := x"020";  -- 0x20
+    constant REG_IRQ_STATUS     : std_logic_vector(11 downto 0) := x"024";  -- 0x24
+    constant REG_PERF_CYCLES    : std_logic_vector(11 downto 0) := x"028";  -- 0x28
+    constant REG_PERF_OPS       : std_logic_vector(11 downto 0) := x"02C";  -- 0x2C
+    constant REG_FMAP_ADDR      : std_logic_vector(11 downto 0) := x"030";  -- 0x30
+    constant REG_TILE_CFG       : std_logic_vector(11 downto 0) := x"034";  -- 0x34
+    constant REG_FB_CTRL        : std_logic_vector(11 downto 0) := x"038";  -- 0x38
+    constant REG_FB_STATS       : std_logic_vector(11 downto 0) := x"03C";  -- 0x3C
+    constant REG_SRC_DIM        : std_logic_vector(11 downto 0) := x"040";  -- 0x40
+    constant REG_CROP_ORIGIN    : std_logic_vector(11 downto 0) := x"044";  -- 0x44
+    constant REG_CROP_DIM       : std_logic_vector(11 downto 0) := x"048";  -- 0x48
+    constant REG_SCALE_X        : std_logic_vector(11 downto 0) := x"04C";  -- 0x4C
+    constant REG_SCALE_Y        : std_logic_vector(11 downto 0) := x"050";  -- 0x50
+    constant REG_NORM_R         : std_logic_vector(11 downto 0) := x"054";  -- 0x54
+    constant REG_NORM_G         : std_logic_vector(11 downto 0) := x"058";  -- 0x58
+    constant REG_NORM_B         : std_logic_vector(11 downto 0) := x"05C";  -- 0x5C
+    constant REG_INPUT_FMT      : std_logic_vector(11 downto 0) := x"060";  -- 0x60
+    constant REG_RING_BASE      : std_logic_vector(11 downto 0) := x"064";  -- 0x64
+    constant REG_RING_CFG       : std_logic_vector(11 downto 0) := x"068";  -- 0x68
+    constant REG_RING_HEAD      : std_logic_vector(11 downto 0) := x"06C";  -- 0x6C
+    constant REG_RING_TAIL      : std_logic_vector(11 downto 0) := x"070";  -- 0x70
+    constant REG_COMPLETIONS    : std_logic_vector(11 downto 0) := x"074";  -- 0x74
+    constant REG_IRQ_COALESCE   : std_logic_vector(11 downto 0) := x"078";  -- 0x78
+    constant REG_IRQ_TIMEOUT    : std_logic_vector(11 downto 0) := x"07C";  -- 0x7C
+    constant REG_STREAM_CTRL    : std_logic_vector(11 downto 0) := x"080";  -- 0x80
+    constant REG_FRAME_TAG      : std_logic_vector(11 downto 0) := x"084";  -- 0x84
+    constant REG_TOPK_STATUS    : std_logic_vector(11 downto 0) := x"088";  -- 0x88
+    constant REG_TOPK_BASE      : std_logic_vector(11 downto 0) := x"08C";  -- 0x8C + 4*k
+    constant REG_DET_CFG        : std_logic_vector(11 downto 0) := x"0A0";  -- 0xA0
+    constant REG_DET_CELL       : std_logic_vector(11 downto 0) := x"0A4";  -- 0xA4
+    constant REG_DET_ANCHOR     : std_logic_vector(11 downto 0) := x"0A8";  -- 0xA8
+    constant REG_DET_THRESH     : std_logic_vector(11 downto 0) := x"0AC";  -- 0xAC
+    constant REG_DET_ADDR       : std_logic_vector(11 downto 0) := x"0B0";  -- 0xB0
+    constant REG_DET_STATUS     : std_logic_vector(11 downto 0) := x"0B4";  -- 0xB4
+    constant REG_CORE_ID        : std_logic_vector(11 downto 0) := x"100";  -- 0x100
+    constant REG_CORE_VERSION   : std_logic_vector(11 downto 0) := x"104";  -- 0x104
+    constant REG_CAPABILITIES   : std_logic_vector(11 downto 0) := x"108";  -- 0x108
+    constant REG_ENGINE         : std_logic_vector(11 downto 0) := x"10C";  -- 0x10C
+    constant REG_BUILD_DIM      : std_logic_vector(11 downto 0) := x"110";  -- 0x110
+    
+    -- Per-layer bank: 0x200 + layer * 0x20, register at [4:0]
+    constant BANK_LAYER         : std_logic_vector(3 downto 0) := x"2";
+    constant LREG_CFG           : std_logic_vector(4 downto 0) := "00000";  -- +0x00
+    constant LREG_CYCLES        : std_logic_vector(4 downto 0) := "00100";  -- +0x04
+    constant LREG_STALLS        : std_logic_vector(4 downto 0) := "01000";  -- +0x08
+    constant LREG_BEATS         : std_logic_vector(4 downto 0) := "01100";  -- +0x0C
+    constant LREG_FIFO_HWM      : std_logic_vector(4 downto 0) := "10000";  -- +0x10
+    constant LREG_QUANT         : std_logic_vector(4 downto 0) := "10100";  -- +0x14
+    
+    -- Layer config: [2:0] activation, [3] BN enable, [4] pool type,
+    -- [5] int8 datapath, [6] sparse MAC lanes, [7] GEMM backend, [31]
+    -- override (0 = follow CONFIG, Q8.8, dense, conv2d_engine)
+    constant LAYER_INT8         : integer := 5;
+    constant LAYER_SPARSE       : integer := 6;
+    constant LAYER_GEMM         : integer := 7;
+    constant LAYER_OVERRIDE     : integer := 31;
+    
+    -- Layer quantization: [7:0] input zero point, [15:8] output zero point,
+    -- [23:16] activation min, [31:24] activation max (all int8)
+    constant QUANT_DEFAULT      : std_logic_vector(31 downto 0) := x"7F800000";
+    
+    -- Engine description
+    constant ENGINE_INFO        : std_logic_vector(31 downto 0) :=
+        std_logic_vector(to_unsigned(FRAC_BITS, 8)) & std_logic_vector(to_unsigned(DATA_WIDTH, 8)) &
+        std_logic_vector(to_unsigned(NUM_MAC_UNITS, 8)) & std_logic_vector(to_unsigned(NUM_LAYERS, 8));
+    constant BUILD_DIM          : std_logic_vector(31 downto 0) :=
+        std_logic_vector(to_unsigned(BUILD_HEIGHT, 16)) & std_logic_vector(to_unsigned(BUILD_WIDTH, 16));
+    
+    -- (pixel - 128) / 128: maps [0, 255] to [-1, 1]
+    constant NORM_DEFAULT       : std_logic_vector(31 downto 0) := x"01008000";
+    constant CONFIG_DEFAULT     : std_logic_vector(31 downto 0) := x"000001FF";  -- All layers, ReLU
+    constant INPUT_DIM_DEFAULT  : std_logic_vector(31 downto 0) := x"00800080";  -- 128x128
+    constant DET_THRESH_DEFAULT : std_logic_vector(31 downto 0) := x"00800080";  -- Score 0.5, IoU 0.5
     
     -- Registers
     signal reg_control      : std_logic_vector(31 downto 0);
@@ -122,21 +336,87 @@ architecture rtl of axi_lite_cnn_ctrl is
     signal reg_output_addr  : std_logic_vector(31 downto 0);
     signal reg_irq_enable   : std_logic_vector(31 downto 0);
     signal reg_irq_status   : std_logic_vector(31 downto 0);
+    signal reg_fmap_addr    : std_logic_vector(31 downto 0);
+    signal reg_tile_cfg     : std_logic_vector(31 downto 0);
+    signal reg_fb_ctrl      : std_logic_vector(31 downto 0);
+    signal stats_clear_reg  : std_logic;
+    signal reg_src_dim      : std_logic_vector(31 downto 0);
+    signal reg_crop_origin  : std_logic_vector(31 downto 0);
+    signal reg_crop_dim     : std_logic_vector(31 downto 0);
+    signal reg_scale_x      : std_logic_vector(31 downto 0);
+    signal reg_scale_y      : std_logic_vector(31 downto 0);
+    signal reg_norm_r       : std_logic_vector(31 downto 0);
+    signal reg_norm_g       : std_logic_vector(31 downto 0);
+    signal reg_norm_b       : std_logic_vector(31 downto 0);
+    signal reg_input_fmt    : std_logic_vector(31 downto 0);
+    signal reg_ring_base    : std_logic_vector(31 downto 0);
+    signal reg_ring_cfg     : std_logic_vector(31 downto 0);
+    signal reg_ring_tail    : std_logic_vector(31 downto 0);
+    signal reg_irq_coalesce : std_logic_vector(31 downto 0);
+    signal reg_irq_timeout  : std_logic_vector(31 downto 0);
+    signal completions_clear: std_logic;
+    signal hwm_clear        : std_logic_vector(NUM_LAYERS-1 downto 0);
+    signal reg_stream_ctrl  : std_logic_vector(31 downto 0);
+    signal reg_det_cfg      : std_logic_vector(31 downto 0);
+    signal reg_det_cell     : std_logic_vector(31 downto 0);
+    signal reg_det_anchor   : std_logic_vector(31 downto 0);
+    signal reg_det_thresh   : std_logic_vector(31 downto 0);
+    signal reg_det_addr     : std_logic_vector(31 downto 0);
+    
+    type layer_regs_t is array (0 to NUM_LAYERS-1) of std_logic_vector(31 downto 0);
+    signal reg_layer_cfg    : layer_regs_t;
+    signal reg_layer_quant  : layer_regs_t;
+    
+    -- Active copies of the shadowed registers (drive the datapath)
+    signal act_config       : std_logic_vector(31 downto 0);
+    signal act_input_dim    : std_logic_vector(31 downto 0);
+    signal act_weight_addr  : std_logic_vector(31 downto 0);
+    signal act_bias_addr    : std_logic_vector(31 downto 0);
+    signal act_input_addr   : std_logic_vector(31 downto 0);
+    signal act_output_addr  : std_logic_vector(31 downto 0);
+    signal act_fmap_addr    : std_logic_vector(31 downto 0);
+    signal act_tile_cfg     : std_logic_vector(31 downto 0);
+    signal act_src_dim      : std_logic_vector(31 downto 0);
+    signal act_crop_origin  : std_logic_vector(31 downto 0);
+    signal act_crop_dim     : std_logic_vector(31 downto 0);
+    signal act_scale_x      : std_logic_vector(31 downto 0);
+    signal act_scale_y      : std_logic_vector(31 downto 0);
+    signal act_norm_r       : std_logic_vector(31 downto 0);
+    signal act_norm_g       : std_logic_vector(31 downto 0);
+    signal act_norm_b       : std_logic_vector(31 downto 0);
+    signal act_input_fmt    : std_logic_vector(31 downto 0);
+    signal act_det_cfg      : std_logic_vector(31 downto 0);
+    signal act_det_cell     : std_logic_vector(31 downto 0);
+    signal act_det_anchor   : std_logic_vector(31 downto 0);
+    signal act_det_thresh   : std_logic_vector(31 downto 0);
+    signal act_det_addr     : std_logic_vector(31 downto 0);
+    signal act_layer_cfg    : layer_regs_t;
+    signal act_layer_quant  : layer_regs_t;
+    signal commit_pending   : std_logic;
     
     -- Internal signals
     signal awaddr_reg       : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0);
     signal araddr_reg       : std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0);
     signal rdata_reg        : std_logic_vector(C_S_AXI_DATA_WIDTH-1 downto 0);
+    signal wr_layer         : integer range 0 to 7;
+    signal rd_layer         : integer range 0 to 7;
+    signal wr_layer_sel     : std_logic;
+    signal rd_layer_sel     : std_logic;
+    signal rd_topk          : integer range 0 to 1023;
+    signal rd_topk_sel      : std_logic;
     
     -- Pulse generators for control bits
     signal start_pulse      : std_logic;
     signal stop_pulse       : std_logic;
     signal reset_pulse      : std_logic;
-    signal control_prev     : std_logic_vector(2 downto 0);
+    signal commit_pulse     : std_logic;
+    signal control_prev     : std_logic_vector(3 downto 0);
     
-    -- Done edge detection for interrupt
-    signal done_prev        : std_logic;
-    signal done_edge        : std_logic;
+    -- Completion counting and interrupt coalescing
+    signal completion_cnt   : unsigned(31 downto 0);
+    signal pending_cnt      : unsigned(15 downto 0);
+    signal pending_timer    : unsigned(31 downto 0);
+    signal coalesce_fire    : std_logic;
 
 begin
 
@@ -186,6 +466,17 @@ begin
         end if;
     end process;
 
+    -- Per-layer bank decode (layers past NUM_LAYERS read as zero)
+    wr_layer <= to_integer(unsigned(awaddr_reg(7 downto 5)));
+    rd_layer <= to_integer(unsigned(araddr_reg(7 downto 5)));
+    wr_layer_sel <= '1' when awaddr_reg(11 downto 8) = BANK_LAYER and wr_layer < NUM_LAYERS else '0';
+    rd_layer_sel <= '1' when araddr_reg(11 downto 8) = BANK_LAYER and rd_layer < NUM_LAYERS else '0';
+
+    -- Top-K entries, one word each from REG_TOPK_BASE
+    rd_topk <= to_integer(unsigned(araddr_reg) - unsigned(REG_TOPK_BASE)) / 4;
+    rd_topk_sel <= '1' when unsigned(araddr_reg) >= unsigned(REG_TOPK_BASE) and
+                            unsigned(araddr_reg) < unsigned(REG_TOPK_BASE) + 4*TOPK_K else '0';
+
     -- ==========================================================================
     -- Write Process
     -- ==========================================================================
@@ -194,15 +485,46 @@ begin
         if rising_edge(S_AXI_ACLK) then
             if S_AXI_ARESETN = '0' then
                 reg_control <= (others => '0');
-                reg_config <= x"000001FF";  -- All layers enabled, ReLU activation
-                reg_input_dim <= x"00800080";  -- 128x128
+                reg_config <= CONFIG_DEFAULT;
+                reg_input_dim <= INPUT_DIM_DEFAULT;
                 reg_weight_addr <= (others => '0');
                 reg_bias_addr <= (others => '0');
                 reg_input_addr <= (others => '0');
                 reg_output_addr <= (others => '0');
                 reg_irq_enable <= (others => '0');
+                reg_fmap_addr <= (others => '0');
+                reg_tile_cfg <= (others => '0');  -- Untiled
+                reg_fb_ctrl <= (others => '0');   -- Frame buffer bypassed
+                stats_clear_reg <= '0';
+                reg_src_dim <= (others => '0');
+                reg_crop_origin <= (others => '0');
+                reg_crop_dim <= (others => '0');    -- Scaler bypassed
+                reg_scale_x <= (others => '0');
+                reg_scale_y <= (others => '0');
+                reg_norm_r <= NORM_DEFAULT;
+                reg_norm_g <= NORM_DEFAULT;
+                reg_norm_b <= NORM_DEFAULT;
+                reg_input_fmt <= (others => '0');   -- RGB888 stream
+                reg_ring_base <= (others => '0');
+                reg_ring_cfg <= (others => '0');    -- Ring disabled
+                reg_ring_tail <= (others => '0');
+                reg_irq_coalesce <= (others => '0');  -- IRQ on every completion
+                reg_irq_timeout <= (others => '0');   -- No timeout
+                completions_clear <= '0';
+                hwm_clear <= (others => '0');
+                reg_stream_ctrl <= (others => '0');  -- Start per CONTROL write
+                reg_det_cfg <= (others => '0');     -- Detection off
+                reg_det_cell <= (others => '0');
+                reg_det_anchor <= (others => '0');
+                reg_det_thresh <= DET_THRESH_DEFAULT;
+                reg_det_addr <= (others => '0');
+                reg_layer_cfg <= (others => (others => '0'));  -- Follow CONFIG
+                reg_layer_quant <= (others => QUANT_DEFAULT);
             elsif axi_state = WRITE_ADDR and S_AXI_WVALID = '1' then
-                case awaddr_reg is
+                stats_clear_reg <= '0';
+                completions_clear <= '0';
+                hwm_clear <= (others => '0');
+                case awaddr_reg(11 downto 0) is
                     when REG_CONTROL =>
                         reg_control <= S_AXI_WDATA;
                     when REG_CONFIG =>
@@ -222,17 +544,85 @@ begin
                     when REG_IRQ_STATUS =>
                         -- Write 1 to clear
                         reg_irq_status <= reg_irq_status and not S_AXI_WDATA;
+                    when REG_FMAP_ADDR =>
+                        reg_fmap_addr <= S_AXI_WDATA;
+                    when REG_TILE_CFG =>
+                        reg_tile_cfg <= S_AXI_WDATA;
+                    when REG_FB_CTRL =>
+                        reg_fb_ctrl <= S_AXI_WDATA;
+                    when REG_FB_STATS =>
+                        -- Any write clears the counters
+                        stats_clear_reg <= '1';
+                    when REG_SRC_DIM =>
+                        reg_src_dim <= S_AXI_WDATA;
+                    when REG_CROP_ORIGIN =>
+                        reg_crop_origin <= S_AXI_WDATA;
+                    when REG_CROP_DIM =>
+                        reg_crop_dim <= S_AXI_WDATA;
+                    when REG_SCALE_X =>
+                        reg_scale_x <= S_AXI_WDATA;
+                    when REG_SCALE_Y =>
+                        reg_scale_y <= S_AXI_WDATA;
+                    when REG_NORM_R =>
+                        reg_norm_r <= S_AXI_WDATA;
+                    when REG_NORM_G =>
+                        reg_norm_g <= S_AXI_WDATA;
+                    when REG_NORM_B =>
+                        reg_norm_b <= S_AXI_WDATA;
+                    when REG_INPUT_FMT =>
+                        reg_input_fmt <= S_AXI_WDATA;
+                    when REG_RING_BASE =>
+                        reg_ring_base <= S_AXI_WDATA;
+                    when REG_RING_CFG =>
+                        reg_ring_cfg <= S_AXI_WDATA;
+                        -- Disabling the ring also rewinds the tail
+                        if S_AXI_WDATA(31) = '0' then
+                            reg_ring_tail <= (others => '0');
+                        end if;
+                    when REG_RING_TAIL =>
+                        reg_ring_tail <= S_AXI_WDATA;
+                    when REG_COMPLETIONS =>
+                        -- Any write clears the counter
+                        completions_clear <= '1';
+                    when REG_IRQ_COALESCE =>
+                        reg_irq_coalesce <= S_AXI_WDATA;
+                    when REG_IRQ_TIMEOUT =>
+                        reg_irq_timeout <= S_AXI_WDATA;
+                    when REG_STREAM_CTRL =>
+                        reg_stream_ctrl <= S_AXI_WDATA;
+                    when REG_DET_CFG =>
+                        reg_det_cfg <= S_AXI_WDATA;
+                    when REG_DET_CELL =>
+                        reg_det_cell <= S_AXI_WDATA;
+                    when REG_DET_ANCHOR =>
+                        reg_det_anchor <= S_AXI_WDATA;
+                    when REG_DET_THRESH =>
+                        reg_det_thresh <= S_AXI_WDATA;
+                    when REG_DET_ADDR =>
+                        reg_det_addr <= S_AXI_WDATA;
                     when others =>
-                        null;
+                        if wr_layer_sel = '1' and awaddr_reg(4 downto 0) = LREG_CFG then
+                            reg_layer_cfg(wr_layer) <= S_AXI_WDATA;
+                        end if;
+                        if wr_layer_sel = '1' and awaddr_reg(4 downto 0) = LREG_QUANT then
+                            reg_layer_quant(wr_layer) <= S_AXI_WDATA;
+                        end if;
+                        if wr_layer_sel = '1' and awaddr_reg(4 downto 0) = LREG_FIFO_HWM then
+                            hwm_clear(wr_layer) <= '1';
+                        end if;
                 end case;
             else
-                -- Auto-clear control pulses
-                reg_control(2 downto 0) <= (others => '0');
+                stats_clear_reg <= '0';
+                completions_clear <= '0';
+                hwm_clear <= (others => '0');
                 
-                -- Set interrupt status on done edge
-                if done_edge = '1' then
-                    reg_irq_status(0) <= '1';
-                end if;
+                -- Auto-clear control pulses
+                reg_control(3 downto 0) <= (others => '0');
+            end if;
+            
+            -- Coalesced completion interrupt (wins over a racing clear)
+            if S_AXI_ARESETN = '1' and coalesce_fire = '1' then
+                reg_irq_status(0) <= '1';
             end if;
         end if;
     end process;
@@ -244,11 +634,11 @@ begin
     begin
         if rising_edge(S_AXI_ACLK) then
             if axi_state = READ_ADDR then
-                case araddr_reg is
+                case araddr_reg(11 downto 0) is
                     when REG_CONTROL =>
                         rdata_reg <= reg_control;
                     when REG_STATUS =>
-                        rdata_reg <= (31 downto 8 => '0') & stat_error & "00" & stat_done & stat_busy;
+                        rdata_reg <= (31 downto 8 => '0') & stat_error & commit_pending & '0' & stat_done & stat_busy;
                     when REG_CONFIG =>
                         rdata_reg <= reg_config;
                     when REG_INPUT_DIM =>
@@ -269,8 +659,97 @@ begin
                         rdata_reg <= perf_cycles;
                     when REG_PERF_OPS =>
                         rdata_reg <= perf_ops;
+                    when REG_FMAP_ADDR =>
+                        rdata_reg <= reg_fmap_addr;
+                    when REG_TILE_CFG =>
+                        rdata_reg <= reg_tile_cfg;
+                    when REG_FB_CTRL =>
+                        rdata_reg <= reg_fb_ctrl;
+                    when REG_FB_STATS =>
+                        rdata_reg <= fb_overrun_count & fb_drop_count;
+                    when REG_SRC_DIM =>
+                        rdata_reg <= reg_src_dim;
+                    when REG_CROP_ORIGIN =>
+                        rdata_reg <= reg_crop_origin;
+                    when REG_CROP_DIM =>
+                        rdata_reg <= reg_crop_dim;
+                    when REG_SCALE_X =>
+                        rdata_reg <= reg_scale_x;
+                    when REG_SCALE_Y =>
+                        rdata_reg <= reg_scale_y;
+                    when REG_NORM_R =>
+                        rdata_reg <= reg_norm_r;
+                    when REG_NORM_G =>
+                        rdata_reg <= reg_norm_g;
+                    when REG_NORM_B =>
+                        rdata_reg <= reg_norm_b;
+                    when REG_INPUT_FMT =>
+                        rdata_reg <= reg_input_fmt;
+                    when REG_RING_BASE =>
+                        rdata_reg <= reg_ring_base;
+                    when REG_RING_CFG =>
+                        rdata_reg <= reg_ring_cfg;
+                    when REG_RING_HEAD =>
+                        rdata_reg <= x"0000" & ring_head;
+                    when REG_RING_TAIL =>
+                        rdata_reg <= reg_ring_tail;
+                    when REG_COMPLETIONS =>
+                        rdata_reg <= std_logic_vector(completion_cnt);
+                    when REG_IRQ_COALESCE =>
+                        rdata_reg <= reg_irq_coalesce;
+                    when REG_IRQ_TIMEOUT =>
+                        rdata_reg <= reg_irq_timeout;
+                    when REG_STREAM_CTRL =>
+                        rdata_reg <= reg_stream_ctrl;
+                    when REG_FRAME_TAG =>
+                        rdata_reg <= frame_tag_front & frame_tag_done;
+                    when REG_TOPK_STATUS =>
+                        rdata_reg <= x"000" & topk_valid & topk_classes;
+                    when REG_DET_CFG =>
+                        rdata_reg <= reg_det_cfg;
+                    when REG_DET_CELL =>
+                        rdata_reg <= reg_det_cell;
+                    when REG_DET_ANCHOR =>
+                        rdata_reg <= reg_det_anchor;
+                    when REG_DET_THRESH =>
+                        rdata_reg <= reg_det_thresh;
+                    when REG_DET_ADDR =>
+                        rdata_reg <= reg_det_addr;
+                    when REG_DET_STATUS =>
+                        rdata_reg <= det_candidates & x"00" & det_count;
+                    when REG_CORE_ID =>
+                        rdata_reg <= CNN_CORE_ID;
+                    when REG_CORE_VERSION =>
+                        rdata_reg <= CNN_CORE_VERSION;
+                    when REG_CAPABILITIES =>
+                        rdata_reg <= CAPABILITIES;
+                    when REG_ENGINE =>
+                        rdata_reg <= ENGINE_INFO;
+                    when REG_BUILD_DIM =>
+                        rdata_reg <= BUILD_DIM;
                     when others =>
                         rdata_reg <= (others => '0');
+                        if rd_topk_sel = '1' then
+                            rdata_reg <= topk_entries(32*rd_topk+31 downto 32*rd_topk);
+                        end if;
+                        if rd_layer_sel = '1' then
+                            case araddr_reg(4 downto 0) is
+                                when LREG_CFG =>
+                                    rdata_reg <= reg_layer_cfg(rd_layer);
+                                when LREG_CYCLES =>
+                                    rdata_reg <= layer_cycles(32*rd_layer+31 downto 32*rd_layer);
+                                when LREG_STALLS =>
+                                    rdata_reg <= layer_stalls(32*rd_layer+31 downto 32*rd_layer);
+                                when LREG_BEATS =>
+                                    rdata_reg <= layer_beats(32*rd_layer+31 downto 32*rd_layer);
+                                when LREG_FIFO_HWM =>
+                                    rdata_reg <= x"0000" & layer_fifo_hwm(16*rd_layer+15 downto 16*rd_layer);
+                                when LREG_QUANT =>
+                                    rdata_reg <= reg_layer_quant(rd_layer);
+                                when others =>
+                                    null;
+                            end case;
+                        end if;
                 end case;
             end if;
         end if;
@@ -284,10 +763,8 @@ begin
         if rising_edge(S_AXI_ACLK) then
             if S_AXI_ARESETN = '0' then
                 control_prev <= (others => '0');
-                done_prev <= '0';
             else
-                control_prev <= reg_control(2 downto 0);
-                done_prev <= stat_done;
+                control_prev <= reg_control(3 downto 0);
             end if;
         end if;
     end process;
@@ -295,7 +772,122 @@ begin
     start_pulse <= reg_control(0) and not control_prev(0);
     stop_pulse <= reg_control(1) and not control_prev(1);
     reset_pulse <= reg_control(2) and not control_prev(2);
-    done_edge <= stat_done and not done_prev;
+    commit_pulse <= reg_control(3) and not control_prev(3);
+
+    -- ==========================================================================
+    -- Shadow Register Commit
+    -- ==========================================================================
+    -- A commit is applied at once while the pipeline is idle, otherwise when
+    -- the frame in flight finishes, so a new configuration never lands inside
+    -- a frame. Commit before (not together with) START.
+    process(S_AXI_ACLK)
+    begin
+        if rising_edge(S_AXI_ACLK) then
+            if S_AXI_ARESETN = '0' then
+                commit_pending <= '0';
+                act_config <= CONFIG_DEFAULT;
+                act_input_dim <= INPUT_DIM_DEFAULT;
+                act_weight_addr <= (others => '0');
+                act_bias_addr <= (others => '0');
+                act_input_addr <= (others => '0');
+                act_output_addr <= (others => '0');
+                act_fmap_addr <= (others => '0');
+                act_tile_cfg <= (others => '0');
+                act_src_dim <= (others => '0');
+                act_crop_origin <= (others => '0');
+                act_crop_dim <= (others => '0');
+                act_scale_x <= (others => '0');
+                act_scale_y <= (others => '0');
+                act_norm_r <= NORM_DEFAULT;
+                act_norm_g <= NORM_DEFAULT;
+                act_norm_b <= NORM_DEFAULT;
+                act_input_fmt <= (others => '0');
+                act_det_cfg <= (others => '0');
+                act_det_cell <= (others => '0');
+                act_det_anchor <= (others => '0');
+                act_det_thresh <= DET_THRESH_DEFAULT;
+                act_det_addr <= (others => '0');
+                act_layer_cfg <= (others => (others => '0'));
+                act_layer_quant <= (others => QUANT_DEFAULT);
+            else
+                if commit_pulse = '1' then
+                    commit_pending <= '1';
+                end if;
+                
+                if (commit_pending = '1' or commit_pulse = '1') and stat_busy = '0' then
+                    commit_pending <= '0';
+                    act_config <= reg_config;
+                    act_input_dim <= reg_input_dim;
+                    act_weight_addr <= reg_weight_addr;
+                    act_bias_addr <= reg_bias_addr;
+                    act_input_addr <= reg_input_addr;
+                    act_output_addr <= reg_output_addr;
+                    act_fmap_addr <= reg_fmap_addr;
+                    act_tile_cfg <= reg_tile_cfg;
+                    act_src_dim <= reg_src_dim;
+                    act_crop_origin <= reg_crop_origin;
+                    act_crop_dim <= reg_crop_dim;
+                    act_scale_x <= reg_scale_x;
+                    act_scale_y <= reg_scale_y;
+                    act_norm_r <= reg_norm_r;
+                    act_norm_g <= reg_norm_g;
+                    act_norm_b <= reg_norm_b;
+                    act_input_fmt <= reg_input_fmt;
+                    act_det_cfg <= reg_det_cfg;
+                    act_det_cell <= reg_det_cell;
+                    act_det_anchor <= reg_det_anchor;
+                    act_det_thresh <= reg_det_thresh;
+                    act_det_addr <= reg_det_addr;
+                    act_layer_cfg <= reg_layer_cfg;
+                    act_layer_quant <= reg_layer_quant;
+                end if;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Completion Counter and Interrupt Coalescing
+    -- ==========================================================================
+    -- Completions accumulate until IRQ_COALESCE of them are pending or
+    -- IRQ_TIMEOUT cycles have passed since the first one; a count of 0 or 1
+    -- interrupts on every completion.
+    process(S_AXI_ACLK)
+        variable pending : unsigned(15 downto 0);
+    begin
+        if rising_edge(S_AXI_ACLK) then
+            if S_AXI_ARESETN = '0' then
+                completion_cnt <= (others => '0');
+                pending_cnt <= (others => '0');
+                pending_timer <= (others => '0');
+                coalesce_fire <= '0';
+            else
+                coalesce_fire <= '0';
+                
+                if completions_clear = '1' then
+                    completion_cnt <= (others => '0');
+                elsif job_complete = '1' then
+                    completion_cnt <= completion_cnt + 1;
+                end if;
+                
+                pending := pending_cnt;
+                if job_complete = '1' then
+                    pending := pending + 1;
+                end if;
+                
+                if pending = 0 then
+                    pending_timer <= (others => '0');
+                elsif pending >= unsigned(reg_irq_coalesce(15 downto 0)) or
+                      (unsigned(reg_irq_timeout) /= 0 and pending_timer >= unsigned(reg_irq_timeout)) then
+                    coalesce_fire <= '1';
+                    pending := (others => '0');
+                    pending_timer <= (others => '0');
+                else
+                    pending_timer <= pending_timer + 1;
+                end if;
+                pending_cnt <= pending;
+            end if;
+        end if;
+    end process;
 
     -- ==========================================================================
     -- AXI-Lite Response Signals
@@ -316,16 +908,77 @@ begin
     ctrl_stop <= stop_pulse;
     ctrl_reset <= reset_pulse;
     
-    cfg_layer_enable <= reg_config(7 downto 0);
-    cfg_activation <= reg_config(10 downto 8);
-    cfg_pool_type <= reg_config(11);
-    cfg_input_width <= reg_input_dim(11 downto 0);
-    cfg_input_height <= reg_input_dim(27 downto 16);
+    cfg_layer_enable <= act_config(7 downto 0);
+    cfg_input_width <= act_input_dim(11 downto 0);
+    cfg_input_height <= act_input_dim(27 downto 16);
+    
+    gen_layer_cfg: for i in 0 to NUM_LAYERS-1 generate
+        cfg_layer_act(3*i+2 downto 3*i) <= act_layer_cfg(i)(2 downto 0)
+            when act_layer_cfg(i)(LAYER_OVERRIDE) = '1' else act_config(10 downto 8);
+        cfg_layer_bn(i) <= act_layer_cfg(i)(3)
+            when act_layer_cfg(i)(LAYER_OVERRIDE) = '1' else act_config(12);
+        cfg_layer_pool(i) <= act_layer_cfg(i)(4)
+            when act_layer_cfg(i)(LAYER_OVERRIDE) = '1' else act_config(11);
+        cfg_layer_int8(i) <= act_layer_cfg(i)(LAYER_INT8) and act_layer_cfg(i)(LAYER_OVERRIDE);
+        cfg_layer_sparse(i) <= act_layer_cfg(i)(LAYER_SPARSE) and act_layer_cfg(i)(LAYER_OVERRIDE);
+        cfg_layer_gemm(i) <= act_layer_cfg(i)(LAYER_GEMM) and act_layer_cfg(i)(LAYER_OVERRIDE);
+        cfg_layer_quant(32*i+31 downto 32*i) <= act_layer_quant(i);
+    end generate;
+    
+    dma_weight_addr <= act_weight_addr;
+    dma_bias_addr <= act_bias_addr;
+    dma_input_addr <= act_input_addr;
+    dma_output_addr <= act_output_addr;
+    dma_fmap_addr <= act_fmap_addr;
+    
+    cfg_tile_enable <= act_tile_cfg(0);
+    cfg_stripe_rows <= act_tile_cfg(15 downto 8);
+    
+    cfg_fb_enable <= reg_fb_ctrl(0);
+    cfg_fb_latest <= reg_fb_ctrl(1);
+    fb_stats_clear <= stats_clear_reg;
+    
+    -- Unset source dimensions default to the CNN input dimensions
+    cfg_src_width <= act_src_dim(11 downto 0) when act_src_dim(11 downto 0) /= x"000" else
+                     act_input_dim(11 downto 0);
+    cfg_src_height <= act_src_dim(27 downto 16) when act_src_dim(27 downto 16) /= x"000" else
+                      act_input_dim(27 downto 16);
+    cfg_scale_enable <= '1' when act_crop_dim(11 downto 0) /= x"000" else '0';
+    cfg_crop_x <= act_crop_origin(11 downto 0);
+    cfg_crop_y <= act_crop_origin(27 downto 16);
+    cfg_crop_width <= act_crop_dim(11 downto 0);
+    cfg_crop_height <= act_crop_dim(27 downto 16);
+    cfg_step_x <= act_scale_x;
+    cfg_step_y <= act_scale_y;
+    
+    cfg_norm_r <= act_norm_r;
+    cfg_norm_g <= act_norm_g;
+    cfg_norm_b <= act_norm_b;
+    
+    cfg_input_fmt <= act_input_fmt(1 downto 0);
+    cfg_yuv_bt709 <= act_input_fmt(4);
+    cfg_yuv_full <= act_input_fmt(5);
+    
+    cfg_ring_enable <= reg_ring_cfg(31);
+    cfg_ring_base <= reg_ring_base;
+    cfg_ring_size <= reg_ring_cfg(15 downto 0);
+    cfg_ring_tail <= reg_ring_tail(15 downto 0);
+    
+    cfg_stream_enable <= reg_stream_ctrl(0);
+    cfg_stream_overlap <= reg_stream_ctrl(1);
+    cfg_commit_pending <= commit_pending;
+    
+    cfg_det_enable <= act_det_cfg(0);
+    cfg_det_grid_w <= act_det_cfg(15 downto 8);
+    cfg_det_cell_w <= act_det_cell(15 downto 0);
+    cfg_det_cell_h <= act_det_cell(31 downto 16);
+    cfg_det_anchor_w <= act_det_anchor(15 downto 0);
+    cfg_det_anchor_h <= act_det_anchor(31 downto 16);
+    cfg_det_score_thr <= act_det_thresh(15 downto 0);
+    cfg_det_iou_thr <= act_det_thresh(23 downto 16);
+    cfg_det_addr <= act_det_addr;
     
-    dma_weight_addr <= reg_weight_addr;
-    dma_bias_addr <= reg_bias_addr;
-    dma_input_addr <= reg_input_addr;
-    dma_output_addr <= reg_output_addr;
+    layer_hwm_clear <= hwm_clear;
     
     irq <= '1' when (reg_irq_status and reg_irq_enable) /= x"00000000" else '0';
 
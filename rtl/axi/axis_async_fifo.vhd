@@ -0,0 +1,220 @@
+-- =============================================================================
+-- AXI-Stream Asynchronous FIFO (block RAM)
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Independent write and read clocks; Gray-coded pointers cross through
+--     two-flop synchronizers
+--   - DEPTH entries of tdata + tlast + tuser in dual-clock block RAM
+--   - Registered RAM read into the output stage, full throughput
+--   - Write-side occupancy and high-water mark (pessimistic: counts entries
+--     until their read has crossed back)
+--   - Read-side flush drops everything that has crossed so far
+--
+-- DEPTH must be a power of two, at least 4.
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+entity axis_async_fifo is
+    generic (
+        DATA_W          : integer := 16;
+        DEPTH           : integer := 512
+    );
+    port (
+        -- Write side
+        s_clk           : in  std_logic;
+        s_rst_n         : in  std_logic;
+        s_axis_tdata    : in  std_logic_vector(DATA_W-1 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;
+        s_axis_tuser    : in  std_logic;
+        s_level         : out std_logic_vector(15 downto 0);
+        s_high_water    : out std_logic_vector(15 downto 0);
+        s_hwm_clear     : in  std_logic;
+
+        -- Read side
+        m_clk           : in  std_logic;
+        m_rst_n         : in  std_logic;
+        m_flush         : in  std_logic;
+        m_axis_tdata    : out std_logic_vector(DATA_W-1 downto 0);
+        m_axis_tvalid   : out std_logic;
+        m_axis_tready   : in  std_logic;
+        m_axis_tlast    : out std_logic;
+        m_axis_tuser    : out std_logic
+    );
+end axis_async_fifo;
+
+architecture rtl of axis_async_fifo is
+
+    function clog2(n : integer) return integer is
+        variable r : integer := 0;
+    begin
+        while 2**r < n loop
+            r := r + 1;
+        end loop;
+        return r;
+    end function;
+
+    constant ADDR_W     : integer := clog2(DEPTH);
+
+    subtype ptr_t is unsigned(ADDR_W downto 0);
+
+    function bin2gray(b : ptr_t) return ptr_t is
+    begin
+        return b xor shift_right(b, 1);
+    end function;
+
+    function gray2bin(g : ptr_t) return ptr_t is
+        variable b : ptr_t;
+    begin
+        b(ADDR_W) := g(ADDR_W);
+        for i in ADDR_W-1 downto 0 loop
+            b(i) := b(i+1) xor g(i);
+        end loop;
+        return b;
+    end function;
+
+    type mem_t is array (0 to DEPTH-1) of std_logic_vector(DATA_W+1 downto 0);
+    signal mem          : mem_t;
+    attribute ram_style : string;
+    attribute ram_style of mem : signal is "block";
+
+    -- Write side
+    signal wr_bin       : ptr_t;
+    signal wr_gray      : ptr_t;
+    signal rd_gray_s1   : ptr_t;
+    signal rd_gray_s2   : ptr_t;
+    signal wr_used      : ptr_t;
+    signal wr_en        : std_logic;
+    signal in_ready     : std_logic;
+    signal mark         : ptr_t;
+
+    -- Read side
+    signal rd_bin       : ptr_t;
+    signal rd_gray      : ptr_t;
+    signal wr_gray_s1   : ptr_t;
+    signal wr_gray_s2   : ptr_t;
+    signal rd_en        : std_logic;
+    signal rd_empty     : std_logic;
+    signal rd_data      : std_logic_vector(DATA_W+1 downto 0);
+    signal out_valid    : std_logic;
+
+    attribute ASYNC_REG : string;
+    attribute ASYNC_REG of rd_gray_s1 : signal is "TRUE";
+    attribute ASYNC_REG of rd_gray_s2 : signal is "TRUE";
+    attribute ASYNC_REG of wr_gray_s1 : signal is "TRUE";
+    attribute ASYNC_REG of wr_gray_s2 : signal is "TRUE";
+
+begin
+
+    -- ==========================================================================
+    -- Write Side
+    -- ==========================================================================
+    wr_en <= s_axis_tvalid and in_ready;
+    wr_used <= wr_bin - gray2bin(rd_gray_s2);
+
+    process(s_clk)
+    begin
+        if rising_edge(s_clk) then
+            if wr_en = '1' then
+                mem(to_integer(wr_bin(ADDR_W-1 downto 0))) <= s_axis_tuser & s_axis_tlast & s_axis_tdata;
+            end if;
+        end if;
+    end process;
+
+    process(s_clk, s_rst_n)
+        variable next_bin : ptr_t;
+    begin
+        if s_rst_n = '0' then
+            wr_bin <= (others => '0');
+            wr_gray <= (others => '0');
+            rd_gray_s1 <= (others => '0');
+            rd_gray_s2 <= (others => '0');
+            in_ready <= '1';
+            mark <= (others => '0');
+        elsif rising_edge(s_clk) then
+            rd_gray_s1 <= rd_gray;
+            rd_gray_s2 <= rd_gray_s1;
+
+            next_bin := wr_bin;
+            if wr_en = '1' then
+                next_bin := wr_bin + 1;
+            end if;
+            wr_bin <= next_bin;
+            wr_gray <= bin2gray(next_bin);
+
+            -- Full against the synchronized read pointer (registered ready)
+            if next_bin - gray2bin(rd_gray_s2) < DEPTH then
+                in_ready <= '1';
+            else
+                in_ready <= '0';
+            end if;
+
+            if s_hwm_clear = '1' then
+                mark <= (others => '0');
+            elsif wr_used > mark then
+                mark <= wr_used;
+            end if;
+        end if;
+    end process;
+
+    s_axis_tready <= in_ready;
+    s_level <= std_logic_vector(resize(wr_used, 16));
+    s_high_water <= std_logic_vector(resize(mark, 16));
+
+    -- ==========================================================================
+    -- Read Side
+    -- ==========================================================================
+    rd_empty <= '1' when rd_gray = wr_gray_s2 else '0';
+    rd_en <= '1' when rd_empty = '0' and (out_valid = '0' or m_axis_tready = '1') else '0';
+
+    process(m_clk)
+    begin
+        if rising_edge(m_clk) then
+            if rd_en = '1' then
+                rd_data <= mem(to_integer(rd_bin(ADDR_W-1 downto 0)));
+            end if;
+        end if;
+    end process;
+
+    process(m_clk, m_rst_n)
+        variable next_bin : ptr_t;
+    begin
+        if m_rst_n = '0' then
+            rd_bin <= (others => '0');
+            rd_gray <= (others => '0');
+            wr_gray_s1 <= (others => '0');
+            wr_gray_s2 <= (others => '0');
+            out_valid <= '0';
+        elsif rising_edge(m_clk) then
+            wr_gray_s1 <= wr_gray;
+            wr_gray_s2 <= wr_gray_s1;
+
+            if m_flush = '1' then
+                -- Catch up with the writer
+                next_bin := gray2bin(wr_gray_s2);
+                out_valid <= '0';
+            else
+                next_bin := rd_bin;
+                if rd_en = '1' then
+                    next_bin := rd_bin + 1;
+                    out_valid <= '1';
+                elsif m_axis_tready = '1' then
+                    out_valid <= '0';
+                end if;
+            end if;
+            rd_bin <= next_bin;
+            rd_gray <= bin2gray(next_bin);
+        end if;
+    end process;
+
+    m_axis_tdata <= rd_data(DATA_W-1 downto 0);
+    m_axis_tlast <= rd_data(DATA_W);
+    m_axis_tuser <= rd_data(DATA_W+1);
+    m_axis_tvalid <= out_valid;
+
+end rtl;
@@ -6,7 +6,9 @@
 --   - Connects multiple CNN layers in sequence
 --   - Configurable routing based on layer execution order
 --   - Bypass paths for skip connections
---   - FIFO buffering between stages
+--   - Registered skid buffer on every link (no combinational tready chain)
+--   - Block-RAM FIFO of FIFO_DEPTH entries in front of each stage, with
+--     occupancy high-water marks (FIFO_DEPTH = 0: skid buffers only)
 -- =============================================================================
 
 library IEEE;
@@ -19,7 +21,7 @@ use work.cnn_pkg.all;
 entity axis_cnn_interconnect is
     generic (
         NUM_LAYERS      : integer := 8;
-        FIFO_DEPTH      : integer := 512
+        FIFO_DEPTH      : integer := 512    -- Power of two, or 0
     );
     port (
         clk             : in  std_logic;
@@ -89,58 +91,209 @@ entity axis_cnn_interconnect is
         m_axis_tvalid   : out std_logic;
         m_axis_tready   : in  std_logic;
         m_axis_tlast    : out std_logic;
-        m_axis_tuser    : out std_logic
+        m_axis_tuser    : out std_logic;
+        
+        -- FIFO statistics (16 bits per stage: conv0, pool0, conv1, pool1)
+        fifo_high_water : out std_logic_vector(63 downto 0);
+        fifo_hwm_clear  : in  std_logic;
+        flush           : in  std_logic
     );
 end axis_cnn_interconnect;
 
 architecture rtl of axis_cnn_interconnect is
 
-    -- Internal FIFO signals
-    type fifo_data_t is array (0 to 3) of std_logic_vector(DATA_WIDTH-1 downto 0);
-    signal fifo_din     : fifo_data_t;
-    signal fifo_dout    : fifo_data_t;
-    signal fifo_wr_en   : std_logic_vector(3 downto 0);
-    signal fifo_rd_en   : std_logic_vector(3 downto 0);
-    signal fifo_full    : std_logic_vector(3 downto 0);
-    signal fifo_empty   : std_logic_vector(3 downto 0);
+    component axis_skid_buffer is
+        generic (
+            DATA_W          : integer := 16
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            flush           : in  std_logic;
+            s_axis_tdata    : in  std_logic_vector(DATA_W-1 downto 0);
+            s_axis_tvalid   : in  std_logic;
+            s_axis_tready   : out std_logic;
+            s_axis_tlast    : in  std_logic;
+            s_axis_tuser    : in  std_logic;
+            m_axis_tdata    : out std_logic_vector(DATA_W-1 downto 0);
+            m_axis_tvalid   : out std_logic;
+            m_axis_tready   : in  std_logic;
+            m_axis_tlast    : out std_logic;
+            m_axis_tuser    : out std_logic
+        );
+    end component;
+
+    component axis_fifo is
+        generic (
+            DATA_W          : integer := 16;
+            DEPTH           : integer := 512
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            flush           : in  std_logic;
+            s_axis_tdata    : in  std_logic_vector(DATA_W-1 downto 0);
+            s_axis_tvalid   : in  std_logic;
+            s_axis_tready   : out std_logic;
+            s_axis_tlast    : in  std_logic;
+            s_axis_tuser    : in  std_logic;
+            m_axis_tdata    : out std_logic_vector(DATA_W-1 downto 0);
+            m_axis_tvalid   : out std_logic;
+            m_axis_tready   : in  std_logic;
+            m_axis_tlast    : out std_logic;
+            m_axis_tuser    : out std_logic;
+            level           : out std_logic_vector(15 downto 0);
+            high_water      : out std_logic_vector(15 downto 0);
+            high_water_clear: in  std_logic
+        );
+    end component;
+
+    -- Per-stage links: 0 = conv0, 1 = pool0, 2 = conv1, 3 = pool1
+    type link_data_t is array (0 to 3) of std_logic_vector(DATA_WIDTH-1 downto 0);
+    
+    -- Producer side of each link
+    signal src_tdata    : link_data_t;
+    signal src_tvalid   : std_logic_vector(3 downto 0);
+    signal src_tready   : std_logic_vector(3 downto 0);
+    signal src_tlast    : std_logic_vector(3 downto 0);
+    signal src_tuser    : std_logic_vector(3 downto 0);
+    
+    -- Between skid buffer and FIFO
+    signal skid_tdata   : link_data_t;
+    signal skid_tvalid  : std_logic_vector(3 downto 0);
+    signal skid_tready  : std_logic_vector(3 downto 0);
+    signal skid_tlast   : std_logic_vector(3 downto 0);
+    signal skid_tuser   : std_logic_vector(3 downto 0);
+    
+    -- Stage input side
+    signal dst_tdata    : link_data_t;
+    signal dst_tvalid   : std_logic_vector(3 downto 0);
+    signal dst_tready   : std_logic_vector(3 downto 0);
+    signal dst_tlast    : std_logic_vector(3 downto 0);
+    signal dst_tuser    : std_logic_vector(3 downto 0);
+    
+    -- Output multiplexer
+    signal mux_tdata    : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal mux_tvalid   : std_logic;
+    signal mux_tready   : std_logic;
+    signal mux_tlast    : std_logic;
+    signal mux_tuser    : std_logic;
 
 begin
 
     -- ==========================================================================
-    -- Input to Conv0 connection (direct or through FIFO)
+    -- Link Sources: the video input, then each stage's output
     -- ==========================================================================
-    conv0_s_tdata <= s_axis_tdata;
-    conv0_s_tvalid <= s_axis_tvalid when cfg_layer_enable(0) = '1' else '0';
-    conv0_s_tlast <= s_axis_tlast;
-    conv0_s_tuser <= s_axis_tuser;
-    s_axis_tready <= conv0_s_tready when cfg_layer_enable(0) = '1' else '1';
+    src_tdata(0) <= s_axis_tdata;
+    src_tvalid(0) <= s_axis_tvalid;
+    src_tlast(0) <= s_axis_tlast;
+    src_tuser(0) <= s_axis_tuser;
+    s_axis_tready <= src_tready(0);
+    
+    src_tdata(1) <= conv0_m_tdata;
+    src_tvalid(1) <= conv0_m_tvalid;
+    src_tlast(1) <= conv0_m_tlast;
+    src_tuser(1) <= conv0_m_tuser;
+    conv0_m_tready <= src_tready(1);
+    
+    src_tdata(2) <= pool0_m_tdata;
+    src_tvalid(2) <= pool0_m_tvalid;
+    src_tlast(2) <= pool0_m_tlast;
+    src_tuser(2) <= pool0_m_tuser;
+    pool0_m_tready <= src_tready(2);
+    
+    src_tdata(3) <= conv1_m_tdata;
+    src_tvalid(3) <= conv1_m_tvalid;
+    src_tlast(3) <= conv1_m_tlast;
+    src_tuser(3) <= conv1_m_tuser;
+    conv1_m_tready <= src_tready(3);
 
     -- ==========================================================================
-    -- Conv0 to Pool0
+    -- Per-Link Skid Buffer and Stage FIFO
     -- ==========================================================================
-    pool0_s_tdata <= conv0_m_tdata;
-    pool0_s_tvalid <= conv0_m_tvalid when cfg_layer_enable(1) = '1' else '0';
-    pool0_s_tlast <= conv0_m_tlast;
-    pool0_s_tuser <= conv0_m_tuser;
-    conv0_m_tready <= pool0_s_tready when cfg_layer_enable(1) = '1' else '1';
+    gen_link: for i in 0 to 3 generate
+        skid_inst : axis_skid_buffer
+            generic map (
+                DATA_W          => DATA_WIDTH
+            )
+            port map (
+                clk             => clk,
+                rst_n           => rst_n,
+                flush           => flush,
+                s_axis_tdata    => src_tdata(i),
+                s_axis_tvalid   => src_tvalid(i),
+                s_axis_tready   => src_tready(i),
+                s_axis_tlast    => src_tlast(i),
+                s_axis_tuser    => src_tuser(i),
+                m_axis_tdata    => skid_tdata(i),
+                m_axis_tvalid   => skid_tvalid(i),
+                m_axis_tready   => skid_tready(i),
+                m_axis_tlast    => skid_tlast(i),
+                m_axis_tuser    => skid_tuser(i)
+            );
+        
+        gen_fifo: if FIFO_DEPTH > 0 generate
+            fifo_inst : axis_fifo
+                generic map (
+                    DATA_W          => DATA_WIDTH,
+                    DEPTH           => FIFO_DEPTH
+                )
+                port map (
+                    clk             => clk,
+                    rst_n           => rst_n,
+                    flush           => flush,
+                    s_axis_tdata    => skid_tdata(i),
+                    s_axis_tvalid   => skid_tvalid(i),
+                    s_axis_tready   => skid_tready(i),
+                    s_axis_tlast    => skid_tlast(i),
+                    s_axis_tuser    => skid_tuser(i),
+                    m_axis_tdata    => dst_tdata(i),
+                    m_axis_tvalid   => dst_tvalid(i),
+                    m_axis_tready   => dst_tready(i),
+                    m_axis_tlast    => dst_tlast(i),
+                    m_axis_tuser    => dst_tuser(i),
+                    level           => open,
+                    high_water      => fifo_high_water(16*i+15 downto 16*i),
+                    high_water_clear=> fifo_hwm_clear
+                );
+        end generate;
+        
+        gen_no_fifo: if FIFO_DEPTH = 0 generate
+            dst_tdata(i) <= skid_tdata(i);
+            dst_tvalid(i) <= skid_tvalid(i);
+            skid_tready(i) <= dst_tready(i);
+            dst_tlast(i) <= skid_tlast(i);
+            dst_tuser(i) <= skid_tuser(i);
+            fifo_high_water(16*i+15 downto 16*i) <= (others => '0');
+        end generate;
+    end generate;
 
     -- ==========================================================================
-    -- Pool0 to Conv1
+    -- Stage Inputs (a disabled stage drains its link)
     -- ==========================================================================
-    conv1_s_tdata <= pool0_m_tdata;
-    conv1_s_tvalid <= pool0_m_tvalid when cfg_layer_enable(2) = '1' else '0';
-    conv1_s_tlast <= pool0_m_tlast;
-    conv1_s_tuser <= pool0_m_tuser;
-    pool0_m_tready <= conv1_s_tready when cfg_layer_enable(2) = '1' else '1';
+    conv0_s_tdata <= dst_tdata(0);
+    conv0_s_tvalid <= dst_tvalid(0) when cfg_layer_enable(0) = '1' else '0';
+    conv0_s_tlast <= dst_tlast(0);
+    conv0_s_tuser <= dst_tuser(0);
+    dst_tready(0) <= conv0_s_tready when cfg_layer_enable(0) = '1' else '1';
 
-    -- ==========================================================================
-    -- Conv1 to Pool1
-    -- ==========================================================================
-    pool1_s_tdata <= conv1_m_tdata;
-    pool1_s_tvalid <= conv1_m_tvalid when cfg_layer_enable(3) = '1' else '0';
-    pool1_s_tlast <= conv1_m_tlast;
-    pool1_s_tuser <= conv1_m_tuser;
-    conv1_m_tready <= pool1_s_tready when cfg_layer_enable(3) = '1' else '1';
+    pool0_s_tdata <= dst_tdata(1);
+    pool0_s_tvalid <= dst_tvalid(1) when cfg_layer_enable(1) = '1' else '0';
+    pool0_s_tlast <= dst_tlast(1);
+    pool0_s_tuser <= dst_tuser(1);
+    dst_tready(1) <= pool0_s_tready when cfg_layer_enable(1) = '1' else '1';
+
+    conv1_s_tdata <= dst_tdata(2);
+    conv1_s_tvalid <= dst_tvalid(2) when cfg_layer_enable(2) = '1' else '0';
+    conv1_s_tlast <= dst_tlast(2);
+    conv1_s_tuser <= dst_tuser(2);
+    dst_tready(2) <= conv1_s_tready when cfg_layer_enable(2) = '1' else '1';
+
+    pool1_s_tdata <= dst_tdata(3);
+    pool1_s_tvalid <= dst_tvalid(3) when cfg_layer_enable(3) = '1' else '0';
+    pool1_s_tlast <= dst_tlast(3);
+    pool1_s_tuser <= dst_tuser(3);
+    dst_tready(3) <= pool1_s_tready when cfg_layer_enable(3) = '1' else '1';
 
     -- ==========================================================================
     -- Output Multiplexer
@@ -152,28 +305,49 @@ begin
     begin
         case cfg_route_sel is
             when "0000" =>  -- After Conv0
-                m_axis_tdata <= conv0_m_tdata;
-                m_axis_tvalid <= conv0_m_tvalid;
-                m_axis_tlast <= conv0_m_tlast;
-                m_axis_tuser <= conv0_m_tuser;
+                mux_tdata <= conv0_m_tdata;
+                mux_tvalid <= conv0_m_tvalid;
+                mux_tlast <= conv0_m_tlast;
+                mux_tuser <= conv0_m_tuser;
             when "0001" =>  -- After Pool0
-                m_axis_tdata <= pool0_m_tdata;
-                m_axis_tvalid <= pool0_m_tvalid;
-                m_axis_tlast <= pool0_m_tlast;
-                m_axis_tuser <= pool0_m_tuser;
+                mux_tdata <= pool0_m_tdata;
+                mux_tvalid <= pool0_m_tvalid;
+                mux_tlast <= pool0_m_tlast;
+                mux_tuser <= pool0_m_tuser;
             when "0010" =>  -- After Conv1
-                m_axis_tdata <= conv1_m_tdata;
-                m_axis_tvalid <= conv1_m_tvalid;
-                m_axis_tlast <= conv1_m_tlast;
-                m_axis_tuser <= conv1_m_tuser;
+                mux_tdata <= conv1_m_tdata;
+                mux_tvalid <= conv1_m_tvalid;
+                mux_tlast <= conv1_m_tlast;
+                mux_tuser <= conv1_m_tuser;
             when others =>  -- After Pool1 (default - full pipeline)
-                m_axis_tdata <= pool1_m_tdata;
-                m_axis_tvalid <= pool1_m_tvalid;
-                m_axis_tlast <= pool1_m_tlast;
-                m_axis_tuser <= pool1_m_tuser;
+                mux_tdata <= pool1_m_tdata;
+                mux_tvalid <= pool1_m_tvalid;
+                mux_tlast <= pool1_m_tlast;
+                mux_tuser <= pool1_m_tuser;
         end case;
     end process;
     
-    pool1_m_tready <= m_axis_tready;
+    pool1_m_tready <= mux_tready;
+
+    -- Output link
+    out_skid_inst : axis_skid_buffer
+        generic map (
+            DATA_W          => DATA_WIDTH
+        )
+        port map (
+            clk             => clk,
+            rst_n           => rst_n,
+            flush           => flush,
+            s_axis_tdata    => mux_tdata,
+            s_axis_tvalid   => mux_tvalid,
+            s_axis_tready   => mux_tready,
+            s_axis_tlast    => mux_tlast,
+            s_axis_tuser    => mux_tuser,
+            m_axis_tdata    => m_axis_tdata,
+            m_axis_tvalid   => m_axis_tvalid,
+            m_axis_tready   => m_axis_tready,
+            m_axis_tlast    => m_axis_tlast,
+            m_axis_tuser    => m_axis_tuser
+        );
 
 end rtl;
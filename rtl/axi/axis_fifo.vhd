@@ -0,0 +1,176 @@
+-- =============================================================================
+-- AXI-Stream FIFO (block RAM)
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - DEPTH entries of tdata + tlast + tuser in block RAM
+--   - tready is a registered occupancy compare, so a stall downstream never
+--     reaches the producer combinationally
+--   - Registered RAM read into the output stage, full throughput
+--   - Occupancy and high-water mark for sizing the FIFO from measured runs
+--
+-- DEPTH must be a power of two.
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+entity axis_fifo is
+    generic (
+        DATA_W          : integer := 16;
+        DEPTH           : integer := 512
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+        flush           : in  std_logic;    -- Empty the FIFO (keeps the mark)
+
+        -- AXI-Stream Input
+        s_axis_tdata    : in  std_logic_vector(DATA_W-1 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;
+        s_axis_tuser    : in  std_logic;
+
+        -- AXI-Stream Output
+        m_axis_tdata    : out std_logic_vector(DATA_W-1 downto 0);
+        m_axis_tvalid   : out std_logic;
+        m_axis_tready   : in  std_logic;
+        m_axis_tlast    : out std_logic;
+        m_axis_tuser    : out std_logic;
+
+        -- Statistics
+        level           : out std_logic_vector(15 downto 0);
+        high_water      : out std_logic_vector(15 downto 0);
+        high_water_clear: in  std_logic
+    );
+end axis_fifo;
+
+architecture rtl of axis_fifo is
+
+    function clog2(n : integer) return integer is
+        variable r : integer := 0;
+    begin
+        while 2**r < n loop
+            r := r + 1;
+        end loop;
+        return r;
+    end function;
+
+    constant ADDR_W     : integer := clog2(DEPTH);
+
+    type mem_t is array (0 to DEPTH-1) of std_logic_vector(DATA_W+1 downto 0);
+    signal mem          : mem_t;
+    attribute ram_style : string;
+    attribute ram_style of mem : signal is "block";
+
+    signal wr_ptr       : unsigned(ADDR_W-1 downto 0);
+    signal rd_ptr       : unsigned(ADDR_W-1 downto 0);
+    signal count        : unsigned(ADDR_W downto 0);   -- Entries in RAM
+    signal in_ready     : std_logic;
+
+    -- Output stage (RAM read register)
+    signal rd_data      : std_logic_vector(DATA_W+1 downto 0);
+    signal out_valid    : std_logic;
+
+    signal wr_en        : std_logic;
+    signal rd_en        : std_logic;
+    signal occupied     : unsigned(ADDR_W+1 downto 0);
+    signal mark         : unsigned(ADDR_W+1 downto 0);
+
+begin
+
+    wr_en <= s_axis_tvalid and in_ready;
+    rd_en <= '1' when count /= 0 and (out_valid = '0' or m_axis_tready = '1') else '0';
+
+    -- ==========================================================================
+    -- Storage
+    -- ==========================================================================
+    process(clk)
+    begin
+        if rising_edge(clk) then
+            if wr_en = '1' then
+                mem(to_integer(wr_ptr)) <= s_axis_tuser & s_axis_tlast & s_axis_tdata;
+            end if;
+            if rd_en = '1' then
+                rd_data <= mem(to_integer(rd_ptr));
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Pointers and Occupancy
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable next_count : unsigned(ADDR_W downto 0);
+    begin
+        if rst_n = '0' then
+            wr_ptr <= (others => '0');
+            rd_ptr <= (others => '0');
+            count <= (others => '0');
+            in_ready <= '1';
+            out_valid <= '0';
+        elsif rising_edge(clk) then
+            if flush = '1' then
+                wr_ptr <= (others => '0');
+                rd_ptr <= (others => '0');
+                count <= (others => '0');
+                in_ready <= '1';
+                out_valid <= '0';
+            else
+                next_count := count;
+                if wr_en = '1' then
+                    wr_ptr <= wr_ptr + 1;
+                    next_count := next_count + 1;
+                end if;
+                if rd_en = '1' then
+                    rd_ptr <= rd_ptr + 1;
+                    next_count := next_count - 1;
+                end if;
+                count <= next_count;
+                if next_count < DEPTH then
+                    in_ready <= '1';
+                else
+                    in_ready <= '0';
+                end if;
+                
+                if rd_en = '1' then
+                    out_valid <= '1';
+                elsif m_axis_tready = '1' then
+                    out_valid <= '0';
+                end if;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- High-Water Mark (RAM plus output stage)
+    -- ==========================================================================
+    occupied <= resize(count, ADDR_W+2) + 1 when out_valid = '1' else
+                resize(count, ADDR_W+2);
+
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            mark <= (others => '0');
+        elsif rising_edge(clk) then
+            if high_water_clear = '1' then
+                mark <= (others => '0');
+            elsif occupied > mark then
+                mark <= occupied;
+            end if;
+        end if;
+    end process;
+
+    s_axis_tready <= in_ready;
+
+    m_axis_tdata <= rd_data(DATA_W-1 downto 0);
+    m_axis_tlast <= rd_data(DATA_W);
+    m_axis_tuser <= rd_data(DATA_W+1);
+    m_axis_tvalid <= out_valid;
+
+    level <= std_logic_vector(resize(occupied, 16));
+    high_water <= std_logic_vector(resize(mark, 16));
+
+end rtl;
@@ -0,0 +1,289 @@
+-- =============================================================================
+-- AXI-Stream Parameter Loader
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Receives the packed parameter blob from the weight DMA (MM2S)
+--   - Decodes section headers (weights, biases, batchnorm, int8 weights,
+--     int8 quantization, sparse weights)
+--   - Drives the per-layer weight/bias/batchnorm/quantization write ports
+--   - Int8 weights are sign-extended onto the weight port
+--   - Sparse weights are expanded from bitmask + nonzeros, writing zeros for
+--     the masked-out taps so the engine weight memory stays dense
+--   - One parameter write per cycle
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+library work;
+use work.cnn_pkg.all;
+
+entity axis_param_loader is
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+
+        -- AXI-Stream Input (from weight DMA)
+        s_axis_tdata    : in  std_logic_vector(31 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;
+
+        -- Weight write port
+        weight_valid    : out std_logic;
+        weight_layer    : out std_logic_vector(3 downto 0);
+        weight_data     : out std_logic_vector(WEIGHT_WIDTH-1 downto 0);
+        weight_addr     : out std_logic_vector(15 downto 0);
+        weight_filter   : out std_logic_vector(7 downto 0);
+
+        -- Bias write port
+        bias_valid      : out std_logic;
+        bias_layer      : out std_logic_vector(3 downto 0);
+        bias_data       : out std_logic_vector(BIAS_WIDTH-1 downto 0);
+        bias_addr       : out std_logic_vector(7 downto 0);
+
+        -- Batchnorm parameter write port
+        bn_valid        : out std_logic;
+        bn_layer        : out std_logic_vector(3 downto 0);
+        bn_channel      : out std_logic_vector(9 downto 0);
+        bn_scale        : out std_logic_vector(DATA_WIDTH-1 downto 0);
+        bn_bias         : out std_logic_vector(DATA_WIDTH-1 downto 0);
+
+        -- Int8 quantization write port (sel '0' = bias, '1' = multiplier/shift)
+        quant_valid     : out std_logic;
+        quant_layer     : out std_logic_vector(3 downto 0);
+        quant_channel   : out std_logic_vector(7 downto 0);
+        quant_sel       : out std_logic;
+        quant_data      : out std_logic_vector(31 downto 0);
+
+        -- Status
+        busy            : out std_logic;
+        sections_loaded : out std_logic_vector(15 downto 0)
+    );
+end axis_param_loader;
+
+architecture rtl of axis_param_loader is
+
+    -- FSM states
+    type state_t is (HEADER, PAYLOAD_LO, PAYLOAD_HI, PAYLOAD_BYTE, SPARSE_MASK, SPARSE_VALUE);
+    signal state        : state_t;
+
+    -- Current section
+    signal sec_type     : std_logic_vector(3 downto 0);
+    signal sec_layer    : std_logic_vector(3 downto 0);
+    signal sec_index    : unsigned(7 downto 0);
+    signal sec_remain   : unsigned(15 downto 0);
+    signal val_idx      : unsigned(15 downto 0);
+
+    -- Payload word held for the high half / upper bytes
+    signal word_hi      : std_logic_vector(15 downto 0);
+    signal word_bytes   : std_logic_vector(31 downto 0);
+    signal byte_lane    : unsigned(1 downto 0);
+
+    -- Sparse group: mask bits left in the group, pending high half of a
+    -- nonzero word
+    signal sp_mask      : std_logic_vector(31 downto 0);
+    signal sp_bits      : unsigned(5 downto 0);
+    signal sp_have_hi   : std_logic;
+
+    -- Registered write strobes
+    signal wr_valid     : std_logic;
+    signal wr_data      : std_logic_vector(15 downto 0);
+    signal wr_data_hi   : std_logic_vector(15 downto 0);
+    signal wr_idx       : unsigned(15 downto 0);
+    signal wr_type      : std_logic_vector(3 downto 0);
+
+    signal section_cnt  : unsigned(15 downto 0);
+    signal input_accept : std_logic;
+
+begin
+
+    -- ==========================================================================
+    -- Section Decoder
+    -- ==========================================================================
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            state <= HEADER;
+            sec_type <= (others => '0');
+            sec_layer <= (others => '0');
+            sec_index <= (others => '0');
+            sec_remain <= (others => '0');
+            val_idx <= (others => '0');
+            word_hi <= (others => '0');
+            word_bytes <= (others => '0');
+            byte_lane <= (others => '0');
+            sp_mask <= (others => '0');
+            sp_bits <= (others => '0');
+            sp_have_hi <= '0';
+            wr_valid <= '0';
+            wr_data <= (others => '0');
+            wr_data_hi <= (others => '0');
+            wr_idx <= (others => '0');
+            wr_type <= (others => '0');
+            section_cnt <= (others => '0');
+        elsif rising_edge(clk) then
+            wr_valid <= '0';
+
+            case state is
+                when HEADER =>
+                    if s_axis_tvalid = '1' then
+                        sec_type <= s_axis_tdata(31 downto 28);
+                        sec_layer <= s_axis_tdata(27 downto 24);
+                        sec_index <= unsigned(s_axis_tdata(23 downto 16));
+                        sec_remain <= unsigned(s_axis_tdata(15 downto 0));
+                        val_idx <= (others => '0');
+                        section_cnt <= section_cnt + 1;
+                        if unsigned(s_axis_tdata(15 downto 0)) /= 0 then
+                            if s_axis_tdata(31 downto 28) = PARAM_SEC_SPARSE then
+                                state <= SPARSE_MASK;
+                            else
+                                state <= PAYLOAD_LO;
+                            end if;
+                        end if;
+                    end if;
+
+                when PAYLOAD_LO =>
+                    if s_axis_tvalid = '1' then
+                        wr_valid <= '1';
+                        wr_type <= sec_type;
+                        wr_data <= s_axis_tdata(15 downto 0);
+                        wr_data_hi <= s_axis_tdata(31 downto 16);
+                        wr_idx <= val_idx;
+                        word_hi <= s_axis_tdata(31 downto 16);
+                        val_idx <= val_idx + 1;
+                        sec_remain <= sec_remain - 1;
+
+                        if sec_type = PARAM_SEC_WEIGHTS8 then
+                            -- Four int8 values per word, low byte first
+                            wr_data <= std_logic_vector(resize(signed(s_axis_tdata(7 downto 0)), 16));
+                            word_bytes <= s_axis_tdata;
+                            byte_lane <= "01";
+                        end if;
+
+                        if sec_remain = 1 then
+                            state <= HEADER;
+                        elsif sec_type = PARAM_SEC_WEIGHTS8 then
+                            state <= PAYLOAD_BYTE;
+                        elsif sec_type /= PARAM_SEC_BN and sec_type /= PARAM_SEC_QUANT then
+                            -- Two 16-bit values per word
+                            state <= PAYLOAD_HI;
+                        end if;
+                    end if;
+
+                when PAYLOAD_HI =>
+                    wr_valid <= '1';
+                    wr_type <= sec_type;
+                    wr_data <= word_hi;
+                    wr_idx <= val_idx;
+                    val_idx <= val_idx + 1;
+                    sec_remain <= sec_remain - 1;
+
+                    if sec_remain = 1 then
+                        state <= HEADER;
+                    else
+                        state <= PAYLOAD_LO;
+                    end if;
+
+                when PAYLOAD_BYTE =>
+                    wr_valid <= '1';
+                    wr_type <= sec_type;
+                    wr_data <= std_logic_vector(resize(signed(
+                        word_bytes(8*to_integer(byte_lane)+7 downto 8*to_integer(byte_lane))), 16));
+                    wr_idx <= val_idx;
+                    val_idx <= val_idx + 1;
+                    sec_remain <= sec_remain - 1;
+                    byte_lane <= byte_lane + 1;
+
+                    if sec_remain = 1 then
+                        state <= HEADER;
+                    elsif byte_lane = 3 then
+                        state <= PAYLOAD_LO;
+                    end if;
+
+                when SPARSE_MASK =>
+                    -- Group of up to 32 taps; a leftover padding half is dropped
+                    if s_axis_tvalid = '1' then
+                        sp_mask <= s_axis_tdata;
+                        sp_have_hi <= '0';
+                        if sec_remain > 32 then
+                            sp_bits <= to_unsigned(32, 6);
+                        else
+                            sp_bits <= resize(sec_remain, 6);
+                        end if;
+                        state <= SPARSE_VALUE;
+                    end if;
+
+                when SPARSE_VALUE =>
+                    -- Zero taps cost no payload; nonzeros come two per word
+                    if sp_mask(0) = '0' or sp_have_hi = '1' or s_axis_tvalid = '1' then
+                        wr_valid <= '1';
+                        wr_type <= sec_type;
+                        wr_idx <= val_idx;
+                        if sp_mask(0) = '0' then
+                            wr_data <= (others => '0');
+                        elsif sp_have_hi = '1' then
+                            wr_data <= word_hi;
+                            sp_have_hi <= '0';
+                        else
+                            wr_data <= s_axis_tdata(15 downto 0);
+                            word_hi <= s_axis_tdata(31 downto 16);
+                            sp_have_hi <= '1';
+                        end if;
+                        sp_mask <= '0' & sp_mask(31 downto 1);
+                        sp_bits <= sp_bits - 1;
+                        val_idx <= val_idx + 1;
+                        sec_remain <= sec_remain - 1;
+
+                        if sec_remain = 1 then
+                            state <= HEADER;
+                        elsif sp_bits = 1 then
+                            state <= SPARSE_MASK;
+                        end if;
+                    end if;
+
+                when others =>
+                    state <= HEADER;
+            end case;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Output Assignment
+    -- ==========================================================================
+    input_accept <= '0' when state = PAYLOAD_HI or state = PAYLOAD_BYTE else
+                    (sp_mask(0) and not sp_have_hi) when state = SPARSE_VALUE else '1';
+    s_axis_tready <= input_accept;
+
+    weight_valid <= wr_valid when wr_type = PARAM_SEC_WEIGHTS or wr_type = PARAM_SEC_WEIGHTS8 or
+                                  wr_type = PARAM_SEC_SPARSE else '0';
+    weight_layer <= sec_layer;
+    weight_data <= wr_data;
+    weight_addr <= std_logic_vector(wr_idx);
+    weight_filter <= std_logic_vector(sec_index);
+
+    -- Biases and batchnorm start at the channel given in the header
+    bias_valid <= wr_valid when wr_type = PARAM_SEC_BIASES else '0';
+    bias_layer <= sec_layer;
+    bias_data <= wr_data;
+    bias_addr <= std_logic_vector(sec_index + wr_idx(7 downto 0));
+
+    bn_valid <= wr_valid when wr_type = PARAM_SEC_BN else '0';
+    bn_layer <= sec_layer;
+    bn_channel <= std_logic_vector(resize(sec_index, 10) + wr_idx(9 downto 0));
+    bn_scale <= wr_data;
+    bn_bias <= wr_data_hi;
+
+    -- Quantization words alternate bias / multiplier per channel
+    quant_valid <= wr_valid when wr_type = PARAM_SEC_QUANT else '0';
+    quant_layer <= sec_layer;
+    quant_channel <= std_logic_vector(sec_index + wr_idx(8 downto 1));
+    quant_sel <= wr_idx(0);
+    quant_data <= wr_data_hi & wr_data;
+
+    busy <= '0' when state = HEADER else '1';
+    sections_loaded <= std_logic_vector(section_cnt);
+
+end rtl;
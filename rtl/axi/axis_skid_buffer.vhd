@@ -0,0 +1,99 @@
+-- =============================================================================
+-- AXI-Stream Skid Buffer
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Registered tvalid / tdata and registered tready: breaks both the
+--     forward and the backward combinational path of a link
+--   - Full throughput; a second register catches the beat accepted in the
+--     cycle the downstream stalls
+--   - tlast / tuser carried alongside the data
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+entity axis_skid_buffer is
+    generic (
+        DATA_W          : integer := 16
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+        flush           : in  std_logic;    -- Drop both buffered beats
+
+        -- AXI-Stream Input
+        s_axis_tdata    : in  std_logic_vector(DATA_W-1 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;
+        s_axis_tuser    : in  std_logic;
+
+        -- AXI-Stream Output
+        m_axis_tdata    : out std_logic_vector(DATA_W-1 downto 0);
+        m_axis_tvalid   : out std_logic;
+        m_axis_tready   : in  std_logic;
+        m_axis_tlast    : out std_logic;
+        m_axis_tuser    : out std_logic
+    );
+end axis_skid_buffer;
+
+architecture rtl of axis_skid_buffer is
+
+    -- Output register
+    signal out_valid    : std_logic;
+    signal out_data     : std_logic_vector(DATA_W+1 downto 0);
+
+    -- Skid register (holds the beat that arrived while the output stalled)
+    signal skid_valid   : std_logic;
+    signal skid_data    : std_logic_vector(DATA_W+1 downto 0);
+
+    signal in_ready     : std_logic;
+    signal in_word      : std_logic_vector(DATA_W+1 downto 0);
+
+begin
+
+    in_word <= s_axis_tuser & s_axis_tlast & s_axis_tdata;
+
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            out_valid <= '0';
+            out_data <= (others => '0');
+            skid_valid <= '0';
+            skid_data <= (others => '0');
+            in_ready <= '1';
+        elsif rising_edge(clk) then
+            if flush = '1' then
+                out_valid <= '0';
+                skid_valid <= '0';
+                in_ready <= '1';
+            elsif out_valid = '0' or m_axis_tready = '1' then
+                -- Output register free: refill from the skid first
+                if skid_valid = '1' then
+                    out_valid <= '1';
+                    out_data <= skid_data;
+                    skid_valid <= '0';
+                else
+                    out_valid <= s_axis_tvalid and in_ready;
+                    out_data <= in_word;
+                end if;
+                in_ready <= '1';
+            elsif s_axis_tvalid = '1' and in_ready = '1' then
+                -- Output stalled: park the accepted beat
+                skid_valid <= '1';
+                skid_data <= in_word;
+                in_ready <= '0';
+            end if;
+        end if;
+    end process;
+
+    s_axis_tready <= in_ready;
+
+    m_axis_tdata <= out_data(DATA_W-1 downto 0);
+    m_axis_tlast <= out_data(DATA_W);
+    m_axis_tuser <= out_data(DATA_W+1);
+    m_axis_tvalid <= out_valid;
+
+end rtl;
@@ -4,9 +4,14 @@
 -- 
 -- Features:
 --   - Receives video frames from camera/DMA via AXI-Stream
---   - RGB to fixed-point conversion
+--   - RGB to fixed-point conversion with per-channel mean / scale
+--     (out = (pixel - mean) * scale, one DSP multiply per channel)
 --   - Frame synchronization with SOF/EOL signals
 --   - Configurable input resolution
+--   - Optional crop ROI and bilinear downscale from the sensor resolution
+--     (video_scaler) ahead of the normalization
+--   - Optional YUV 4:2:2 input (Y[7:0], chroma[15:8]) converted to RGB888
+--     by video_yuv2rgb ahead of the scaler
 -- =============================================================================
 
 library IEEE;
@@ -29,9 +34,27 @@ entity axis_video_input is
         
         -- Configuration
         cfg_enable      : in  std_logic;
-        cfg_normalize   : in  std_logic;    -- Normalize to [-1, 1] or [0, 1]
+        cfg_norm_r      : in  std_logic_vector(31 downto 0);  -- [15:0] mean Q8.8, [31:16] scale Q1.15
+        cfg_norm_g      : in  std_logic_vector(31 downto 0);
+        cfg_norm_b      : in  std_logic_vector(31 downto 0);
         
-        -- AXI-Stream Video Input (RGB)
+        -- Color conversion (YUV 4:2:2 input)
+        cfg_yuv_enable  : in  std_logic;
+        cfg_yuv_bt709   : in  std_logic;
+        cfg_yuv_full    : in  std_logic;
+        
+        -- Crop / scale (source -> INPUT_WIDTH x INPUT_HEIGHT)
+        cfg_scale_enable: in  std_logic;
+        cfg_crop_x      : in  std_logic_vector(11 downto 0);
+        cfg_crop_y      : in  std_logic_vector(11 downto 0);
+        cfg_crop_width  : in  std_logic_vector(11 downto 0);
+        cfg_crop_height : in  std_logic_vector(11 downto 0);
+        cfg_out_width   : in  std_logic_vector(11 downto 0);
+        cfg_out_height  : in  std_logic_vector(11 downto 0);
+        cfg_step_x      : in  std_logic_vector(31 downto 0);
+        cfg_step_y      : in  std_logic_vector(31 downto 0);
+        
+        -- AXI-Stream Video Input (RGB888, or YUV 4:2:2 in the low 16 bits)
         s_axis_tdata    : in  std_logic_vector(PIXEL_WIDTH-1 downto 0);
         s_axis_tvalid   : in  std_logic;
         s_axis_tready   : out std_logic;
@@ -55,9 +78,56 @@ end axis_video_input;
 
 architecture rtl of axis_video_input is
 
+    -- (pixel * 256 - mean) * scale / 2^15, saturated to Q8.8
+    function norm_scale(diff : signed; scale : unsigned) return pixel_t is
+        variable product : signed(diff'length + scale'length downto 0);
+        variable shifted : signed(diff'length + scale'length downto 0);
+        constant MAX_PIX : pixel_t := (DATA_WIDTH-1 => '0', others => '1');
+        constant MIN_PIX : pixel_t := (DATA_WIDTH-1 => '1', others => '0');
+    begin
+        product := diff * signed('0' & scale);
+        shifted := shift_right(product, 15);
+        if shifted > resize(MAX_PIX, shifted'length) then
+            return MAX_PIX;
+        elsif shifted < resize(MIN_PIX, shifted'length) then
+            return MIN_PIX;
+        end if;
+        return shifted(DATA_WIDTH-1 downto 0);
+    end function;
+
+    -- Color converter output / bypass
+    signal yuv_tdata    : std_logic_vector(23 downto 0);
+    signal yuv_tvalid   : std_logic;
+    signal yuv_tlast    : std_logic;
+    signal yuv_tuser    : std_logic;
+    signal yuv_in_valid : std_logic;
+    signal yuv_in_ready : std_logic;
+    signal rgb_tdata    : std_logic_vector(23 downto 0);
+    signal rgb_tvalid   : std_logic;
+    signal rgb_tready   : std_logic;
+    signal rgb_tlast    : std_logic;
+    signal rgb_tuser    : std_logic;
+    
+    -- Scaler output / bypass
+    signal scl_tdata    : std_logic_vector(23 downto 0);
+    signal scl_tvalid   : std_logic;
+    signal scl_tready   : std_logic;
+    signal scl_tlast    : std_logic;
+    signal scl_tuser    : std_logic;
+    signal scl_in_valid : std_logic;
+    signal scl_in_ready : std_logic;
+    signal px_tdata     : std_logic_vector(23 downto 0);
+    signal px_tvalid    : std_logic;
+    signal px_tlast     : std_logic;
+    signal px_tuser     : std_logic;
+    
     -- RGB extraction
     signal r_in, g_in, b_in : unsigned(7 downto 0);
     
+    -- Mean-subtracted values (Q8.8 pixel units) and their scales
+    signal r_diff, g_diff, b_diff : signed(DATA_WIDTH downto 0);
+    signal r_scale, g_scale, b_scale : unsigned(15 downto 0);
+    
     -- Normalized values (Q8.8 format)
     signal r_norm, g_norm, b_norm : pixel_t;
     
@@ -71,55 +141,122 @@ architecture rtl of axis_video_input is
     signal pixel_cnt    : unsigned(31 downto 0);
     
     -- Internal control
+    signal pipe_en      : std_logic;
     signal input_accept : std_logic;
+    signal s_axis_accept: std_logic;
 
 begin
 
+    -- ==========================================================================
+    -- YUV 4:2:2 to RGB888 (bypassed when cfg_yuv_enable = '0')
+    -- ==========================================================================
+    yuv2rgb_inst : entity work.video_yuv2rgb
+        port map (
+            clk             => clk,
+            rst_n           => rst_n,
+            cfg_bt709       => cfg_yuv_bt709,
+            cfg_full_range  => cfg_yuv_full,
+            s_axis_tdata    => s_axis_tdata(15 downto 0),
+            s_axis_tvalid   => yuv_in_valid,
+            s_axis_tready   => yuv_in_ready,
+            s_axis_tlast    => s_axis_tlast,
+            s_axis_tuser    => s_axis_tuser,
+            m_axis_tdata    => yuv_tdata,
+            m_axis_tvalid   => yuv_tvalid,
+            m_axis_tready   => rgb_tready,
+            m_axis_tlast    => yuv_tlast,
+            m_axis_tuser    => yuv_tuser
+        );
+    
+    yuv_in_valid <= s_axis_tvalid and cfg_yuv_enable;
+    
+    rgb_tdata <= yuv_tdata when cfg_yuv_enable = '1' else s_axis_tdata(23 downto 0);
+    rgb_tvalid <= yuv_tvalid when cfg_yuv_enable = '1' else s_axis_tvalid;
+    rgb_tlast <= yuv_tlast when cfg_yuv_enable = '1' else s_axis_tlast;
+    rgb_tuser <= yuv_tuser when cfg_yuv_enable = '1' else s_axis_tuser;
+
+    -- ==========================================================================
+    -- Crop and Downscale (bypassed when cfg_scale_enable = '0')
+    -- ==========================================================================
+    scaler_inst : entity work.video_scaler
+        generic map (
+            MAX_OUT_WIDTH => INPUT_WIDTH
+        )
+        port map (
+            clk             => clk,
+            rst_n           => rst_n,
+            cfg_crop_x      => cfg_crop_x,
+            cfg_crop_y      => cfg_crop_y,
+            cfg_crop_width  => cfg_crop_width,
+            cfg_crop_height => cfg_crop_height,
+            cfg_out_width   => cfg_out_width,
+            cfg_out_height  => cfg_out_height,
+            cfg_step_x      => cfg_step_x,
+            cfg_step_y      => cfg_step_y,
+            s_axis_tdata    => rgb_tdata,
+            s_axis_tvalid   => scl_in_valid,
+            s_axis_tready   => scl_in_ready,
+            s_axis_tlast    => rgb_tlast,
+            s_axis_tuser    => rgb_tuser,
+            m_axis_tdata    => scl_tdata,
+            m_axis_tvalid   => scl_tvalid,
+            m_axis_tready   => scl_tready,
+            m_axis_tlast    => scl_tlast,
+            m_axis_tuser    => scl_tuser
+        );
+    
+    scl_in_valid <= rgb_tvalid and cfg_scale_enable;
+    scl_tready <= input_accept and cfg_scale_enable;
+    
+    px_tdata <= scl_tdata when cfg_scale_enable = '1' else rgb_tdata;
+    px_tvalid <= scl_tvalid when cfg_scale_enable = '1' else rgb_tvalid;
+    px_tlast <= scl_tlast when cfg_scale_enable = '1' else rgb_tlast;
+    px_tuser <= scl_tuser when cfg_scale_enable = '1' else rgb_tuser;
+
     -- ==========================================================================
     -- RGB Extraction (assuming RGB888 format: R[23:16], G[15:8], B[7:0])
     -- ==========================================================================
-    r_in <= unsigned(s_axis_tdata(23 downto 16));
-    g_in <= unsigned(s_axis_tdata(15 downto 8));
-    b_in <= unsigned(s_axis_tdata(7 downto 0));
+    r_in <= unsigned(px_tdata(23 downto 16));
+    g_in <= unsigned(px_tdata(15 downto 8));
+    b_in <= unsigned(px_tdata(7 downto 0));
 
     -- ==========================================================================
     -- Normalization Pipeline
-    -- Convert 8-bit [0, 255] to Q8.8 format
-    -- If cfg_normalize = '0': [0, 255] -> [0, 1] in Q8.8 (value stays same, just interpreted)
-    -- If cfg_normalize = '1': [0, 255] -> [-1, 1] in Q8.8 (subtract 128, then scale)
+    -- Stage 1: subtract the channel mean (Q8.8, in 0..255 pixel units)
+    -- Stage 2: multiply by the channel scale (Q1.15, 1 / (255 * std)) and
+    --          saturate to Q8.8
+    -- Reset values reproduce the fixed [-1, 1] mapping (mean 128, scale 1/128)
     -- ==========================================================================
     process(clk, rst_n)
-        variable r_ext, g_ext, b_ext : signed(DATA_WIDTH-1 downto 0);
     begin
         if rst_n = '0' then
+            r_diff <= (others => '0');
+            g_diff <= (others => '0');
+            b_diff <= (others => '0');
+            r_scale <= (others => '0');
+            g_scale <= (others => '0');
+            b_scale <= (others => '0');
             r_norm <= (others => '0');
             g_norm <= (others => '0');
             b_norm <= (others => '0');
         elsif rising_edge(clk) then
-            if s_axis_tvalid = '1' and input_accept = '1' then
-                if cfg_normalize = '1' then
-                    -- Map [0, 255] to [-1, 1] in Q8.8
-                    -- Formula: (pixel - 128) * 2 = (pixel - 128) << 1
-                    -- In Q8.8: -1 = -256, 1 = 256
-                    r_ext := resize(signed('0' & r_in), DATA_WIDTH) - 128;
-                    g_ext := resize(signed('0' & g_in), DATA_WIDTH) - 128;
-                    b_ext := resize(signed('0' & b_in), DATA_WIDTH) - 128;
-                    r_norm <= shift_left(r_ext, 1);
-                    g_norm <= shift_left(g_ext, 1);
-                    b_norm <= shift_left(b_ext, 1);
-                else
-                    -- Map [0, 255] to [0, 1] in Q8.8
-                    -- In Q8.8: 1.0 = 256, so pixel value maps to pixel
-                    r_norm <= resize(signed('0' & r_in), DATA_WIDTH);
-                    g_norm <= resize(signed('0' & g_in), DATA_WIDTH);
-                    b_norm <= resize(signed('0' & b_in), DATA_WIDTH);
-                end if;
+            if pipe_en = '1' then
+                r_diff <= signed("0" & r_in & x"00") - signed('0' & cfg_norm_r(15 downto 0));
+                g_diff <= signed("0" & g_in & x"00") - signed('0' & cfg_norm_g(15 downto 0));
+                b_diff <= signed("0" & b_in & x"00") - signed('0' & cfg_norm_b(15 downto 0));
+                r_scale <= unsigned(cfg_norm_r(31 downto 16));
+                g_scale <= unsigned(cfg_norm_g(31 downto 16));
+                b_scale <= unsigned(cfg_norm_b(31 downto 16));
+                
+                r_norm <= norm_scale(r_diff, r_scale);
+                g_norm <= norm_scale(g_diff, g_scale);
+                b_norm <= norm_scale(b_diff, b_scale);
             end if;
         end if;
     end process;
 
     -- ==========================================================================
-    -- Pipeline Control
+    -- Pipeline Control (stalls as a whole on output backpressure)
     -- ==========================================================================
     process(clk, rst_n)
     begin
@@ -128,14 +265,16 @@ begin
             last_d <= (others => '0');
             user_d <= (others => '0');
         elsif rising_edge(clk) then
-            valid_d(0) <= s_axis_tvalid and input_accept and cfg_enable;
-            valid_d(1) <= valid_d(0);
-            
-            last_d(0) <= s_axis_tlast;
-            last_d(1) <= last_d(0);
-            
-            user_d(0) <= s_axis_tuser;
-            user_d(1) <= user_d(0);
+            if pipe_en = '1' then
+                valid_d(0) <= px_tvalid and input_accept;
+                valid_d(1) <= valid_d(0);
+                
+                last_d(0) <= px_tlast;
+                last_d(1) <= last_d(0);
+                
+                user_d(0) <= px_tuser;
+                user_d(1) <= user_d(0);
+            end if;
         end if;
     end process;
 
@@ -148,7 +287,7 @@ begin
             frame_cnt <= (others => '0');
             pixel_cnt <= (others => '0');
         elsif rising_edge(clk) then
-            if s_axis_tvalid = '1' and input_accept = '1' then
+            if s_axis_tvalid = '1' and s_axis_accept = '1' then
                 if s_axis_tuser = '1' then
                     -- Start of new frame
                     frame_cnt <= frame_cnt + 1;
@@ -163,8 +302,11 @@ begin
     -- ==========================================================================
     -- Output Assignment
     -- ==========================================================================
-    input_accept <= cfg_enable and (m_axis_tready or not valid_d(1));
-    s_axis_tready <= input_accept;
+    pipe_en <= m_axis_tready or not valid_d(1);
+    input_accept <= cfg_enable and pipe_en;
+    rgb_tready <= scl_in_ready when cfg_scale_enable = '1' else input_accept;
+    s_axis_accept <= yuv_in_ready when cfg_yuv_enable = '1' else rgb_tready;
+    s_axis_tready <= s_axis_accept;
     
     m_axis_r_tdata <= std_logic_vector(r_norm);
     m_axis_g_tdata <= std_logic_vector(g_norm);
@@ -0,0 +1,59 @@
+-- =============================================================================
+-- Pulse Synchronizer
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - A one-cycle pulse in the source clock becomes a one-cycle pulse in
+--     the destination clock (toggle, two-flop synchronizer, edge detect)
+--   - Either clock may be the faster one
+--
+-- Pulses less than about three destination cycles apart can merge.
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+
+entity cdc_pulse is
+    port (
+        src_clk         : in  std_logic;
+        src_rst_n       : in  std_logic;
+        src_pulse       : in  std_logic;
+
+        dst_clk         : in  std_logic;
+        dst_rst_n       : in  std_logic;
+        dst_pulse       : out std_logic
+    );
+end cdc_pulse;
+
+architecture rtl of cdc_pulse is
+
+    signal src_toggle   : std_logic;
+    signal dst_sync     : std_logic_vector(2 downto 0);
+    attribute ASYNC_REG : string;
+    attribute ASYNC_REG of dst_sync : signal is "TRUE";
+
+begin
+
+    process(src_clk, src_rst_n)
+    begin
+        if src_rst_n = '0' then
+            src_toggle <= '0';
+        elsif rising_edge(src_clk) then
+            if src_pulse = '1' then
+                src_toggle <= not src_toggle;
+            end if;
+        end if;
+    end process;
+
+    process(dst_clk, dst_rst_n)
+    begin
+        if dst_rst_n = '0' then
+            dst_sync <= (others => '0');
+        elsif rising_edge(dst_clk) then
+            dst_sync <= dst_sync(1 downto 0) & src_toggle;
+        end if;
+    end process;
+
+    dst_pulse <= dst_sync(2) xor dst_sync(1);
+
+end rtl;
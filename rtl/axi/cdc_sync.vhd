@@ -0,0 +1,51 @@
+-- =============================================================================
+-- Level Synchronizer
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - STAGES flip-flops per bit into the destination clock (ASYNC_REG)
+--   - For levels and slowly changing flags; the bits of a vector are
+--     synchronized independently, so a multi-bit value must be Gray coded
+--     or held stable while it is sampled
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+
+entity cdc_sync is
+    generic (
+        WIDTH           : integer := 1;
+        STAGES          : integer := 2
+    );
+    port (
+        clk             : in  std_logic;    -- Destination clock
+        rst_n           : in  std_logic;
+        d               : in  std_logic_vector(WIDTH-1 downto 0);
+        q               : out std_logic_vector(WIDTH-1 downto 0)
+    );
+end cdc_sync;
+
+architecture rtl of cdc_sync is
+
+    type sync_t is array (0 to STAGES-1) of std_logic_vector(WIDTH-1 downto 0);
+    signal sync_reg     : sync_t;
+    attribute ASYNC_REG : string;
+    attribute ASYNC_REG of sync_reg : signal is "TRUE";
+
+begin
+
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            sync_reg <= (others => (others => '0'));
+        elsif rising_edge(clk) then
+            sync_reg(0) <= d;
+            for i in 1 to STAGES-1 loop
+                sync_reg(i) <= sync_reg(i-1);
+            end loop;
+        end if;
+    end process;
+
+    q <= sync_reg(STAGES-1);
+
+end rtl;
@@ -6,9 +6,15 @@
 --   - ReLU: max(0, x)
 --   - ReLU6: min(max(0, x), 6)
 --   - Leaky ReLU: x if x > 0, else alpha * x
---   - Sigmoid: 1 / (1 + exp(-x)) - LUT based
---   - Tanh: (exp(x) - exp(-x)) / (exp(x) + exp(-x)) - LUT based
+--   - Sigmoid: 1 / (1 + exp(-x)) - piecewise-linear table
+--   - Tanh: (exp(x) - exp(-x)) / (exp(x) + exp(-x)) - piecewise-linear table
 --   - Swish: x * sigmoid(x)
+--   - Extension table (GELU or hard-swish, selected by EXT_FUNC)
+--
+-- Fixed latency of ACT_LATENCY cycles for every function:
+--   Stages 1-2: Table read and interpolation (pwl_function)
+--   Stage 3:    Swish multiply
+--   Stage 4:    Output mux
 -- =============================================================================
 
 library IEEE;
@@ -20,9 +26,8 @@ use work.cnn_pkg.all;
 
 entity activation_unit is
     generic (
-        USE_LUT_SIGMOID : boolean := true;
-        USE_LUT_TANH    : boolean := true;
-        LUT_DEPTH       : integer := 256
+        LUT_BITS        : integer := 8;           -- Segments per table (log2)
+        EXT_FUNC        : pwl_func_t := PWL_GELU  -- Function behind ACT_EXT
     );
     port (
         clk             : in  std_logic;
@@ -43,80 +48,28 @@ end activation_unit;
 
 architecture rtl of activation_unit is
 
-    -- LUT for sigmoid (precomputed values)
-    type sigmoid_lut_t is array (0 to LUT_DEPTH-1) of pixel_t;
-    
-    -- Sigmoid LUT initialization function
-    -- Values are in Q8.8 format, input range [-8, 8] mapped to [0, 255]
-    function init_sigmoid_lut return sigmoid_lut_t is
-        variable lut : sigmoid_lut_t;
-        variable x : real;
-        variable y : real;
-        variable idx : integer;
-    begin
-        for i in 0 to LUT_DEPTH-1 loop
-            -- Map index to input range [-8, 8]
-            x := (real(i) / real(LUT_DEPTH-1)) * 16.0 - 8.0;
-            -- Sigmoid: 1 / (1 + exp(-x))
-            y := 1.0 / (1.0 + exp(-x));
-            -- Convert to Q8.8 (multiply by 256)
-            idx := integer(y * 256.0);
-            if idx > 32767 then idx := 32767; end if;
-            if idx < -32768 then idx := -32768; end if;
-            lut(i) := to_signed(idx, DATA_WIDTH);
-        end loop;
-        return lut;
-    end function;
-    
-    -- Tanh LUT initialization
-    function init_tanh_lut return sigmoid_lut_t is
-        variable lut : sigmoid_lut_t;
-        variable x : real;
-        variable y : real;
-        variable idx : integer;
-    begin
-        for i in 0 to LUT_DEPTH-1 loop
-            -- Map index to input range [-4, 4]
-            x := (real(i) / real(LUT_DEPTH-1)) * 8.0 - 4.0;
-            -- Tanh
-            if x > 20.0 then
-                y := 1.0;
-            elsif x < -20.0 then
-                y := -1.0;
-            else
-                y := (exp(x) - exp(-x)) / (exp(x) + exp(-x));
-            end if;
-            -- Convert to Q8.8
-            idx := integer(y * 256.0);
-            if idx > 32767 then idx := 32767; end if;
-            if idx < -32768 then idx := -32768; end if;
-            lut(i) := to_signed(idx, DATA_WIDTH);
-        end loop;
-        return lut;
-    end function;
-    
-    -- LUT signals
-    signal sigmoid_lut  : sigmoid_lut_t := init_sigmoid_lut;
-    signal tanh_lut     : sigmoid_lut_t := init_tanh_lut;
-    
-    -- Input as signed
+    -- Input as signed, and its pipeline copies
     signal input_pixel  : pixel_t;
-    
+    signal input_pipe   : feature_slice_t(0 to PWL_LATENCY-1);
+    signal input_d      : pixel_t;
+
     -- Intermediate results
     signal relu_out     : pixel_t;
     signal relu6_out    : pixel_t;
     signal leaky_out    : pixel_t;
-    signal sigmoid_out  : pixel_t;
-    signal tanh_out     : pixel_t;
+    signal sigmoid_out  : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal sigmoid_d    : pixel_t;
+    signal tanh_out     : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal tanh_d       : pixel_t;
+    signal ext_out      : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal ext_d        : pixel_t;
     signal swish_out    : pixel_t;
-    
-    -- LUT address calculation
-    signal lut_addr_sig : unsigned(7 downto 0);
-    signal lut_addr_tanh: unsigned(7 downto 0);
-    
+
     -- Pipeline
     signal result_mux   : pixel_t;
-    signal valid_pipe   : std_logic_vector(2 downto 0);
+    signal valid_pipe   : std_logic_vector(ACT_LATENCY-1 downto 0);
+    type act_sel_pipe_t is array (0 to ACT_LATENCY-2) of std_logic_vector(2 downto 0);
+    signal act_sel_pipe : act_sel_pipe_t;
     signal act_sel_d    : std_logic_vector(2 downto 0);
 
 begin
@@ -124,94 +77,94 @@ begin
     input_pixel <= signed(data_in);
 
     -- ==========================================================================
-    -- ReLU: max(0, x)
-    -- ==========================================================================
-    relu_out <= (others => '0') when input_pixel(DATA_WIDTH-1) = '1' else input_pixel;
-
-    -- ==========================================================================
-    -- ReLU6: min(max(0, x), 6)
-    -- ==========================================================================
-    process(input_pixel)
+    -- Piecewise-Linear Tables (sigmoid over [-8, 8), tanh/extension over [-4, 4))
+    -- ==========================================================================
+    sigmoid_inst : entity work.pwl_function
+        generic map (
+            FUNC        => PWL_SIGMOID,
+            RANGE_LOG2  => 3,
+            LUT_BITS    => LUT_BITS
+        )
+        port map (
+            clk         => clk,
+            data_in     => data_in,
+            data_out    => sigmoid_out
+        );
+
+    tanh_inst : entity work.pwl_function
+        generic map (
+            FUNC        => PWL_TANH,
+            RANGE_LOG2  => 2,
+            LUT_BITS    => LUT_BITS
+        )
+        port map (
+            clk         => clk,
+            data_in     => data_in,
+            data_out    => tanh_out
+        );
+
+    ext_inst : entity work.pwl_function
+        generic map (
+            FUNC        => EXT_FUNC,
+            RANGE_LOG2  => 2,
+            LUT_BITS    => LUT_BITS
+        )
+        port map (
+            clk         => clk,
+            data_in     => data_in,
+            data_out    => ext_out
+        );
+
+    -- Input copy aligned with the table outputs
+    process(clk)
     begin
-        if input_pixel(DATA_WIDTH-1) = '1' then
-            relu6_out <= (others => '0');
-        elsif input_pixel > RELU6_THRESHOLD then
-            relu6_out <= RELU6_THRESHOLD;
-        else
-            relu6_out <= input_pixel;
+        if rising_edge(clk) then
+            input_pipe(0) <= input_pixel;
+            for i in 1 to PWL_LATENCY-1 loop
+                input_pipe(i) <= input_pipe(i-1);
+            end loop;
         end if;
     end process;
 
     -- ==========================================================================
-    -- Leaky ReLU: x if x > 0, else 0.01 * x (approximated as x >> 7)
-    -- ==========================================================================
-    leaky_out <= input_pixel when input_pixel(DATA_WIDTH-1) = '0' 
-                 else shift_right(input_pixel, LEAKY_ALPHA_SHIFT);
-
+    -- ReLU: max(0, x)  (evaluated on the mux-stage input copy)
     -- ==========================================================================
-    -- Sigmoid LUT Address Calculation
-    -- Map input from [-8, 8] (Q8.8: [-2048, 2048]) to [0, 255]
-    -- ==========================================================================
-    process(input_pixel)
-        variable scaled : signed(DATA_WIDTH-1 downto 0);
-        variable addr : unsigned(7 downto 0);
-    begin
-        -- Clamp to [-8, 8] range first
-        if input_pixel < to_signed(-2048, DATA_WIDTH) then
-            scaled := to_signed(-2048, DATA_WIDTH);
-        elsif input_pixel > to_signed(2047, DATA_WIDTH) then
-            scaled := to_signed(2047, DATA_WIDTH);
-        else
-            scaled := input_pixel;
-        end if;
-        
-        -- Map to [0, 255]: (x + 2048) * 255 / 4096 ≈ (x + 2048) >> 4
-        addr := unsigned(scaled(11 downto 4)) + 128;
-        lut_addr_sig <= addr;
-    end process;
+    relu_out <= (others => '0') when input_d(DATA_WIDTH-1) = '1' else input_d;
 
     -- ==========================================================================
-    -- Tanh LUT Address Calculation  
-    -- Map input from [-4, 4] (Q8.8: [-1024, 1024]) to [0, 255]
+    -- ReLU6: min(max(0, x), 6)
     -- ==========================================================================
-    process(input_pixel)
-        variable scaled : signed(DATA_WIDTH-1 downto 0);
-        variable addr : unsigned(7 downto 0);
+    process(input_d)
     begin
-        if input_pixel < to_signed(-1024, DATA_WIDTH) then
-            scaled := to_signed(-1024, DATA_WIDTH);
-        elsif input_pixel > to_signed(1023, DATA_WIDTH) then
-            scaled := to_signed(1023, DATA_WIDTH);
+        if input_d(DATA_WIDTH-1) = '1' then
+            relu6_out <= (others => '0');
+        elsif input_d > RELU6_THRESHOLD then
+            relu6_out <= RELU6_THRESHOLD;
         else
-            scaled := input_pixel;
+            relu6_out <= input_d;
         end if;
-        
-        addr := unsigned(scaled(10 downto 3)) + 128;
-        lut_addr_tanh <= addr;
     end process;
 
     -- ==========================================================================
-    -- LUT Read (registered for timing)
+    -- Leaky ReLU: x if x > 0, else 0.01 * x (approximated as x >> 7)
     -- ==========================================================================
-    process(clk)
-    begin
-        if rising_edge(clk) then
-            sigmoid_out <= sigmoid_lut(to_integer(lut_addr_sig));
-            tanh_out <= tanh_lut(to_integer(lut_addr_tanh));
-        end if;
-    end process;
+    leaky_out <= input_d when input_d(DATA_WIDTH-1) = '0' 
+                 else shift_right(input_d, LEAKY_ALPHA_SHIFT);
 
     -- ==========================================================================
-    -- Swish: x * sigmoid(x)
-    -- Computed as: input_pixel * sigmoid_out (needs extra pipeline stage)
+    -- Stage 3: Swish x * sigmoid(x), other paths delayed to match
     -- ==========================================================================
     process(clk)
         variable product : signed(2*DATA_WIDTH-1 downto 0);
     begin
         if rising_edge(clk) then
-            product := input_pixel * sigmoid_out;
+            product := input_pipe(PWL_LATENCY-1) * signed(sigmoid_out);
             -- Scale back: sigmoid output is in [0, 1] as Q8.8, so >> 8
             swish_out <= product(DATA_WIDTH+FRAC_BITS-1 downto FRAC_BITS);
+            input_d <= input_pipe(PWL_LATENCY-1);
+            sigmoid_d <= signed(sigmoid_out);
+            tanh_d <= signed(tanh_out);
+            ext_d <= signed(ext_out);
         end if;
     end process;
 
@@ -222,16 +175,21 @@ begin
     begin
         if rst_n = '0' then
             valid_pipe <= (others => '0');
-            act_sel_d <= (others => '0');
+            act_sel_pipe <= (others => (others => '0'));
         elsif rising_edge(clk) then
             valid_pipe(0) <= valid_in;
-            valid_pipe(2 downto 1) <= valid_pipe(1 downto 0);
+            valid_pipe(ACT_LATENCY-1 downto 1) <= valid_pipe(ACT_LATENCY-2 downto 0);
             
-            act_sel_d <= cfg_activation;
+            act_sel_pipe(0) <= cfg_activation;
+            for i in 1 to ACT_LATENCY-2 loop
+                act_sel_pipe(i) <= act_sel_pipe(i-1);
+            end loop;
         end if;
     end process;
+
+    act_sel_d <= act_sel_pipe(ACT_LATENCY-2);
     
-    -- Output multiplexer (select based on activation type)
+    -- Stage 4: Output multiplexer (select based on activation type)
     process(clk)
     begin
         if rising_edge(clk) then
@@ -243,13 +201,15 @@ begin
                 when ACT_LEAKY_RELU =>
                     result_mux <= leaky_out;
                 when ACT_SIGMOID =>
-                    result_mux <= sigmoid_out;
+                    result_mux <= sigmoid_d;
                 when ACT_TANH =>
-                    result_mux <= tanh_out;
+                    result_mux <= tanh_d;
                 when ACT_SWISH =>
                     result_mux <= swish_out;
+                when ACT_EXT =>
+                    result_mux <= ext_d;
                 when others =>
-                    result_mux <= input_pixel;  -- Pass through
+                    result_mux <= input_d;  -- Pass through
             end case;
         end if;
     end process;
@@ -258,6 +218,6 @@ begin
     -- Output
     -- ==========================================================================
     data_out <= std_logic_vector(result_mux);
-    valid_out <= valid_pipe(1);  -- Adjusted for pipeline depth
+    valid_out <= valid_pipe(ACT_LATENCY-1);
 
 end rtl;
@@ -5,8 +5,20 @@
 -- Complete CNN inference engine with:
 --   - AXI-Lite control interface
 --   - DMA for weight/bias loading and frame I/O
---   - Configurable Conv2D + Pooling pipeline
+--   - Configurable Conv2D + BatchNorm + Pooling pipeline
 --   - Real-time object detection support
+--   - Optional DDR frame buffer between the video input and the pipeline
+--   - Streaming mode: each start of frame on the video input starts the
+--     next inference without a CPU write
+--   - Inter-frame overlap: conv0 starts frame N+1 while conv1 finishes
+--     frame N
+--   - Separate compute clock for the conv / pool datapath and parameter
+--     memories; asynchronous FIFOs at the video, parameter and result
+--     streams, synchronized control and status
+--   - Optional im2col + systolic GEMM backend for the last conv layer,
+--     selected per layer
+--   - Top-K result registers and hardware box decode + NMS for detection
+--     heads, written to DDR through their own master
 -- =============================================================================
 
 library IEEE;
@@ -23,10 +35,18 @@ entity cnn_accelerator_top is
         INPUT_HEIGHT    : integer := 128;
         INPUT_CHANNELS  : integer := 3;
         NUM_CLASSES     : integer := 10;
+        USE_BATCHNORM   : boolean := true;
+        EXT_ACT_FUNC    : pwl_func_t := PWL_GELU;  -- Activation behind ACT_EXT
+        FUSE_POOL       : boolean := true;         -- Pool inside the conv engines
+        LINK_FIFO_DEPTH : integer := 512;          -- FIFO before each conv layer (2^n, 0 = none)
+        USE_INT8        : boolean := true;         -- Int8 layers with requantization
+        SPARSE_MACS     : integer := 0;            -- MAC lanes replacing the conv taps (0 = dense)
+        USE_WINOGRAD    : boolean := false;        -- Winograd F(2x2,3x3) conv engines
+        GEMM_COLS       : integer := 4;            -- Systolic columns of the conv1 GEMM backend (0 = none)
         
         -- AXI parameters
         C_S_AXI_DATA_WIDTH  : integer := 32;
-        C_S_AXI_ADDR_WIDTH  : integer := 6;
+        C_S_AXI_ADDR_WIDTH  : integer := 12;    -- 4KB banked register map
         C_M_AXI_DATA_WIDTH  : integer := 64;
         C_M_AXI_ADDR_WIDTH  : integer := 32
     );
@@ -35,6 +55,11 @@ entity cnn_accelerator_top is
         aclk            : in  std_logic;
         aresetn         : in  std_logic;
         
+        -- Compute clock (conv / pool datapath and the spill master m_axi);
+        -- may be aclk itself
+        compute_clk     : in  std_logic;
+        compute_aresetn : in  std_logic;
+        
         -- AXI-Lite Slave Interface (Control/Status)
         s_axi_awaddr    : in  std_logic_vector(C_S_AXI_ADDR_WIDTH-1 downto 0);
         s_axi_awprot    : in  std_logic_vector(2 downto 0);
@@ -63,6 +88,12 @@ entity cnn_accelerator_top is
         s_axis_video_tlast  : in  std_logic;
         s_axis_video_tuser  : in  std_logic;
         
+        -- AXI-Stream Parameter Input (from weight DMA)
+        s_axis_weights_tdata  : in  std_logic_vector(31 downto 0);
+        s_axis_weights_tvalid : in  std_logic;
+        s_axis_weights_tready : out std_logic;
+        s_axis_weights_tlast  : in  std_logic;
+        
         -- AXI-Stream Result Output
         m_axis_result_tdata : out std_logic_vector(DATA_WIDTH-1 downto 0);
         m_axis_result_tvalid: out std_logic;
@@ -96,6 +127,76 @@ entity cnn_accelerator_top is
         m_axi_rvalid    : in  std_logic;
         m_axi_rready    : out std_logic;
         
+        -- AXI4 Master Interface (Frame buffer)
+        m_axi_fb_awaddr : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_fb_awlen  : out std_logic_vector(7 downto 0);
+        m_axi_fb_awsize : out std_logic_vector(2 downto 0);
+        m_axi_fb_awburst: out std_logic_vector(1 downto 0);
+        m_axi_fb_awvalid: out std_logic;
+        m_axi_fb_awready: in  std_logic;
+        m_axi_fb_wdata  : out std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        m_axi_fb_wstrb  : out std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+        m_axi_fb_wlast  : out std_logic;
+        m_axi_fb_wvalid : out std_logic;
+        m_axi_fb_wready : in  std_logic;
+        m_axi_fb_bresp  : in  std_logic_vector(1 downto 0);
+        m_axi_fb_bvalid : in  std_logic;
+        m_axi_fb_bready : out std_logic;
+        m_axi_fb_araddr : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_fb_arlen  : out std_logic_vector(7 downto 0);
+        m_axi_fb_arsize : out std_logic_vector(2 downto 0);
+        m_axi_fb_arburst: out std_logic_vector(1 downto 0);
+        m_axi_fb_arvalid: out std_logic;
+        m_axi_fb_arready: in  std_logic;
+        m_axi_fb_rdata  : in  std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        m_axi_fb_rresp  : in  std_logic_vector(1 downto 0);
+        m_axi_fb_rlast  : in  std_logic;
+        m_axi_fb_rvalid : in  std_logic;
+        m_axi_fb_rready : out std_logic;
+        
+        -- AXI4 Master Interface (Command ring)
+        m_axi_cmd_awaddr : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_cmd_awlen  : out std_logic_vector(7 downto 0);
+        m_axi_cmd_awsize : out std_logic_vector(2 downto 0);
+        m_axi_cmd_awburst: out std_logic_vector(1 downto 0);
+        m_axi_cmd_awvalid: out std_logic;
+        m_axi_cmd_awready: in  std_logic;
+        m_axi_cmd_wdata  : out std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        m_axi_cmd_wstrb  : out std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+        m_axi_cmd_wlast  : out std_logic;
+        m_axi_cmd_wvalid : out std_logic;
+        m_axi_cmd_wready : in  std_logic;
+        m_axi_cmd_bresp  : in  std_logic_vector(1 downto 0);
+        m_axi_cmd_bvalid : in  std_logic;
+        m_axi_cmd_bready : out std_logic;
+        m_axi_cmd_araddr : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_cmd_arlen  : out std_logic_vector(7 downto 0);
+        m_axi_cmd_arsize : out std_logic_vector(2 downto 0);
+        m_axi_cmd_arburst: out std_logic_vector(1 downto 0);
+        m_axi_cmd_arvalid: out std_logic;
+        m_axi_cmd_arready: in  std_logic;
+        m_axi_cmd_rdata  : in  std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+        m_axi_cmd_rresp  : in  std_logic_vector(1 downto 0);
+        m_axi_cmd_rlast  : in  std_logic;
+        m_axi_cmd_rvalid : in  std_logic;
+        m_axi_cmd_rready : out std_logic;
+        
+        -- AXI4 Master Interface (Detections, write only)
+        m_axi_det_awaddr : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_det_awlen  : out std_logic_vector(7 downto 0);
+        m_axi_det_awsize : out std_logic_vector(2 downto 0);
+        m_axi_det_awburst: out std_logic_vector(1 downto 0);
+        m_axi_det_awvalid: out std_logic;
+        m_axi_det_awready: in  std_logic;
+        m_axi_det_wdata  : out std_logic_vector(63 downto 0);
+        m_axi_det_wstrb  : out std_logic_vector(7 downto 0);
+        m_axi_det_wlast  : out std_logic;
+        m_axi_det_wvalid : out std_logic;
+        m_axi_det_wready : in  std_logic;
+        m_axi_det_bresp  : in  std_logic_vector(1 downto 0);
+        m_axi_det_bvalid : in  std_logic;
+        m_axi_det_bready : out std_logic;
+        
         -- Interrupt
         irq             : out std_logic
     );
@@ -103,6 +204,84 @@ end cnn_accelerator_top;
 
 architecture rtl of cnn_accelerator_top is
 
+    constant NUM_CONV_LAYERS : integer := 2;
+    
+    -- Features of this build, reported in the CAPABILITIES register
+    function build_caps(bn, fused, fifo, int8, sparse, winograd, gemm : boolean) return std_logic_vector is
+        variable caps : std_logic_vector(31 downto 0) := (others => '0');
+    begin
+        if bn then
+            caps(CAP_BATCHNORM) := '1';
+        end if;
+        if fused then
+            caps(CAP_FUSED_POOL) := '1';
+        end if;
+        caps(CAP_TILING) := '1';
+        caps(CAP_FRAME_BUFFER) := '1';
+        caps(CAP_SCALER) := '1';
+        caps(CAP_NORM) := '1';
+        caps(CAP_YUV) := '1';
+        caps(CAP_NV12) := '1';
+        caps(CAP_CMD_RING) := '1';
+        caps(CAP_IRQ_COALESCE) := '1';
+        caps(CAP_LAYER_CFG) := '1';
+        caps(CAP_SHADOW_CFG) := '1';
+        caps(CAP_STREAMING) := '1';
+        caps(CAP_FRAME_OVERLAP) := '1';
+        caps(CAP_TOPK) := '1';
+        caps(CAP_NMS) := '1';
+        if fifo then
+            caps(CAP_LINK_FIFO) := '1';
+        end if;
+        if int8 then
+            caps(CAP_INT8) := '1';
+        end if;
+        if sparse then
+            caps(CAP_SPARSE) := '1';
+        end if;
+        if winograd then
+            caps(CAP_WINOGRAD) := '1';
+        end if;
+        if gemm then
+            caps(CAP_GEMM) := '1';
+        end if;
+        return caps;
+    end function;
+    
+    -- The GEMM backend takes the direct (untransformed) 3x3 weights
+    constant USE_GEMM1      : boolean := GEMM_COLS > 0 and not USE_WINOGRAD;
+    
+    constant BUILD_CAPS     : std_logic_vector(31 downto 0) := build_caps(USE_BATCHNORM, FUSE_POOL, LINK_FIFO_DEPTH > 0,
+                                                                  USE_INT8 and SPARSE_MACS = 0 and not USE_WINOGRAD,
+                                                                  SPARSE_MACS > 0 and not USE_WINOGRAD,
+                                                                  USE_WINOGRAD, USE_GEMM1);
+    
+    -- The conv0 input FIFO also crosses into the compute clock, so it is
+    -- always built
+    function cdc_depth(depth : integer) return integer is
+    begin
+        if depth < 16 then
+            return 16;
+        end if;
+        return depth;
+    end function;
+    
+    constant CONV0_FIFO_DEPTH : integer := cdc_depth(LINK_FIFO_DEPTH);
+    
+    -- Block design: which interfaces run on which clock
+    attribute X_INTERFACE_INFO : string;
+    attribute X_INTERFACE_PARAMETER : string;
+    attribute X_INTERFACE_INFO of aclk : signal is "xilinx.com:signal:clock:1.0 aclk CLK";
+    attribute X_INTERFACE_PARAMETER of aclk : signal is
+        "ASSOCIATED_BUSIF s_axi:s_axis_video:s_axis_weights:m_axis_result:m_axi_fb:m_axi_cmd:m_axi_det, ASSOCIATED_RESET aresetn";
+    attribute X_INTERFACE_INFO of aresetn : signal is "xilinx.com:signal:reset:1.0 aresetn RST";
+    attribute X_INTERFACE_PARAMETER of aresetn : signal is "POLARITY ACTIVE_LOW";
+    attribute X_INTERFACE_INFO of compute_clk : signal is "xilinx.com:signal:clock:1.0 compute_clk CLK";
+    attribute X_INTERFACE_PARAMETER of compute_clk : signal is
+        "ASSOCIATED_BUSIF m_axi, ASSOCIATED_RESET compute_aresetn";
+    attribute X_INTERFACE_INFO of compute_aresetn : signal is "xilinx.com:signal:reset:1.0 compute_aresetn RST";
+    attribute X_INTERFACE_PARAMETER of compute_aresetn : signal is "POLARITY ACTIVE_LOW";
+
     -- ==========================================================================
     -- Component Declarations
     -- ==========================================================================
@@ -110,7 +289,12 @@ architecture rtl of cnn_accelerator_top is
     component axi_lite_cnn_ctrl is
         generic (
             C_S_AXI_DATA_WIDTH  : integer := 32;
-            C_S_AXI_ADDR_WIDTH  : integer := 6
+            C_S_AXI_ADDR_WIDTH  : integer := 12;
+            NUM_LAYERS      : integer := 2;
+            NUM_MAC_UNITS   : integer := 9;
+            BUILD_WIDTH     : integer := 128;
+            BUILD_HEIGHT    : integer := 128;
+            CAPABILITIES    : std_logic_vector(31 downto 0) := (others => '0')
         );
         port (
             S_AXI_ACLK      : in  std_logic;
@@ -140,21 +324,174 @@ architecture rtl of cnn_accelerator_top is
             stat_busy       : in  std_logic;
             stat_done       : in  std_logic;
             stat_error      : in  std_logic_vector(3 downto 0);
+            job_complete    : in  std_logic;
             cfg_layer_enable: out std_logic_vector(7 downto 0);
-            cfg_activation  : out std_logic_vector(2 downto 0);
-            cfg_pool_type   : out std_logic;
             cfg_input_width : out std_logic_vector(11 downto 0);
             cfg_input_height: out std_logic_vector(11 downto 0);
+            cfg_layer_act   : out std_logic_vector(3*NUM_LAYERS-1 downto 0);
+            cfg_layer_bn    : out std_logic_vector(NUM_LAYERS-1 downto 0);
+            cfg_layer_pool  : out std_logic_vector(NUM_LAYERS-1 downto 0);
+            cfg_layer_int8  : out std_logic_vector(NUM_LAYERS-1 downto 0);
+            cfg_layer_sparse: out std_logic_vector(NUM_LAYERS-1 downto 0);
+            cfg_layer_gemm  : out std_logic_vector(NUM_LAYERS-1 downto 0);
+            cfg_layer_quant : out std_logic_vector(32*NUM_LAYERS-1 downto 0);
+            layer_cycles    : in  std_logic_vector(32*NUM_LAYERS-1 downto 0);
+            layer_stalls    : in  std_logic_vector(32*NUM_LAYERS-1 downto 0);
+            layer_beats     : in  std_logic_vector(32*NUM_LAYERS-1 downto 0);
+            layer_fifo_hwm  : in  std_logic_vector(16*NUM_LAYERS-1 downto 0);
+            layer_hwm_clear : out std_logic_vector(NUM_LAYERS-1 downto 0);
             dma_weight_addr : out std_logic_vector(31 downto 0);
             dma_bias_addr   : out std_logic_vector(31 downto 0);
             dma_input_addr  : out std_logic_vector(31 downto 0);
             dma_output_addr : out std_logic_vector(31 downto 0);
+            dma_fmap_addr   : out std_logic_vector(31 downto 0);
+            cfg_tile_enable : out std_logic;
+            cfg_stripe_rows : out std_logic_vector(7 downto 0);
+            cfg_fb_enable   : out std_logic;
+            cfg_fb_latest   : out std_logic;
+            fb_stats_clear  : out std_logic;
+            fb_drop_count   : in  std_logic_vector(15 downto 0);
+            fb_overrun_count: in  std_logic_vector(15 downto 0);
+            cfg_src_width   : out std_logic_vector(11 downto 0);
+            cfg_src_height  : out std_logic_vector(11 downto 0);
+            cfg_scale_enable: out std_logic;
+            cfg_crop_x      : out std_logic_vector(11 downto 0);
+            cfg_crop_y      : out std_logic_vector(11 downto 0);
+            cfg_crop_width  : out std_logic_vector(11 downto 0);
+            cfg_crop_height : out std_logic_vector(11 downto 0);
+            cfg_step_x      : out std_logic_vector(31 downto 0);
+            cfg_step_y      : out std_logic_vector(31 downto 0);
+            cfg_norm_r      : out std_logic_vector(31 downto 0);
+            cfg_norm_g      : out std_logic_vector(31 downto 0);
+            cfg_norm_b      : out std_logic_vector(31 downto 0);
+            cfg_input_fmt   : out std_logic_vector(1 downto 0);
+            cfg_yuv_bt709   : out std_logic;
+            cfg_yuv_full    : out std_logic;
+            cfg_ring_enable : out std_logic;
+            cfg_ring_base   : out std_logic_vector(31 downto 0);
+            cfg_ring_size   : out std_logic_vector(15 downto 0);
+            cfg_ring_tail   : out std_logic_vector(15 downto 0);
+            ring_head       : in  std_logic_vector(15 downto 0);
+            cfg_stream_enable: out std_logic;
+            cfg_stream_overlap: out std_logic;
+            frame_tag_done  : in  std_logic_vector(15 downto 0);
+            frame_tag_front : in  std_logic_vector(15 downto 0);
+            cfg_commit_pending: out std_logic;
+            topk_entries    : in  std_logic_vector(32*TOPK_K-1 downto 0);
+            topk_valid      : in  std_logic_vector(3 downto 0);
+            topk_classes    : in  std_logic_vector(15 downto 0);
+            cfg_det_enable  : out std_logic;
+            cfg_det_grid_w  : out std_logic_vector(7 downto 0);
+            cfg_det_cell_w  : out std_logic_vector(15 downto 0);
+            cfg_det_cell_h  : out std_logic_vector(15 downto 0);
+            cfg_det_anchor_w: out std_logic_vector(15 downto 0);
+            cfg_det_anchor_h: out std_logic_vector(15 downto 0);
+            cfg_det_score_thr: out std_logic_vector(15 downto 0);
+            cfg_det_iou_thr : out std_logic_vector(7 downto 0);
+            cfg_det_addr    : out std_logic_vector(31 downto 0);
+            det_count       : in  std_logic_vector(7 downto 0);
+            det_candidates  : in  std_logic_vector(15 downto 0);
             irq             : out std_logic;
             perf_cycles     : in  std_logic_vector(31 downto 0);
             perf_ops        : in  std_logic_vector(31 downto 0)
         );
     end component;
     
+    component frame_buffer_ctrl is
+        generic (
+            FRAME_WIDTH     : integer := 128;
+            FRAME_HEIGHT    : integer := 128;
+            PIXEL_WIDTH     : integer := 24;
+            NUM_BUFFERS     : integer := 3;
+            BURST_LEN       : integer := 16;
+            MAX_OUTSTANDING : integer := 4
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            cfg_enable      : in  std_logic;
+            cfg_latest_wins : in  std_logic;
+            cfg_base_addr   : in  std_logic_vector(31 downto 0);
+            cfg_frame_width : in  std_logic_vector(11 downto 0);
+            cfg_frame_height: in  std_logic_vector(11 downto 0);
+            stats_clear     : in  std_logic;
+            s_axis_tdata    : in  std_logic_vector(PIXEL_WIDTH-1 downto 0);
+            s_axis_tvalid   : in  std_logic;
+            s_axis_tready   : out std_logic;
+            s_axis_tlast    : in  std_logic;
+            s_axis_tuser    : in  std_logic;
+            m_axis_tdata    : out std_logic_vector(PIXEL_WIDTH-1 downto 0);
+            m_axis_tvalid   : out std_logic;
+            m_axis_tready   : in  std_logic;
+            m_axis_tlast    : out std_logic;
+            m_axis_tuser    : out std_logic;
+            m_axi_awaddr    : out std_logic_vector(31 downto 0);
+            m_axi_awlen     : out std_logic_vector(7 downto 0);
+            m_axi_awsize    : out std_logic_vector(2 downto 0);
+            m_axi_awburst   : out std_logic_vector(1 downto 0);
+            m_axi_awvalid   : out std_logic;
+            m_axi_awready   : in  std_logic;
+            m_axi_wdata     : out std_logic_vector(63 downto 0);
+            m_axi_wstrb     : out std_logic_vector(7 downto 0);
+            m_axi_wlast     : out std_logic;
+            m_axi_wvalid    : out std_logic;
+            m_axi_wready    : in  std_logic;
+            m_axi_bresp     : in  std_logic_vector(1 downto 0);
+            m_axi_bvalid    : in  std_logic;
+            m_axi_bready    : out std_logic;
+            m_axi_araddr    : out std_logic_vector(31 downto 0);
+            m_axi_arlen     : out std_logic_vector(7 downto 0);
+            m_axi_arsize    : out std_logic_vector(2 downto 0);
+            m_axi_arburst   : out std_logic_vector(1 downto 0);
+            m_axi_arvalid   : out std_logic;
+            m_axi_arready   : in  std_logic;
+            m_axi_rdata     : in  std_logic_vector(63 downto 0);
+            m_axi_rresp     : in  std_logic_vector(1 downto 0);
+            m_axi_rlast     : in  std_logic;
+            m_axi_rvalid    : in  std_logic;
+            m_axi_rready    : out std_logic;
+            write_buf_idx   : out std_logic_vector(1 downto 0);
+            read_buf_idx    : out std_logic_vector(1 downto 0);
+            frame_complete  : out std_logic;
+            drop_count      : out std_logic_vector(15 downto 0);
+            overrun_count   : out std_logic_vector(15 downto 0)
+        );
+    end component;
+    
+    component nv12_reader is
+        generic (
+            MAX_WIDTH       : integer := 4096;
+            BURST_LEN       : integer := 16;
+            MAX_OUTSTANDING : integer := 4
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            cfg_start       : in  std_logic;
+            cfg_base_addr   : in  std_logic_vector(31 downto 0);
+            cfg_width       : in  std_logic_vector(11 downto 0);
+            cfg_height      : in  std_logic_vector(11 downto 0);
+            m_axis_tdata    : out std_logic_vector(15 downto 0);
+            m_axis_tvalid   : out std_logic;
+            m_axis_tready   : in  std_logic;
+            m_axis_tlast    : out std_logic;
+            m_axis_tuser    : out std_logic;
+            m_axi_araddr    : out std_logic_vector(31 downto 0);
+            m_axi_arlen     : out std_logic_vector(7 downto 0);
+            m_axi_arsize    : out std_logic_vector(2 downto 0);
+            m_axi_arburst   : out std_logic_vector(1 downto 0);
+            m_axi_arvalid   : out std_logic;
+            m_axi_arready   : in  std_logic;
+            m_axi_rdata     : in  std_logic_vector(63 downto 0);
+            m_axi_rresp     : in  std_logic_vector(1 downto 0);
+            m_axi_rlast     : in  std_logic;
+            m_axi_rvalid    : in  std_logic;
+            m_axi_rready    : out std_logic;
+            busy            : out std_logic;
+            dma_error       : out std_logic
+        );
+    end component;
+    
     component axis_video_input is
         generic (
             INPUT_WIDTH     : integer := 128;
@@ -166,7 +503,21 @@ architecture rtl of cnn_accelerator_top is
             clk             : in  std_logic;
             rst_n           : in  std_logic;
             cfg_enable      : in  std_logic;
-            cfg_normalize   : in  std_logic;
+            cfg_norm_r      : in  std_logic_vector(31 downto 0);
+            cfg_norm_g      : in  std_logic_vector(31 downto 0);
+            cfg_norm_b      : in  std_logic_vector(31 downto 0);
+            cfg_yuv_enable  : in  std_logic;
+            cfg_yuv_bt709   : in  std_logic;
+            cfg_yuv_full    : in  std_logic;
+            cfg_scale_enable: in  std_logic;
+            cfg_crop_x      : in  std_logic_vector(11 downto 0);
+            cfg_crop_y      : in  std_logic_vector(11 downto 0);
+            cfg_crop_width  : in  std_logic_vector(11 downto 0);
+            cfg_crop_height : in  std_logic_vector(11 downto 0);
+            cfg_out_width   : in  std_logic_vector(11 downto 0);
+            cfg_out_height  : in  std_logic_vector(11 downto 0);
+            cfg_step_x      : in  std_logic_vector(31 downto 0);
+            cfg_step_y      : in  std_logic_vector(31 downto 0);
             s_axis_tdata    : in  std_logic_vector(PIXEL_WIDTH-1 downto 0);
             s_axis_tvalid   : in  std_logic;
             s_axis_tready   : out std_logic;
@@ -193,13 +544,71 @@ architecture rtl of cnn_accelerator_top is
             INPUT_HEIGHT    : integer := 128;
             STRIDE          : integer := 1;
             PADDING         : integer := 1;
-            NUM_MAC_UNITS   : integer := 9
+            NUM_MAC_UNITS   : integer := 9;
+            USE_BATCHNORM   : boolean := true;
+            EXT_ACT_FUNC    : pwl_func_t := PWL_GELU;
+            FUSE_POOL       : boolean := false;
+            USE_INT8        : boolean := false;
+            SPARSE_MACS     : integer := 0;
+            USE_WINOGRAD    : boolean := false
         );
         port (
             clk             : in  std_logic;
             rst_n           : in  std_logic;
             cfg_enable      : in  std_logic;
             cfg_activation  : in  std_logic_vector(2 downto 0);
+            cfg_bn_enable   : in  std_logic;
+            cfg_pool_type   : in  std_logic;
+            cfg_rows        : in  std_logic_vector(11 downto 0);
+            cfg_int8        : in  std_logic;
+            cfg_sparse      : in  std_logic;
+            cfg_quant       : in  std_logic_vector(31 downto 0);
+            weight_valid    : in  std_logic;
+            weight_data     : in  std_logic_vector(WEIGHT_WIDTH-1 downto 0);
+            weight_addr     : in  std_logic_vector(15 downto 0);
+            weight_filter   : in  std_logic_vector(7 downto 0);
+            bias_valid      : in  std_logic;
+            bias_data       : in  std_logic_vector(BIAS_WIDTH-1 downto 0);
+            bias_addr       : in  std_logic_vector(7 downto 0);
+            bn_valid        : in  std_logic;
+            bn_channel      : in  std_logic_vector(9 downto 0);
+            bn_scale        : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+            bn_bias         : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+            quant_valid     : in  std_logic;
+            quant_channel   : in  std_logic_vector(7 downto 0);
+            quant_sel       : in  std_logic;
+            quant_data      : in  std_logic_vector(31 downto 0);
+            s_axis_tdata    : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+            s_axis_tvalid   : in  std_logic;
+            s_axis_tready   : out std_logic;
+            s_axis_tlast    : in  std_logic;
+            s_axis_tuser    : in  std_logic;
+            m_axis_tdata    : out std_logic_vector(DATA_WIDTH-1 downto 0);
+            m_axis_tvalid   : out std_logic;
+            m_axis_tready   : in  std_logic;
+            m_axis_tlast    : out std_logic;
+            m_axis_tuser    : out std_logic;
+            busy            : out std_logic;
+            done            : out std_logic
+        );
+    end component;
+    
+    component gemm_conv_engine is
+        generic (
+            KERNEL_SIZE     : integer := 3;
+            INPUT_CHANNELS  : integer := 16;
+            OUTPUT_CHANNELS : integer := 32;
+            INPUT_WIDTH     : integer := 64;
+            INPUT_HEIGHT    : integer := 64;
+            GEMM_COLS       : integer := 4;
+            EXT_ACT_FUNC    : pwl_func_t := PWL_GELU
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            cfg_enable      : in  std_logic;
+            cfg_activation  : in  std_logic_vector(2 downto 0);
+            cfg_rows        : in  std_logic_vector(11 downto 0);
             weight_valid    : in  std_logic;
             weight_data     : in  std_logic_vector(WEIGHT_WIDTH-1 downto 0);
             weight_addr     : in  std_logic_vector(15 downto 0);
@@ -248,6 +657,291 @@ architecture rtl of cnn_accelerator_top is
             busy            : out std_logic
         );
     end component;
+    
+    component axis_param_loader is
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            s_axis_tdata    : in  std_logic_vector(31 downto 0);
+            s_axis_tvalid   : in  std_logic;
+            s_axis_tready   : out std_logic;
+            s_axis_tlast    : in  std_logic;
+            weight_valid    : out std_logic;
+            weight_layer    : out std_logic_vector(3 downto 0);
+            weight_data     : out std_logic_vector(WEIGHT_WIDTH-1 downto 0);
+            weight_addr     : out std_logic_vector(15 downto 0);
+            weight_filter   : out std_logic_vector(7 downto 0);
+            bias_valid      : out std_logic;
+            bias_layer      : out std_logic_vector(3 downto 0);
+            bias_data       : out std_logic_vector(BIAS_WIDTH-1 downto 0);
+            bias_addr       : out std_logic_vector(7 downto 0);
+            bn_valid        : out std_logic;
+            bn_layer        : out std_logic_vector(3 downto 0);
+            bn_channel      : out std_logic_vector(9 downto 0);
+            bn_scale        : out std_logic_vector(DATA_WIDTH-1 downto 0);
+            bn_bias         : out std_logic_vector(DATA_WIDTH-1 downto 0);
+            quant_valid     : out std_logic;
+            quant_layer     : out std_logic_vector(3 downto 0);
+            quant_channel   : out std_logic_vector(7 downto 0);
+            quant_sel       : out std_logic;
+            quant_data      : out std_logic_vector(31 downto 0);
+            busy            : out std_logic;
+            sections_loaded : out std_logic_vector(15 downto 0)
+        );
+    end component;
+    
+    component axi_fmap_spill is
+        generic (
+            C_M_AXI_DATA_WIDTH  : integer := 64;
+            C_M_AXI_ADDR_WIDTH  : integer := 32;
+            BURST_LEN           : integer := 16;
+            MAX_OUTSTANDING     : integer := 4;
+            HALO                : integer := 1
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            cfg_enable      : in  std_logic;
+            cfg_base_addr   : in  std_logic_vector(31 downto 0);
+            cfg_width       : in  std_logic_vector(11 downto 0);
+            cfg_height      : in  std_logic_vector(11 downto 0);
+            cfg_channels    : in  std_logic_vector(9 downto 0);
+            cfg_stripe_rows : in  std_logic_vector(7 downto 0);
+            cfg_passes      : in  std_logic_vector(7 downto 0);
+            s_axis_tdata    : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+            s_axis_tvalid   : in  std_logic;
+            s_axis_tready   : out std_logic;
+            s_axis_tlast    : in  std_logic;
+            s_axis_tuser    : in  std_logic;
+            m_axis_tdata    : out std_logic_vector(DATA_WIDTH-1 downto 0);
+            m_axis_tvalid   : out std_logic;
+            m_axis_tready   : in  std_logic;
+            m_axis_tlast    : out std_logic;
+            m_axis_tuser    : out std_logic;
+            stripe_rows     : out std_logic_vector(11 downto 0);
+            last_stripe     : out std_logic;
+            m_axi_awaddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+            m_axi_awlen     : out std_logic_vector(7 downto 0);
+            m_axi_awsize    : out std_logic_vector(2 downto 0);
+            m_axi_awburst   : out std_logic_vector(1 downto 0);
+            m_axi_awvalid   : out std_logic;
+            m_axi_awready   : in  std_logic;
+            m_axi_wdata     : out std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+            m_axi_wstrb     : out std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+            m_axi_wlast     : out std_logic;
+            m_axi_wvalid    : out std_logic;
+            m_axi_wready    : in  std_logic;
+            m_axi_bresp     : in  std_logic_vector(1 downto 0);
+            m_axi_bvalid    : in  std_logic;
+            m_axi_bready    : out std_logic;
+            m_axi_araddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+            m_axi_arlen     : out std_logic_vector(7 downto 0);
+            m_axi_arsize    : out std_logic_vector(2 downto 0);
+            m_axi_arburst   : out std_logic_vector(1 downto 0);
+            m_axi_arvalid   : out std_logic;
+            m_axi_arready   : in  std_logic;
+            m_axi_rdata     : in  std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+            m_axi_rresp     : in  std_logic_vector(1 downto 0);
+            m_axi_rlast     : in  std_logic;
+            m_axi_rvalid    : in  std_logic;
+            m_axi_rready    : out std_logic;
+            busy            : out std_logic;
+            dma_error       : out std_logic
+        );
+    end component;
+    
+    component axi_cmd_queue is
+        generic (
+            C_M_AXI_DATA_WIDTH  : integer := 64;
+            C_M_AXI_ADDR_WIDTH  : integer := 32;
+            BURST_LEN           : integer := 16
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            cfg_enable      : in  std_logic;
+            cfg_ring_base   : in  std_logic_vector(31 downto 0);
+            cfg_ring_size   : in  std_logic_vector(15 downto 0);
+            cfg_tail        : in  std_logic_vector(15 downto 0);
+            ring_head       : out std_logic_vector(15 downto 0);
+            job_start       : out std_logic;
+            job_input_addr  : out std_logic_vector(31 downto 0);
+            job_model_addr  : out std_logic_vector(31 downto 0);
+            job_flags       : out std_logic_vector(31 downto 0);
+            job_done        : in  std_logic;
+            job_error       : in  std_logic_vector(3 downto 0);
+            job_cycles      : in  std_logic_vector(31 downto 0);
+            job_complete    : out std_logic;
+            s_axis_tdata    : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+            s_axis_tvalid   : in  std_logic;
+            s_axis_tready   : out std_logic;
+            s_axis_tlast    : in  std_logic;
+            m_axi_awaddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+            m_axi_awlen     : out std_logic_vector(7 downto 0);
+            m_axi_awsize    : out std_logic_vector(2 downto 0);
+            m_axi_awburst   : out std_logic_vector(1 downto 0);
+            m_axi_awvalid   : out std_logic;
+            m_axi_awready   : in  std_logic;
+            m_axi_wdata     : out std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+            m_axi_wstrb     : out std_logic_vector((C_M_AXI_DATA_WIDTH/8)-1 downto 0);
+            m_axi_wlast     : out std_logic;
+            m_axi_wvalid    : out std_logic;
+            m_axi_wready    : in  std_logic;
+            m_axi_bresp     : in  std_logic_vector(1 downto 0);
+            m_axi_bvalid    : in  std_logic;
+            m_axi_bready    : out std_logic;
+            m_axi_araddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+            m_axi_arlen     : out std_logic_vector(7 downto 0);
+            m_axi_arsize    : out std_logic_vector(2 downto 0);
+            m_axi_arburst   : out std_logic_vector(1 downto 0);
+            m_axi_arvalid   : out std_logic;
+            m_axi_arready   : in  std_logic;
+            m_axi_rdata     : in  std_logic_vector(C_M_AXI_DATA_WIDTH-1 downto 0);
+            m_axi_rresp     : in  std_logic_vector(1 downto 0);
+            m_axi_rlast     : in  std_logic;
+            m_axi_rvalid    : in  std_logic;
+            m_axi_rready    : out std_logic;
+            busy            : out std_logic;
+            dma_error       : out std_logic
+        );
+    end component;
+
+    component axis_fifo is
+        generic (
+            DATA_W          : integer := 16;
+            DEPTH           : integer := 512
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            flush           : in  std_logic;
+            s_axis_tdata    : in  std_logic_vector(DATA_W-1 downto 0);
+            s_axis_tvalid   : in  std_logic;
+            s_axis_tready   : out std_logic;
+            s_axis_tlast    : in  std_logic;
+            s_axis_tuser    : in  std_logic;
+            m_axis_tdata    : out std_logic_vector(DATA_W-1 downto 0);
+            m_axis_tvalid   : out std_logic;
+            m_axis_tready   : in  std_logic;
+            m_axis_tlast    : out std_logic;
+            m_axis_tuser    : out std_logic;
+            level           : out std_logic_vector(15 downto 0);
+            high_water      : out std_logic_vector(15 downto 0);
+            high_water_clear: in  std_logic
+        );
+    end component;
+
+    component axis_async_fifo is
+        generic (
+            DATA_W          : integer := 16;
+            DEPTH           : integer := 512
+        );
+        port (
+            s_clk           : in  std_logic;
+            s_rst_n         : in  std_logic;
+            s_axis_tdata    : in  std_logic_vector(DATA_W-1 downto 0);
+            s_axis_tvalid   : in  std_logic;
+            s_axis_tready   : out std_logic;
+            s_axis_tlast    : in  std_logic;
+            s_axis_tuser    : in  std_logic;
+            s_level         : out std_logic_vector(15 downto 0);
+            s_high_water    : out std_logic_vector(15 downto 0);
+            s_hwm_clear     : in  std_logic;
+            m_clk           : in  std_logic;
+            m_rst_n         : in  std_logic;
+            m_flush         : in  std_logic;
+            m_axis_tdata    : out std_logic_vector(DATA_W-1 downto 0);
+            m_axis_tvalid   : out std_logic;
+            m_axis_tready   : in  std_logic;
+            m_axis_tlast    : out std_logic;
+            m_axis_tuser    : out std_logic
+        );
+    end component;
+
+    component topk_unit is
+        generic (
+            TOPK            : integer := 5
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            flush           : in  std_logic;
+            in_valid        : in  std_logic;
+            in_data         : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+            in_eof          : in  std_logic;
+            topk_entries    : out std_logic_vector(32*TOPK-1 downto 0);
+            topk_valid      : out std_logic_vector(3 downto 0);
+            topk_classes    : out std_logic_vector(15 downto 0)
+        );
+    end component;
+    
+    component nms_unit is
+        generic (
+            C_M_AXI_ADDR_WIDTH  : integer := 32;
+            CANDIDATES      : integer := 32;
+            MAX_DET         : integer := 20
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            flush           : in  std_logic;
+            cfg_enable      : in  std_logic;
+            cfg_grid_w      : in  std_logic_vector(7 downto 0);
+            cfg_cell_w      : in  std_logic_vector(15 downto 0);
+            cfg_cell_h      : in  std_logic_vector(15 downto 0);
+            cfg_anchor_w    : in  std_logic_vector(15 downto 0);
+            cfg_anchor_h    : in  std_logic_vector(15 downto 0);
+            cfg_score_thr   : in  std_logic_vector(15 downto 0);
+            cfg_iou_thr     : in  std_logic_vector(7 downto 0);
+            cfg_out_addr    : in  std_logic_vector(31 downto 0);
+            in_valid        : in  std_logic;
+            in_data         : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+            in_eof          : in  std_logic;
+            det_count       : out std_logic_vector(7 downto 0);
+            det_candidates  : out std_logic_vector(15 downto 0);
+            busy            : out std_logic;
+            done            : out std_logic;
+            axi_error       : out std_logic;
+            m_axi_awaddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+            m_axi_awlen     : out std_logic_vector(7 downto 0);
+            m_axi_awsize    : out std_logic_vector(2 downto 0);
+            m_axi_awburst   : out std_logic_vector(1 downto 0);
+            m_axi_awvalid   : out std_logic;
+            m_axi_awready   : in  std_logic;
+            m_axi_wdata     : out std_logic_vector(63 downto 0);
+            m_axi_wstrb     : out std_logic_vector(7 downto 0);
+            m_axi_wlast     : out std_logic;
+            m_axi_wvalid    : out std_logic;
+            m_axi_wready    : in  std_logic;
+            m_axi_bresp     : in  std_logic_vector(1 downto 0);
+            m_axi_bvalid    : in  std_logic;
+            m_axi_bready    : out std_logic
+        );
+    end component;
+    
+    component cdc_sync is
+        generic (
+            WIDTH           : integer := 1;
+            STAGES          : integer := 2
+        );
+        port (
+            clk             : in  std_logic;
+            rst_n           : in  std_logic;
+            d               : in  std_logic_vector(WIDTH-1 downto 0);
+            q               : out std_logic_vector(WIDTH-1 downto 0)
+        );
+    end component;
+
+    component cdc_pulse is
+        port (
+            src_clk         : in  std_logic;
+            src_rst_n       : in  std_logic;
+            src_pulse       : in  std_logic;
+            dst_clk         : in  std_logic;
+            dst_rst_n       : in  std_logic;
+            dst_pulse       : out std_logic
+        );
+    end component;
 
     -- ==========================================================================
     -- Internal Signals
@@ -263,16 +957,163 @@ architecture rtl of cnn_accelerator_top is
     
     -- Configuration signals
     signal cfg_layer_enable : std_logic_vector(7 downto 0);
-    signal cfg_activation   : std_logic_vector(2 downto 0);
-    signal cfg_pool_type    : std_logic;
     signal cfg_input_width  : std_logic_vector(11 downto 0);
     signal cfg_input_height : std_logic_vector(11 downto 0);
     
+    -- Per conv layer configuration (activation is 3 bits per layer)
+    signal cfg_layer_act    : std_logic_vector(3*NUM_CONV_LAYERS-1 downto 0);
+    signal cfg_layer_bn     : std_logic_vector(NUM_CONV_LAYERS-1 downto 0);
+    signal cfg_layer_pool   : std_logic_vector(NUM_CONV_LAYERS-1 downto 0);
+    signal cfg_layer_int8   : std_logic_vector(NUM_CONV_LAYERS-1 downto 0);
+    signal cfg_layer_sparse : std_logic_vector(NUM_CONV_LAYERS-1 downto 0);
+    signal cfg_layer_gemm   : std_logic_vector(NUM_CONV_LAYERS-1 downto 0);
+    signal cfg_layer_quant  : std_logic_vector(32*NUM_CONV_LAYERS-1 downto 0);
+    
     -- DMA addresses
     signal dma_weight_addr  : std_logic_vector(31 downto 0);
     signal dma_bias_addr    : std_logic_vector(31 downto 0);
     signal dma_input_addr   : std_logic_vector(31 downto 0);
     signal dma_output_addr  : std_logic_vector(31 downto 0);
+    signal dma_fmap_addr    : std_logic_vector(31 downto 0);
+    
+    -- Tiling / feature-map spill
+    signal cfg_tile_enable  : std_logic;
+    signal cfg_stripe_rows  : std_logic_vector(7 downto 0);
+    signal spill_tready     : std_logic;
+    signal refill_tdata     : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal refill_tvalid    : std_logic;
+    signal refill_tready    : std_logic;
+    signal refill_tlast     : std_logic;
+    signal refill_tuser     : std_logic;
+    signal refill_rows      : std_logic_vector(11 downto 0);
+    signal refill_last      : std_logic;
+    signal refill_passes    : std_logic_vector(7 downto 0);
+    signal spill_busy       : std_logic;
+    signal spill_error      : std_logic;
+    
+    -- Frame buffer
+    signal cfg_fb_enable    : std_logic;
+    signal cfg_fb_latest    : std_logic;
+    signal fb_stats_clear   : std_logic;
+    signal fb_drop_count    : std_logic_vector(15 downto 0);
+    signal fb_overrun_count : std_logic_vector(15 downto 0);
+    signal fb_in_tvalid     : std_logic;
+    signal fb_in_tready     : std_logic;
+    signal fb_out_tdata     : std_logic_vector(23 downto 0);
+    signal fb_out_tvalid    : std_logic;
+    signal fb_out_tready    : std_logic;
+    signal fb_out_tlast     : std_logic;
+    signal fb_out_tuser     : std_logic;
+    
+    -- Input crop / scale
+    signal cfg_src_width    : std_logic_vector(11 downto 0);
+    signal cfg_src_height   : std_logic_vector(11 downto 0);
+    signal cfg_scale_enable : std_logic;
+    signal cfg_crop_x       : std_logic_vector(11 downto 0);
+    signal cfg_crop_y       : std_logic_vector(11 downto 0);
+    signal cfg_crop_width   : std_logic_vector(11 downto 0);
+    signal cfg_crop_height  : std_logic_vector(11 downto 0);
+    signal cfg_step_x       : std_logic_vector(31 downto 0);
+    signal cfg_step_y       : std_logic_vector(31 downto 0);
+    
+    -- Input normalization
+    signal cfg_norm_r       : std_logic_vector(31 downto 0);
+    signal cfg_norm_g       : std_logic_vector(31 downto 0);
+    signal cfg_norm_b       : std_logic_vector(31 downto 0);
+    
+    -- Input format / NV12 reader
+    signal cfg_input_fmt    : std_logic_vector(1 downto 0);
+    signal cfg_yuv_bt709    : std_logic;
+    signal cfg_yuv_full     : std_logic;
+    signal cfg_yuv_enable   : std_logic;
+    signal cfg_nv12         : std_logic;
+    signal fb_active        : std_logic;
+    signal fb_araddr        : std_logic_vector(31 downto 0);
+    signal fb_arlen         : std_logic_vector(7 downto 0);
+    signal fb_arsize        : std_logic_vector(2 downto 0);
+    signal fb_arburst       : std_logic_vector(1 downto 0);
+    signal fb_arvalid       : std_logic;
+    signal fb_arready       : std_logic;
+    signal fb_rvalid        : std_logic;
+    signal fb_rready        : std_logic;
+    signal nv12_start       : std_logic;
+    signal nv12_tdata       : std_logic_vector(15 downto 0);
+    signal nv12_tvalid      : std_logic;
+    signal nv12_tready      : std_logic;
+    signal nv12_tlast       : std_logic;
+    signal nv12_tuser       : std_logic;
+    signal nv12_araddr      : std_logic_vector(31 downto 0);
+    signal nv12_arlen       : std_logic_vector(7 downto 0);
+    signal nv12_arsize      : std_logic_vector(2 downto 0);
+    signal nv12_arburst     : std_logic_vector(1 downto 0);
+    signal nv12_arvalid     : std_logic;
+    signal nv12_arready     : std_logic;
+    signal nv12_rvalid      : std_logic;
+    signal nv12_rready      : std_logic;
+    signal nv12_error       : std_logic;
+    
+    -- Video input stream (camera, frame buffer or NV12 reader)
+    signal vin_tdata        : std_logic_vector(23 downto 0);
+    signal vin_tvalid       : std_logic;
+    signal vin_tready       : std_logic;
+    signal vin_tlast        : std_logic;
+    signal vin_tuser        : std_logic;
+    
+    -- Command ring
+    signal cfg_ring_enable  : std_logic;
+    signal cfg_ring_base    : std_logic_vector(31 downto 0);
+    signal cfg_ring_size    : std_logic_vector(15 downto 0);
+    signal cfg_ring_tail    : std_logic_vector(15 downto 0);
+    signal ring_head        : std_logic_vector(15 downto 0);
+    signal job_start        : std_logic;
+    signal job_input_addr   : std_logic_vector(31 downto 0);
+    signal job_done         : std_logic;
+    signal job_complete     : std_logic;   -- Result (and descriptor) written
+    signal queue_complete   : std_logic;
+    signal job_tready       : std_logic;
+    signal queue_error      : std_logic;
+    signal run_start        : std_logic;   -- Register start, queued job or SOF
+    signal cfg_stream_enable: std_logic;
+    signal stream_armed     : std_logic;   -- Streaming and waiting for a frame
+    signal stream_start     : std_logic;
+    signal stream_drain     : std_logic;
+    signal vin_accept       : std_logic;
+    
+    -- Inter-frame overlap: the front stage (input, conv0) is main_state, the
+    -- back stage (conv1, pool1, output) holds the frame handed over by it
+    signal cfg_stream_overlap: std_logic;
+    signal cfg_commit_pending: std_logic;
+    
+    -- Top-K of the last result frame
+    signal topk_entries     : std_logic_vector(32*TOPK_K-1 downto 0);
+    signal topk_valid       : std_logic_vector(3 downto 0);
+    signal topk_classes     : std_logic_vector(15 downto 0);
+    
+    -- Detection post-processing
+    signal cfg_det_enable   : std_logic;
+    signal cfg_det_grid_w   : std_logic_vector(7 downto 0);
+    signal cfg_det_cell_w   : std_logic_vector(15 downto 0);
+    signal cfg_det_cell_h   : std_logic_vector(15 downto 0);
+    signal cfg_det_anchor_w : std_logic_vector(15 downto 0);
+    signal cfg_det_anchor_h : std_logic_vector(15 downto 0);
+    signal cfg_det_score_thr: std_logic_vector(15 downto 0);
+    signal cfg_det_iou_thr  : std_logic_vector(7 downto 0);
+    signal cfg_det_addr     : std_logic_vector(31 downto 0);
+    signal det_count        : std_logic_vector(7 downto 0);
+    signal det_candidates   : std_logic_vector(15 downto 0);
+    signal det_done         : std_logic;
+    signal det_error        : std_logic;
+    signal overlap_active   : std_logic;
+    signal front_busy       : std_logic;
+    signal front_drained    : std_logic;   -- conv0 has finished the frame
+    signal conv0_busy_d     : std_logic;
+    signal back_busy        : std_logic;
+    signal back_done        : std_logic;
+    signal frame_seq        : unsigned(15 downto 0);
+    signal front_tag        : std_logic_vector(15 downto 0);
+    signal back_tag         : std_logic_vector(15 downto 0);
+    signal done_tag         : std_logic_vector(15 downto 0);
+    signal frame_addr       : std_logic_vector(31 downto 0);
     
     -- Performance counters
     signal perf_cycles      : std_logic_vector(31 downto 0);
@@ -280,6 +1121,23 @@ architecture rtl of cnn_accelerator_top is
     signal cycle_counter    : unsigned(31 downto 0);
     signal ops_counter      : unsigned(31 downto 0);
     
+    -- Per conv layer telemetry
+    type layer_cnt_t is array (0 to NUM_CONV_LAYERS-1) of unsigned(31 downto 0);
+    signal layer_busy       : std_logic_vector(NUM_CONV_LAYERS-1 downto 0);
+    signal layer_stall      : std_logic_vector(NUM_CONV_LAYERS-1 downto 0);
+    signal layer_beat       : std_logic_vector(NUM_CONV_LAYERS-1 downto 0);
+    signal layer_cycle_cnt  : layer_cnt_t;
+    signal layer_stall_cnt  : layer_cnt_t;
+    signal layer_beat_cnt   : layer_cnt_t;
+    signal layer_cycles     : std_logic_vector(32*NUM_CONV_LAYERS-1 downto 0);
+    signal layer_stalls     : std_logic_vector(32*NUM_CONV_LAYERS-1 downto 0);
+    signal layer_beats      : std_logic_vector(32*NUM_CONV_LAYERS-1 downto 0);
+    
+    -- Elastic FIFOs in front of the conv layers
+    signal link_flush       : std_logic;
+    signal link_hwm         : std_logic_vector(16*NUM_CONV_LAYERS-1 downto 0);
+    signal link_hwm_clear   : std_logic_vector(NUM_CONV_LAYERS-1 downto 0);
+    
     -- Video input signals
     signal video_r, video_g, video_b : std_logic_vector(DATA_WIDTH-1 downto 0);
     signal video_valid      : std_logic;
@@ -293,6 +1151,11 @@ architecture rtl of cnn_accelerator_top is
     signal conv0_in_tready  : std_logic;
     signal conv0_in_tlast   : std_logic;
     signal conv0_in_tuser   : std_logic;
+    signal conv0_q_tdata    : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal conv0_q_tvalid   : std_logic;
+    signal conv0_q_tready   : std_logic;
+    signal conv0_q_tlast    : std_logic;
+    signal conv0_q_tuser    : std_logic;
     signal conv0_out_tdata  : std_logic_vector(DATA_WIDTH-1 downto 0);
     signal conv0_out_tvalid : std_logic;
     signal conv0_out_tready : std_logic;
@@ -307,9 +1170,20 @@ architecture rtl of cnn_accelerator_top is
     signal pool0_out_tready : std_logic;
     signal pool0_out_tlast  : std_logic;
     signal pool0_out_tuser  : std_logic;
+    signal pool0_q_tdata    : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal pool0_q_tvalid   : std_logic;
+    signal pool0_q_tready   : std_logic;
+    signal pool0_q_tlast    : std_logic;
+    signal pool0_q_tuser    : std_logic;
     signal pool0_busy       : std_logic;
     
     -- Conv1 signals (16 input channels -> 32 output channels)
+    signal conv1_in_tdata   : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal conv1_in_tvalid  : std_logic;
+    signal conv1_in_tready  : std_logic;
+    signal conv1_in_tlast   : std_logic;
+    signal conv1_in_tuser   : std_logic;
+    signal conv1_rows       : std_logic_vector(11 downto 0);
     signal conv1_out_tdata  : std_logic_vector(DATA_WIDTH-1 downto 0);
     signal conv1_out_tvalid : std_logic;
     signal conv1_out_tready : std_logic;
@@ -318,6 +1192,17 @@ architecture rtl of cnn_accelerator_top is
     signal conv1_busy       : std_logic;
     signal conv1_done       : std_logic;
     
+    -- conv2d_engine side of conv1 (muxed with the GEMM backend)
+    signal conv1_eng_in_tvalid  : std_logic;
+    signal conv1_eng_in_tready  : std_logic;
+    signal conv1_eng_out_tdata  : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal conv1_eng_out_tvalid : std_logic;
+    signal conv1_eng_out_tready : std_logic;
+    signal conv1_eng_out_tlast  : std_logic;
+    signal conv1_eng_out_tuser  : std_logic;
+    signal conv1_eng_busy       : std_logic;
+    signal conv1_eng_done       : std_logic;
+    
     -- Pool1 signals
     signal pool1_out_tdata  : std_logic_vector(DATA_WIDTH-1 downto 0);
     signal pool1_out_tvalid : std_logic;
@@ -326,14 +1211,37 @@ architecture rtl of cnn_accelerator_top is
     signal pool1_out_tuser  : std_logic;
     signal pool1_busy       : std_logic;
     
-    -- Weight/bias loading
+    -- Weight/bias/batchnorm loading
     signal weight_valid     : std_logic;
+    signal weight_layer     : std_logic_vector(3 downto 0);
     signal weight_data      : std_logic_vector(WEIGHT_WIDTH-1 downto 0);
     signal weight_addr      : std_logic_vector(15 downto 0);
     signal weight_filter    : std_logic_vector(7 downto 0);
     signal bias_valid       : std_logic;
+    signal bias_layer       : std_logic_vector(3 downto 0);
     signal bias_data        : std_logic_vector(BIAS_WIDTH-1 downto 0);
     signal bias_addr        : std_logic_vector(7 downto 0);
+    signal bn_valid         : std_logic;
+    signal bn_layer         : std_logic_vector(3 downto 0);
+    signal bn_channel       : std_logic_vector(9 downto 0);
+    signal bn_scale         : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal bn_bias          : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal quant_valid      : std_logic;
+    signal quant_layer      : std_logic_vector(3 downto 0);
+    signal quant_channel    : std_logic_vector(7 downto 0);
+    signal quant_sel        : std_logic;
+    signal quant_data       : std_logic_vector(31 downto 0);
+    signal param_busy       : std_logic;
+    
+    -- Per-layer parameter write strobes (conv layer index from section header)
+    signal conv0_weight_valid : std_logic;
+    signal conv0_bias_valid   : std_logic;
+    signal conv0_bn_valid     : std_logic;
+    signal conv1_weight_valid : std_logic;
+    signal conv1_bias_valid   : std_logic;
+    signal conv1_bn_valid     : std_logic;
+    signal conv0_quant_valid  : std_logic;
+    signal conv1_quant_valid  : std_logic;
     
     -- Channel multiplexer for RGB input
     signal channel_sel      : unsigned(1 downto 0);
@@ -342,8 +1250,40 @@ architecture rtl of cnn_accelerator_top is
     -- Global enable
     signal global_enable    : std_logic;
     
+    -- Clock domain crossings (_c: compute clock, _s: synchronized to aclk)
+    signal counters_clear   : std_logic;
+    signal counters_clear_c : std_logic;
+    signal link_flush_c     : std_logic;
+    signal conv1_hwm_clear_c: std_logic;
+    signal conv1_hwm_c      : std_logic_vector(15 downto 0);
+    signal cstat_c          : std_logic_vector(2 downto 0);
+    signal cstat_s          : std_logic_vector(2 downto 0);
+    signal conv0_busy_s     : std_logic;
+    signal param_busy_s     : std_logic;
+    signal spill_error_s    : std_logic;
+    signal params_pending   : std_logic;   -- Loader busy or words in flight
+    signal weights_level    : std_logic_vector(15 downto 0);
+    signal wq_tdata         : std_logic_vector(31 downto 0);
+    signal wq_tvalid        : std_logic;
+    signal wq_tready        : std_logic;
+    signal wq_tlast         : std_logic;
+    
+    -- Result stream in aclk; tuser marks the last beat of a frame
+    signal frame_end_c      : std_logic;
+    signal frame_end_d      : std_logic;
+    signal eof_armed        : std_logic;
+    signal pool1_out_eof    : std_logic;
+    signal res_tdata        : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal res_tvalid       : std_logic;
+    signal res_tready       : std_logic;
+    signal res_tlast        : std_logic;
+    signal res_teof         : std_logic;
+    signal res_eof          : std_logic;   -- Frame's last result beat taken
+    signal res_handshake    : std_logic;
+    signal frame_eof        : std_logic;   -- Frame's results (and boxes) complete
+    
     -- FSM for overall control
-    type main_state_t is (IDLE, LOAD_WEIGHTS, PROCESS_FRAME, OUTPUT_RESULT, DONE);
+    type main_state_t is (IDLE, LOAD_WEIGHTS, PROCESS_FRAME, DONE);
     signal main_state       : main_state_t;
 
 begin
@@ -354,7 +1294,12 @@ begin
     ctrl_inst : axi_lite_cnn_ctrl
         generic map (
             C_S_AXI_DATA_WIDTH => C_S_AXI_DATA_WIDTH,
-            C_S_AXI_ADDR_WIDTH => C_S_AXI_ADDR_WIDTH
+            C_S_AXI_ADDR_WIDTH => C_S_AXI_ADDR_WIDTH,
+            NUM_LAYERS      => NUM_CONV_LAYERS,
+            NUM_MAC_UNITS   => 9,
+            BUILD_WIDTH     => INPUT_WIDTH,
+            BUILD_HEIGHT    => INPUT_HEIGHT,
+            CAPABILITIES    => BUILD_CAPS
         )
         port map (
             S_AXI_ACLK      => aclk,
@@ -384,20 +1329,230 @@ begin
             stat_busy       => stat_busy,
             stat_done       => stat_done,
             stat_error      => stat_error,
+            job_complete    => job_complete,
             cfg_layer_enable => cfg_layer_enable,
-            cfg_activation  => cfg_activation,
-            cfg_pool_type   => cfg_pool_type,
             cfg_input_width => cfg_input_width,
             cfg_input_height => cfg_input_height,
+            cfg_layer_act   => cfg_layer_act,
+            cfg_layer_bn    => cfg_layer_bn,
+            cfg_layer_pool  => cfg_layer_pool,
+            cfg_layer_int8  => cfg_layer_int8,
+            cfg_layer_sparse=> cfg_layer_sparse,
+            cfg_layer_gemm  => cfg_layer_gemm,
+            cfg_layer_quant => cfg_layer_quant,
+            layer_cycles    => layer_cycles,
+            layer_stalls    => layer_stalls,
+            layer_beats     => layer_beats,
+            layer_fifo_hwm  => link_hwm,
+            layer_hwm_clear => link_hwm_clear,
             dma_weight_addr => dma_weight_addr,
             dma_bias_addr   => dma_bias_addr,
             dma_input_addr  => dma_input_addr,
             dma_output_addr => dma_output_addr,
+            dma_fmap_addr   => dma_fmap_addr,
+            cfg_tile_enable => cfg_tile_enable,
+            cfg_stripe_rows => cfg_stripe_rows,
+            cfg_fb_enable   => cfg_fb_enable,
+            cfg_fb_latest   => cfg_fb_latest,
+            fb_stats_clear  => fb_stats_clear,
+            fb_drop_count   => fb_drop_count,
+            fb_overrun_count => fb_overrun_count,
+            cfg_src_width   => cfg_src_width,
+            cfg_src_height  => cfg_src_height,
+            cfg_scale_enable => cfg_scale_enable,
+            cfg_crop_x      => cfg_crop_x,
+            cfg_crop_y      => cfg_crop_y,
+            cfg_crop_width  => cfg_crop_width,
+            cfg_crop_height => cfg_crop_height,
+            cfg_step_x      => cfg_step_x,
+            cfg_step_y      => cfg_step_y,
+            cfg_norm_r      => cfg_norm_r,
+            cfg_norm_g      => cfg_norm_g,
+            cfg_norm_b      => cfg_norm_b,
+            cfg_input_fmt   => cfg_input_fmt,
+            cfg_yuv_bt709   => cfg_yuv_bt709,
+            cfg_yuv_full    => cfg_yuv_full,
+            cfg_ring_enable => cfg_ring_enable,
+            cfg_ring_base   => cfg_ring_base,
+            cfg_ring_size   => cfg_ring_size,
+            cfg_ring_tail   => cfg_ring_tail,
+            ring_head       => ring_head,
+            cfg_stream_enable => cfg_stream_enable,
+            cfg_stream_overlap => cfg_stream_overlap,
+            frame_tag_done  => done_tag,
+            frame_tag_front => front_tag,
+            cfg_commit_pending => cfg_commit_pending,
+            topk_entries    => topk_entries,
+            topk_valid      => topk_valid,
+            topk_classes    => topk_classes,
+            cfg_det_enable  => cfg_det_enable,
+            cfg_det_grid_w  => cfg_det_grid_w,
+            cfg_det_cell_w  => cfg_det_cell_w,
+            cfg_det_cell_h  => cfg_det_cell_h,
+            cfg_det_anchor_w => cfg_det_anchor_w,
+            cfg_det_anchor_h => cfg_det_anchor_h,
+            cfg_det_score_thr => cfg_det_score_thr,
+            cfg_det_iou_thr => cfg_det_iou_thr,
+            cfg_det_addr    => cfg_det_addr,
+            det_count       => det_count,
+            det_candidates  => det_candidates,
             irq             => irq,
             perf_cycles     => perf_cycles,
             perf_ops        => perf_ops
         );
 
+    -- ==========================================================================
+    -- Frame Buffer (camera -> DDR -> pipeline)
+    -- ==========================================================================
+    -- Decouples the camera from the CNN. With latest-frame-wins the camera is
+    -- never stalled and the pipeline always starts on the newest complete
+    -- frame; otherwise every frame is processed and the camera is held off.
+    frame_buffer_inst : frame_buffer_ctrl
+        generic map (
+            FRAME_WIDTH     => INPUT_WIDTH,
+            FRAME_HEIGHT    => INPUT_HEIGHT,
+            PIXEL_WIDTH     => 24,
+            NUM_BUFFERS     => 3
+        )
+        port map (
+            clk             => aclk,
+            rst_n           => aresetn,
+            cfg_enable      => fb_active,
+            cfg_latest_wins => cfg_fb_latest,
+            cfg_base_addr   => frame_addr,
+            cfg_frame_width => cfg_src_width,
+            cfg_frame_height => cfg_src_height,
+            stats_clear     => fb_stats_clear,
+            s_axis_tdata    => s_axis_video_tdata,
+            s_axis_tvalid   => fb_in_tvalid,
+            s_axis_tready   => fb_in_tready,
+            s_axis_tlast    => s_axis_video_tlast,
+            s_axis_tuser    => s_axis_video_tuser,
+            m_axis_tdata    => fb_out_tdata,
+            m_axis_tvalid   => fb_out_tvalid,
+            m_axis_tready   => fb_out_tready,
+            m_axis_tlast    => fb_out_tlast,
+            m_axis_tuser    => fb_out_tuser,
+            m_axi_awaddr    => m_axi_fb_awaddr,
+            m_axi_awlen     => m_axi_fb_awlen,
+            m_axi_awsize    => m_axi_fb_awsize,
+            m_axi_awburst   => m_axi_fb_awburst,
+            m_axi_awvalid   => m_axi_fb_awvalid,
+            m_axi_awready   => m_axi_fb_awready,
+            m_axi_wdata     => m_axi_fb_wdata,
+            m_axi_wstrb     => m_axi_fb_wstrb,
+            m_axi_wlast     => m_axi_fb_wlast,
+            m_axi_wvalid    => m_axi_fb_wvalid,
+            m_axi_wready    => m_axi_fb_wready,
+            m_axi_bresp     => m_axi_fb_bresp,
+            m_axi_bvalid    => m_axi_fb_bvalid,
+            m_axi_bready    => m_axi_fb_bready,
+            m_axi_araddr    => fb_araddr,
+            m_axi_arlen     => fb_arlen,
+            m_axi_arsize    => fb_arsize,
+            m_axi_arburst   => fb_arburst,
+            m_axi_arvalid   => fb_arvalid,
+            m_axi_arready   => fb_arready,
+            m_axi_rdata     => m_axi_fb_rdata,
+            m_axi_rresp     => m_axi_fb_rresp,
+            m_axi_rlast     => m_axi_fb_rlast,
+            m_axi_rvalid    => fb_rvalid,
+            m_axi_rready    => fb_rready,
+            write_buf_idx   => open,
+            read_buf_idx    => open,
+            frame_complete  => open,
+            drop_count      => fb_drop_count,
+            overrun_count   => fb_overrun_count
+        );
+    
+    -- ==========================================================================
+    -- NV12 Reader (DDR -> YUV 4:2:2 stream, one frame per start)
+    -- ==========================================================================
+    -- Shares the frame buffer's AXI master: the camera frame buffer is not
+    -- used when the input comes from memory, so only the read channels are
+    -- switched over.
+    nv12_reader_inst : nv12_reader
+        generic map (
+            MAX_WIDTH       => 4096
+        )
+        port map (
+            clk             => aclk,
+            rst_n           => aresetn,
+            cfg_start       => nv12_start,
+            cfg_base_addr   => frame_addr,
+            cfg_width       => cfg_src_width,
+            cfg_height      => cfg_src_height,
+            m_axis_tdata    => nv12_tdata,
+            m_axis_tvalid   => nv12_tvalid,
+            m_axis_tready   => nv12_tready,
+            m_axis_tlast    => nv12_tlast,
+            m_axis_tuser    => nv12_tuser,
+            m_axi_araddr    => nv12_araddr,
+            m_axi_arlen     => nv12_arlen,
+            m_axi_arsize    => nv12_arsize,
+            m_axi_arburst   => nv12_arburst,
+            m_axi_arvalid   => nv12_arvalid,
+            m_axi_arready   => nv12_arready,
+            m_axi_rdata     => m_axi_fb_rdata,
+            m_axi_rresp     => m_axi_fb_rresp,
+            m_axi_rlast     => m_axi_fb_rlast,
+            m_axi_rvalid    => nv12_rvalid,
+            m_axi_rready    => nv12_rready,
+            busy            => open,
+            dma_error       => nv12_error
+        );
+    
+    -- Input format: 0 = RGB888 stream, 1 = YUV 4:2:2 stream, 2 = NV12 from DDR
+    cfg_yuv_enable <= '1' when cfg_input_fmt /= "00" else '0';
+    cfg_nv12 <= '1' when cfg_input_fmt = "10" else '0';
+    fb_active <= cfg_fb_enable and not cfg_nv12;
+    nv12_start <= run_start and cfg_nv12;
+    
+    m_axi_fb_araddr <= nv12_araddr when cfg_nv12 = '1' else fb_araddr;
+    m_axi_fb_arlen <= nv12_arlen when cfg_nv12 = '1' else fb_arlen;
+    m_axi_fb_arsize <= nv12_arsize when cfg_nv12 = '1' else fb_arsize;
+    m_axi_fb_arburst <= nv12_arburst when cfg_nv12 = '1' else fb_arburst;
+    m_axi_fb_arvalid <= nv12_arvalid when cfg_nv12 = '1' else fb_arvalid;
+    m_axi_fb_rready <= nv12_rready when cfg_nv12 = '1' else fb_rready;
+    nv12_arready <= m_axi_fb_arready and cfg_nv12;
+    nv12_rvalid <= m_axi_fb_rvalid and cfg_nv12;
+    fb_arready <= m_axi_fb_arready and not cfg_nv12;
+    fb_rvalid <= m_axi_fb_rvalid and not cfg_nv12;
+    
+    -- Camera goes straight to the video input when the frame buffer is off
+    fb_in_tvalid <= s_axis_video_tvalid and fb_active;
+    fb_out_tready <= vin_accept and fb_active;
+    nv12_tready <= vin_accept and cfg_nv12;
+    s_axis_video_tready <= '0' when cfg_nv12 = '1' else
+                           fb_in_tready when fb_active = '1' else
+                           vin_accept;
+    
+    -- Streaming: an SOF at the head of the input starts the next inference;
+    -- the rest of a frame that began while the pipeline was busy is dropped
+    -- so every run starts on a frame boundary. NV12 and the command ring
+    -- start from memory and ignore this mode.
+    -- With overlap, a pending commit holds the next frame until the back
+    -- stage has drained, so the new configuration applies to both layers.
+    stream_armed <= '1' when cfg_stream_enable = '1' and cfg_nv12 = '0' and
+                             cfg_ring_enable = '0' and main_state = IDLE and
+                             (back_busy = '0' or cfg_commit_pending = '0') else '0';
+    stream_start <= stream_armed and vin_tvalid and vin_tuser;
+    stream_drain <= stream_armed and not vin_tuser;
+    vin_accept <= vin_tready or stream_drain;
+    
+    vin_tdata <= x"00" & nv12_tdata when cfg_nv12 = '1' else
+                 fb_out_tdata when fb_active = '1' else
+                 s_axis_video_tdata;
+    vin_tvalid <= nv12_tvalid when cfg_nv12 = '1' else
+                  fb_out_tvalid when fb_active = '1' else
+                  s_axis_video_tvalid;
+    vin_tlast <= nv12_tlast when cfg_nv12 = '1' else
+                 fb_out_tlast when fb_active = '1' else
+                 s_axis_video_tlast;
+    vin_tuser <= nv12_tuser when cfg_nv12 = '1' else
+                 fb_out_tuser when fb_active = '1' else
+                 s_axis_video_tuser;
+
     -- ==========================================================================
     -- Video Input Processing
     -- ==========================================================================
@@ -412,12 +1567,26 @@ begin
             clk             => aclk,
             rst_n           => aresetn,
             cfg_enable      => global_enable,
-            cfg_normalize   => '1',  -- Normalize to [-1, 1]
-            s_axis_tdata    => s_axis_video_tdata,
-            s_axis_tvalid   => s_axis_video_tvalid,
-            s_axis_tready   => s_axis_video_tready,
-            s_axis_tlast    => s_axis_video_tlast,
-            s_axis_tuser    => s_axis_video_tuser,
+            cfg_norm_r      => cfg_norm_r,
+            cfg_norm_g      => cfg_norm_g,
+            cfg_norm_b      => cfg_norm_b,
+            cfg_yuv_enable  => cfg_yuv_enable,
+            cfg_yuv_bt709   => cfg_yuv_bt709,
+            cfg_yuv_full    => cfg_yuv_full,
+            cfg_scale_enable => cfg_scale_enable,
+            cfg_crop_x      => cfg_crop_x,
+            cfg_crop_y      => cfg_crop_y,
+            cfg_crop_width  => cfg_crop_width,
+            cfg_crop_height => cfg_crop_height,
+            cfg_out_width   => cfg_input_width,
+            cfg_out_height  => cfg_input_height,
+            cfg_step_x      => cfg_step_x,
+            cfg_step_y      => cfg_step_y,
+            s_axis_tdata    => vin_tdata,
+            s_axis_tvalid   => vin_tvalid,
+            s_axis_tready   => vin_tready,
+            s_axis_tlast    => vin_tlast,
+            s_axis_tuser    => vin_tuser,
             m_axis_r_tdata  => video_r,
             m_axis_g_tdata  => video_g,
             m_axis_b_tdata  => video_b,
@@ -437,7 +1606,7 @@ begin
         if aresetn = '0' then
             channel_sel <= (others => '0');
         elsif rising_edge(aclk) then
-            if video_valid = '1' and conv0_in_tready = '1' then
+            if conv0_in_tvalid = '1' and conv0_in_tready = '1' then
                 if channel_sel = 2 then
                     channel_sel <= (others => '0');
                 else
@@ -455,7 +1624,78 @@ begin
     conv0_in_tvalid <= video_valid and global_enable;
     conv0_in_tlast <= video_last when channel_sel = 2 else '0';
     conv0_in_tuser <= video_user when channel_sel = 0 else '0';
-    video_ready <= conv0_in_tready when channel_sel = 2 else '1';
+    video_ready <= conv0_in_tready and global_enable when channel_sel = 2 else '1';
+
+    -- ==========================================================================
+    -- Layer Input FIFOs: absorb short stalls of a layer without holding off
+    -- the one before it; tready toward the producer is registered. The conv0
+    -- FIFO also carries the pixels into the compute clock.
+    -- ==========================================================================
+    link_flush <= ctrl_reset or ctrl_stop;
+
+    conv0_fifo_inst : axis_async_fifo
+        generic map (
+            DATA_W          => DATA_WIDTH,
+            DEPTH           => CONV0_FIFO_DEPTH
+        )
+        port map (
+            s_clk           => aclk,
+            s_rst_n         => aresetn,
+            s_axis_tdata    => conv0_in_tdata,
+            s_axis_tvalid   => conv0_in_tvalid,
+            s_axis_tready   => conv0_in_tready,
+            s_axis_tlast    => conv0_in_tlast,
+            s_axis_tuser    => conv0_in_tuser,
+            s_level         => open,
+            s_high_water    => link_hwm(15 downto 0),
+            s_hwm_clear     => link_hwm_clear(0),
+            m_clk           => compute_clk,
+            m_rst_n         => compute_aresetn,
+            m_flush         => link_flush_c,
+            m_axis_tdata    => conv0_q_tdata,
+            m_axis_tvalid   => conv0_q_tvalid,
+            m_axis_tready   => conv0_q_tready,
+            m_axis_tlast    => conv0_q_tlast,
+            m_axis_tuser    => conv0_q_tuser
+        );
+
+    gen_link_fifo: if LINK_FIFO_DEPTH > 0 generate
+        conv1_fifo_inst : axis_fifo
+            generic map (
+                DATA_W          => DATA_WIDTH,
+                DEPTH           => LINK_FIFO_DEPTH
+            )
+            port map (
+                clk             => compute_clk,
+                rst_n           => compute_aresetn,
+                flush           => link_flush_c,
+                s_axis_tdata    => pool0_out_tdata,
+                s_axis_tvalid   => pool0_out_tvalid,
+                s_axis_tready   => pool0_out_tready,
+                s_axis_tlast    => pool0_out_tlast,
+                s_axis_tuser    => pool0_out_tuser,
+                m_axis_tdata    => pool0_q_tdata,
+                m_axis_tvalid   => pool0_q_tvalid,
+                m_axis_tready   => pool0_q_tready,
+                m_axis_tlast    => pool0_q_tlast,
+                m_axis_tuser    => pool0_q_tuser,
+                level           => open,
+                high_water      => conv1_hwm_c,
+                high_water_clear=> conv1_hwm_clear_c
+            );
+    end generate;
+
+    gen_link_direct: if LINK_FIFO_DEPTH = 0 generate
+        pool0_q_tdata <= pool0_out_tdata;
+        pool0_q_tvalid <= pool0_out_tvalid;
+        pool0_out_tready <= pool0_q_tready;
+        pool0_q_tlast <= pool0_out_tlast;
+        pool0_q_tuser <= pool0_out_tuser;
+        conv1_hwm_c <= (others => '0');
+    end generate;
+    
+    -- Read by software; held while the marks are sampled
+    link_hwm(31 downto 16) <= conv1_hwm_c;
 
     -- ==========================================================================
     -- Conv Layer 0: 3 channels -> 16 filters, 3x3 kernel
@@ -469,25 +1709,45 @@ begin
             INPUT_HEIGHT    => INPUT_HEIGHT,
             STRIDE          => 1,
             PADDING         => 1,
-            NUM_MAC_UNITS   => 9
+            NUM_MAC_UNITS   => 9,
+            USE_BATCHNORM   => USE_BATCHNORM,
+            EXT_ACT_FUNC    => EXT_ACT_FUNC,
+            FUSE_POOL       => FUSE_POOL,
+            USE_INT8        => USE_INT8,
+            SPARSE_MACS     => SPARSE_MACS,
+            USE_WINOGRAD    => USE_WINOGRAD
         )
         port map (
-            clk             => aclk,
-            rst_n           => aresetn,
+            clk             => compute_clk,
+            rst_n           => compute_aresetn,
             cfg_enable      => cfg_layer_enable(0),
-            cfg_activation  => cfg_activation,
-            weight_valid    => weight_valid,
+            cfg_activation  => cfg_layer_act(2 downto 0),
+            cfg_bn_enable   => cfg_layer_bn(0),
+            cfg_pool_type   => cfg_layer_pool(0),
+            cfg_rows        => (others => '0'),
+            cfg_int8        => cfg_layer_int8(0),
+            cfg_sparse      => cfg_layer_sparse(0),
+            cfg_quant       => cfg_layer_quant(31 downto 0),
+            weight_valid    => conv0_weight_valid,
             weight_data     => weight_data,
             weight_addr     => weight_addr,
             weight_filter   => weight_filter,
-            bias_valid      => bias_valid,
+            bias_valid      => conv0_bias_valid,
             bias_data       => bias_data,
             bias_addr       => bias_addr,
-            s_axis_tdata    => conv0_in_tdata,
-            s_axis_tvalid   => conv0_in_tvalid,
-            s_axis_tready   => conv0_in_tready,
-            s_axis_tlast    => conv0_in_tlast,
-            s_axis_tuser    => conv0_in_tuser,
+            bn_valid        => conv0_bn_valid,
+            bn_channel      => bn_channel,
+            bn_scale        => bn_scale,
+            bn_bias         => bn_bias,
+            quant_valid     => conv0_quant_valid,
+            quant_channel   => quant_channel,
+            quant_sel       => quant_sel,
+            quant_data      => quant_data,
+            s_axis_tdata    => conv0_q_tdata,
+            s_axis_tvalid   => conv0_q_tvalid,
+            s_axis_tready   => conv0_q_tready,
+            s_axis_tlast    => conv0_q_tlast,
+            s_axis_tuser    => conv0_q_tuser,
             m_axis_tdata    => conv0_out_tdata,
             m_axis_tvalid   => conv0_out_tvalid,
             m_axis_tready   => conv0_out_tready,
@@ -498,33 +1758,117 @@ begin
         );
 
     -- ==========================================================================
-    -- Pooling Layer 0: 2x2 Max Pooling
+    -- Pooling Layer 0: 2x2 Max Pooling (separate engine unless FUSE_POOL)
+    -- ==========================================================================
+    gen_pool0: if not FUSE_POOL generate
+        pool0_inst : pooling_engine
+            generic map (
+                POOL_SIZE       => 2,
+                INPUT_WIDTH     => INPUT_WIDTH,
+                INPUT_HEIGHT    => INPUT_HEIGHT,
+                INPUT_CHANNELS  => 16,
+                STRIDE          => 2
+            )
+            port map (
+                clk             => compute_clk,
+                rst_n           => compute_aresetn,
+                cfg_enable      => cfg_layer_enable(1),
+                cfg_pool_type   => cfg_layer_pool(0),
+                s_axis_tdata    => conv0_out_tdata,
+                s_axis_tvalid   => conv0_out_tvalid,
+                s_axis_tready   => conv0_out_tready,
+                s_axis_tlast    => conv0_out_tlast,
+                s_axis_tuser    => conv0_out_tuser,
+                m_axis_tdata    => pool0_out_tdata,
+                m_axis_tvalid   => pool0_out_tvalid,
+                m_axis_tready   => pool0_out_tready,
+                m_axis_tlast    => pool0_out_tlast,
+                m_axis_tuser    => pool0_out_tuser,
+                busy            => pool0_busy
+            );
+    end generate;
+
+    -- Fused mode: conv0 already delivers the pooled stream
+    gen_pool0_fused: if FUSE_POOL generate
+        pool0_out_tdata <= conv0_out_tdata;
+        pool0_out_tvalid <= conv0_out_tvalid;
+        conv0_out_tready <= pool0_out_tready;
+        pool0_out_tlast <= conv0_out_tlast;
+        pool0_out_tuser <= conv0_out_tuser;
+        pool0_busy <= '0';
+    end generate;
+
+    -- ==========================================================================
+    -- Feature-Map Spill (tiled mode): layer-0 output goes to DDR and comes
+    -- back as row bands, so conv1 holds one stripe instead of the whole map
     -- ==========================================================================
-    pool0_inst : pooling_engine
+    spill_inst : axi_fmap_spill
         generic map (
-            POOL_SIZE       => 2,
-            INPUT_WIDTH     => INPUT_WIDTH,
-            INPUT_HEIGHT    => INPUT_HEIGHT,
-            INPUT_CHANNELS  => 16,
-            STRIDE          => 2
+            C_M_AXI_DATA_WIDTH  => C_M_AXI_DATA_WIDTH,
+            C_M_AXI_ADDR_WIDTH  => C_M_AXI_ADDR_WIDTH,
+            BURST_LEN           => 16,
+            MAX_OUTSTANDING     => 4,
+            HALO                => 1
         )
         port map (
-            clk             => aclk,
-            rst_n           => aresetn,
-            cfg_enable      => cfg_layer_enable(1),
-            cfg_pool_type   => cfg_pool_type,
-            s_axis_tdata    => conv0_out_tdata,
-            s_axis_tvalid   => conv0_out_tvalid,
-            s_axis_tready   => conv0_out_tready,
-            s_axis_tlast    => conv0_out_tlast,
-            s_axis_tuser    => conv0_out_tuser,
-            m_axis_tdata    => pool0_out_tdata,
-            m_axis_tvalid   => pool0_out_tvalid,
-            m_axis_tready   => pool0_out_tready,
-            m_axis_tlast    => pool0_out_tlast,
-            m_axis_tuser    => pool0_out_tuser,
-            busy            => pool0_busy
+            clk             => compute_clk,
+            rst_n           => compute_aresetn,
+            cfg_enable      => cfg_tile_enable,
+            cfg_base_addr   => dma_fmap_addr,
+            cfg_width       => std_logic_vector(to_unsigned(INPUT_WIDTH/2, 12)),
+            cfg_height      => std_logic_vector(to_unsigned(INPUT_HEIGHT/2, 12)),
+            cfg_channels    => std_logic_vector(to_unsigned(16, 10)),
+            cfg_stripe_rows => cfg_stripe_rows,
+            cfg_passes      => refill_passes,
+            s_axis_tdata    => pool0_q_tdata,
+            s_axis_tvalid   => pool0_q_tvalid,
+            s_axis_tready   => spill_tready,
+            s_axis_tlast    => pool0_q_tlast,
+            s_axis_tuser    => pool0_q_tuser,
+            m_axis_tdata    => refill_tdata,
+            m_axis_tvalid   => refill_tvalid,
+            m_axis_tready   => refill_tready,
+            m_axis_tlast    => refill_tlast,
+            m_axis_tuser    => refill_tuser,
+            stripe_rows     => refill_rows,
+            last_stripe     => refill_last,
+            m_axi_awaddr    => m_axi_awaddr,
+            m_axi_awlen     => m_axi_awlen,
+            m_axi_awsize    => m_axi_awsize,
+            m_axi_awburst   => m_axi_awburst,
+            m_axi_awvalid   => m_axi_awvalid,
+            m_axi_awready   => m_axi_awready,
+            m_axi_wdata     => m_axi_wdata,
+            m_axi_wstrb     => m_axi_wstrb,
+            m_axi_wlast     => m_axi_wlast,
+            m_axi_wvalid    => m_axi_wvalid,
+            m_axi_wready    => m_axi_wready,
+            m_axi_bresp     => m_axi_bresp,
+            m_axi_bvalid    => m_axi_bvalid,
+            m_axi_bready    => m_axi_bready,
+            m_axi_araddr    => m_axi_araddr,
+            m_axi_arlen     => m_axi_arlen,
+            m_axi_arsize    => m_axi_arsize,
+            m_axi_arburst   => m_axi_arburst,
+            m_axi_arvalid   => m_axi_arvalid,
+            m_axi_arready   => m_axi_arready,
+            m_axi_rdata     => m_axi_rdata,
+            m_axi_rresp     => m_axi_rresp,
+            m_axi_rlast     => m_axi_rlast,
+            m_axi_rvalid    => m_axi_rvalid,
+            m_axi_rready    => m_axi_rready,
+            busy            => spill_busy,
+            dma_error       => spill_error
         );
+    
+    -- Conv1 input: refilled stripes when tiled, layer-0 stream otherwise
+    conv1_in_tdata <= refill_tdata when cfg_tile_enable = '1' else pool0_q_tdata;
+    conv1_in_tvalid <= refill_tvalid when cfg_tile_enable = '1' else pool0_q_tvalid;
+    conv1_in_tlast <= refill_tlast when cfg_tile_enable = '1' else pool0_q_tlast;
+    conv1_in_tuser <= refill_tuser when cfg_tile_enable = '1' else pool0_q_tuser;
+    conv1_rows <= refill_rows when cfg_tile_enable = '1' else (others => '0');
+    pool0_q_tready <= spill_tready when cfg_tile_enable = '1' else conv1_in_tready;
+    refill_tready <= conv1_in_tready when cfg_tile_enable = '1' else '0';
 
     -- ==========================================================================
     -- Conv Layer 1: 16 channels -> 32 filters, 3x3 kernel
@@ -538,121 +1882,537 @@ begin
             INPUT_HEIGHT    => INPUT_HEIGHT/2,
             STRIDE          => 1,
             PADDING         => 1,
-            NUM_MAC_UNITS   => 9
+            NUM_MAC_UNITS   => 9,
+            USE_BATCHNORM   => USE_BATCHNORM,
+            EXT_ACT_FUNC    => EXT_ACT_FUNC,
+            FUSE_POOL       => FUSE_POOL,
+            USE_INT8        => USE_INT8,
+            SPARSE_MACS     => SPARSE_MACS,
+            USE_WINOGRAD    => USE_WINOGRAD
         )
         port map (
-            clk             => aclk,
-            rst_n           => aresetn,
+            clk             => compute_clk,
+            rst_n           => compute_aresetn,
             cfg_enable      => cfg_layer_enable(2),
-            cfg_activation  => cfg_activation,
-            weight_valid    => weight_valid,
+            cfg_activation  => cfg_layer_act(5 downto 3),
+            cfg_bn_enable   => cfg_layer_bn(1),
+            cfg_pool_type   => cfg_layer_pool(1),
+            cfg_rows        => conv1_rows,
+            cfg_int8        => cfg_layer_int8(1),
+            cfg_sparse      => cfg_layer_sparse(1),
+            cfg_quant       => cfg_layer_quant(63 downto 32),
+            weight_valid    => conv1_weight_valid,
             weight_data     => weight_data,
             weight_addr     => weight_addr,
             weight_filter   => weight_filter,
-            bias_valid      => bias_valid,
+            bias_valid      => conv1_bias_valid,
             bias_data       => bias_data,
             bias_addr       => bias_addr,
-            s_axis_tdata    => pool0_out_tdata,
-            s_axis_tvalid   => pool0_out_tvalid,
-            s_axis_tready   => pool0_out_tready,
-            s_axis_tlast    => pool0_out_tlast,
-            s_axis_tuser    => pool0_out_tuser,
-            m_axis_tdata    => conv1_out_tdata,
-            m_axis_tvalid   => conv1_out_tvalid,
-            m_axis_tready   => conv1_out_tready,
-            m_axis_tlast    => conv1_out_tlast,
-            m_axis_tuser    => conv1_out_tuser,
-            busy            => conv1_busy,
-            done            => conv1_done
+            bn_valid        => conv1_bn_valid,
+            bn_channel      => bn_channel,
+            bn_scale        => bn_scale,
+            bn_bias         => bn_bias,
+            quant_valid     => conv1_quant_valid,
+            quant_channel   => quant_channel,
+            quant_sel       => quant_sel,
+            quant_data      => quant_data,
+            s_axis_tdata    => conv1_in_tdata,
+            s_axis_tvalid   => conv1_eng_in_tvalid,
+            s_axis_tready   => conv1_eng_in_tready,
+            s_axis_tlast    => conv1_in_tlast,
+            s_axis_tuser    => conv1_in_tuser,
+            m_axis_tdata    => conv1_eng_out_tdata,
+            m_axis_tvalid   => conv1_eng_out_tvalid,
+            m_axis_tready   => conv1_eng_out_tready,
+            m_axis_tlast    => conv1_eng_out_tlast,
+            m_axis_tuser    => conv1_eng_out_tuser,
+            busy            => conv1_eng_busy,
+            done            => conv1_eng_done
+        );
+
+    -- ==========================================================================
+    -- Conv Layer 1 GEMM Backend: im2col + systolic array, selected by the
+    -- layer's GEMM bit; the stream and status muxes keep the rest of the
+    -- pipeline unaware of which engine ran
+    -- ==========================================================================
+    gen_gemm1: if USE_GEMM1 generate
+        constant GEMM1_OUT      : integer := 32;  -- conv1 output channels
+        constant GEMM1_PASSES   : integer := GEMM1_OUT / GEMM_COLS;
+        
+        signal gemm_in_tvalid   : std_logic;
+        signal gemm_in_tready   : std_logic;
+        signal gemm_out_tdata   : std_logic_vector(DATA_WIDTH-1 downto 0);
+        signal gemm_out_tvalid  : std_logic;
+        signal gemm_out_tready  : std_logic;
+        signal gemm_out_tlast   : std_logic;
+        signal gemm_out_tuser   : std_logic;
+        signal gemm_q_tdata     : std_logic_vector(DATA_WIDTH-1 downto 0);
+        signal gemm_q_tvalid    : std_logic;
+        signal gemm_q_tready    : std_logic;
+        signal gemm_q_tlast     : std_logic;
+        signal gemm_q_tuser     : std_logic;
+        signal gemm_busy        : std_logic;
+        signal gemm_done        : std_logic;
+        signal gemm_sel         : std_logic;
+        signal gemm_enable      : std_logic;
+    begin
+        -- The backend makes one pass over its input per GEMM_COLS output
+        -- channels, so it runs on the refilled stripes, repeated that often
+        gemm_sel <= cfg_layer_gemm(1) and cfg_tile_enable;
+        gemm_enable <= cfg_layer_enable(2) and gemm_sel;
+        refill_passes <= std_logic_vector(to_unsigned(GEMM1_PASSES, 8)) when gemm_sel = '1' else (others => '0');
+
+        gemm1_inst : gemm_conv_engine
+            generic map (
+                KERNEL_SIZE     => 3,
+                INPUT_CHANNELS  => 16,
+                OUTPUT_CHANNELS => GEMM1_OUT,
+                INPUT_WIDTH     => INPUT_WIDTH/2,
+                INPUT_HEIGHT    => INPUT_HEIGHT/2,
+                GEMM_COLS       => GEMM_COLS,
+                EXT_ACT_FUNC    => EXT_ACT_FUNC
+            )
+            port map (
+                clk             => compute_clk,
+                rst_n           => compute_aresetn,
+                cfg_enable      => gemm_enable,
+                cfg_activation  => cfg_layer_act(5 downto 3),
+                cfg_rows        => conv1_rows,
+                weight_valid    => conv1_weight_valid,
+                weight_data     => weight_data,
+                weight_addr     => weight_addr,
+                weight_filter   => weight_filter,
+                bias_valid      => conv1_bias_valid,
+                bias_data       => bias_data,
+                bias_addr       => bias_addr,
+                s_axis_tdata    => conv1_in_tdata,
+                s_axis_tvalid   => gemm_in_tvalid,
+                s_axis_tready   => gemm_in_tready,
+                s_axis_tlast    => conv1_in_tlast,
+                s_axis_tuser    => conv1_in_tuser,
+                m_axis_tdata    => gemm_out_tdata,
+                m_axis_tvalid   => gemm_out_tvalid,
+                m_axis_tready   => gemm_out_tready,
+                m_axis_tlast    => gemm_out_tlast,
+                m_axis_tuser    => gemm_out_tuser,
+                busy            => gemm_busy,
+                done            => gemm_done
+            );
+
+        -- The backend has no fused pool: give it its own engine in fused
+        -- builds so conv1's output stream has the same shape either way
+        gen_gemm1_pool: if FUSE_POOL generate
+            gemm1_pool_inst : pooling_engine
+                generic map (
+                    POOL_SIZE       => 2,
+                    INPUT_WIDTH     => INPUT_WIDTH/2,
+                    INPUT_HEIGHT    => INPUT_HEIGHT/2,
+                    INPUT_CHANNELS  => 32,
+                    STRIDE          => 2
+                )
+                port map (
+                    clk             => compute_clk,
+                    rst_n           => compute_aresetn,
+                    cfg_enable      => '1',
+                    cfg_pool_type   => cfg_layer_pool(1),
+                    s_axis_tdata    => gemm_out_tdata,
+                    s_axis_tvalid   => gemm_out_tvalid,
+                    s_axis_tready   => gemm_out_tready,
+                    s_axis_tlast    => gemm_out_tlast,
+                    s_axis_tuser    => gemm_out_tuser,
+                    m_axis_tdata    => gemm_q_tdata,
+                    m_axis_tvalid   => gemm_q_tvalid,
+                    m_axis_tready   => gemm_q_tready,
+                    m_axis_tlast    => gemm_q_tlast,
+                    m_axis_tuser    => gemm_q_tuser,
+                    busy            => open
+                );
+        end generate;
+
+        gen_gemm1_direct: if not FUSE_POOL generate
+            gemm_q_tdata <= gemm_out_tdata;
+            gemm_q_tvalid <= gemm_out_tvalid;
+            gemm_out_tready <= gemm_q_tready;
+            gemm_q_tlast <= gemm_out_tlast;
+            gemm_q_tuser <= gemm_out_tuser;
+        end generate;
+
+        conv1_eng_in_tvalid <= conv1_in_tvalid and not gemm_sel;
+        gemm_in_tvalid <= conv1_in_tvalid and gemm_sel;
+        conv1_in_tready <= gemm_in_tready when gemm_sel = '1' else conv1_eng_in_tready;
+
+        conv1_out_tdata <= gemm_q_tdata when gemm_sel = '1' else conv1_eng_out_tdata;
+        conv1_out_tvalid <= gemm_q_tvalid when gemm_sel = '1' else conv1_eng_out_tvalid;
+        conv1_out_tlast <= gemm_q_tlast when gemm_sel = '1' else conv1_eng_out_tlast;
+        conv1_out_tuser <= gemm_q_tuser when gemm_sel = '1' else conv1_eng_out_tuser;
+        gemm_q_tready <= conv1_out_tready and gemm_sel;
+        conv1_eng_out_tready <= conv1_out_tready and not gemm_sel;
+
+        conv1_busy <= gemm_busy when gemm_sel = '1' else conv1_eng_busy;
+        conv1_done <= gemm_done when gemm_sel = '1' else conv1_eng_done;
+    end generate;
+
+    gen_no_gemm1: if not USE_GEMM1 generate
+        refill_passes <= (others => '0');
+        conv1_eng_in_tvalid <= conv1_in_tvalid;
+        conv1_in_tready <= conv1_eng_in_tready;
+        conv1_out_tdata <= conv1_eng_out_tdata;
+        conv1_out_tvalid <= conv1_eng_out_tvalid;
+        conv1_eng_out_tready <= conv1_out_tready;
+        conv1_out_tlast <= conv1_eng_out_tlast;
+        conv1_out_tuser <= conv1_eng_out_tuser;
+        conv1_busy <= conv1_eng_busy;
+        conv1_done <= conv1_eng_done;
+    end generate;
+
+    -- ==========================================================================
+    -- Pooling Layer 1: 2x2 Max Pooling (separate engine unless FUSE_POOL)
+    -- ==========================================================================
+    gen_pool1: if not FUSE_POOL generate
+        pool1_inst : pooling_engine
+            generic map (
+                POOL_SIZE       => 2,
+                INPUT_WIDTH     => INPUT_WIDTH/2,
+                INPUT_HEIGHT    => INPUT_HEIGHT/2,
+                INPUT_CHANNELS  => 32,
+                STRIDE          => 2
+            )
+            port map (
+                clk             => compute_clk,
+                rst_n           => compute_aresetn,
+                cfg_enable      => cfg_layer_enable(3),
+                cfg_pool_type   => cfg_layer_pool(1),
+                s_axis_tdata    => conv1_out_tdata,
+                s_axis_tvalid   => conv1_out_tvalid,
+                s_axis_tready   => conv1_out_tready,
+                s_axis_tlast    => conv1_out_tlast,
+                s_axis_tuser    => conv1_out_tuser,
+                m_axis_tdata    => pool1_out_tdata,
+                m_axis_tvalid   => pool1_out_tvalid,
+                m_axis_tready   => pool1_out_tready,
+                m_axis_tlast    => pool1_out_tlast,
+                m_axis_tuser    => pool1_out_tuser,
+                busy            => pool1_busy
+            );
+    end generate;
+
+    -- Fused mode: conv1 already delivers the pooled stream
+    gen_pool1_fused: if FUSE_POOL generate
+        pool1_out_tdata <= conv1_out_tdata;
+        pool1_out_tvalid <= conv1_out_tvalid;
+        conv1_out_tready <= pool1_out_tready;
+        pool1_out_tlast <= conv1_out_tlast;
+        pool1_out_tuser <= conv1_out_tuser;
+        pool1_busy <= '0';
+    end generate;
+
+    -- ==========================================================================
+    -- Output to Result Stream
+    -- ==========================================================================
+    -- The frame ends on the first result tlast at or after conv1's last
+    -- output (the last stripe when tiled). That beat is tagged here, in the
+    -- compute clock, and travels with the data through the result FIFO.
+    frame_end_c <= conv1_done when cfg_tile_enable = '0' else conv1_done and refill_last;
+    pool1_out_eof <= pool1_out_tlast and (eof_armed or (frame_end_c and not frame_end_d));
+    
+    process(compute_clk, compute_aresetn)
+    begin
+        if compute_aresetn = '0' then
+            frame_end_d <= '0';
+            eof_armed <= '0';
+        elsif rising_edge(compute_clk) then
+            frame_end_d <= frame_end_c;
+            if link_flush_c = '1' then
+                eof_armed <= '0';
+            elsif pool1_out_tvalid = '1' and pool1_out_tready = '1' and pool1_out_eof = '1' then
+                eof_armed <= '0';
+            elsif frame_end_c = '1' and frame_end_d = '0' then
+                eof_armed <= '1';
+            end if;
+        end if;
+    end process;
+    
+    result_fifo_inst : axis_async_fifo
+        generic map (
+            DATA_W          => DATA_WIDTH,
+            DEPTH           => 16
+        )
+        port map (
+            s_clk           => compute_clk,
+            s_rst_n         => compute_aresetn,
+            s_axis_tdata    => pool1_out_tdata,
+            s_axis_tvalid   => pool1_out_tvalid,
+            s_axis_tready   => pool1_out_tready,
+            s_axis_tlast    => pool1_out_tlast,
+            s_axis_tuser    => pool1_out_eof,
+            s_level         => open,
+            s_high_water    => open,
+            s_hwm_clear     => '0',
+            m_clk           => aclk,
+            m_rst_n         => aresetn,
+            m_flush         => link_flush,
+            m_axis_tdata    => res_tdata,
+            m_axis_tvalid   => res_tvalid,
+            m_axis_tready   => res_tready,
+            m_axis_tlast    => res_tlast,
+            m_axis_tuser    => res_teof
         );
+    
+    res_eof <= res_tvalid and res_tready and res_teof;
+    
+    -- With the command ring enabled the queue writes results to the
+    -- descriptor's output address instead
+    m_axis_result_tdata <= res_tdata;
+    m_axis_result_tvalid <= res_tvalid and not cfg_ring_enable;
+    res_tready <= job_tready when cfg_ring_enable = '1' else m_axis_result_tready;
+    m_axis_result_tlast <= res_tlast;
 
     -- ==========================================================================
-    -- Pooling Layer 1: 2x2 Max Pooling
+    -- Top-K of the logits, for the CPU without a DDR read
     -- ==========================================================================
-    pool1_inst : pooling_engine
+    -- Taps the result handshake, so it sees every frame whether the results
+    -- go out on m_axis_result or through the command queue
+    topk_inst : topk_unit
         generic map (
-            POOL_SIZE       => 2,
-            INPUT_WIDTH     => INPUT_WIDTH/2,
-            INPUT_HEIGHT    => INPUT_HEIGHT/2,
-            INPUT_CHANNELS  => 32,
-            STRIDE          => 2
+            TOPK            => TOPK_K
         )
         port map (
             clk             => aclk,
             rst_n           => aresetn,
-            cfg_enable      => cfg_layer_enable(3),
-            cfg_pool_type   => cfg_pool_type,
-            s_axis_tdata    => conv1_out_tdata,
-            s_axis_tvalid   => conv1_out_tvalid,
-            s_axis_tready   => conv1_out_tready,
-            s_axis_tlast    => conv1_out_tlast,
-            s_axis_tuser    => conv1_out_tuser,
-            m_axis_tdata    => pool1_out_tdata,
-            m_axis_tvalid   => pool1_out_tvalid,
-            m_axis_tready   => pool1_out_tready,
-            m_axis_tlast    => pool1_out_tlast,
-            m_axis_tuser    => pool1_out_tuser,
-            busy            => pool1_busy
+            flush           => link_flush,
+            in_valid        => res_handshake,
+            in_data         => res_tdata,
+            in_eof          => res_teof,
+            topk_entries    => topk_entries,
+            topk_valid      => topk_valid,
+            topk_classes    => topk_classes
         );
+    
+    res_handshake <= res_tvalid and res_tready;
 
     -- ==========================================================================
-    -- Output to Result Stream
+    -- Detection Post-Processing (box decode, NMS, boxes to DDR)
+    -- ==========================================================================
+    -- With detection enabled a frame completes once its boxes are in DDR,
+    -- so the CPU never reads a half-written list
+    nms_inst : nms_unit
+        generic map (
+            C_M_AXI_ADDR_WIDTH  => C_M_AXI_ADDR_WIDTH,
+            CANDIDATES      => 32,
+            MAX_DET         => NMS_MAX_DET
+        )
+        port map (
+            clk             => aclk,
+            rst_n           => aresetn,
+            flush           => link_flush,
+            cfg_enable      => cfg_det_enable,
+            cfg_grid_w      => cfg_det_grid_w,
+            cfg_cell_w      => cfg_det_cell_w,
+            cfg_cell_h      => cfg_det_cell_h,
+            cfg_anchor_w    => cfg_det_anchor_w,
+            cfg_anchor_h    => cfg_det_anchor_h,
+            cfg_score_thr   => cfg_det_score_thr,
+            cfg_iou_thr     => cfg_det_iou_thr,
+            cfg_out_addr    => cfg_det_addr,
+            in_valid        => res_handshake,
+            in_data         => res_tdata,
+            in_eof          => res_teof,
+            det_count       => det_count,
+            det_candidates  => det_candidates,
+            busy            => open,
+            done            => det_done,
+            axi_error       => det_error,
+            m_axi_awaddr    => m_axi_det_awaddr,
+            m_axi_awlen     => m_axi_det_awlen,
+            m_axi_awsize    => m_axi_det_awsize,
+            m_axi_awburst   => m_axi_det_awburst,
+            m_axi_awvalid   => m_axi_det_awvalid,
+            m_axi_awready   => m_axi_det_awready,
+            m_axi_wdata     => m_axi_det_wdata,
+            m_axi_wstrb     => m_axi_det_wstrb,
+            m_axi_wlast     => m_axi_det_wlast,
+            m_axi_wvalid    => m_axi_det_wvalid,
+            m_axi_wready    => m_axi_det_wready,
+            m_axi_bresp     => m_axi_det_bresp,
+            m_axi_bvalid    => m_axi_det_bvalid,
+            m_axi_bready    => m_axi_det_bready
+        );
+    
+    frame_eof <= det_done when cfg_det_enable = '1' else res_eof;
+
+    -- ==========================================================================
+    -- Command Queue (DDR descriptor ring)
     -- ==========================================================================
-    m_axis_result_tdata <= pool1_out_tdata;
-    m_axis_result_tvalid <= pool1_out_tvalid;
-    pool1_out_tready <= m_axis_result_tready;
-    m_axis_result_tlast <= pool1_out_tlast;
+    cmd_queue_inst : axi_cmd_queue
+        generic map (
+            C_M_AXI_DATA_WIDTH  => C_M_AXI_DATA_WIDTH,
+            C_M_AXI_ADDR_WIDTH  => C_M_AXI_ADDR_WIDTH,
+            BURST_LEN           => 16
+        )
+        port map (
+            clk             => aclk,
+            rst_n           => aresetn,
+            cfg_enable      => cfg_ring_enable,
+            cfg_ring_base   => cfg_ring_base,
+            cfg_ring_size   => cfg_ring_size,
+            cfg_tail        => cfg_ring_tail,
+            ring_head       => ring_head,
+            job_start       => job_start,
+            job_input_addr  => job_input_addr,
+            job_model_addr  => open,
+            job_flags       => open,
+            job_done        => job_done,
+            job_error       => stat_error,
+            job_cycles      => perf_cycles,
+            job_complete    => queue_complete,
+            s_axis_tdata    => res_tdata,
+            s_axis_tvalid   => res_tvalid,
+            s_axis_tready   => job_tready,
+            s_axis_tlast    => res_tlast,
+            m_axi_awaddr    => m_axi_cmd_awaddr,
+            m_axi_awlen     => m_axi_cmd_awlen,
+            m_axi_awsize    => m_axi_cmd_awsize,
+            m_axi_awburst   => m_axi_cmd_awburst,
+            m_axi_awvalid   => m_axi_cmd_awvalid,
+            m_axi_awready   => m_axi_cmd_awready,
+            m_axi_wdata     => m_axi_cmd_wdata,
+            m_axi_wstrb     => m_axi_cmd_wstrb,
+            m_axi_wlast     => m_axi_cmd_wlast,
+            m_axi_wvalid    => m_axi_cmd_wvalid,
+            m_axi_wready    => m_axi_cmd_wready,
+            m_axi_bresp     => m_axi_cmd_bresp,
+            m_axi_bvalid    => m_axi_cmd_bvalid,
+            m_axi_bready    => m_axi_cmd_bready,
+            m_axi_araddr    => m_axi_cmd_araddr,
+            m_axi_arlen     => m_axi_cmd_arlen,
+            m_axi_arsize    => m_axi_cmd_arsize,
+            m_axi_arburst   => m_axi_cmd_arburst,
+            m_axi_arvalid   => m_axi_cmd_arvalid,
+            m_axi_arready   => m_axi_cmd_arready,
+            m_axi_rdata     => m_axi_cmd_rdata,
+            m_axi_rresp     => m_axi_cmd_rresp,
+            m_axi_rlast     => m_axi_cmd_rlast,
+            m_axi_rvalid    => m_axi_cmd_rvalid,
+            m_axi_rready    => m_axi_cmd_rready,
+            busy            => open,
+            dma_error       => queue_error
+        );
+    
+    -- Queued jobs start the pipeline like a CONTROL.start write and take the
+    -- frame address from their descriptor
+    run_start <= ctrl_start or job_start or stream_start;
+    frame_addr <= job_input_addr when cfg_ring_enable = '1' else dma_input_addr;
+    job_done <= '1' when main_state = DONE or back_done = '1' else '0';
+    
+    -- Overlap needs whole frames per layer, so it is off while tiling
+    overlap_active <= cfg_stream_enable and cfg_stream_overlap and not cfg_tile_enable;
+    back_done <= back_busy and frame_eof;
+    stat_busy <= front_busy or back_busy;
+    
+    -- A queued job completes once its status is in DDR
+    job_complete <= queue_complete when cfg_ring_enable = '1' else job_done;
 
     -- ==========================================================================
     -- Main Control FSM
     -- ==========================================================================
+    -- With overlap active a frame leaves the FSM once conv0 has finished it
+    -- and conv1 is free; the back stage then completes it on pool1's last
+    -- beat while the FSM admits the next frame into conv0.
     process(aclk, aresetn)
     begin
         if aresetn = '0' then
             main_state <= IDLE;
             global_enable <= '0';
-            stat_busy <= '0';
+            front_busy <= '0';
+            front_drained <= '0';
+            conv0_busy_d <= '0';
+            back_busy <= '0';
+            frame_seq <= (others => '0');
+            front_tag <= (others => '0');
+            back_tag <= (others => '0');
+            done_tag <= (others => '0');
             stat_done <= '0';
             stat_error <= (others => '0');
         elsif rising_edge(aclk) then
             if ctrl_reset = '1' then
                 main_state <= IDLE;
                 global_enable <= '0';
-                stat_busy <= '0';
+                front_busy <= '0';
+                front_drained <= '0';
+                conv0_busy_d <= '0';
+                back_busy <= '0';
+                frame_seq <= (others => '0');
+                front_tag <= (others => '0');
+                back_tag <= (others => '0');
+                done_tag <= (others => '0');
                 stat_done <= '0';
+                stat_error <= (others => '0');
             else
+                -- Sticky AXI error from the spill, NV12 reader, command queue
+                -- or detection writer
+                if spill_error_s = '1' or nv12_error = '1' or queue_error = '1' or
+                   det_error = '1' then
+                    stat_error(0) <= '1';
+                end if;
+                
+                conv0_busy_d <= conv0_busy_s;
+                
+                -- Back stage: the handed-over frame ends on pool1's last beat
+                if back_done = '1' then
+                    back_busy <= '0';
+                    done_tag <= back_tag;
+                    stat_done <= '1';
+                end if;
+                
                 case main_state is
                     when IDLE =>
-                        stat_done <= '0';
-                        if ctrl_start = '1' then
+                        if back_done = '0' then
+                            stat_done <= '0';
+                        end if;
+                        if run_start = '1' then
                             main_state <= LOAD_WEIGHTS;
-                            stat_busy <= '1';
+                            front_busy <= '1';
+                            front_drained <= '0';
+                            front_tag <= std_logic_vector(frame_seq);
+                            frame_seq <= frame_seq + 1;
                         end if;
                         
                     when LOAD_WEIGHTS =>
-                        -- Weight loading handled by DMA
-                        -- Simplified: assume weights are pre-loaded
-                        main_state <= PROCESS_FRAME;
-                        global_enable <= '1';
+                        -- Parameters are streamed in by the weight DMA;
+                        -- wait for any section in flight to finish
+                        if params_pending = '0' then
+                            main_state <= PROCESS_FRAME;
+                            global_enable <= '1';
+                        end if;
                         
                     when PROCESS_FRAME =>
+                        if conv0_busy_d = '1' and conv0_busy_s = '0' then
+                            front_drained <= '1';
+                        end if;
+                        
                         if ctrl_stop = '1' then
                             main_state <= IDLE;
                             global_enable <= '0';
-                            stat_busy <= '0';
-                        elsif conv1_done = '1' then
-                            main_state <= OUTPUT_RESULT;
-                        end if;
-                        
-                    when OUTPUT_RESULT =>
-                        if pool1_out_tlast = '1' and pool1_out_tvalid = '1' and m_axis_result_tready = '1' then
+                            front_busy <= '0';
+                            back_busy <= '0';
+                        elsif overlap_active = '1' then
+                            if front_drained = '1' and back_busy = '0' then
+                                -- Hand the frame to conv1 and free conv0
+                                back_busy <= '1';
+                                back_tag <= front_tag;
+                                global_enable <= '0';
+                                front_busy <= '0';
+                                main_state <= IDLE;
+                            end if;
+                        elsif frame_eof = '1' then
                             main_state <= DONE;
                         end if;
                         
                     when DONE =>
                         stat_done <= '1';
-                        stat_busy <= '0';
+                        front_busy <= '0';
                         global_enable <= '0';
+                        done_tag <= front_tag;
                         main_state <= IDLE;
                         
                     when others =>
@@ -665,56 +2425,207 @@ begin
     -- ==========================================================================
     -- Performance Counters
     -- ==========================================================================
+    -- PERF_CYCLES counts aclk cycles; the operation and per-layer counters
+    -- run in the compute clock and are read once the frame is done
+    counters_clear <= ctrl_reset or run_start;
+    
     process(aclk, aresetn)
     begin
         if aresetn = '0' then
             cycle_counter <= (others => '0');
-            ops_counter <= (others => '0');
         elsif rising_edge(aclk) then
-            if ctrl_reset = '1' or ctrl_start = '1' then
+            if counters_clear = '1' then
                 cycle_counter <= (others => '0');
-                ops_counter <= (others => '0');
             elsif stat_busy = '1' then
                 cycle_counter <= cycle_counter + 1;
+            end if;
+        end if;
+    end process;
+    
+    process(compute_clk, compute_aresetn)
+    begin
+        if compute_aresetn = '0' then
+            ops_counter <= (others => '0');
+        elsif rising_edge(compute_clk) then
+            if counters_clear_c = '1' then
+                ops_counter <= (others => '0');
+            elsif conv0_out_tvalid = '1' or conv1_out_tvalid = '1' then
                 -- Count MAC operations
-                if conv0_out_tvalid = '1' or conv1_out_tvalid = '1' then
-                    ops_counter <= ops_counter + 9;  -- 3x3 kernel = 9 MACs
-                end if;
+                ops_counter <= ops_counter + 9;  -- 3x3 kernel = 9 MACs
             end if;
         end if;
     end process;
     
     perf_cycles <= std_logic_vector(cycle_counter);
     perf_ops <= std_logic_vector(ops_counter);
+    
+    -- Per conv layer: busy cycles, output stalls (valid held off) and beats
+    layer_busy <= conv1_busy & conv0_busy;
+    layer_stall <= (conv1_out_tvalid and not conv1_out_tready) & (conv0_out_tvalid and not conv0_out_tready);
+    layer_beat <= (conv1_out_tvalid and conv1_out_tready) & (conv0_out_tvalid and conv0_out_tready);
+    
+    gen_layer_perf: for i in 0 to NUM_CONV_LAYERS-1 generate
+        process(compute_clk, compute_aresetn)
+        begin
+            if compute_aresetn = '0' then
+                layer_cycle_cnt(i) <= (others => '0');
+                layer_stall_cnt(i) <= (others => '0');
+                layer_beat_cnt(i) <= (others => '0');
+            elsif rising_edge(compute_clk) then
+                if counters_clear_c = '1' then
+                    layer_cycle_cnt(i) <= (others => '0');
+                    layer_stall_cnt(i) <= (others => '0');
+                    layer_beat_cnt(i) <= (others => '0');
+                else
+                    if layer_busy(i) = '1' then
+                        layer_cycle_cnt(i) <= layer_cycle_cnt(i) + 1;
+                    end if;
+                    if layer_stall(i) = '1' then
+                        layer_stall_cnt(i) <= layer_stall_cnt(i) + 1;
+                    end if;
+                    if layer_beat(i) = '1' then
+                        layer_beat_cnt(i) <= layer_beat_cnt(i) + 1;
+                    end if;
+                end if;
+            end if;
+        end process;
+        
+        layer_cycles(32*i+31 downto 32*i) <= std_logic_vector(layer_cycle_cnt(i));
+        layer_stalls(32*i+31 downto 32*i) <= std_logic_vector(layer_stall_cnt(i));
+        layer_beats(32*i+31 downto 32*i) <= std_logic_vector(layer_beat_cnt(i));
+    end generate;
 
     -- ==========================================================================
-    -- AXI Memory Interface (simplified - directly pass through)
-    -- ==========================================================================
-    -- In a full implementation, this would have a DMA engine for weight loading
-    m_axi_awaddr <= dma_weight_addr;
-    m_axi_awlen <= x"0F";
-    m_axi_awsize <= "011";
-    m_axi_awburst <= "01";
-    m_axi_awvalid <= '0';  -- Not used in this simplified version
-    m_axi_wdata <= (others => '0');
-    m_axi_wstrb <= (others => '0');
-    m_axi_wlast <= '0';
-    m_axi_wvalid <= '0';
-    m_axi_bready <= '1';
-    m_axi_araddr <= dma_input_addr;
-    m_axi_arlen <= x"0F";
-    m_axi_arsize <= "011";
-    m_axi_arburst <= "01";
-    m_axi_arvalid <= '0';
-    m_axi_rready <= '1';
-    
-    -- Weight/bias loading (simplified - would be driven by DMA in full implementation)
-    weight_valid <= '0';
-    weight_data <= (others => '0');
-    weight_addr <= (others => '0');
-    weight_filter <= (others => '0');
-    bias_valid <= '0';
-    bias_data <= (others => '0');
-    bias_addr <= (others => '0');
+    -- Parameter Loading (weight DMA stream -> conv/BN parameter memories)
+    -- ==========================================================================
+    weights_fifo_inst : axis_async_fifo
+        generic map (
+            DATA_W          => 32,
+            DEPTH           => 16
+        )
+        port map (
+            s_clk           => aclk,
+            s_rst_n         => aresetn,
+            s_axis_tdata    => s_axis_weights_tdata,
+            s_axis_tvalid   => s_axis_weights_tvalid,
+            s_axis_tready   => s_axis_weights_tready,
+            s_axis_tlast    => s_axis_weights_tlast,
+            s_axis_tuser    => '0',
+            s_level         => weights_level,
+            s_high_water    => open,
+            s_hwm_clear     => '0',
+            m_clk           => compute_clk,
+            m_rst_n         => compute_aresetn,
+            m_flush         => '0',
+            m_axis_tdata    => wq_tdata,
+            m_axis_tvalid   => wq_tvalid,
+            m_axis_tready   => wq_tready,
+            m_axis_tlast    => wq_tlast,
+            m_axis_tuser    => open
+        );
+    
+    param_loader_inst : axis_param_loader
+        port map (
+            clk             => compute_clk,
+            rst_n           => compute_aresetn,
+            s_axis_tdata    => wq_tdata,
+            s_axis_tvalid   => wq_tvalid,
+            s_axis_tready   => wq_tready,
+            s_axis_tlast    => wq_tlast,
+            weight_valid    => weight_valid,
+            weight_layer    => weight_layer,
+            weight_data     => weight_data,
+            weight_addr     => weight_addr,
+            weight_filter   => weight_filter,
+            bias_valid      => bias_valid,
+            bias_layer      => bias_layer,
+            bias_data       => bias_data,
+            bias_addr       => bias_addr,
+            bn_valid        => bn_valid,
+            bn_layer        => bn_layer,
+            bn_channel      => bn_channel,
+            bn_scale        => bn_scale,
+            bn_bias         => bn_bias,
+            quant_valid     => quant_valid,
+            quant_layer     => quant_layer,
+            quant_channel   => quant_channel,
+            quant_sel       => quant_sel,
+            quant_data      => quant_data,
+            busy            => param_busy,
+            sections_loaded => open
+        );
+    
+    conv0_weight_valid <= weight_valid when weight_layer = x"0" else '0';
+    conv0_bias_valid <= bias_valid when bias_layer = x"0" else '0';
+    conv0_bn_valid <= bn_valid when bn_layer = x"0" else '0';
+    conv1_weight_valid <= weight_valid when weight_layer = x"1" else '0';
+    conv1_bias_valid <= bias_valid when bias_layer = x"1" else '0';
+    conv1_bn_valid <= bn_valid when bn_layer = x"1" else '0';
+    conv0_quant_valid <= quant_valid when quant_layer = x"0" else '0';
+    conv1_quant_valid <= quant_valid when quant_layer = x"1" else '0';
+
+    -- ==========================================================================
+    -- Control and Status Crossings
+    -- ==========================================================================
+    -- Configuration outputs of the register block are shadowed and only
+    -- change while the pipeline is idle, so they feed the compute clock
+    -- directly (max-delay constrained). Pulses and status flags cross here.
+    clear_sync_inst : cdc_pulse
+        port map (
+            src_clk         => aclk,
+            src_rst_n       => aresetn,
+            src_pulse       => counters_clear,
+            dst_clk         => compute_clk,
+            dst_rst_n       => compute_aresetn,
+            dst_pulse       => counters_clear_c
+        );
+    
+    flush_sync_inst : cdc_pulse
+        port map (
+            src_clk         => aclk,
+            src_rst_n       => aresetn,
+            src_pulse       => link_flush,
+            dst_clk         => compute_clk,
+            dst_rst_n       => compute_aresetn,
+            dst_pulse       => link_flush_c
+        );
+    
+    hwm_sync_inst : cdc_pulse
+        port map (
+            src_clk         => aclk,
+            src_rst_n       => aresetn,
+            src_pulse       => link_hwm_clear(1),
+            dst_clk         => compute_clk,
+            dst_rst_n       => compute_aresetn,
+            dst_pulse       => conv1_hwm_clear_c
+        );
+    
+    -- Registered first so the synchronizers never sample a glitch
+    process(compute_clk, compute_aresetn)
+    begin
+        if compute_aresetn = '0' then
+            cstat_c <= (others => '0');
+        elsif rising_edge(compute_clk) then
+            cstat_c <= spill_error & param_busy & conv0_busy;
+        end if;
+    end process;
+    
+    status_sync_inst : cdc_sync
+        generic map (
+            WIDTH           => 3
+        )
+        port map (
+            clk             => aclk,
+            rst_n           => aresetn,
+            d               => cstat_c,
+            q               => cstat_s
+        );
+    
+    conv0_busy_s <= cstat_s(0);
+    param_busy_s <= cstat_s(1);
+    spill_error_s <= cstat_s(2);
+    
+    -- Parameter words still in the crossing FIFO count as loading
+    params_pending <= '1' when param_busy_s = '1' or weights_level /= x"0000" else '0';
 
 end rtl;
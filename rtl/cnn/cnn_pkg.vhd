@@ -22,6 +22,11 @@ package cnn_pkg is
     constant WEIGHT_WIDTH       : integer := 16;
     constant WEIGHT_FRAC_BITS   : integer := 8;
     
+    -- Int8 layers (TFLite scheme): values ride sign-extended in the low byte
+    -- of the 16-bit lanes, accumulate in int32 and requantize per channel
+    constant INT8_WIDTH         : integer := 8;
+    constant QUANT_MULT_WIDTH   : integer := 24;  -- Multiplier, Q0.24
+    
     -- Accumulator width (needs extra bits for MAC operations)
     constant ACC_WIDTH          : integer := 32;
     
@@ -86,6 +91,7 @@ package cnn_pkg is
     constant ACT_SIGMOID        : std_logic_vector(2 downto 0) := "100";
     constant ACT_TANH           : std_logic_vector(2 downto 0) := "101";
     constant ACT_SWISH          : std_logic_vector(2 downto 0) := "110";
+    constant ACT_EXT            : std_logic_vector(2 downto 0) := "111";  -- Build-time table
     
     -- ReLU6 threshold (6.0 in Q8.8)
     constant RELU6_THRESHOLD    : signed(DATA_WIDTH-1 downto 0) := to_signed(6 * 256, DATA_WIDTH);
@@ -93,6 +99,15 @@ package cnn_pkg is
     -- Leaky ReLU alpha (0.01 approximated as 1/128)
     constant LEAKY_ALPHA_SHIFT  : integer := 7;
     
+    -- Piecewise-linear table generators (see pwl_function)
+    type pwl_func_t is (PWL_SIGMOID, PWL_TANH, PWL_GELU, PWL_HSWISH, PWL_EXP);
+    
+    -- Piecewise-linear evaluator depth: table read, multiply-add
+    constant PWL_LATENCY        : integer := 2;
+    
+    -- Activation unit pipeline depth (see activation_unit)
+    constant ACT_LATENCY        : integer := PWL_LATENCY + 2;
+    
     -- ==========================================================================
     -- AXI-Stream Interface
     -- ==========================================================================
@@ -116,6 +131,9 @@ package cnn_pkg is
     -- Line buffer depth (for 3x3 conv on max width)
     constant LINE_BUF_DEPTH     : integer := MAX_IMG_WIDTH;
     
+    -- Line buffer RAM primitive ("block" or "ultra"; "distributed" for tiny rows)
+    constant LINE_BUF_RAM_STYLE : string := "block";
+    
     -- Weight buffer size per filter
     constant WEIGHT_BUF_SIZE    : integer := DEFAULT_KERNEL * DEFAULT_KERNEL * MAX_CHANNELS;
     
@@ -177,6 +195,77 @@ package cnn_pkg is
     constant LAYER_ADD          : std_logic_vector(3 downto 0) := "0110";  -- Skip connection
     constant LAYER_CONCAT       : std_logic_vector(3 downto 0) := "0111";
     
+    -- ==========================================================================
+    -- Parameter Stream Format (weight DMA -> axis_param_loader)
+    -- ==========================================================================
+    -- Header word:  [31:28] section, [27:24] conv layer, [23:16] filter/start
+    --               channel, [15:0] number of values in the section
+    -- Payload:      weights/biases packed two 16-bit values per word (low half
+    --               first); batchnorm one channel per word (scale low, bias high);
+    --               int8 weights four per word (low byte first); quantization
+    --               two words per channel (int32 bias, then [23:0] multiplier
+    --               Q0.24 and [31:24] signed shift), counted in words; sparse
+    --               weights in groups of 32 taps, each a bitmask word (bit i =
+    --               tap i nonzero) followed by the group's nonzero values two
+    --               per word, the count being the dense number of taps.
+    --               Winograd engines take WINO_WEIGHTS transformed weights
+    --               per input channel in place of the 3x3 kernel
+    
+    constant PARAM_SEC_WEIGHTS  : std_logic_vector(3 downto 0) := "0001";
+    constant PARAM_SEC_BIASES   : std_logic_vector(3 downto 0) := "0010";
+    constant PARAM_SEC_BN       : std_logic_vector(3 downto 0) := "0011";
+    constant PARAM_SEC_WEIGHTS8 : std_logic_vector(3 downto 0) := "0100";
+    constant PARAM_SEC_QUANT    : std_logic_vector(3 downto 0) := "0101";
+    constant PARAM_SEC_SPARSE   : std_logic_vector(3 downto 0) := "0110";
+    
+    -- Batchnorm pipeline depth (see batchnorm_unit)
+    constant BN_LATENCY         : integer := 3;
+    
+    -- Winograd F(2x2,3x3): 4x4 input tiles, 16 transformed weights per
+    -- input channel (U = G g G^T in Q6.10, exact for the 1/2 and 1/4 terms of G)
+    constant WINO_TILE          : integer := 4;
+    constant WINO_WEIGHTS       : integer := 16;
+    constant WINO_WEIGHT_FRAC_BITS : integer := 10;
+    
+    -- Result pairs kept by the top-K unit (AXI-Lite 0x8C onwards)
+    constant TOPK_K             : integer := 5;
+    
+    -- Boxes written per frame by the NMS unit (CNN_MAX_DETECTIONS)
+    constant NMS_MAX_DET        : integer := 20;
+    
+    -- Int8 requantization depth: multiply, round / shift / clamp
+    constant REQUANT_LATENCY    : integer := 2;
+    
+    -- ==========================================================================
+    -- Core Identification (AXI-Lite bank 1)
+    -- ==========================================================================
+    
+    constant CNN_CORE_ID        : std_logic_vector(31 downto 0) := x"434E4E41";  -- "CNNA"
+    constant CNN_CORE_VERSION   : std_logic_vector(31 downto 0) := x"02000000";  -- 2.0.0
+    
+    -- Capability bits, set per build by the top level
+    constant CAP_BATCHNORM      : integer := 0;   -- Inline BN stage
+    constant CAP_FUSED_POOL     : integer := 1;   -- Pooling inside the conv engines
+    constant CAP_TILING         : integer := 2;   -- Feature-map spill / stripes
+    constant CAP_FRAME_BUFFER   : integer := 3;
+    constant CAP_SCALER         : integer := 4;   -- Input crop / downscale
+    constant CAP_NORM           : integer := 5;   -- Per-channel normalization
+    constant CAP_YUV            : integer := 6;   -- YUV 4:2:2 stream input
+    constant CAP_NV12           : integer := 7;   -- NV12 frames from DDR
+    constant CAP_CMD_RING       : integer := 8;
+    constant CAP_IRQ_COALESCE   : integer := 9;
+    constant CAP_LAYER_CFG      : integer := 10;  -- Per-layer config / telemetry bank
+    constant CAP_SHADOW_CFG     : integer := 11;  -- Shadowed config with COMMIT
+    constant CAP_STREAMING      : integer := 12;  -- SOF-triggered continuous mode
+    constant CAP_FRAME_OVERLAP  : integer := 13;  -- conv0 / conv1 on consecutive frames
+    constant CAP_LINK_FIFO      : integer := 14;  -- FIFO with high-water mark per layer
+    constant CAP_INT8           : integer := 15;  -- Int8 layers with requantization
+    constant CAP_SPARSE         : integer := 16;  -- Zero-skipping MAC lanes
+    constant CAP_WINOGRAD       : integer := 17;  -- Winograd conv, transformed weights
+    constant CAP_GEMM           : integer := 18;  -- im2col + systolic backend (last layer)
+    constant CAP_TOPK           : integer := 19;  -- Top-K result registers
+    constant CAP_NMS            : integer := 20;  -- Detection decode + NMS to DDR
+    
     -- ==========================================================================
     -- Functions
     -- ==========================================================================
@@ -187,6 +276,9 @@ package cnn_pkg is
     -- Fixed-point multiplication with saturation
     function fp_mult(a : pixel_t; b : weight_t) return acc_t;
     
+    -- Int8 multiplier operand: the low byte of a pixel minus the zero point
+    function int8_operand(a : pixel_t; zp : signed) return signed;
+    
     -- Truncate accumulator to pixel width
     function trunc_acc(acc : acc_t) return pixel_t;
     
@@ -205,6 +297,9 @@ package cnn_pkg is
     -- Calculate output dimension
     function calc_out_dim(in_dim, kernel, stride, pad : integer) return integer;
     
+    -- Select between two integers (for generic-dependent constants)
+    function sel(cond : boolean; a, b : integer) return integer;
+    
 end package cnn_pkg;
 
 package body cnn_pkg is
@@ -235,6 +330,12 @@ package body cnn_pkg is
         return resize(product, ACC_WIDTH);
     end function;
     
+    -- The difference of two int8 values needs 9 bits
+    function int8_operand(a : pixel_t; zp : signed) return signed is
+    begin
+        return resize(a(INT8_WIDTH-1 downto 0), INT8_WIDTH+1) - resize(zp, INT8_WIDTH+1);
+    end function;
+    
     -- Truncate accumulator to pixel width with saturation
     function trunc_acc(acc : acc_t) return pixel_t is
         variable shifted : signed(ACC_WIDTH-1 downto 0);
@@ -305,5 +406,15 @@ package body cnn_pkg is
     begin
         return (in_dim + 2*pad - kernel) / stride + 1;
     end function;
+    
+    -- Select a if cond is true, else b
+    function sel(cond : boolean; a, b : integer) return integer is
+    begin
+        if cond then
+            return a;
+        else
+            return b;
+        end if;
+    end function;
 
 end package body cnn_pkg;
@@ -4,9 +4,22 @@
 -- 
 -- Features:
 --   - Configurable kernel size (1x1, 3x3, 5x5)
---   - Line buffer for streaming convolution
+--   - Block-RAM line buffers with a registered read, cascaded row to row
 --   - Parallel MAC units for high throughput
---   - Integrated bias addition and activation
+--   - Integrated bias addition, batch normalization and activation
+--     (ReLU family plus interpolated sigmoid/tanh/swish/GELU via activation_unit)
+--   - Optional int8 mode (USE_INT8, dense builds): int8 x int8 MACs into
+--     int32 on the Q8.8 tap multipliers, with a per-output-channel
+--     multiplier/shift requantization and clamp
+--   - Optional Winograd F(2x2,3x3) architecture (USE_WINOGRAD): 4x4 input
+--     tiles from three line buffers plus the input row, 16 products per
+--     2x2 output tile on host-transformed weights instead of 36
+--   - Optional sparse build (SPARSE_MACS > 0): a few MAC lanes replace the
+--     tap multipliers and walk the taps of each window, skipping those with
+--     a zero weight or activation on sparse layers; the input is throttled
+--     to the cycles the filter plane needs on the lanes
+--   - Optional fused 2x2/stride-2 pooling (FUSE_POOL) reduced in registers
+--     with a half-width partial row, replacing a separate pooling_engine
 --   - AXI-Stream input/output interfaces
 -- =============================================================================
 
@@ -26,7 +39,13 @@ entity conv2d_engine is
         INPUT_HEIGHT    : integer := 128;
         STRIDE          : integer := 1;
         PADDING         : integer := 1;
-        NUM_MAC_UNITS   : integer := 9     -- Parallel MACs (3x3 kernel)
+        NUM_MAC_UNITS   : integer := 9;    -- Parallel MACs (3x3 kernel)
+        USE_BATCHNORM   : boolean := true;  -- Inline BN stage before activation
+        EXT_ACT_FUNC    : pwl_func_t := PWL_GELU;  -- Table behind ACT_EXT
+        FUSE_POOL       : boolean := false; -- 2x2 pool on the conv output
+        USE_INT8        : boolean := false; -- Int8 datapath selectable per run
+        SPARSE_MACS     : integer := 0;     -- MAC lanes replacing the taps (0 = dense)
+        USE_WINOGRAD    : boolean := false  -- F(2x2,3x3) tiles (3x3, stride 1, even dims)
     );
     port (
         clk             : in  std_logic;
@@ -35,6 +54,12 @@ entity conv2d_engine is
         -- Configuration interface
         cfg_enable      : in  std_logic;
         cfg_activation  : in  std_logic_vector(2 downto 0);
+        cfg_bn_enable   : in  std_logic;
+        cfg_pool_type   : in  std_logic;  -- Fused pool: '0' = max, '1' = average
+        cfg_rows        : in  std_logic_vector(11 downto 0);  -- Rows per frame/stripe (0 = INPUT_HEIGHT)
+        cfg_int8        : in  std_logic;  -- Int8 datapath (USE_INT8 builds only)
+        cfg_sparse      : in  std_logic;  -- Skip zero taps (SPARSE_MACS > 0 builds)
+        cfg_quant       : in  std_logic_vector(31 downto 0);  -- Zero points, clamp
         
         -- Weight loading interface
         weight_valid    : in  std_logic;
@@ -47,6 +72,18 @@ entity conv2d_engine is
         bias_data       : in  std_logic_vector(BIAS_WIDTH-1 downto 0);
         bias_addr       : in  std_logic_vector(7 downto 0);
         
+        -- Batchnorm parameter loading interface
+        bn_valid        : in  std_logic;
+        bn_channel      : in  std_logic_vector(9 downto 0);
+        bn_scale        : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+        bn_bias         : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+        
+        -- Int8 quantization loading interface
+        quant_valid     : in  std_logic;
+        quant_channel   : in  std_logic_vector(7 downto 0);
+        quant_sel       : in  std_logic;  -- '0' = int32 bias, '1' = multiplier/shift
+        quant_data      : in  std_logic_vector(31 downto 0);
+        
         -- AXI-Stream Input
         s_axis_tdata    : in  std_logic_vector(DATA_WIDTH-1 downto 0);
         s_axis_tvalid   : in  std_logic;
@@ -73,18 +110,45 @@ architecture rtl of conv2d_engine is
     constant OUT_WIDTH  : integer := (INPUT_WIDTH + 2*PADDING - KERNEL_SIZE) / STRIDE + 1;
     constant OUT_HEIGHT : integer := (INPUT_HEIGHT + 2*PADDING - KERNEL_SIZE) / STRIDE + 1;
     
-    -- Line buffer signals
-    type line_buf_array_t is array (0 to KERNEL_SIZE-2) of line_buffer_t;
-    signal line_buffers : line_buf_array_t;
-    signal lb_wr_addr   : unsigned(11 downto 0);
+    -- Pipeline depth from window to output: MAC register + optional BN + activation
+    constant MAC_LATENCY : integer := 1;
+    constant PIPE_DEPTH  : integer := MAC_LATENCY + sel(USE_BATCHNORM, BN_LATENCY, 0) + ACT_LATENCY;
+    
+    constant KK          : integer := KERNEL_SIZE * KERNEL_SIZE;
+    
+    -- Winograd builds keep a 4x4 tile (three line buffers for the rows
+    -- above the input row) and 16 transformed weights per input channel
+    constant LB_ROWS     : integer := sel(USE_WINOGRAD, WINO_TILE-1, KERNEL_SIZE-1);
+    constant WEIGHT_DEPTH: integer := sel(USE_WINOGRAD, WINO_WEIGHTS, KK) * INPUT_CHANNELS;
+    
+    -- Line buffer signals: the column is read when a beat is accepted and
+    -- written back (shifted one row down) from the stage register a cycle later
+    type lb_data_array_t is array (0 to LB_ROWS-1) of std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal lb_rd_data   : lb_data_array_t;
+    signal lb_wr_data   : lb_data_array_t;
     signal lb_rd_addr   : unsigned(11 downto 0);
+    signal lb_wr_addr   : unsigned(11 downto 0);
+    signal lb_accept    : std_logic;
+    
+    -- Input stage, aligned with the line buffer read data
+    signal stage_valid  : std_logic;
+    signal stage_data   : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal stage_last   : std_logic;
+    signal stage_user   : std_logic;
+    signal stage_filled : std_logic;  -- Beat completes a full window
     
     -- Sliding window
     signal pixel_window : window_3x3_t;
     signal window_valid : std_logic;
     
+    -- Window strobes for the sparse lanes, which finish a window after it
+    -- has shifted in
+    signal window_new   : std_logic;  -- Window shifted this cycle
+    signal window_last  : std_logic;
+    signal window_user  : std_logic;
+    
     -- Weight memory (BRAM-based)
-    type weight_mem_t is array (0 to KERNEL_SIZE*KERNEL_SIZE*INPUT_CHANNELS-1) of weight_t;
+    type weight_mem_t is array (0 to WEIGHT_DEPTH-1) of weight_t;
     type weight_bank_t is array (0 to OUTPUT_CHANNELS-1) of weight_mem_t;
     signal weight_mem   : weight_bank_t;
     
@@ -93,19 +157,68 @@ architecture rtl of conv2d_engine is
     signal bias_mem     : bias_mem_t;
     
     -- Position counters
+    signal frame_rows   : unsigned(11 downto 0);
     signal x_pos        : unsigned(11 downto 0);
     signal y_pos        : unsigned(11 downto 0);
+    signal beat_x       : unsigned(11 downto 0);  -- Position of the offered beat
+    signal beat_y       : unsigned(11 downto 0);
     signal ch_in        : unsigned(9 downto 0);
     signal ch_out       : unsigned(9 downto 0);
     
     -- MAC accumulator
     signal mac_acc      : acc_t;
     signal mac_result   : pixel_t;
+    signal mac_valid    : std_logic;
+    signal mac_total    : acc_t;  -- Int8: accumulator plus int32 bias
+    
+    -- Tap products, one multiplier per tap for both datapaths
+    type tap_prod_t is array (0 to KK-1) of acc_t;
+    signal tap_prod     : tap_prod_t;
+    
+    -- Int8 mode
+    signal int8_mode    : std_logic;
+    signal zp_in        : signed(INT8_WIDTH-1 downto 0);
+    signal quant_result : pixel_t;
+    type qbias_mem_t is array (0 to OUTPUT_CHANNELS-1) of acc_t;
+    type qmult_mem_t is array (0 to OUTPUT_CHANNELS-1) of std_logic_vector(31 downto 0);
+    signal qbias_mem    : qbias_mem_t;
+    signal qmult_mem    : qmult_mem_t;
+    
+    -- Sparse builds: the taps left for the current window and their partial
+    -- sum; the input waits sparse_cpw cycles per beat
+    signal sparse_mode  : std_logic;
+    signal sparse_rem   : std_logic_vector(KK-1 downto 0);
+    signal sparse_sum   : acc_t;
+    signal sparse_busy  : std_logic;
+    
+    -- Sparse lane issue (combinational): the operands routed this cycle, the
+    -- taps left after it, and whether it closes the window
+    type lane_px_t is array (0 to SPARSE_MACS-1) of pixel_t;
+    type lane_w_t is array (0 to SPARSE_MACS-1) of weight_t;
+    signal lane_px      : lane_px_t;
+    signal lane_w       : lane_w_t;
+    signal sparse_start : std_logic;
+    signal sparse_issue : std_logic;
+    signal sparse_next  : std_logic_vector(KK-1 downto 0);
+    signal sparse_finish : std_logic;
+    signal sparse_cpw   : unsigned(3 downto 0);  -- Cycles per window
+    signal sparse_wait  : unsigned(3 downto 0);
+    
+    -- Winograd output stream (one result per cycle, biased) and drain hold-off
+    signal wino_out     : pixel_t;
+    signal wino_out_valid : std_logic;
+    signal wino_out_last  : std_logic;
+    signal wino_out_user  : std_logic;
+    signal wino_drain   : std_logic;
+    
+    -- Batchnorm stage
+    signal bn_result    : pixel_t;
+    signal act_out      : std_logic_vector(DATA_WIDTH-1 downto 0);
     
     -- Pipeline registers
-    signal pipe_valid   : std_logic_vector(4 downto 0);
-    signal pipe_last    : std_logic_vector(4 downto 0);
-    signal pipe_user    : std_logic_vector(4 downto 0);
+    signal pipe_valid   : std_logic_vector(PIPE_DEPTH-1 downto 0);
+    signal pipe_last    : std_logic_vector(PIPE_DEPTH-1 downto 0);
+    signal pipe_user    : std_logic_vector(PIPE_DEPTH-1 downto 0);
     
     -- FSM states
     type state_t is (IDLE, FILL_BUFFER, CONVOLVE, OUTPUT_RESULT, WAIT_READY);
@@ -119,6 +232,18 @@ architecture rtl of conv2d_engine is
     signal input_ready  : std_logic;
     signal output_valid : std_logic;
     signal frame_done   : std_logic;
+    
+    -- Combine two pool candidates (sum for average, max otherwise)
+    function pool_combine(a, b : signed; avg : std_logic) return signed is
+    begin
+        if avg = '1' then
+            return a + b;
+        elsif b > a then
+            return b;
+        else
+            return a;
+        end if;
+    end function;
 
 begin
 
@@ -133,7 +258,7 @@ begin
             if weight_valid = '1' then
                 filter_idx := to_integer(unsigned(weight_filter));
                 weight_idx := to_integer(unsigned(weight_addr));
-                if filter_idx < OUTPUT_CHANNELS and weight_idx < KERNEL_SIZE*KERNEL_SIZE*INPUT_CHANNELS then
+                if filter_idx < OUTPUT_CHANNELS and weight_idx < WEIGHT_DEPTH then
                     weight_mem(filter_idx)(weight_idx) <= signed(weight_data);
                 end if;
             end if;
@@ -154,39 +279,90 @@ begin
         end if;
     end process;
 
+    -- ==========================================================================
+    -- Int8 Quantization Memory (per output channel)
+    -- ==========================================================================
+    int8_mode <= cfg_int8 when USE_INT8 and SPARSE_MACS = 0 and not USE_WINOGRAD else '0';
+    zp_in <= signed(cfg_quant(7 downto 0));
+    
+    process(clk)
+    begin
+        if rising_edge(clk) then
+            if USE_INT8 and quant_valid = '1' and to_integer(unsigned(quant_channel)) < OUTPUT_CHANNELS then
+                if quant_sel = '0' then
+                    qbias_mem(to_integer(unsigned(quant_channel))) <= signed(quant_data);
+                else
+                    qmult_mem(to_integer(unsigned(quant_channel))) <= quant_data;
+                end if;
+            end if;
+        end if;
+    end process;
+
     -- ==========================================================================
     -- Line Buffer Control
     -- ==========================================================================
+    lb_accept <= s_axis_tvalid and input_ready;
+    
     process(clk, rst_n)
     begin
         if rst_n = '0' then
-            lb_wr_addr <= (others => '0');
             lb_rd_addr <= (others => '0');
+            lb_wr_addr <= (others => '0');
+            stage_valid <= '0';
+            stage_data <= (others => '0');
+            stage_last <= '0';
+            stage_user <= '0';
+            stage_filled <= '0';
         elsif rising_edge(clk) then
-            if s_axis_tvalid = '1' and input_ready = '1' then
-                -- Write to line buffer
-                lb_wr_addr <= lb_wr_addr + 1;
-                if lb_wr_addr = INPUT_WIDTH - 1 then
-                    lb_wr_addr <= (others => '0');
+            stage_valid <= lb_accept;
+            if lb_accept = '1' then
+                -- Column address advances per beat; write-back follows a cycle later
+                lb_wr_addr <= lb_rd_addr;
+                lb_rd_addr <= lb_rd_addr + 1;
+                if lb_rd_addr = INPUT_WIDTH - 1 then
+                    lb_rd_addr <= (others => '0');
+                end if;
+                
+                stage_data <= s_axis_tdata;
+                stage_last <= s_axis_tlast;
+                stage_user <= s_axis_tuser;
+                if beat_y >= KERNEL_SIZE-1 and beat_x >= KERNEL_SIZE-1 then
+                    stage_filled <= '1';
+                else
+                    stage_filled <= '0';
                 end if;
             end if;
         end if;
     end process;
     
-    -- Line buffer shift register (stores previous rows)
-    gen_line_buffers: for i in 0 to KERNEL_SIZE-2 generate
-        process(clk)
-        begin
-            if rising_edge(clk) then
-                if s_axis_tvalid = '1' and input_ready = '1' then
-                    line_buffers(i)(to_integer(lb_wr_addr)) <= signed(s_axis_tdata);
-                end if;
-            end if;
-        end process;
+    -- Line buffers (row i holds the pixel i+1 rows above the input)
+    gen_line_buffers: for i in 0 to LB_ROWS-1 generate
+        gen_first: if i = 0 generate
+            lb_wr_data(i) <= stage_data;
+        end generate;
+        gen_cascade: if i > 0 generate
+            lb_wr_data(i) <= lb_rd_data(i-1);
+        end generate;
+        
+        lb_ram_inst : entity work.line_buffer_ram
+            generic map (
+                DATA_W          => DATA_WIDTH,
+                DEPTH           => LINE_BUF_DEPTH,
+                RAM_STYLE       => LINE_BUF_RAM_STYLE
+            )
+            port map (
+                clk             => clk,
+                wr_en           => stage_valid,
+                wr_addr         => lb_wr_addr,
+                wr_data         => lb_wr_data(i),
+                rd_en           => lb_accept,
+                rd_addr         => lb_rd_addr,
+                rd_data         => lb_rd_data(i)
+            );
     end generate;
 
     -- ==========================================================================
-    -- Sliding Window Generation (3x3)
+    -- Sliding Window Generation (3x3), one cycle behind the accepted beat
     -- ==========================================================================
     process(clk, rst_n)
     begin
@@ -197,8 +373,12 @@ begin
                 end loop;
             end loop;
             window_valid <= '0';
+            window_new <= '0';
+            window_last <= '0';
+            window_user <= '0';
         elsif rising_edge(clk) then
-            if s_axis_tvalid = '1' and input_ready = '1' then
+            window_new <= stage_valid;
+            if stage_valid = '1' then
                 -- Shift window horizontally
                 for i in 0 to 2 loop
                     pixel_window(i, 0) <= pixel_window(i, 1);
@@ -207,24 +387,28 @@ begin
                 
                 -- Load new column from line buffers and input
                 if KERNEL_SIZE >= 3 then
-                    pixel_window(0, 2) <= line_buffers(1)(to_integer(lb_rd_addr));
-                    pixel_window(1, 2) <= line_buffers(0)(to_integer(lb_rd_addr));
+                    pixel_window(0, 2) <= signed(lb_rd_data(1));
+                    pixel_window(1, 2) <= signed(lb_rd_data(0));
                 end if;
-                pixel_window(2, 2) <= signed(s_axis_tdata);
+                pixel_window(2, 2) <= signed(stage_data);
                 
                 -- Window is valid after filling
-                if y_pos >= KERNEL_SIZE-1 and x_pos >= KERNEL_SIZE-1 then
-                    window_valid <= '1';
-                else
-                    window_valid <= '0';
-                end if;
+                window_valid <= stage_filled;
+                window_last <= stage_last;
+                window_user <= stage_user;
             end if;
         end if;
     end process;
 
     -- ==========================================================================
-    -- Position Counter
+    -- Position Counter (a tiled layer sees each row band as its own frame)
     -- ==========================================================================
+    frame_rows <= to_unsigned(INPUT_HEIGHT, 12) when unsigned(cfg_rows) = 0 else unsigned(cfg_rows);
+    
+    -- The start-of-frame beat is column 0 of row 0
+    beat_x <= (others => '0') when s_axis_tuser = '1' else x_pos;
+    beat_y <= (others => '0') when s_axis_tuser = '1' else y_pos;
+    
     process(clk, rst_n)
     begin
         if rst_n = '0' then
@@ -233,16 +417,14 @@ begin
             ch_in <= (others => '0');
             ch_out <= (others => '0');
         elsif rising_edge(clk) then
-            if s_axis_tuser = '1' and s_axis_tvalid = '1' then
-                -- Start of new frame
-                x_pos <= (others => '0');
-                y_pos <= (others => '0');
-                ch_in <= (others => '0');
-            elsif s_axis_tvalid = '1' and input_ready = '1' then
-                -- Advance position
-                if x_pos = INPUT_WIDTH - 1 then
+            if s_axis_tvalid = '1' and input_ready = '1' then
+                -- Advance past the accepted beat
+                if s_axis_tuser = '1' then
+                    ch_in <= (others => '0');
+                end if;
+                if beat_x = INPUT_WIDTH - 1 then
                     x_pos <= (others => '0');
-                    if y_pos = INPUT_HEIGHT - 1 then
+                    if beat_y = frame_rows - 1 then
                         y_pos <= (others => '0');
                         if ch_in = INPUT_CHANNELS - 1 then
                             ch_in <= (others => '0');
@@ -250,73 +432,695 @@ begin
                             ch_in <= ch_in + 1;
                         end if;
                     else
-                        y_pos <= y_pos + 1;
+                        y_pos <= beat_y + 1;
                     end if;
                 else
-                    x_pos <= x_pos + 1;
+                    x_pos <= beat_x + 1;
+                    y_pos <= beat_y;
                 end if;
+            elsif s_axis_tuser = '1' and s_axis_tvalid = '1' then
+                -- Start of new frame offered
+                x_pos <= (others => '0');
+                y_pos <= (others => '0');
+                ch_in <= (others => '0');
             end if;
         end if;
     end process;
 
+    -- ==========================================================================
+    -- Tap Multipliers: one DSP per tap, shared by the two datapaths. Q8.8
+    -- multiplies the pixel by the weight; int8 multiplies the pixel's low
+    -- byte minus the input zero point by the weight's low byte. Sparse
+    -- builds use their lanes instead.
+    -- ==========================================================================
+    gen_taps: if SPARSE_MACS = 0 generate
+        process(int8_mode, pixel_window, weight_mem, ch_in, ch_out, zp_in)
+            variable weight_idx : integer;
+            variable w          : weight_t;
+            variable a          : pixel_t;
+            variable b          : weight_t;
+        begin
+            for ky in 0 to KERNEL_SIZE-1 loop
+                for kx in 0 to KERNEL_SIZE-1 loop
+                    weight_idx := ky * KERNEL_SIZE + kx + to_integer(ch_in) * KK;
+                    w := (others => '0');
+                    if weight_idx < KK*INPUT_CHANNELS then
+                        w := weight_mem(to_integer(ch_out))(weight_idx);
+                    end if;
+                    
+                    if int8_mode = '1' then
+                        a := resize(int8_operand(pixel_window(ky, kx), zp_in), DATA_WIDTH);
+                        b := resize(w(INT8_WIDTH-1 downto 0), WEIGHT_WIDTH);
+                    else
+                        a := pixel_window(ky, kx);
+                        b := w;
+                    end if;
+                    tap_prod(ky * KERNEL_SIZE + kx) <= a * b;
+                end loop;
+            end loop;
+        end process;
+    end generate;
+    
+    gen_no_taps: if SPARSE_MACS > 0 generate
+        tap_prod <= (others => (others => '0'));
+    end generate;
+
     -- ==========================================================================
     -- Convolution MAC Array (3x3 kernel, parallel computation)
     -- ==========================================================================
     process(clk, rst_n)
         variable mac_sum : acc_t;
-        variable weight_idx : integer;
+        variable finish  : std_logic;
+        variable acc     : acc_t;
     begin
         if rst_n = '0' then
             mac_acc <= (others => '0');
             mac_result <= (others => '0');
+            mac_valid <= '0';
+            mac_total <= (others => '0');
+            sparse_rem <= (others => '0');
+            sparse_sum <= (others => '0');
+            sparse_busy <= '0';
         elsif rising_edge(clk) then
-            if window_valid = '1' and cfg_enable = '1' then
-                mac_sum := (others => '0');
-                
-                -- Compute 3x3 convolution (all 9 MACs in parallel)
-                for ky in 0 to KERNEL_SIZE-1 loop
-                    for kx in 0 to KERNEL_SIZE-1 loop
-                        weight_idx := ky * KERNEL_SIZE + kx + to_integer(ch_in) * KERNEL_SIZE * KERNEL_SIZE;
-                        if weight_idx < KERNEL_SIZE*KERNEL_SIZE*INPUT_CHANNELS then
-                            mac_sum := mac_sum + fp_mult(
-                                pixel_window(ky, kx),
-                                weight_mem(to_integer(ch_out))(weight_idx)
-                            );
-                        end if;
+            mac_valid <= '0';
+            finish := '0';
+            mac_sum := (others => '0');
+            
+            if sparse_mode = '1' then
+                -- Accumulate the lanes issued this cycle; a new window starts
+                -- a fresh sum
+                if sparse_issue = '1' then
+                    if sparse_start = '0' then
+                        mac_sum := sparse_sum;
+                    end if;
+                    for l in 0 to SPARSE_MACS-1 loop
+                        mac_sum := mac_sum + fp_mult(lane_px(l), lane_w(l));
                     end loop;
+                    sparse_rem <= sparse_next;
+                    sparse_sum <= mac_sum;
+                    sparse_busy <= not sparse_finish;
+                    finish := sparse_finish;
+                end if;
+            elsif not USE_WINOGRAD and window_valid = '1' and cfg_enable = '1' then
+                -- Compute 3x3 convolution (all 9 tap products in parallel)
+                for t in 0 to KK-1 loop
+                    mac_sum := mac_sum + tap_prod(t);
                 end loop;
-                
+                finish := '1';
+            end if;
+            
+            if finish = '1' then
                 -- Accumulate across input channels
                 if ch_in = 0 then
-                    mac_acc <= mac_sum;
+                    acc := mac_sum;
                 else
-                    mac_acc <= mac_acc + mac_sum;
+                    acc := mac_acc + mac_sum;
                 end if;
+                mac_acc <= acc;
                 
                 -- Final result with bias when all channels processed
+                -- (Q8.8 bias aligned to the Q16.16 accumulator)
                 if ch_in = INPUT_CHANNELS - 1 then
-                    mac_result <= trunc_acc(mac_acc + mac_sum + resize(bias_mem(to_integer(ch_out)), ACC_WIDTH));
+                    mac_result <= trunc_acc(acc + 
+                        shift_left(resize(bias_mem(to_integer(ch_out)), ACC_WIDTH), WEIGHT_FRAC_BITS));
+                    mac_valid <= '1';
+                    if USE_INT8 then
+                        mac_total <= acc + qbias_mem(to_integer(ch_out));
+                    end if;
                 end if;
             end if;
+            
+            -- Winograd results arrive complete, one per cycle
+            if USE_WINOGRAD then
+                mac_result <= wino_out;
+                mac_valid <= wino_out_valid;
+            end if;
         end if;
     end process;
 
     -- ==========================================================================
-    -- Activation Function
+    -- Sparse Input Throttle: one beat per ceil(taps / SPARSE_MACS) cycles,
+    -- counting only the nonzero weights of the current filter plane on a
+    -- sparse layer, so a window's lanes finish before the next one shifts in
+    -- ==========================================================================
+    gen_sparse: if SPARSE_MACS > 0 and not USE_WINOGRAD generate
+        sparse_mode <= '1';
+        
+        -- Lane issue: a new window takes all its taps, or on a sparse layer
+        -- only those with both operands nonzero, then up to SPARSE_MACS of
+        -- them go to the lanes each cycle, lowest first; idle lanes multiply
+        -- zero. sparse_finish marks the cycle the last group issues, so the
+        -- pipeline strobes register on the same edge as mac_result.
+        process(window_new, window_valid, cfg_enable, cfg_sparse, sparse_rem,
+                sparse_busy, pixel_window, weight_mem, ch_in, ch_out)
+            variable taps   : std_logic_vector(KK-1 downto 0);
+            variable lanes  : integer range 0 to KK;
+            variable active : std_logic;
+            variable weight_idx : integer;
+            variable px     : lane_px_t;
+            variable w      : lane_w_t;
+        begin
+            if window_new = '1' and window_valid = '1' and cfg_enable = '1' then
+                for t in 0 to KK-1 loop
+                    weight_idx := t + to_integer(ch_in) * KK;
+                    taps(t) := '0';
+                    if weight_idx < KK*INPUT_CHANNELS then
+                        if cfg_sparse = '0' or
+                           (weight_mem(to_integer(ch_out))(weight_idx) /= 0 and
+                            pixel_window(t / KERNEL_SIZE, t mod KERNEL_SIZE) /= 0) then
+                            taps(t) := '1';
+                        end if;
+                    end if;
+                end loop;
+                active := '1';
+            else
+                taps := sparse_rem;
+                active := sparse_busy;
+            end if;
+            
+            lanes := 0;
+            px := (others => (others => '0'));
+            w := (others => (others => '0'));
+            if active = '1' then
+                for t in 0 to KK-1 loop
+                    weight_idx := t + to_integer(ch_in) * KK;
+                    if taps(t) = '1' and lanes < SPARSE_MACS and weight_idx < KK*INPUT_CHANNELS then
+                        px(lanes) := pixel_window(t / KERNEL_SIZE, t mod KERNEL_SIZE);
+                        w(lanes) := weight_mem(to_integer(ch_out))(weight_idx);
+                        taps(t) := '0';
+                        lanes := lanes + 1;
+                    end if;
+                end loop;
+            end if;
+            
+            lane_px <= px;
+            lane_w <= w;
+            sparse_start <= window_new and window_valid and cfg_enable;
+            sparse_issue <= active;
+            sparse_next <= taps;
+            if active = '1' and unsigned(taps) = 0 then
+                sparse_finish <= '1';
+            else
+                sparse_finish <= '0';
+            end if;
+        end process;
+        
+        process(clk, rst_n)
+            variable cycles : integer range 1 to KK;
+            variable lanes  : integer range 0 to KK;
+            variable weight_idx : integer;
+        begin
+            if rst_n = '0' then
+                sparse_cpw <= to_unsigned(1, 4);
+                sparse_wait <= (others => '0');
+            elsif rising_edge(clk) then
+                cycles := 1;
+                lanes := 0;
+                for t in 0 to KK-1 loop
+                    weight_idx := t + to_integer(ch_in) * KK;
+                    if weight_idx < KK*INPUT_CHANNELS then
+                        if cfg_sparse = '0' or weight_mem(to_integer(ch_out))(weight_idx) /= 0 then
+                            if lanes = SPARSE_MACS then
+                                cycles := cycles + 1;
+                                lanes := 1;
+                            else
+                                lanes := lanes + 1;
+                            end if;
+                        end if;
+                    end if;
+                end loop;
+                sparse_cpw <= to_unsigned(cycles, 4);
+                
+                if sparse_mode = '1' and s_axis_tvalid = '1' and input_ready = '1' then
+                    sparse_wait <= sparse_cpw - 1;
+                elsif sparse_wait /= 0 then
+                    sparse_wait <= sparse_wait - 1;
+                end if;
+            end if;
+        end process;
+    end generate;
+    
+    gen_no_sparse: if SPARSE_MACS = 0 or USE_WINOGRAD generate
+        sparse_mode <= '0';
+        sparse_cpw <= to_unsigned(1, 4);
+        sparse_wait <= (others => '0');
+        lane_px <= (others => (others => '0'));
+        lane_w <= (others => (others => '0'));
+        sparse_start <= '0';
+        sparse_issue <= '0';
+        sparse_next <= (others => '0');
+        sparse_finish <= '0';
+    end generate;
+
+    -- ==========================================================================
+    -- Winograd F(2x2,3x3) Tiles (USE_WINOGRAD)
+    --   Y = A^T [ sum over ch_in of U .* (B^T d B) ] A,  U = G g G^T (host)
+    -- A 4x4 input tile completes on every odd column of every odd row and
+    -- yields a 2x2 output tile: the top pair is emitted at once, the bottom
+    -- pair waits in a row RAM and is emitted at the same columns of the next
+    -- (even) row, which keeps the outputs in raster order. The last tile row
+    -- of a frame is drained with the input held off.
+    -- Each tile takes 16 products, done as two halves on 8 multipliers since
+    -- tiles are at least two beats apart.
+    -- ==========================================================================
+    gen_winograd: if USE_WINOGRAD generate
+        constant TILES      : integer := (INPUT_WIDTH - 2) / 2;  -- Tiles per tile row
+        
+        type wino_tile_t is array (0 to WINO_TILE-1, 0 to WINO_TILE-1) of pixel_t;
+        subtype wino_v_t is signed(DATA_WIDTH+1 downto 0);
+        type wino_v_array_t is array (0 to WINO_WEIGHTS-1) of wino_v_t;
+        type wino_acc_array_t is array (0 to WINO_WEIGHTS-1) of acc_t;
+        type wino_y_array_t is array (0 to 3) of pixel_t;
+        
+        -- Beat flags, aligned with the input stage
+        signal st_tile      : std_logic;  -- Beat completes a 4x4 tile
+        signal st_flush     : std_logic;  -- Beat releases a stored bottom pair
+        signal st_first     : std_logic;  -- First tile of the frame
+        signal st_final     : std_logic;  -- Last beat of the frame
+        
+        -- Input tile and its token (T)
+        signal tile         : wino_tile_t;
+        signal tk_tile      : std_logic;
+        signal tk_flush     : std_logic;
+        signal tk_last      : std_logic;
+        signal tk_first     : std_logic;
+        signal tk_final     : std_logic;
+        
+        -- Transform / multiply phases (T+1, T+2)
+        signal wino_v       : wino_v_array_t;
+        signal wino_acc     : wino_acc_array_t;
+        signal ph1_tile     : std_logic;
+        signal ph1_flush    : std_logic;
+        signal ph1_last     : std_logic;
+        signal ph1_first    : std_logic;
+        signal ph2_tile     : std_logic;
+        signal ph2_flush    : std_logic;
+        signal ph2_last     : std_logic;
+        signal ph2_first    : std_logic;
+        
+        -- End-of-frame drain
+        signal drain        : std_logic;
+        signal drain_cnt    : unsigned(11 downto 0);
+        signal drain_gap    : std_logic;
+        
+        -- Bottom-pair row RAM
+        signal bot_wr_en    : std_logic;
+        signal bot_wr_addr  : unsigned(11 downto 0);
+        signal bot_wr_data  : std_logic_vector(2*DATA_WIDTH-1 downto 0);
+        signal bot_rd_addr  : unsigned(11 downto 0);
+        signal bot_rd_data  : std_logic_vector(2*DATA_WIDTH-1 downto 0);
+        
+        -- Second output of the pair, emitted a cycle after the first
+        signal held         : std_logic;
+        signal held_data    : pixel_t;
+        signal held_last    : std_logic;
+    begin
+        -- Tile and flush positions, sampled when the beat is accepted
+        process(clk, rst_n)
+        begin
+            if rst_n = '0' then
+                st_tile <= '0';
+                st_flush <= '0';
+                st_first <= '0';
+                st_final <= '0';
+            elsif rising_edge(clk) then
+                if lb_accept = '1' then
+                    st_tile <= '0';
+                    st_flush <= '0';
+                    if beat_x >= WINO_TILE-1 and beat_x(0) = '1' then
+                        if beat_y >= WINO_TILE-1 and beat_y(0) = '1' then
+                            st_tile <= '1';
+                        elsif beat_y >= WINO_TILE and beat_y(0) = '0' then
+                            st_flush <= '1';
+                        end if;
+                    end if;
+                    if beat_x = WINO_TILE-1 and beat_y = WINO_TILE-1 then
+                        st_first <= '1';
+                    else
+                        st_first <= '0';
+                    end if;
+                    if beat_x = INPUT_WIDTH-1 and beat_y = frame_rows-1 then
+                        st_final <= '1';
+                    else
+                        st_final <= '0';
+                    end if;
+                end if;
+            end if;
+        end process;
+        
+        -- Input tile (column 3 newest) and the drain token source
+        process(clk, rst_n)
+        begin
+            if rst_n = '0' then
+                tile <= (others => (others => (others => '0')));
+                tk_tile <= '0';
+                tk_flush <= '0';
+                tk_last <= '0';
+                tk_first <= '0';
+                tk_final <= '0';
+                drain <= '0';
+                drain_cnt <= (others => '0');
+                drain_gap <= '0';
+            elsif rising_edge(clk) then
+                tk_tile <= '0';
+                tk_flush <= '0';
+                tk_last <= '0';
+                tk_first <= '0';
+                tk_final <= '0';
+                
+                if stage_valid = '1' then
+                    for i in 0 to WINO_TILE-1 loop
+                        for j in 0 to WINO_TILE-2 loop
+                            tile(i, j) <= tile(i, j+1);
+                        end loop;
+                    end loop;
+                    tile(0, 3) <= signed(lb_rd_data(2));
+                    tile(1, 3) <= signed(lb_rd_data(1));
+                    tile(2, 3) <= signed(lb_rd_data(0));
+                    tile(3, 3) <= signed(stage_data);
+                    
+                    tk_tile <= st_tile;
+                    tk_flush <= st_flush;
+                    tk_last <= stage_last;
+                    tk_first <= st_first;
+                    tk_final <= st_final and st_tile;
+                end if;
+                
+                -- After the frame's last tile, release its bottom pairs
+                -- every second cycle
+                if tk_final = '1' and cfg_enable = '1' then
+                    drain <= '1';
+                    drain_cnt <= to_unsigned(TILES, 12);
+                    drain_gap <= '1';
+                elsif drain = '1' then
+                    drain_gap <= not drain_gap;
+                    if drain_gap = '0' then
+                        tk_flush <= '1';
+                        if drain_cnt = 1 then
+                            tk_last <= '1';
+                            drain <= '0';
+                        end if;
+                        drain_cnt <= drain_cnt - 1;
+                    end if;
+                end if;
+            end if;
+        end process;
+        
+        wino_drain <= drain;
+        
+        -- Transform, multiply-accumulate in the Winograd domain, output
+        -- transform, emission
+        process(clk, rst_n)
+            variable t    : wino_v_array_t;
+            variable v    : wino_v_array_t;
+            variable a    : wino_v_t;
+            variable u    : weight_t;
+            variable prod : signed(DATA_WIDTH+WEIGHT_WIDTH+1 downto 0);
+            variable m    : wino_acc_array_t;
+            variable s    : wino_acc_array_t;
+            variable y    : wino_y_array_t;
+            variable bias : acc_t;
+            variable base : integer;
+            variable hi   : integer;
+        begin
+            if rst_n = '0' then
+                wino_v <= (others => (others => '0'));
+                wino_acc <= (others => (others => '0'));
+                ph1_tile <= '0';
+                ph1_flush <= '0';
+                ph1_last <= '0';
+                ph1_first <= '0';
+                ph2_tile <= '0';
+                ph2_flush <= '0';
+                ph2_last <= '0';
+                ph2_first <= '0';
+                bot_wr_en <= '0';
+                bot_wr_addr <= (others => '0');
+                bot_wr_data <= (others => '0');
+                bot_rd_addr <= (others => '0');
+                held <= '0';
+                held_data <= (others => '0');
+                held_last <= '0';
+                wino_out <= (others => '0');
+                wino_out_valid <= '0';
+                wino_out_last <= '0';
+                wino_out_user <= '0';
+            elsif rising_edge(clk) then
+                -- T: input transform V = B^T d B (adds only), rows then columns
+                for j in 0 to 3 loop
+                    t(0*4+j) := resize(tile(0, j), DATA_WIDTH+2) - resize(tile(2, j), DATA_WIDTH+2);
+                    t(1*4+j) := resize(tile(1, j), DATA_WIDTH+2) + resize(tile(2, j), DATA_WIDTH+2);
+                    t(2*4+j) := resize(tile(2, j), DATA_WIDTH+2) - resize(tile(1, j), DATA_WIDTH+2);
+                    t(3*4+j) := resize(tile(1, j), DATA_WIDTH+2) - resize(tile(3, j), DATA_WIDTH+2);
+                end loop;
+                for i in 0 to 3 loop
+                    v(i*4+0) := t(i*4+0) - t(i*4+2);
+                    v(i*4+1) := t(i*4+1) + t(i*4+2);
+                    v(i*4+2) := t(i*4+2) - t(i*4+1);
+                    v(i*4+3) := t(i*4+1) - t(i*4+3);
+                end loop;
+                if tk_tile = '1' then
+                    wino_v <= v;
+                end if;
+                ph1_tile <= tk_tile;
+                ph1_flush <= tk_flush;
+                ph1_last <= tk_last;
+                ph1_first <= tk_first;
+                ph2_tile <= ph1_tile;
+                ph2_flush <= ph1_flush;
+                ph2_last <= ph1_last;
+                ph2_first <= ph1_first;
+                
+                -- T+1 / T+2: eight products per cycle, U in Q6.10 so the
+                -- product is rescaled to the Q16.16 accumulator
+                m := wino_acc;
+                if ph1_tile = '1' or ph2_tile = '1' then
+                    if ph2_tile = '1' then
+                        hi := 1;
+                    else
+                        hi := 0;
+                    end if;
+                    base := to_integer(ch_in) * WINO_WEIGHTS;
+                    for k in 0 to WINO_WEIGHTS/2-1 loop
+                        a := wino_v(hi*WINO_WEIGHTS/2 + k);
+                        u := (others => '0');
+                        if base + hi*WINO_WEIGHTS/2 + k < WINO_WEIGHTS*INPUT_CHANNELS then
+                            u := weight_mem(to_integer(ch_out))(base + hi*WINO_WEIGHTS/2 + k);
+                        end if;
+                        prod := a * u;
+                        m(hi*WINO_WEIGHTS/2 + k) := resize(shift_right(prod,
+                            WINO_WEIGHT_FRAC_BITS - WEIGHT_FRAC_BITS), ACC_WIDTH);
+                        if ch_in /= 0 then
+                            m(hi*WINO_WEIGHTS/2 + k) := m(hi*WINO_WEIGHTS/2 + k) +
+                                                        wino_acc(hi*WINO_WEIGHTS/2 + k);
+                        end if;
+                    end loop;
+                    wino_acc <= m;
+                end if;
+                
+                -- T+2: output transform Y = A^T M A plus bias; the bottom
+                -- pair goes to the row RAM
+                bot_wr_en <= '0';
+                wino_out_valid <= '0';
+                wino_out_last <= '0';
+                wino_out_user <= '0';
+                if bot_wr_en = '1' then
+                    if bot_wr_addr = TILES-1 then
+                        bot_wr_addr <= (others => '0');
+                    else
+                        bot_wr_addr <= bot_wr_addr + 1;
+                    end if;
+                end if;
+                
+                if held = '1' then
+                    wino_out <= held_data;
+                    wino_out_valid <= '1';
+                    wino_out_last <= held_last;
+                    held <= '0';
+                end if;
+                
+                if ch_in = INPUT_CHANNELS - 1 and cfg_enable = '1' then
+                    if ph2_tile = '1' then
+                        for j in 0 to 3 loop
+                            s(0*4+j) := m(0*4+j) + m(1*4+j) + m(2*4+j);
+                            s(1*4+j) := m(1*4+j) - m(2*4+j) - m(3*4+j);
+                        end loop;
+                        bias := shift_left(resize(bias_mem(to_integer(ch_out)), ACC_WIDTH), WEIGHT_FRAC_BITS);
+                        for i in 0 to 1 loop
+                            y(i*2+0) := trunc_acc(s(i*4+0) + s(i*4+1) + s(i*4+2) + bias);
+                            y(i*2+1) := trunc_acc(s(i*4+1) - s(i*4+2) - s(i*4+3) + bias);
+                        end loop;
+                        
+                        wino_out <= y(0);
+                        wino_out_valid <= '1';
+                        wino_out_user <= ph2_first;
+                        held_data <= y(1);
+                        held_last <= ph2_last;
+                        held <= '1';
+                        bot_wr_en <= '1';
+                        bot_wr_data <= std_logic_vector(y(3)) & std_logic_vector(y(2));
+                    elsif ph2_flush = '1' then
+                        wino_out <= signed(bot_rd_data(DATA_WIDTH-1 downto 0));
+                        wino_out_valid <= '1';
+                        held_data <= signed(bot_rd_data(2*DATA_WIDTH-1 downto DATA_WIDTH));
+                        held_last <= ph2_last;
+                        held <= '1';
+                    end if;
+                end if;
+                
+                -- Read address steps once per flush (read issued at T+1)
+                if ph2_flush = '1' then
+                    if bot_rd_addr = TILES-1 then
+                        bot_rd_addr <= (others => '0');
+                    else
+                        bot_rd_addr <= bot_rd_addr + 1;
+                    end if;
+                end if;
+            end if;
+        end process;
+        
+        bot_ram_inst : entity work.line_buffer_ram
+            generic map (
+                DATA_W          => 2*DATA_WIDTH,
+                DEPTH           => LINE_BUF_DEPTH/2,
+                RAM_STYLE       => LINE_BUF_RAM_STYLE
+            )
+            port map (
+                clk             => clk,
+                wr_en           => bot_wr_en,
+                wr_addr         => bot_wr_addr,
+                wr_data         => bot_wr_data,
+                rd_en           => ph1_flush,
+                rd_addr         => bot_rd_addr,
+                rd_data         => bot_rd_data
+            );
+    end generate;
+    
+    gen_no_winograd: if not USE_WINOGRAD generate
+        wino_out <= (others => '0');
+        wino_out_valid <= '0';
+        wino_out_last <= '0';
+        wino_out_user <= '0';
+        wino_drain <= '0';
+    end generate;
+
+    -- ==========================================================================
+    -- Batch Normalization (between bias add and activation)
     -- ==========================================================================
-    process(mac_result, cfg_activation)
+    gen_bn: if USE_BATCHNORM generate
+        signal bn_out       : std_logic_vector(DATA_WIDTH-1 downto 0);
+        signal bypass_d     : feature_slice_t(0 to BN_LATENCY-1);
     begin
-        case cfg_activation is
-            when ACT_RELU =>
-                activated_result <= relu(mac_result);
-            when ACT_RELU6 =>
-                activated_result <= relu6(mac_result);
-            when ACT_LEAKY_RELU =>
-                activated_result <= leaky_relu(mac_result);
-            when others =>
-                activated_result <= mac_result;  -- No activation
-        end case;
-    end process;
+        bn_inst : entity work.batchnorm_unit
+            generic map (
+                NUM_CHANNELS    => OUTPUT_CHANNELS
+            )
+            port map (
+                clk             => clk,
+                rst_n           => rst_n,
+                cfg_enable      => cfg_enable,
+                param_valid     => bn_valid,
+                param_channel   => bn_channel,
+                param_scale     => bn_scale,
+                param_bias      => bn_bias,
+                channel_idx     => std_logic_vector(ch_out),
+                data_in         => std_logic_vector(mac_result),
+                valid_in        => mac_valid,
+                data_out        => bn_out,
+                valid_out       => open
+            );
+        
+        -- Matched-latency bypass when BN is disabled at runtime
+        process(clk)
+        begin
+            if rising_edge(clk) then
+                bypass_d(0) <= mac_result;
+                for i in 1 to BN_LATENCY-1 loop
+                    bypass_d(i) <= bypass_d(i-1);
+                end loop;
+            end if;
+        end process;
+        
+        bn_result <= signed(bn_out) when cfg_bn_enable = '1' else bypass_d(BN_LATENCY-1);
+    end generate;
+    
+    gen_no_bn: if not USE_BATCHNORM generate
+        bn_result <= mac_result;
+    end generate;
+
+    -- ==========================================================================
+    -- Activation Function (fixed ACT_LATENCY for every cfg_activation)
+    -- ==========================================================================
+    act_inst : entity work.activation_unit
+        generic map (
+            LUT_BITS        => 8,
+            EXT_FUNC        => EXT_ACT_FUNC
+        )
+        port map (
+            clk             => clk,
+            rst_n           => rst_n,
+            cfg_activation  => cfg_activation,
+            data_in         => std_logic_vector(bn_result),
+            valid_in        => '1',
+            data_out        => act_out,
+            valid_out       => open
+        );
+    
+    -- Int8 layers bypass the activation unit: the requantizer clamps instead
+    activated_result <= quant_result when int8_mode = '1' else signed(act_out);
+
+    -- ==========================================================================
+    -- Int8 Requantization (TFLite per-channel scheme)
+    --   q = clamp(round(acc * M * 2^(shift - 24)) + zp_out, act_min, act_max)
+    -- Delayed to line up with the activation output
+    -- ==========================================================================
+    gen_int8: if USE_INT8 generate
+        constant PROD_WIDTH : integer := ACC_WIDTH + QUANT_MULT_WIDTH + 1;
+        constant RQ_DELAY   : integer := PIPE_DEPTH - MAC_LATENCY - REQUANT_LATENCY;
+        signal rq_prod      : signed(PROD_WIDTH-1 downto 0);
+        signal rq_rshift    : integer range 1 to PROD_WIDTH-2;
+        signal rq_delay_d   : feature_slice_t(0 to RQ_DELAY);
+    begin
+        process(clk)
+            variable mult    : std_logic_vector(31 downto 0);
+            variable rshift  : integer;
+            variable rounded : signed(PROD_WIDTH-1 downto 0);
+            variable q       : signed(PROD_WIDTH-1 downto 0);
+        begin
+            if rising_edge(clk) then
+                -- Multiply by the channel's Q0.24 multiplier
+                mult := qmult_mem(to_integer(ch_out));
+                rq_prod <= mac_total * signed('0' & mult(QUANT_MULT_WIDTH-1 downto 0));
+                rshift := QUANT_MULT_WIDTH - to_integer(signed(mult(31 downto 24)));
+                if rshift < 1 then
+                    rshift := 1;
+                elsif rshift > PROD_WIDTH-2 then
+                    rshift := PROD_WIDTH-2;
+                end if;
+                rq_rshift <= rshift;
+                
+                -- Round half up, add the output zero point, clamp to the
+                -- activation range
+                rounded := shift_right(rq_prod + shift_left(to_signed(1, PROD_WIDTH), rq_rshift-1), rq_rshift);
+                q := rounded + resize(signed(cfg_quant(15 downto 8)), PROD_WIDTH);
+                if q < resize(signed(cfg_quant(23 downto 16)), PROD_WIDTH) then
+                    q := resize(signed(cfg_quant(23 downto 16)), PROD_WIDTH);
+                elsif q > resize(signed(cfg_quant(31 downto 24)), PROD_WIDTH) then
+                    q := resize(signed(cfg_quant(31 downto 24)), PROD_WIDTH);
+                end if;
+                rq_delay_d(0) <= resize(q, DATA_WIDTH);
+                for i in 1 to RQ_DELAY loop
+                    rq_delay_d(i) <= rq_delay_d(i-1);
+                end loop;
+            end if;
+        end process;
+        
+        quant_result <= rq_delay_d(RQ_DELAY);
+    end generate;
+    
+    gen_no_int8: if not USE_INT8 generate
+        quant_result <= (others => '0');
+    end generate;
 
     -- ==========================================================================
     -- Pipeline Control
@@ -329,14 +1133,28 @@ begin
             pipe_user <= (others => '0');
         elsif rising_edge(clk) then
             -- Shift pipeline
-            pipe_valid(0) <= window_valid and cfg_enable;
-            pipe_valid(4 downto 1) <= pipe_valid(3 downto 0);
-            
-            pipe_last(0) <= s_axis_tlast;
-            pipe_last(4 downto 1) <= pipe_last(3 downto 0);
-            
-            pipe_user(0) <= s_axis_tuser;
-            pipe_user(4 downto 1) <= pipe_user(3 downto 0);
+            if sparse_mode = '1' then
+                pipe_valid(0) <= sparse_finish;
+                pipe_last(0) <= window_last;
+            elsif USE_WINOGRAD then
+                pipe_valid(0) <= wino_out_valid;
+                pipe_last(0) <= wino_out_last;
+            else
+                pipe_valid(0) <= window_valid and cfg_enable;
+                pipe_last(0) <= stage_last;
+            end if;
+            if sparse_mode = '1' then
+                pipe_user(0) <= window_user;
+            elsif USE_WINOGRAD then
+                pipe_user(0) <= wino_out_user;
+            else
+                pipe_user(0) <= stage_user;
+            end if;
+            for i in 1 to PIPE_DEPTH-1 loop
+                pipe_valid(i) <= pipe_valid(i-1);
+                pipe_last(i) <= pipe_last(i-1);
+                pipe_user(i) <= pipe_user(i-1);
+            end loop;
         end if;
     end process;
 
@@ -353,7 +1171,7 @@ begin
     end process;
     
     process(state, cfg_enable, s_axis_tvalid, s_axis_tuser, window_valid, 
-            m_axis_tready, y_pos, x_pos, ch_out)
+            m_axis_tready, y_pos, x_pos, ch_out, frame_rows)
     begin
         next_state <= state;
         
@@ -369,7 +1187,7 @@ begin
                 end if;
                 
             when CONVOLVE =>
-                if y_pos = INPUT_HEIGHT - 1 and x_pos = INPUT_WIDTH - 1 then
+                if y_pos = frame_rows - 1 and x_pos = INPUT_WIDTH - 1 then
                     next_state <= OUTPUT_RESULT;
                 end if;
                 
@@ -392,17 +1210,112 @@ begin
         end case;
     end process;
 
+    -- ==========================================================================
+    -- Fused 2x2 Pooling (stride 2)
+    -- Even columns hold the left pixel, odd columns reduce the horizontal pair;
+    -- even rows park the pair in a half-width row, odd rows emit the result.
+    -- ==========================================================================
+    gen_fused_pool: if FUSE_POOL generate
+        constant POOL_ROW_LEN : integer := OUT_WIDTH / 2;
+        subtype pool_acc_t is signed(DATA_WIDTH+1 downto 0);
+        type pool_row_t is array (0 to POOL_ROW_LEN-1) of pool_acc_t;
+        signal pool_row     : pool_row_t;
+        signal pool_left    : pool_acc_t;
+        signal pool_col     : unsigned(11 downto 0);
+        signal pool_row_odd : std_logic;
+        signal pool_sof     : std_logic;
+        signal pool_data    : pixel_t;
+        signal pool_valid   : std_logic;
+        signal pool_last    : std_logic;
+        signal pool_user    : std_logic;
+    begin
+        process(clk, rst_n)
+            variable col     : unsigned(11 downto 0);
+            variable row_odd : std_logic;
+            variable pair    : pool_acc_t;
+            variable quad    : pool_acc_t;
+        begin
+            if rst_n = '0' then
+                pool_left <= (others => '0');
+                pool_col <= (others => '0');
+                pool_row_odd <= '0';
+                pool_sof <= '0';
+                pool_data <= (others => '0');
+                pool_valid <= '0';
+                pool_last <= '0';
+                pool_user <= '0';
+            elsif rising_edge(clk) then
+                pool_valid <= '0';
+                
+                if output_valid = '1' then
+                    -- Conv output position (restart on start of frame)
+                    if pipe_user(PIPE_DEPTH-1) = '1' then
+                        col := (others => '0');
+                        row_odd := '0';
+                    else
+                        col := pool_col;
+                        row_odd := pool_row_odd;
+                    end if;
+                    
+                    if col < 2 * POOL_ROW_LEN then
+                        if col(0) = '0' then
+                            pool_left <= resize(activated_result, DATA_WIDTH+2);
+                        else
+                            pair := pool_combine(pool_left, resize(activated_result, DATA_WIDTH+2), cfg_pool_type);
+                            if row_odd = '0' then
+                                pool_row(to_integer(col(11 downto 1))) <= pair;
+                            else
+                                quad := pool_combine(pool_row(to_integer(col(11 downto 1))), pair, cfg_pool_type);
+                                if cfg_pool_type = '1' then
+                                    pool_data <= quad(DATA_WIDTH+1 downto 2);
+                                else
+                                    pool_data <= quad(DATA_WIDTH-1 downto 0);
+                                end if;
+                                pool_valid <= '1';
+                                pool_last <= pipe_last(PIPE_DEPTH-1);
+                                pool_user <= pool_sof or pipe_user(PIPE_DEPTH-1);
+                                pool_sof <= '0';
+                            end if;
+                        end if;
+                    end if;
+                    
+                    if pipe_user(PIPE_DEPTH-1) = '1' then
+                        pool_sof <= '1';
+                    end if;
+                    
+                    -- Advance conv output position
+                    if col = OUT_WIDTH - 1 then
+                        pool_col <= (others => '0');
+                        pool_row_odd <= not row_odd;
+                    else
+                        pool_col <= col + 1;
+                        pool_row_odd <= row_odd;
+                    end if;
+                end if;
+            end if;
+        end process;
+        
+        m_axis_tvalid <= pool_valid;
+        m_axis_tdata <= std_logic_vector(pool_data);
+        m_axis_tlast <= pool_last and pool_valid;
+        m_axis_tuser <= pool_user and pool_valid;
+    end generate;
+
     -- ==========================================================================
     -- Output Assignment
     -- ==========================================================================
-    input_ready <= '1' when (state = FILL_BUFFER or state = CONVOLVE) and cfg_enable = '1' else '0';
+    input_ready <= '1' when (state = FILL_BUFFER or state = CONVOLVE) and cfg_enable = '1' and
+                            sparse_wait = 0 and wino_drain = '0' else '0';
     s_axis_tready <= input_ready;
     
-    output_valid <= pipe_valid(4) and cfg_enable when ch_in = INPUT_CHANNELS - 1 else '0';
-    m_axis_tvalid <= output_valid;
-    m_axis_tdata <= std_logic_vector(activated_result);
-    m_axis_tlast <= pipe_last(4) and output_valid;
-    m_axis_tuser <= pipe_user(4) and output_valid;
+    output_valid <= pipe_valid(PIPE_DEPTH-1) and cfg_enable when ch_in = INPUT_CHANNELS - 1 else '0';
+    
+    gen_stream_out: if not FUSE_POOL generate
+        m_axis_tvalid <= output_valid;
+        m_axis_tdata <= std_logic_vector(activated_result);
+        m_axis_tlast <= pipe_last(PIPE_DEPTH-1) and output_valid;
+        m_axis_tuser <= pipe_user(PIPE_DEPTH-1) and output_valid;
+    end generate;
     
     busy <= '1' when state /= IDLE else '0';
     done <= '1' when state = OUTPUT_RESULT and ch_out = OUTPUT_CHANNELS - 1 else '0';
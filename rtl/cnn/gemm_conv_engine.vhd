@@ -0,0 +1,517 @@
+-- =============================================================================
+-- GEMM Convolution Engine - im2col + Weight-Stationary Systolic Array
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Alternative backend to conv2d_engine for deep, low-resolution layers
+--     (1x1 / 3x3 over many channels): computes GEMM_COLS output channels
+--     per input pass instead of one
+--   - im2col_unit turns each input plane into KERNEL_SIZE^2 columns that a
+--     KERNEL_SIZE^2 x GEMM_COLS systolic array multiplies by the stationary
+--     weights of the current input channel, one column per cycle
+--   - Per-pixel partial sums of the GEMM_COLS channels in a block-RAM
+--     buffer, accumulated across input planes (read-modify-write)
+--   - After the last plane the buffer is read out one output plane at a
+--     time, biased, activated and queued, so the output stays channel-
+--     planar like conv2d_engine's
+--
+-- Same weight/bias load interface and parameter layout as conv2d_engine.
+-- No inline batchnorm (fold BN in the packer). The input planes are
+-- streamed once per block of GEMM_COLS output channels.
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+library work;
+use work.cnn_pkg.all;
+
+entity gemm_conv_engine is
+    generic (
+        KERNEL_SIZE     : integer := 3;     -- 1 or 3
+        INPUT_CHANNELS  : integer := 16;
+        OUTPUT_CHANNELS : integer := 32;    -- Multiple of GEMM_COLS
+        INPUT_WIDTH     : integer := 64;
+        INPUT_HEIGHT    : integer := 64;
+        GEMM_COLS       : integer := 4;     -- Output channels per pass (array columns)
+        EXT_ACT_FUNC    : pwl_func_t := PWL_GELU
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+
+        -- Configuration interface
+        cfg_enable      : in  std_logic;
+        cfg_activation  : in  std_logic_vector(2 downto 0);
+        cfg_rows        : in  std_logic_vector(11 downto 0);  -- Rows per frame/stripe (0 = INPUT_HEIGHT)
+
+        -- Weight loading interface
+        weight_valid    : in  std_logic;
+        weight_data     : in  std_logic_vector(WEIGHT_WIDTH-1 downto 0);
+        weight_addr     : in  std_logic_vector(15 downto 0);
+        weight_filter   : in  std_logic_vector(7 downto 0);
+
+        -- Bias loading interface
+        bias_valid      : in  std_logic;
+        bias_data       : in  std_logic_vector(BIAS_WIDTH-1 downto 0);
+        bias_addr       : in  std_logic_vector(7 downto 0);
+
+        -- AXI-Stream Input
+        s_axis_tdata    : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;
+        s_axis_tuser    : in  std_logic;
+
+        -- AXI-Stream Output
+        m_axis_tdata    : out std_logic_vector(DATA_WIDTH-1 downto 0);
+        m_axis_tvalid   : out std_logic;
+        m_axis_tready   : in  std_logic;
+        m_axis_tlast    : out std_logic;
+        m_axis_tuser    : out std_logic;
+
+        -- Status
+        busy            : out std_logic;
+        done            : out std_logic     -- Last output of the layer accepted
+    );
+end gemm_conv_engine;
+
+architecture rtl of gemm_conv_engine is
+
+    constant KK         : integer := KERNEL_SIZE * KERNEL_SIZE;
+    constant OUT_W      : integer := INPUT_WIDTH - KERNEL_SIZE + 1;
+    constant PASSES     : integer := OUTPUT_CHANNELS / GEMM_COLS;
+    constant MAX_PIX    : integer := OUT_W * (INPUT_HEIGHT - KERNEL_SIZE + 1);
+
+    -- Columns still in the array (and the read-modify-write) after the
+    -- last one of a plane
+    constant DRAIN_CYCLES : integer := KK + GEMM_COLS + 3;
+
+    -- Output queue; reads stop while it could not take the readout pipeline
+    constant OUT_FIFO_DEPTH : integer := 64;
+    constant RO_LATENCY : integer := 2 + ACT_LATENCY;
+
+    -- Weight and bias memories (same layout as conv2d_engine)
+    type weight_mem_t is array (0 to KK*INPUT_CHANNELS-1) of weight_t;
+    type weight_bank_t is array (0 to OUTPUT_CHANNELS-1) of weight_mem_t;
+    signal weight_mem   : weight_bank_t;
+    type bias_mem_t is array (0 to OUTPUT_CHANNELS-1) of bias_t;
+    signal bias_mem     : bias_mem_t;
+
+    -- Sequencing
+    type gstate_t is (G_LOAD, G_STREAM, G_DRAIN, G_READOUT);
+    signal gstate       : gstate_t;
+    signal ci           : unsigned(9 downto 0);
+    signal blk          : unsigned(7 downto 0);
+    signal drain_cnt    : unsigned(7 downto 0);
+    signal release      : std_logic;
+    signal running      : std_logic;
+    signal frame_rows   : unsigned(11 downto 0);
+    signal npix         : unsigned(11 downto 0);
+
+    -- im2col columns
+    signal col_valid    : std_logic;
+    signal col_data     : std_logic_vector(KK*DATA_WIDTH-1 downto 0);
+    signal col_index    : std_logic_vector(11 downto 0);
+    signal col_last     : std_logic;
+
+    -- Systolic array
+    signal w_load       : std_logic;
+    signal w_data       : std_logic_vector(KK*GEMM_COLS*WEIGHT_WIDTH-1 downto 0);
+    signal arr_valid    : std_logic;
+    signal arr_tag      : std_logic_vector(11 downto 0);
+    signal arr_data     : std_logic_vector(GEMM_COLS*ACC_WIDTH-1 downto 0);
+
+    -- Partial-sum buffer
+    signal ps_rd_en     : std_logic;
+    signal ps_rd_addr   : unsigned(11 downto 0);
+    signal ps_rd_data   : std_logic_vector(GEMM_COLS*ACC_WIDTH-1 downto 0);
+    signal ps_wr_en     : std_logic;
+    signal ps_wr_addr   : unsigned(11 downto 0);
+    signal ps_wr_data   : std_logic_vector(GEMM_COLS*ACC_WIDTH-1 downto 0);
+    signal rmw_valid    : std_logic;
+    signal rmw_addr     : unsigned(11 downto 0);
+    signal rmw_data     : std_logic_vector(GEMM_COLS*ACC_WIDTH-1 downto 0);
+
+    -- Readout
+    signal ro_issue     : std_logic;
+    signal ro_pix       : unsigned(11 downto 0);
+    signal ro_x         : unsigned(11 downto 0);
+    signal ro_lane      : unsigned(7 downto 0);
+    signal ro1_valid    : std_logic;
+    signal ro1_lane     : unsigned(7 downto 0);
+    signal ro1_last     : std_logic;
+    signal ro1_user     : std_logic;
+    signal ro1_bias     : acc_t;
+    signal ro2_valid    : std_logic;
+    signal ro2_data     : pixel_t;
+    signal ro2_last     : std_logic;
+    signal ro2_user     : std_logic;
+    signal act_out      : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal act_valid_d  : std_logic_vector(ACT_LATENCY-1 downto 0);
+    signal act_last_d   : std_logic_vector(ACT_LATENCY-1 downto 0);
+    signal act_user_d   : std_logic_vector(ACT_LATENCY-1 downto 0);
+    signal fifo_level   : std_logic_vector(15 downto 0);
+
+    -- Output beat count (done on the last one)
+    signal out_count    : unsigned(19 downto 0);
+    signal out_total    : unsigned(19 downto 0);
+    signal out_valid    : std_logic;
+
+begin
+
+    -- Pixel indices, partial-sum addresses and the readout counter are
+    -- 12 bits wide; every pass covers all output channels in whole blocks
+    assert MAX_PIX <= 2**npix'length and MAX_PIX <= 2**ps_rd_addr'length
+        report "gemm_conv_engine: output pixels per plane exceed the 12-bit pixel index"
+        severity failure;
+    assert OUTPUT_CHANNELS mod GEMM_COLS = 0
+        report "gemm_conv_engine: OUTPUT_CHANNELS must be a multiple of GEMM_COLS"
+        severity failure;
+
+    -- ==========================================================================
+    -- Weight and Bias Memory Write
+    -- ==========================================================================
+    process(clk)
+        variable filter_idx : integer;
+        variable weight_idx : integer;
+    begin
+        if rising_edge(clk) then
+            if weight_valid = '1' then
+                filter_idx := to_integer(unsigned(weight_filter));
+                weight_idx := to_integer(unsigned(weight_addr));
+                if filter_idx < OUTPUT_CHANNELS and weight_idx < KK*INPUT_CHANNELS then
+                    weight_mem(filter_idx)(weight_idx) <= signed(weight_data);
+                end if;
+            end if;
+            if bias_valid = '1' then
+                if to_integer(unsigned(bias_addr)) < OUTPUT_CHANNELS then
+                    bias_mem(to_integer(unsigned(bias_addr))) <= signed(bias_data);
+                end if;
+            end if;
+        end if;
+    end process;
+
+    -- Stationary weights of the current pass / input channel
+    gen_w_rows: for r in 0 to KK-1 generate
+        gen_w_cols: for c in 0 to GEMM_COLS-1 generate
+            w_data((r*GEMM_COLS+c+1)*WEIGHT_WIDTH-1 downto (r*GEMM_COLS+c)*WEIGHT_WIDTH) <=
+                std_logic_vector(weight_mem(to_integer(blk)*GEMM_COLS + c)(to_integer(ci)*KK + r))
+                when to_integer(blk)*GEMM_COLS + c < OUTPUT_CHANNELS and to_integer(ci) < INPUT_CHANNELS
+                else (others => '0');
+        end generate;
+    end generate;
+
+    -- ==========================================================================
+    -- Sequencer: per pass, load weights and take one plane per input channel,
+    -- then read the GEMM_COLS output planes out
+    -- ==========================================================================
+    frame_rows <= to_unsigned(INPUT_HEIGHT, 12) when unsigned(cfg_rows) = 0 else unsigned(cfg_rows);
+
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            gstate <= G_LOAD;
+            ci <= (others => '0');
+            blk <= (others => '0');
+            drain_cnt <= (others => '0');
+            release <= '0';
+            w_load <= '0';
+            running <= '0';
+            npix <= (others => '0');
+            ro_pix <= (others => '0');
+            ro_x <= (others => '0');
+            ro_lane <= (others => '0');
+        elsif rising_edge(clk) then
+            release <= '0';
+            w_load <= '0';
+            npix <= resize(to_unsigned(OUT_W, 12) * (frame_rows - KERNEL_SIZE + 1), 12);
+
+            if col_valid = '1' then
+                running <= '1';
+            end if;
+            if out_valid = '1' and m_axis_tready = '1' and out_count = out_total - 1 then
+                running <= '0';
+            end if;
+
+            case gstate is
+                when G_LOAD =>
+                    if cfg_enable = '1' then
+                        w_load <= '1';
+                        release <= '1';
+                        gstate <= G_STREAM;
+                    end if;
+
+                when G_STREAM =>
+                    if col_valid = '1' and col_last = '1' then
+                        drain_cnt <= to_unsigned(DRAIN_CYCLES, 8);
+                        gstate <= G_DRAIN;
+                    end if;
+
+                when G_DRAIN =>
+                    drain_cnt <= drain_cnt - 1;
+                    if drain_cnt = 1 then
+                        if ci = INPUT_CHANNELS - 1 then
+                            ci <= (others => '0');
+                            ro_pix <= (others => '0');
+                            ro_x <= (others => '0');
+                            ro_lane <= (others => '0');
+                            gstate <= G_READOUT;
+                        else
+                            ci <= ci + 1;
+                            gstate <= G_LOAD;
+                        end if;
+                    end if;
+
+                when G_READOUT =>
+                    if ro_issue = '1' then
+                        if ro_x = OUT_W - 1 then
+                            ro_x <= (others => '0');
+                        else
+                            ro_x <= ro_x + 1;
+                        end if;
+                        if ro_pix = npix - 1 then
+                            ro_pix <= (others => '0');
+                            ro_x <= (others => '0');
+                            if ro_lane = GEMM_COLS - 1 then
+                                -- Next block of output channels
+                                if blk = PASSES - 1 then
+                                    blk <= (others => '0');
+                                else
+                                    blk <= blk + 1;
+                                end if;
+                                gstate <= G_LOAD;
+                            else
+                                ro_lane <= ro_lane + 1;
+                            end if;
+                        else
+                            ro_pix <= ro_pix + 1;
+                        end if;
+                    end if;
+
+                when others =>
+                    gstate <= G_LOAD;
+            end case;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- im2col and Systolic Array
+    -- ==========================================================================
+    im2col_inst : entity work.im2col_unit
+        generic map (
+            KERNEL_SIZE     => KERNEL_SIZE,
+            INPUT_WIDTH     => INPUT_WIDTH,
+            INPUT_HEIGHT    => INPUT_HEIGHT
+        )
+        port map (
+            clk             => clk,
+            rst_n           => rst_n,
+            cfg_rows        => cfg_rows,
+            release         => release,
+            s_axis_tdata    => s_axis_tdata,
+            s_axis_tvalid   => s_axis_tvalid,
+            s_axis_tready   => s_axis_tready,
+            s_axis_tlast    => s_axis_tlast,
+            s_axis_tuser    => s_axis_tuser,
+            col_valid       => col_valid,
+            col_data        => col_data,
+            col_index       => col_index,
+            col_last        => col_last
+        );
+
+    array_inst : entity work.systolic_array
+        generic map (
+            ROWS            => KK,
+            COLS            => GEMM_COLS,
+            TAG_W           => 12
+        )
+        port map (
+            clk             => clk,
+            rst_n           => rst_n,
+            w_load          => w_load,
+            w_data          => w_data,
+            in_valid        => col_valid,
+            in_tag          => col_index,
+            in_data         => col_data,
+            out_valid       => arr_valid,
+            out_tag         => arr_tag,
+            out_data        => arr_data
+        );
+
+    -- ==========================================================================
+    -- Partial-Sum Accumulation: read at the array output, add a cycle later,
+    -- write back the cycle after (each pixel once per plane, no hazard)
+    -- ==========================================================================
+    ps_rd_en <= ro_issue when gstate = G_READOUT else arr_valid;
+    ps_rd_addr <= ro_pix when gstate = G_READOUT else unsigned(arr_tag);
+
+    process(clk, rst_n)
+        variable old : acc_t;
+    begin
+        if rst_n = '0' then
+            rmw_valid <= '0';
+            rmw_addr <= (others => '0');
+            rmw_data <= (others => '0');
+            ps_wr_en <= '0';
+            ps_wr_addr <= (others => '0');
+            ps_wr_data <= (others => '0');
+        elsif rising_edge(clk) then
+            rmw_valid <= arr_valid;
+            rmw_addr <= unsigned(arr_tag);
+            rmw_data <= arr_data;
+
+            ps_wr_en <= rmw_valid;
+            ps_wr_addr <= rmw_addr;
+            for c in 0 to GEMM_COLS-1 loop
+                if ci = 0 then
+                    old := (others => '0');
+                else
+                    old := signed(ps_rd_data((c+1)*ACC_WIDTH-1 downto c*ACC_WIDTH));
+                end if;
+                ps_wr_data((c+1)*ACC_WIDTH-1 downto c*ACC_WIDTH) <= std_logic_vector(
+                    old + signed(rmw_data((c+1)*ACC_WIDTH-1 downto c*ACC_WIDTH)));
+            end loop;
+        end if;
+    end process;
+
+    psum_ram_inst : entity work.line_buffer_ram
+        generic map (
+            DATA_W          => GEMM_COLS*ACC_WIDTH,
+            DEPTH           => MAX_PIX,
+            RAM_STYLE       => "block"
+        )
+        port map (
+            clk             => clk,
+            wr_en           => ps_wr_en,
+            wr_addr         => ps_wr_addr,
+            wr_data         => ps_wr_data,
+            rd_en           => ps_rd_en,
+            rd_addr         => ps_rd_addr,
+            rd_data         => ps_rd_data
+        );
+
+    -- ==========================================================================
+    -- Readout: one output plane per lane, bias, truncate, activate
+    -- ==========================================================================
+    ro_issue <= '1' when gstate = G_READOUT and
+                         unsigned(fifo_level) < OUT_FIFO_DEPTH - RO_LATENCY - 4 else '0';
+
+    process(clk, rst_n)
+        variable ch   : integer;
+        variable lane : integer;
+    begin
+        if rst_n = '0' then
+            ro1_valid <= '0';
+            ro1_lane <= (others => '0');
+            ro1_last <= '0';
+            ro1_user <= '0';
+            ro1_bias <= (others => '0');
+            ro2_valid <= '0';
+            ro2_data <= (others => '0');
+            ro2_last <= '0';
+            ro2_user <= '0';
+            act_valid_d <= (others => '0');
+            act_last_d <= (others => '0');
+            act_user_d <= (others => '0');
+        elsif rising_edge(clk) then
+            ro1_valid <= ro_issue;
+            ro1_lane <= ro_lane;
+            if ro_x = OUT_W - 1 then
+                ro1_last <= '1';
+            else
+                ro1_last <= '0';
+            end if;
+            if ro_pix = 0 then
+                ro1_user <= '1';
+            else
+                ro1_user <= '0';
+            end if;
+
+            -- Q8.8 bias aligned to the Q16.16 accumulator (taken at issue,
+            -- blk moves on with the last read of a pass)
+            ch := to_integer(blk)*GEMM_COLS + to_integer(ro_lane);
+            if ch < OUTPUT_CHANNELS then
+                ro1_bias <= shift_left(resize(bias_mem(ch), ACC_WIDTH), WEIGHT_FRAC_BITS);
+            else
+                ro1_bias <= (others => '0');
+            end if;
+
+            lane := to_integer(ro1_lane);
+            ro2_data <= trunc_acc(signed(ps_rd_data((lane+1)*ACC_WIDTH-1 downto lane*ACC_WIDTH)) + ro1_bias);
+            ro2_valid <= ro1_valid;
+            ro2_last <= ro1_last;
+            ro2_user <= ro1_user;
+
+            act_valid_d <= act_valid_d(ACT_LATENCY-2 downto 0) & ro2_valid;
+            act_last_d <= act_last_d(ACT_LATENCY-2 downto 0) & ro2_last;
+            act_user_d <= act_user_d(ACT_LATENCY-2 downto 0) & ro2_user;
+        end if;
+    end process;
+
+    act_inst : entity work.activation_unit
+        generic map (
+            LUT_BITS        => 8,
+            EXT_FUNC        => EXT_ACT_FUNC
+        )
+        port map (
+            clk             => clk,
+            rst_n           => rst_n,
+            cfg_activation  => cfg_activation,
+            data_in         => std_logic_vector(ro2_data),
+            valid_in        => ro2_valid,
+            data_out        => act_out,
+            valid_out       => open
+        );
+
+    out_fifo_inst : entity work.axis_fifo
+        generic map (
+            DATA_W          => DATA_WIDTH,
+            DEPTH           => OUT_FIFO_DEPTH
+        )
+        port map (
+            clk             => clk,
+            rst_n           => rst_n,
+            flush           => '0',
+            s_axis_tdata    => act_out,
+            s_axis_tvalid   => act_valid_d(ACT_LATENCY-1),
+            s_axis_tready   => open,
+            s_axis_tlast    => act_last_d(ACT_LATENCY-1),
+            s_axis_tuser    => act_user_d(ACT_LATENCY-1),
+            m_axis_tdata    => m_axis_tdata,
+            m_axis_tvalid   => out_valid,
+            m_axis_tready   => m_axis_tready,
+            m_axis_tlast    => m_axis_tlast,
+            m_axis_tuser    => m_axis_tuser,
+            level           => fifo_level,
+            high_water      => open,
+            high_water_clear => '0'
+        );
+
+    m_axis_tvalid <= out_valid;
+
+    -- ==========================================================================
+    -- Status: done on the last output beat of the layer
+    -- ==========================================================================
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            out_count <= (others => '0');
+            out_total <= (others => '0');
+        elsif rising_edge(clk) then
+            out_total <= resize(npix * to_unsigned(OUTPUT_CHANNELS, 8), 20);
+            if out_valid = '1' and m_axis_tready = '1' then
+                if out_count = out_total - 1 then
+                    out_count <= (others => '0');
+                else
+                    out_count <= out_count + 1;
+                end if;
+            end if;
+        end if;
+    end process;
+
+    done <= '1' when out_valid = '1' and m_axis_tready = '1' and out_count = out_total - 1 else '0';
+    busy <= running;
+
+end rtl;
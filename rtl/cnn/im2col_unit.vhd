@@ -0,0 +1,233 @@
+-- =============================================================================
+-- im2col Unit - Sliding-Window Columns for the GEMM Backend
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Turns a pixel stream (one input channel plane per frame) into one
+--     KERNEL_SIZE^2 column per output pixel, tap ky*K+kx, top row first
+--   - Block-RAM line buffers with a registered read, as in conv2d_engine
+--   - Column index within the plane (valid windows only, raster order)
+--   - Holds the input after the last beat of a plane until the consumer
+--     releases the next one, so a new plane never overtakes the array
+--     weights of the previous one
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+library work;
+use work.cnn_pkg.all;
+
+entity im2col_unit is
+    generic (
+        KERNEL_SIZE     : integer := 3;     -- 1 or 3
+        INPUT_WIDTH     : integer := 64;
+        INPUT_HEIGHT    : integer := 64
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+
+        -- Control
+        cfg_rows        : in  std_logic_vector(11 downto 0);  -- Rows per plane (0 = INPUT_HEIGHT)
+        release         : in  std_logic;    -- Accept the next plane
+
+        -- AXI-Stream Input
+        s_axis_tdata    : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;
+        s_axis_tuser    : in  std_logic;
+
+        -- Columns (one per output pixel)
+        col_valid       : out std_logic;
+        col_data        : out std_logic_vector(KERNEL_SIZE*KERNEL_SIZE*DATA_WIDTH-1 downto 0);
+        col_index       : out std_logic_vector(11 downto 0);
+        col_last        : out std_logic     -- Last column of the plane
+    );
+end im2col_unit;
+
+architecture rtl of im2col_unit is
+
+    constant K          : integer := KERNEL_SIZE;
+
+    type lb_data_array_t is array (0 to K-1) of std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal lb_rd_data   : lb_data_array_t;
+    signal lb_wr_data   : lb_data_array_t;
+    signal lb_rd_addr   : unsigned(11 downto 0);
+    signal lb_wr_addr   : unsigned(11 downto 0);
+    signal lb_accept    : std_logic;
+
+    -- Position and plane hold (the SOF beat is column 0 of row 0)
+    signal frame_rows   : unsigned(11 downto 0);
+    signal x_pos        : unsigned(11 downto 0);
+    signal y_pos        : unsigned(11 downto 0);
+    signal beat_x       : unsigned(11 downto 0);
+    signal beat_y       : unsigned(11 downto 0);
+    signal hold         : std_logic;
+
+    -- Input stage, aligned with the line buffer read data
+    signal stage_valid  : std_logic;
+    signal stage_data   : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal stage_filled : std_logic;
+    signal stage_last   : std_logic;
+
+    -- Window
+    type window_t is array (0 to K-1, 0 to K-1) of pixel_t;
+    signal window       : window_t;
+    signal win_valid    : std_logic;
+    signal win_last     : std_logic;
+    signal win_index    : unsigned(11 downto 0);
+    signal next_index   : unsigned(11 downto 0);
+
+begin
+
+    assert (INPUT_WIDTH - K + 1) * (INPUT_HEIGHT - K + 1) <= 2**col_index'length
+        report "im2col_unit: output pixels per plane exceed the col_index range"
+        severity failure;
+
+    frame_rows <= to_unsigned(INPUT_HEIGHT, 12) when unsigned(cfg_rows) = 0 else unsigned(cfg_rows);
+
+    lb_accept <= s_axis_tvalid and not hold;
+    s_axis_tready <= not hold;
+
+    -- ==========================================================================
+    -- Position Counter and Plane Hold
+    -- ==========================================================================
+    beat_x <= (others => '0') when s_axis_tuser = '1' else x_pos;
+    beat_y <= (others => '0') when s_axis_tuser = '1' else y_pos;
+
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            x_pos <= (others => '0');
+            y_pos <= (others => '0');
+            hold <= '1';
+        elsif rising_edge(clk) then
+            if release = '1' then
+                hold <= '0';
+            end if;
+
+            if lb_accept = '1' then
+                if beat_x = INPUT_WIDTH - 1 then
+                    x_pos <= (others => '0');
+                    y_pos <= beat_y + 1;
+                else
+                    x_pos <= beat_x + 1;
+                    y_pos <= beat_y;
+                end if;
+
+                -- Plane complete: wait for the consumer
+                if beat_x = INPUT_WIDTH - 1 and beat_y = frame_rows - 1 then
+                    hold <= '1';
+                end if;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Line Buffers (row i holds the pixel i+1 rows above the input); the
+    -- column is read when a beat is accepted and written back a cycle later
+    -- ==========================================================================
+    lb_rd_addr <= beat_x;
+
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            lb_wr_addr <= (others => '0');
+            stage_valid <= '0';
+            stage_data <= (others => '0');
+            stage_filled <= '0';
+            stage_last <= '0';
+        elsif rising_edge(clk) then
+            stage_valid <= lb_accept;
+            if lb_accept = '1' then
+                lb_wr_addr <= beat_x;
+                stage_data <= s_axis_tdata;
+                if beat_y >= K-1 and beat_x >= K-1 then
+                    stage_filled <= '1';
+                else
+                    stage_filled <= '0';
+                end if;
+                if beat_x = INPUT_WIDTH - 1 and beat_y = frame_rows - 1 then
+                    stage_last <= '1';
+                else
+                    stage_last <= '0';
+                end if;
+            end if;
+        end if;
+    end process;
+
+    gen_line_buffers: for i in 0 to K-2 generate
+        gen_first: if i = 0 generate
+            lb_wr_data(i) <= stage_data;
+        end generate;
+        gen_cascade: if i > 0 generate
+            lb_wr_data(i) <= lb_rd_data(i-1);
+        end generate;
+
+        lb_ram_inst : entity work.line_buffer_ram
+            generic map (
+                DATA_W          => DATA_WIDTH,
+                DEPTH           => LINE_BUF_DEPTH,
+                RAM_STYLE       => LINE_BUF_RAM_STYLE
+            )
+            port map (
+                clk             => clk,
+                wr_en           => stage_valid,
+                wr_addr         => lb_wr_addr,
+                wr_data         => lb_wr_data(i),
+                rd_en           => lb_accept,
+                rd_addr         => lb_rd_addr,
+                rd_data         => lb_rd_data(i)
+            );
+    end generate;
+
+    -- ==========================================================================
+    -- Window and Column Output
+    -- ==========================================================================
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            window <= (others => (others => (others => '0')));
+            win_valid <= '0';
+            win_last <= '0';
+            win_index <= (others => '0');
+            next_index <= (others => '0');
+        elsif rising_edge(clk) then
+            win_valid <= '0';
+            win_last <= '0';
+            if stage_valid = '1' then
+                for ky in 0 to K-1 loop
+                    for kx in 0 to K-2 loop
+                        window(ky, kx) <= window(ky, kx+1);
+                    end loop;
+                end loop;
+                for ky in 0 to K-2 loop
+                    window(ky, K-1) <= signed(lb_rd_data(K-2-ky));
+                end loop;
+                window(K-1, K-1) <= signed(stage_data);
+
+                win_valid <= stage_filled;
+                win_last <= stage_last;
+                if stage_filled = '1' then
+                    win_index <= next_index;
+                    next_index <= next_index + 1;
+                end if;
+                if stage_last = '1' then
+                    next_index <= (others => '0');
+                end if;
+            end if;
+        end if;
+    end process;
+
+    gen_col: for t in 0 to K*K-1 generate
+        col_data((t+1)*DATA_WIDTH-1 downto t*DATA_WIDTH) <= std_logic_vector(window(t / K, t mod K));
+    end generate;
+
+    col_valid <= win_valid;
+    col_index <= std_logic_vector(win_index);
+    col_last <= win_last;
+
+end rtl;
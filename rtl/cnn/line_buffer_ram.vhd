@@ -0,0 +1,65 @@
+-- =============================================================================
+-- Line Buffer RAM (simple dual port, registered read)
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - One image row of DATA_W-bit pixels, written and read once per beat
+--   - Synchronous read into an output register, so the array maps to a
+--     block RAM (or UltraRAM with RAM_STYLE = "ultra") instead of LUTRAM
+--     with a deep read mux
+--   - Separate write and read addresses: the sliding-window engines read a
+--     column when the beat is accepted and write it back one cycle later,
+--     so the two ports never collide on the same address
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+entity line_buffer_ram is
+    generic (
+        DATA_W          : integer := 16;
+        DEPTH           : integer := 224;
+        RAM_STYLE       : string  := "block"
+    );
+    port (
+        clk             : in  std_logic;
+
+        -- Write port
+        wr_en           : in  std_logic;
+        wr_addr         : in  unsigned(11 downto 0);
+        wr_data         : in  std_logic_vector(DATA_W-1 downto 0);
+
+        -- Read port (data valid the cycle after rd_en)
+        rd_en           : in  std_logic;
+        rd_addr         : in  unsigned(11 downto 0);
+        rd_data         : out std_logic_vector(DATA_W-1 downto 0)
+    );
+end line_buffer_ram;
+
+architecture rtl of line_buffer_ram is
+
+    type mem_t is array (0 to DEPTH-1) of std_logic_vector(DATA_W-1 downto 0);
+    signal mem          : mem_t := (others => (others => '0'));
+    attribute ram_style : string;
+    attribute ram_style of mem : signal is RAM_STYLE;
+
+    signal rd_q         : std_logic_vector(DATA_W-1 downto 0) := (others => '0');
+
+begin
+
+    process(clk)
+    begin
+        if rising_edge(clk) then
+            if wr_en = '1' and wr_addr < DEPTH then
+                mem(to_integer(wr_addr)) <= wr_data;
+            end if;
+            if rd_en = '1' and rd_addr < DEPTH then
+                rd_q <= mem(to_integer(rd_addr));
+            end if;
+        end if;
+    end process;
+
+    rd_data <= rd_q;
+
+end rtl;
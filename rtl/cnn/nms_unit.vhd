@@ -0,0 +1,678 @@
+-- =============================================================================
+-- Detection Post-Processing - Box Decode, Score Threshold, Greedy NMS
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Watches the result stream handshake of a detection head: one record of
+--     DET_FIELDS beats per anchor, anchors in raster order over the grid,
+--     one anchor per cell:
+--       score logit, class, tx, ty, tw, th   (Q8.8, class as an integer)
+--   - Decodes each record against its grid cell and the anchor size:
+--       score = sigmoid(logit)
+--       cx = (gx + 0.5 + tx) * cell_w,  w = anchor_w * exp(tw)   (same for y)
+--     sigmoid and exp come from piecewise-linear tables (exp over [-2, 2))
+--   - Keeps the CANDIDATES best-scoring boxes above the score threshold in a
+--     sorted register list (one insertion per cycle)
+--   - After the frame: greedy, class-aware NMS in score order; each
+--     candidate is checked against the boxes kept so far through a pipelined
+--     IoU unit, one pair per cycle, up to MAX_DET kept boxes
+--   - Writes the kept boxes to DDR in one burst (header + 2 beats per box)
+--
+-- Box coordinates are fractions of the image in Q0.16, clamped to [0, 1).
+-- IoU > thr is tested as inter * 256 > thr * union (thr in Q0.8), so no
+-- divider is needed.
+--
+-- DDR layout at cfg_out_addr (64-bit beats, keep it 512-byte aligned so the
+-- burst never crosses 4KB):
+--   beat 0:       [7:0] boxes, [31:16] candidates over threshold,
+--                 [47:32] frame count
+--   beat 1 + 2k:  x_min, y_min, x_max, y_max (16 bits each, Q0.16)
+--   beat 2 + 2k:  [15:0] score (Q8.8), [23:16] class, [47:32] anchor index
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+library work;
+use work.cnn_pkg.all;
+
+entity nms_unit is
+    generic (
+        C_M_AXI_ADDR_WIDTH  : integer := 32;
+        CANDIDATES      : integer := 32;    -- Boxes kept for NMS
+        MAX_DET         : integer := 20     -- Boxes written per frame
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+        flush           : in  std_logic;    -- Drop the frame in progress
+
+        -- Configuration
+        cfg_enable      : in  std_logic;
+        cfg_grid_w      : in  std_logic_vector(7 downto 0);   -- Cells per row
+        cfg_cell_w      : in  std_logic_vector(15 downto 0);  -- 1 / grid width, Q0.16
+        cfg_cell_h      : in  std_logic_vector(15 downto 0);  -- 1 / grid height, Q0.16
+        cfg_anchor_w    : in  std_logic_vector(15 downto 0);  -- Q0.16
+        cfg_anchor_h    : in  std_logic_vector(15 downto 0);  -- Q0.16
+        cfg_score_thr   : in  std_logic_vector(15 downto 0);  -- Probability, Q8.8
+        cfg_iou_thr     : in  std_logic_vector(7 downto 0);   -- Q0.8
+        cfg_out_addr    : in  std_logic_vector(31 downto 0);
+
+        -- Result stream beats (valid and ready already combined)
+        in_valid        : in  std_logic;
+        in_data         : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+        in_eof          : in  std_logic;    -- Last beat of the frame
+
+        -- Status
+        det_count       : out std_logic_vector(7 downto 0);   -- Boxes in the last frame
+        det_candidates  : out std_logic_vector(15 downto 0);  -- Over threshold, last frame
+        busy            : out std_logic;
+        done            : out std_logic;    -- Pulse: boxes of the frame are in DDR
+        axi_error       : out std_logic;
+
+        -- AXI4 Master (write only, 64-bit)
+        m_axi_awaddr    : out std_logic_vector(C_M_AXI_ADDR_WIDTH-1 downto 0);
+        m_axi_awlen     : out std_logic_vector(7 downto 0);
+        m_axi_awsize    : out std_logic_vector(2 downto 0);
+        m_axi_awburst   : out std_logic_vector(1 downto 0);
+        m_axi_awvalid   : out std_logic;
+        m_axi_awready   : in  std_logic;
+        m_axi_wdata     : out std_logic_vector(63 downto 0);
+        m_axi_wstrb     : out std_logic_vector(7 downto 0);
+        m_axi_wlast     : out std_logic;
+        m_axi_wvalid    : out std_logic;
+        m_axi_wready    : in  std_logic;
+        m_axi_bresp     : in  std_logic_vector(1 downto 0);
+        m_axi_bvalid    : in  std_logic;
+        m_axi_bready    : out std_logic
+    );
+end nms_unit;
+
+architecture rtl of nms_unit is
+
+    constant DET_FIELDS     : integer := 6;
+    constant F_SCORE        : integer := 0;
+    constant F_CLASS        : integer := 1;
+    constant F_TX           : integer := 2;
+    constant F_TY           : integer := 3;
+    constant F_TW           : integer := 4;
+    constant F_TH           : integer := 5;
+
+    -- Decode stages after the last field leaves the exp table
+    constant DECODE_DEPTH   : integer := 3;
+    constant IOU_LATENCY    : integer := 4;
+
+    -- Boxes (candidates and kept list)
+    subtype coord_t is unsigned(15 downto 0);
+    type box_t is record
+        score   : pixel_t;
+        class   : unsigned(7 downto 0);
+        x0      : coord_t;
+        y0      : coord_t;
+        x1      : coord_t;
+        y1      : coord_t;
+        area    : unsigned(31 downto 0);
+        anchor  : unsigned(15 downto 0);
+    end record;
+    constant BOX_NONE : box_t := (score => (others => '0'), class => (others => '0'),
+                                  x0 => (others => '0'), y0 => (others => '0'),
+                                  x1 => (others => '0'), y1 => (others => '0'),
+                                  area => (others => '0'), anchor => (others => '0'));
+    type cand_list_t is array (0 to CANDIDATES-1) of box_t;
+    type kept_list_t is array (0 to MAX_DET-1) of box_t;
+
+    -- Record collection
+    signal field        : integer range 0 to DET_FIELDS-1;
+    signal gx           : unsigned(7 downto 0);
+    signal gy           : unsigned(7 downto 0);
+    signal anchor_idx   : unsigned(15 downto 0);
+    signal rec_class    : unsigned(7 downto 0);
+    signal rec_tx       : pixel_t;
+    signal rec_ty       : pixel_t;
+    signal sig_out      : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal exp_out      : std_logic_vector(DATA_WIDTH-1 downto 0);
+    type field_pipe_t is array (0 to PWL_LATENCY-1) of integer range 0 to DET_FIELDS-1;
+    signal field_pipe   : field_pipe_t;
+    signal valid_pipe   : std_logic_vector(PWL_LATENCY-1 downto 0);
+    signal rec_score    : pixel_t;
+    signal rec_ew       : pixel_t;
+
+    -- Record snapshot (taken at the last field)
+    signal p_class      : unsigned(7 downto 0);
+    signal p_tx         : pixel_t;
+    signal p_ty         : pixel_t;
+    signal p_gx         : unsigned(7 downto 0);
+    signal p_gy         : unsigned(7 downto 0);
+    signal p_anchor     : unsigned(15 downto 0);
+
+    -- Decode pipeline
+    signal d1_valid     : std_logic;
+    signal d1_box       : box_t;
+    signal d1_cx        : signed(33 downto 0);
+    signal d1_cy        : signed(33 downto 0);
+    signal d1_w         : unsigned(31 downto 0);
+    signal d1_h         : unsigned(31 downto 0);
+    signal d2_valid     : std_logic;
+    signal d2_box       : box_t;
+    signal d3_valid     : std_logic;
+    signal d3_box       : box_t;
+
+    -- Candidate list (sorted by score, best first)
+    signal cand         : cand_list_t;
+    signal cand_used    : std_logic_vector(CANDIDATES-1 downto 0);
+    signal cand_count   : unsigned(15 downto 0);
+
+    -- NMS
+    type nstate_t is (N_COLLECT, N_SETTLE, N_ISSUE, N_WAIT, N_DECIDE,
+                      N_AW, N_W, N_B);
+    signal nstate       : nstate_t;
+    signal settle_cnt   : unsigned(3 downto 0);
+    signal ci           : integer range 0 to CANDIDATES;
+    signal kj           : integer range 0 to MAX_DET;
+    signal wait_cnt     : unsigned(3 downto 0);
+    signal kept         : kept_list_t;
+    signal n_kept       : integer range 0 to MAX_DET;
+    signal suppressed   : std_logic;
+    signal cur          : box_t;
+
+    -- IoU pipeline (candidate ci against kept kj)
+    signal iou_in_valid : std_logic;
+    signal s1_valid     : std_logic;
+    signal s1_same      : std_logic;
+    signal s1_ix0       : coord_t;
+    signal s1_iy0       : coord_t;
+    signal s1_ix1       : coord_t;
+    signal s1_iy1       : coord_t;
+    signal s1_areas     : unsigned(32 downto 0);
+    signal s2_valid     : std_logic;
+    signal s2_same      : std_logic;
+    signal s2_iw        : coord_t;
+    signal s2_ih        : coord_t;
+    signal s2_areas     : unsigned(32 downto 0);
+    signal s3_valid     : std_logic;
+    signal s3_same      : std_logic;
+    signal s3_inter     : unsigned(32 downto 0);
+    signal s3_areas     : unsigned(32 downto 0);
+    signal s4_valid     : std_logic;
+    signal s4_sup       : std_logic;
+
+    -- DDR write
+    signal w_beat       : integer range 0 to 2*MAX_DET;
+    signal w_last_beat  : integer range 0 to 2*MAX_DET;
+    signal frame_count  : unsigned(15 downto 0);
+    signal r_count      : unsigned(7 downto 0);
+    signal r_candidates : unsigned(15 downto 0);
+    signal done_pulse   : std_logic;
+    signal err          : std_logic;
+
+    function clamp_coord(v : signed(33 downto 0)) return coord_t is
+    begin
+        if v < 0 then
+            return (others => '0');
+        elsif v > 65535 then
+            return to_unsigned(65535, 16);
+        else
+            return unsigned(v(15 downto 0));
+        end if;
+    end function;
+
+    function max_c(a, b : coord_t) return coord_t is
+    begin
+        if a > b then return a; else return b; end if;
+    end function;
+
+    function min_c(a, b : coord_t) return coord_t is
+    begin
+        if a < b then return a; else return b; end if;
+    end function;
+
+begin
+
+    -- ==========================================================================
+    -- Score and Size Tables (every beat goes through both; the right
+    -- outputs are picked by the delayed field index)
+    -- ==========================================================================
+    sig_inst : entity work.pwl_function
+        generic map (
+            FUNC            => PWL_SIGMOID,
+            RANGE_LOG2      => 3,
+            LUT_BITS        => 8
+        )
+        port map (
+            clk             => clk,
+            data_in         => in_data,
+            data_out        => sig_out
+        );
+
+    exp_inst : entity work.pwl_function
+        generic map (
+            FUNC            => PWL_EXP,
+            RANGE_LOG2      => 1,
+            LUT_BITS        => 8
+        )
+        port map (
+            clk             => clk,
+            data_in         => in_data,
+            data_out        => exp_out
+        );
+
+    -- ==========================================================================
+    -- Record Collection
+    -- ==========================================================================
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            field <= 0;
+            gx <= (others => '0');
+            gy <= (others => '0');
+            anchor_idx <= (others => '0');
+            rec_class <= (others => '0');
+            rec_tx <= (others => '0');
+            rec_ty <= (others => '0');
+            field_pipe <= (others => 0);
+            valid_pipe <= (others => '0');
+            rec_score <= (others => '0');
+            rec_ew <= (others => '0');
+            p_class <= (others => '0');
+            p_tx <= (others => '0');
+            p_ty <= (others => '0');
+            p_gx <= (others => '0');
+            p_gy <= (others => '0');
+            p_anchor <= (others => '0');
+        elsif rising_edge(clk) then
+            valid_pipe(0) <= '0';
+            if flush = '1' then
+                field <= 0;
+                gx <= (others => '0');
+                gy <= (others => '0');
+                anchor_idx <= (others => '0');
+            elsif in_valid = '1' and cfg_enable = '1' and nstate = N_COLLECT then
+                valid_pipe(0) <= '1';
+                field_pipe(0) <= field;
+                case field is
+                    when F_CLASS => rec_class <= unsigned(in_data(7 downto 0));
+                    when F_TX    => rec_tx <= signed(in_data);
+                    when F_TY    => rec_ty <= signed(in_data);
+                    when others  => null;
+                end case;
+
+                if field = DET_FIELDS-1 or in_eof = '1' then
+                    field <= 0;
+                    p_class <= rec_class;
+                    p_tx <= rec_tx;
+                    p_ty <= rec_ty;
+                    p_gx <= gx;
+                    p_gy <= gy;
+                    p_anchor <= anchor_idx;
+                    if in_eof = '1' then
+                        gx <= (others => '0');
+                        gy <= (others => '0');
+                        anchor_idx <= (others => '0');
+                    else
+                        anchor_idx <= anchor_idx + 1;
+                        if gx = unsigned(cfg_grid_w) - 1 then
+                            gx <= (others => '0');
+                            gy <= gy + 1;
+                        else
+                            gx <= gx + 1;
+                        end if;
+                    end if;
+                else
+                    field <= field + 1;
+                end if;
+            end if;
+
+            for i in 1 to PWL_LATENCY-1 loop
+                valid_pipe(i) <= valid_pipe(i-1);
+                field_pipe(i) <= field_pipe(i-1);
+            end loop;
+
+            if valid_pipe(PWL_LATENCY-1) = '1' then
+                if field_pipe(PWL_LATENCY-1) = F_SCORE then
+                    rec_score <= signed(sig_out);
+                end if;
+                if field_pipe(PWL_LATENCY-1) = F_TW then
+                    rec_ew <= signed(exp_out);
+                end if;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Box Decode (starts when th leaves the exp table)
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable cx_cells : signed(17 downto 0);
+        variable cy_cells : signed(17 downto 0);
+        variable half_w   : signed(33 downto 0);
+        variable half_h   : signed(33 downto 0);
+        variable b        : box_t;
+    begin
+        if rst_n = '0' then
+            d1_valid <= '0';
+            d1_box <= BOX_NONE;
+            d1_cx <= (others => '0');
+            d1_cy <= (others => '0');
+            d1_w <= (others => '0');
+            d1_h <= (others => '0');
+            d2_valid <= '0';
+            d2_box <= BOX_NONE;
+            d3_valid <= '0';
+            d3_box <= BOX_NONE;
+        elsif rising_edge(clk) then
+            -- D1: centre in cells (Q8.8) scaled by the cell size, size from exp
+            d1_valid <= '0';
+            if valid_pipe(PWL_LATENCY-1) = '1' and field_pipe(PWL_LATENCY-1) = F_TH then
+                if rec_score >= signed(cfg_score_thr) then
+                    d1_valid <= '1';
+                end if;
+            end if;
+            cx_cells := signed(resize(p_gx & x"80", 18)) + resize(p_tx, 18);
+            cy_cells := signed(resize(p_gy & x"80", 18)) + resize(p_ty, 18);
+            d1_cx <= shift_right(resize(cx_cells * signed('0' & cfg_cell_w), 34), 8);
+            d1_cy <= shift_right(resize(cy_cells * signed('0' & cfg_cell_h), 34), 8);
+            d1_w <= shift_right(unsigned(cfg_anchor_w) * unsigned(rec_ew), 8);
+            d1_h <= shift_right(unsigned(cfg_anchor_h) * unsigned(exp_out), 8);
+            d1_box.score <= rec_score;
+            d1_box.class <= p_class;
+            d1_box.anchor <= p_anchor;
+
+            -- D2: corners, clamped to the image
+            d2_valid <= d1_valid;
+            b := d1_box;
+            half_w := signed(resize(shift_right(d1_w, 1), 34));
+            half_h := signed(resize(shift_right(d1_h, 1), 34));
+            b.x0 := clamp_coord(d1_cx - half_w);
+            b.y0 := clamp_coord(d1_cy - half_h);
+            b.x1 := clamp_coord(d1_cx + half_w);
+            b.y1 := clamp_coord(d1_cy + half_h);
+            d2_box <= b;
+
+            -- D3: area for the IoU test
+            d3_valid <= d2_valid;
+            b := d2_box;
+            b.area := (d2_box.x1 - d2_box.x0) * (d2_box.y1 - d2_box.y0);
+            d3_box <= b;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- NMS Sequencer, Candidate List and DDR Write
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable ins    : std_logic_vector(CANDIDATES-1 downto 0);
+    begin
+        if rst_n = '0' then
+            nstate <= N_COLLECT;
+            cand <= (others => BOX_NONE);
+            cand_used <= (others => '0');
+            cand_count <= (others => '0');
+            settle_cnt <= (others => '0');
+            ci <= 0;
+            kj <= 0;
+            wait_cnt <= (others => '0');
+            kept <= (others => BOX_NONE);
+            n_kept <= 0;
+            suppressed <= '0';
+            cur <= BOX_NONE;
+            iou_in_valid <= '0';
+            w_beat <= 0;
+            w_last_beat <= 0;
+            frame_count <= (others => '0');
+            r_count <= (others => '0');
+            r_candidates <= (others => '0');
+            done_pulse <= '0';
+            err <= '0';
+        elsif rising_edge(clk) then
+            done_pulse <= '0';
+            iou_in_valid <= '0';
+
+            -- Insert above-threshold boxes by score, dropping the lowest when
+            -- the list is full
+            if d3_valid = '1' and (nstate = N_COLLECT or nstate = N_SETTLE) then
+                if cand_count /= x"FFFF" then
+                    cand_count <= cand_count + 1;
+                end if;
+                for i in 0 to CANDIDATES-1 loop
+                    if cand_used(i) = '0' or d3_box.score > cand(i).score then
+                        ins(i) := '1';
+                    else
+                        ins(i) := '0';
+                    end if;
+                end loop;
+                for i in 0 to CANDIDATES-1 loop
+                    if ins(i) = '1' then
+                        if i = 0 then
+                            cand(i) <= d3_box;
+                            cand_used(i) <= '1';
+                        elsif ins(i-1) = '0' then
+                            cand(i) <= d3_box;
+                            cand_used(i) <= '1';
+                        else
+                            cand(i) <= cand(i-1);
+                            cand_used(i) <= cand_used(i-1);
+                        end if;
+                    end if;
+                end loop;
+            end if;
+
+            -- IoU results of the pairs in flight
+            if s4_valid = '1' and s4_sup = '1' then
+                suppressed <= '1';
+            end if;
+
+            -- A flush never cuts an AXI transaction short
+            if flush = '1' and nstate /= N_AW and nstate /= N_W and nstate /= N_B then
+                nstate <= N_COLLECT;
+                cand_used <= (others => '0');
+                cand_count <= (others => '0');
+            else
+                case nstate is
+                    when N_COLLECT =>
+                        if in_valid = '1' and in_eof = '1' and cfg_enable = '1' then
+                            settle_cnt <= to_unsigned(PWL_LATENCY + DECODE_DEPTH + 1, 4);
+                            nstate <= N_SETTLE;
+                        end if;
+
+                    when N_SETTLE =>
+                        -- Let the last record through the decode pipeline
+                        settle_cnt <= settle_cnt - 1;
+                        if settle_cnt = 1 then
+                            ci <= 0;
+                            n_kept <= 0;
+                            nstate <= N_DECIDE;
+                            suppressed <= '1';  -- Nothing to keep before candidate 0
+                            cur <= BOX_NONE;
+                        end if;
+
+                    when N_ISSUE =>
+                        -- One (candidate, kept) pair per cycle into the IoU pipe
+                        if kj < n_kept then
+                            iou_in_valid <= '1';
+                            kj <= kj + 1;
+                        else
+                            wait_cnt <= to_unsigned(IOU_LATENCY + 1, 4);
+                            nstate <= N_WAIT;
+                        end if;
+
+                    when N_WAIT =>
+                        wait_cnt <= wait_cnt - 1;
+                        if wait_cnt = 1 then
+                            nstate <= N_DECIDE;
+                        end if;
+
+                    when N_DECIDE =>
+                        -- Keep the box just tested, then move to the next one
+                        if suppressed = '0' and n_kept < MAX_DET then
+                            kept(n_kept) <= cur;
+                            n_kept <= n_kept + 1;
+                        end if;
+                        if ci < CANDIDATES and cand_used(ci mod CANDIDATES) = '1' and
+                           (n_kept < MAX_DET - 1 or (n_kept = MAX_DET - 1 and suppressed = '1')) then
+                            cur <= cand(ci mod CANDIDATES);
+                            ci <= ci + 1;
+                            kj <= 0;
+                            suppressed <= '0';
+                            nstate <= N_ISSUE;
+                        else
+                            nstate <= N_AW;
+                        end if;
+
+                    when N_AW =>
+                        w_beat <= 0;
+                        w_last_beat <= 2 * n_kept;
+                        if m_axi_awready = '1' then
+                            nstate <= N_W;
+                        end if;
+
+                    when N_W =>
+                        if m_axi_wready = '1' then
+                            if w_beat = w_last_beat then
+                                nstate <= N_B;
+                            else
+                                w_beat <= w_beat + 1;
+                            end if;
+                        end if;
+
+                    when N_B =>
+                        if m_axi_bvalid = '1' then
+                            if m_axi_bresp /= "00" then
+                                err <= '1';
+                            end if;
+                            r_count <= to_unsigned(n_kept, 8);
+                            r_candidates <= cand_count;
+                            frame_count <= frame_count + 1;
+                            cand_used <= (others => '0');
+                            cand_count <= (others => '0');
+                            done_pulse <= '1';
+                            nstate <= N_COLLECT;
+                        end if;
+
+                    when others =>
+                        nstate <= N_COLLECT;
+                end case;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- IoU Unit: intersection, its area, then inter * 256 > thr * union
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable kb    : box_t;
+        variable lhs   : unsigned(41 downto 0);
+        variable rhs   : unsigned(41 downto 0);
+    begin
+        if rst_n = '0' then
+            s1_valid <= '0';
+            s1_same <= '0';
+            s1_ix0 <= (others => '0');
+            s1_iy0 <= (others => '0');
+            s1_ix1 <= (others => '0');
+            s1_iy1 <= (others => '0');
+            s1_areas <= (others => '0');
+            s2_valid <= '0';
+            s2_same <= '0';
+            s2_iw <= (others => '0');
+            s2_ih <= (others => '0');
+            s2_areas <= (others => '0');
+            s3_valid <= '0';
+            s3_same <= '0';
+            s3_inter <= (others => '0');
+            s3_areas <= (others => '0');
+            s4_valid <= '0';
+            s4_sup <= '0';
+        elsif rising_edge(clk) then
+            -- S1: intersection rectangle (kj was advanced with the issue)
+            kb := kept((kj - 1) mod MAX_DET);
+            s1_valid <= iou_in_valid;
+            if cur.class = kb.class then
+                s1_same <= '1';
+            else
+                s1_same <= '0';
+            end if;
+            s1_ix0 <= max_c(cur.x0, kb.x0);
+            s1_iy0 <= max_c(cur.y0, kb.y0);
+            s1_ix1 <= min_c(cur.x1, kb.x1);
+            s1_iy1 <= min_c(cur.y1, kb.y1);
+            s1_areas <= resize(cur.area, 33) + resize(kb.area, 33);
+
+            -- S2: clipped width / height
+            s2_valid <= s1_valid;
+            s2_same <= s1_same;
+            if s1_ix1 > s1_ix0 then
+                s2_iw <= s1_ix1 - s1_ix0;
+            else
+                s2_iw <= (others => '0');
+            end if;
+            if s1_iy1 > s1_iy0 then
+                s2_ih <= s1_iy1 - s1_iy0;
+            else
+                s2_ih <= (others => '0');
+            end if;
+            s2_areas <= s1_areas;
+
+            -- S3: intersection area
+            s3_valid <= s2_valid;
+            s3_same <= s2_same;
+            s3_inter <= resize(s2_iw * s2_ih, 33);
+            s3_areas <= s2_areas;
+
+            -- S4: IoU above threshold, same class only
+            lhs := shift_left(resize(s3_inter, 42), 8);
+            rhs := resize(unsigned(cfg_iou_thr) * (s3_areas - s3_inter), 42);
+            s4_valid <= s3_valid;
+            if s3_same = '1' and lhs > rhs then
+                s4_sup <= '1';
+            else
+                s4_sup <= '0';
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- AXI Write Channels
+    -- ==========================================================================
+    m_axi_awaddr <= std_logic_vector(resize(unsigned(cfg_out_addr), C_M_AXI_ADDR_WIDTH));
+    m_axi_awlen <= std_logic_vector(to_unsigned(2 * n_kept, 8));
+    m_axi_awsize <= "011";
+    m_axi_awburst <= "01";
+    m_axi_awvalid <= '1' when nstate = N_AW else '0';
+
+    process(w_beat, n_kept, cand_count, frame_count, kept)
+        variable k : integer range 0 to MAX_DET-1;
+    begin
+        m_axi_wdata <= (others => '0');
+        if w_beat = 0 then
+            m_axi_wdata(7 downto 0) <= std_logic_vector(to_unsigned(n_kept, 8));
+            m_axi_wdata(31 downto 16) <= std_logic_vector(cand_count);
+            m_axi_wdata(47 downto 32) <= std_logic_vector(frame_count);
+        else
+            k := ((w_beat - 1) / 2) mod MAX_DET;
+            if (w_beat mod 2) = 1 then
+                m_axi_wdata <= std_logic_vector(kept(k).y1) & std_logic_vector(kept(k).x1) &
+                               std_logic_vector(kept(k).y0) & std_logic_vector(kept(k).x0);
+            else
+                m_axi_wdata(15 downto 0) <= std_logic_vector(kept(k).score);
+                m_axi_wdata(23 downto 16) <= std_logic_vector(kept(k).class);
+                m_axi_wdata(47 downto 32) <= std_logic_vector(kept(k).anchor);
+            end if;
+        end if;
+    end process;
+
+    m_axi_wstrb <= (others => '1');
+    m_axi_wlast <= '1' when w_beat = w_last_beat else '0';
+    m_axi_wvalid <= '1' when nstate = N_W else '0';
+    m_axi_bready <= '1' when nstate = N_B else '0';
+
+    -- ==========================================================================
+    -- Status
+    -- ==========================================================================
+    det_count <= std_logic_vector(r_count);
+    det_candidates <= std_logic_vector(r_candidates);
+    busy <= '0' when nstate = N_COLLECT else '1';
+    done <= done_pulse;
+    axi_error <= err;
+
+end rtl;
@@ -6,7 +6,7 @@
 --   - Configurable pool size (2x2, 3x3)
 --   - Max pooling and average pooling modes
 --   - Configurable stride
---   - Line buffer based streaming architecture
+--   - Line buffer based streaming architecture (block RAM, registered read)
 -- =============================================================================
 
 library IEEE;
@@ -57,9 +57,10 @@ architecture rtl of pooling_engine is
     constant OUT_WIDTH  : integer := INPUT_WIDTH / STRIDE;
     constant OUT_HEIGHT : integer := INPUT_HEIGHT / STRIDE;
     
-    -- Line buffer for pooling window
-    type line_buf_array_t is array (0 to POOL_SIZE-2) of line_buffer_t;
-    signal line_buffers : line_buf_array_t;
+    -- Line buffers for pooling window (row i holds the pixel i+1 rows above)
+    type lb_data_array_t is array (0 to POOL_SIZE-2) of std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal lb_rd_data   : lb_data_array_t;
+    signal lb_wr_data   : lb_data_array_t;
     
     -- Pooling window (2x2 or 3x3)
     type pool_window_t is array (0 to POOL_SIZE-1, 0 to POOL_SIZE-1) of pixel_t;
@@ -71,8 +72,17 @@ architecture rtl of pooling_engine is
     signal y_pos        : unsigned(11 downto 0);
     signal ch_idx       : unsigned(9 downto 0);
     
-    -- Write address for line buffer
+    -- Line buffer addresses: read on accept, written back a cycle later
+    signal lb_rd_addr   : unsigned(11 downto 0);
     signal lb_wr_addr   : unsigned(11 downto 0);
+    signal lb_accept    : std_logic;
+    
+    -- Input stage, aligned with the line buffer read data
+    signal stage_valid  : std_logic;
+    signal stage_data   : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal stage_last   : std_logic;
+    signal stage_user   : std_logic;
+    signal stage_window : std_logic;  -- Beat lands on a pooling output
     
     -- Pool results
     signal max_result   : pixel_t;
@@ -91,18 +101,55 @@ architecture rtl of pooling_engine is
 begin
 
     -- ==========================================================================
-    -- Line Buffer Write
+    -- Line Buffers (read on accept, cascaded write-back from the input stage)
     -- ==========================================================================
+    lb_accept <= s_axis_tvalid and input_accept;
+    
     gen_line_buffers: for i in 0 to POOL_SIZE-2 generate
-        process(clk)
-        begin
-            if rising_edge(clk) then
-                if s_axis_tvalid = '1' and input_accept = '1' then
-                    line_buffers(i)(to_integer(lb_wr_addr)) <= signed(s_axis_tdata);
-                end if;
-            end if;
-        end process;
+        gen_first: if i = 0 generate
+            lb_wr_data(i) <= stage_data;
+        end generate;
+        gen_cascade: if i > 0 generate
+            lb_wr_data(i) <= lb_rd_data(i-1);
+        end generate;
+        
+        lb_ram_inst : entity work.line_buffer_ram
+            generic map (
+                DATA_W          => DATA_WIDTH,
+                DEPTH           => LINE_BUF_DEPTH,
+                RAM_STYLE       => LINE_BUF_RAM_STYLE
+            )
+            port map (
+                clk             => clk,
+                wr_en           => stage_valid,
+                wr_addr         => lb_wr_addr,
+                wr_data         => lb_wr_data(i),
+                rd_en           => lb_accept,
+                rd_addr         => lb_rd_addr,
+                rd_data         => lb_rd_data(i)
+            );
     end generate;
+    
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            lb_wr_addr <= (others => '0');
+            stage_valid <= '0';
+            stage_data <= (others => '0');
+            stage_last <= '0';
+            stage_user <= '0';
+            stage_window <= '0';
+        elsif rising_edge(clk) then
+            stage_valid <= lb_accept;
+            if lb_accept = '1' then
+                lb_wr_addr <= lb_rd_addr;
+                stage_data <= s_axis_tdata;
+                stage_last <= s_axis_tlast;
+                stage_user <= s_axis_tuser;
+                stage_window <= window_valid;
+            end if;
+        end if;
+    end process;
 
     -- ==========================================================================
     -- Position and Address Counter
@@ -113,20 +160,20 @@ begin
             x_pos <= (others => '0');
             y_pos <= (others => '0');
             ch_idx <= (others => '0');
-            lb_wr_addr <= (others => '0');
+            lb_rd_addr <= (others => '0');
         elsif rising_edge(clk) then
             if s_axis_tuser = '1' and s_axis_tvalid = '1' then
                 -- Start of frame
                 x_pos <= (others => '0');
                 y_pos <= (others => '0');
                 ch_idx <= (others => '0');
-                lb_wr_addr <= (others => '0');
+                lb_rd_addr <= (others => '0');
             elsif s_axis_tvalid = '1' and input_accept = '1' then
-                -- Update write address
-                if lb_wr_addr = INPUT_WIDTH - 1 then
-                    lb_wr_addr <= (others => '0');
+                -- Update line buffer column
+                if lb_rd_addr = INPUT_WIDTH - 1 then
+                    lb_rd_addr <= (others => '0');
                 else
-                    lb_wr_addr <= lb_wr_addr + 1;
+                    lb_rd_addr <= lb_rd_addr + 1;
                 end if;
                 
                 -- Update position
@@ -150,7 +197,7 @@ begin
     end process;
 
     -- ==========================================================================
-    -- Pooling Window Generation
+    -- Pooling Window Generation (one cycle behind the accepted beat)
     -- ==========================================================================
     process(clk, rst_n)
     begin
@@ -161,7 +208,7 @@ begin
                 end loop;
             end loop;
         elsif rising_edge(clk) then
-            if s_axis_tvalid = '1' and input_accept = '1' then
+            if stage_valid = '1' then
                 -- Shift window horizontally
                 for i in 0 to POOL_SIZE-1 loop
                     for j in 0 to POOL_SIZE-2 loop
@@ -171,9 +218,9 @@ begin
                 
                 -- Load new column
                 for i in 0 to POOL_SIZE-2 loop
-                    pool_window(i, POOL_SIZE-1) <= line_buffers(POOL_SIZE-2-i)(to_integer(lb_wr_addr));
+                    pool_window(i, POOL_SIZE-1) <= signed(lb_rd_data(POOL_SIZE-2-i));
                 end loop;
-                pool_window(POOL_SIZE-1, POOL_SIZE-1) <= signed(s_axis_tdata);
+                pool_window(POOL_SIZE-1, POOL_SIZE-1) <= signed(stage_data);
             end if;
         end if;
     end process;
@@ -283,13 +330,13 @@ begin
             last_d <= (others => '0');
             user_d <= (others => '0');
         elsif rising_edge(clk) then
-            valid_d(0) <= window_valid and s_axis_tvalid and cfg_enable;
+            valid_d(0) <= stage_window and stage_valid and cfg_enable;
             valid_d(2 downto 1) <= valid_d(1 downto 0);
             
-            last_d(0) <= s_axis_tlast and window_valid;
+            last_d(0) <= stage_last and stage_window;
             last_d(2 downto 1) <= last_d(1 downto 0);
             
-            user_d(0) <= s_axis_tuser;
+            user_d(0) <= stage_user;
             user_d(2 downto 1) <= user_d(1 downto 0);
         end if;
     end process;
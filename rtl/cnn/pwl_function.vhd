@@ -0,0 +1,180 @@
+-- =============================================================================
+-- Piecewise-Linear Function Evaluator
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Evaluates a smooth activation as y = base[seg] + slope[seg] * dx, where
+-- seg is the upper input bits and dx the offset inside the segment.
+-- The slope/base table is generated at elaboration time from the real-valued
+-- function and maps to a single BRAM18 (2**LUT_BITS x 32 bits).
+--
+-- Input range:  [-2**RANGE_LOG2, 2**RANGE_LOG2) in Q8.8, clamped outside
+-- Latency:      PWL_LATENCY cycles (table read, multiply-add)
+-- Functions with an identity tail (GELU, hard-swish) pass x through above
+-- the table range.
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+use IEEE.MATH_REAL.ALL;
+
+library work;
+use work.cnn_pkg.all;
+
+entity pwl_function is
+    generic (
+        FUNC            : pwl_func_t := PWL_SIGMOID;
+        RANGE_LOG2      : integer := 3;     -- Segments span [-8, 8)
+        LUT_BITS        : integer := 8      -- 256 segments
+    );
+    port (
+        clk             : in  std_logic;
+        data_in         : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+        data_out        : out std_logic_vector(DATA_WIDTH-1 downto 0)
+    );
+end pwl_function;
+
+architecture rtl of pwl_function is
+
+    constant NUM_SEGS   : integer := 2**LUT_BITS;
+    constant DX_BITS    : integer := RANGE_LOG2 + FRAC_BITS + 1 - LUT_BITS;
+    constant SLOPE_FRAC : integer := 12;    -- Slope in Q4.12
+
+    constant X_MIN_Q    : integer := -(2**(RANGE_LOG2 + FRAC_BITS));
+    constant X_MAX_Q    : integer := 2**(RANGE_LOG2 + FRAC_BITS) - 1;
+
+    -- Functions that continue as y = x above the table range
+    constant LINEAR_TAIL : boolean := (FUNC = PWL_GELU) or (FUNC = PWL_HSWISH);
+
+    -- Table entry: [31:16] slope (Q4.12), [15:0] base value (Q8.8)
+    type pwl_table_t is array (0 to NUM_SEGS-1) of std_logic_vector(31 downto 0);
+
+    -- Real-valued reference functions
+    function act_eval(x : real) return real is
+    begin
+        case FUNC is
+            when PWL_SIGMOID =>
+                return 1.0 / (1.0 + exp(-x));
+            when PWL_TANH =>
+                return tanh(x);
+            when PWL_GELU =>
+                return 0.5 * x * (1.0 + tanh(sqrt(2.0 / MATH_PI) * (x + 0.044715 * x * x * x)));
+            when PWL_HSWISH =>
+                return x * realmin(realmax(x + 3.0, 0.0), 6.0) / 6.0;
+            when PWL_EXP =>
+                -- Box size decode; keep RANGE_LOG2 <= 1 so the slope fits Q4.12
+                return exp(x);
+        end case;
+    end function;
+
+    function to_fixed(v : real; frac : integer) return signed is
+        variable q : integer;
+    begin
+        q := integer(round(v * real(2**frac)));
+        if q > 32767 then q := 32767; end if;
+        if q < -32768 then q := -32768; end if;
+        return to_signed(q, 16);
+    end function;
+
+    -- Segment table: base = f(x0), slope = (f(x0 + step) - f(x0)) / step
+    function init_pwl_table return pwl_table_t is
+        variable tbl  : pwl_table_t;
+        variable step : real;
+        variable x0   : real;
+        variable y0   : real;
+        variable y1   : real;
+    begin
+        step := real(2**(RANGE_LOG2 + 1)) / real(NUM_SEGS);
+        for i in 0 to NUM_SEGS-1 loop
+            x0 := -real(2**RANGE_LOG2) + real(i) * step;
+            y0 := act_eval(x0);
+            y1 := act_eval(x0 + step);
+            tbl(i) := std_logic_vector(to_fixed((y1 - y0) / step, SLOPE_FRAC)) &
+                      std_logic_vector(to_fixed(y0, FRAC_BITS));
+        end loop;
+        return tbl;
+    end function;
+
+    signal pwl_table    : pwl_table_t := init_pwl_table;
+    attribute ram_style : string;
+    attribute ram_style of pwl_table : signal is "block";
+
+    -- Address split
+    signal x_clamped    : pixel_t;
+    signal seg_addr     : unsigned(LUT_BITS-1 downto 0);
+    signal dx           : unsigned(DX_BITS-1 downto 0);
+
+    -- Stage 1 registers
+    signal entry_d      : std_logic_vector(31 downto 0);
+    signal dx_d         : unsigned(DX_BITS-1 downto 0);
+    signal x_d          : pixel_t;
+    signal tail_d       : std_logic;
+
+    -- Stage 2 result
+    signal result       : pixel_t;
+
+begin
+
+    -- ==========================================================================
+    -- Clamp and Address Calculation
+    -- ==========================================================================
+    process(data_in)
+        variable x : pixel_t;
+    begin
+        x := signed(data_in);
+        if x < to_signed(X_MIN_Q, DATA_WIDTH) then
+            x_clamped <= to_signed(X_MIN_Q, DATA_WIDTH);
+        elsif x > to_signed(X_MAX_Q, DATA_WIDTH) then
+            x_clamped <= to_signed(X_MAX_Q, DATA_WIDTH);
+        else
+            x_clamped <= x;
+        end if;
+    end process;
+
+    -- Offset-binary segment index (flip MSB), remaining bits are dx
+    seg_addr <= unsigned(not x_clamped(RANGE_LOG2+FRAC_BITS) &
+                x_clamped(RANGE_LOG2+FRAC_BITS-1 downto DX_BITS));
+    dx <= unsigned(x_clamped(DX_BITS-1 downto 0));
+
+    -- ==========================================================================
+    -- Stage 1: Table Read
+    -- ==========================================================================
+    process(clk)
+    begin
+        if rising_edge(clk) then
+            entry_d <= pwl_table(to_integer(seg_addr));
+            dx_d <= dx;
+            x_d <= signed(data_in);
+            if LINEAR_TAIL and signed(data_in) > to_signed(X_MAX_Q, DATA_WIDTH) then
+                tail_d <= '1';
+            else
+                tail_d <= '0';
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Stage 2: Interpolate (single DSP multiply-add)
+    -- ==========================================================================
+    process(clk)
+        variable product : signed(16 + DX_BITS downto 0);
+        variable interp  : signed(DATA_WIDTH downto 0);
+    begin
+        if rising_edge(clk) then
+            product := signed(entry_d(31 downto 16)) * signed('0' & dx_d);
+            interp := resize(signed(entry_d(15 downto 0)), DATA_WIDTH+1) +
+                      resize(shift_right(product, SLOPE_FRAC), DATA_WIDTH+1);
+            if tail_d = '1' then
+                result <= x_d;
+            elsif interp(DATA_WIDTH) /= interp(DATA_WIDTH-1) then
+                -- Saturate on overflow of the interpolated value
+                result <= (DATA_WIDTH-1 => interp(DATA_WIDTH), others => not interp(DATA_WIDTH));
+            else
+                result <= interp(DATA_WIDTH-1 downto 0);
+            end if;
+        end if;
+    end process;
+
+    data_out <= std_logic_vector(result);
+
+end rtl;
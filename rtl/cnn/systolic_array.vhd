@@ -0,0 +1,166 @@
+-- =============================================================================
+-- Weight-Stationary Systolic Array (GEMM core)
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - ROWS x COLS processing elements, one Q8.8 MAC (one DSP48E2) each
+--   - PE (r, c) holds weight W[c][r]: rows index the reduction (im2col
+--     taps), columns the output channels
+--   - Activations enter row r skewed by r cycles and move one column right
+--     per cycle; partial sums move one row down per cycle
+--   - Column results are de-skewed, so all COLS dot products of an input
+--     vector leave together, LATENCY = ROWS + COLS - 1 cycles after it
+--   - A tag (e.g. the pixel index) travels alongside each vector
+--   - Weights are loaded in parallel and must not change while vectors
+--     are in flight
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+library work;
+use work.cnn_pkg.all;
+
+entity systolic_array is
+    generic (
+        ROWS            : integer := 9;
+        COLS            : integer := 4;
+        TAG_W           : integer := 12
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+
+        -- Stationary weights, PE (r, c) at index r*COLS + c
+        w_load          : in  std_logic;
+        w_data          : in  std_logic_vector(ROWS*COLS*WEIGHT_WIDTH-1 downto 0);
+
+        -- Input vectors (element r at [r*DATA_WIDTH +: DATA_WIDTH])
+        in_valid        : in  std_logic;
+        in_tag          : in  std_logic_vector(TAG_W-1 downto 0);
+        in_data         : in  std_logic_vector(ROWS*DATA_WIDTH-1 downto 0);
+
+        -- Dot products, Q16.16 (column c at [c*ACC_WIDTH +: ACC_WIDTH])
+        out_valid       : out std_logic;
+        out_tag         : out std_logic_vector(TAG_W-1 downto 0);
+        out_data        : out std_logic_vector(COLS*ACC_WIDTH-1 downto 0)
+    );
+end systolic_array;
+
+architecture rtl of systolic_array is
+
+    constant LATENCY    : integer := ROWS + COLS - 1;
+
+    type pe_act_t is array (0 to ROWS-1, 0 to COLS-1) of pixel_t;
+    type pe_weight_t is array (0 to ROWS-1, 0 to COLS-1) of weight_t;
+    type pe_sum_t is array (0 to ROWS-1, 0 to COLS-1) of acc_t;
+    type skew_t is array (0 to ROWS-1, 0 to ROWS-1) of pixel_t;
+    type deskew_t is array (0 to COLS-1, 0 to COLS-1) of acc_t;
+    type tag_pipe_t is array (0 to LATENCY-1) of std_logic_vector(TAG_W-1 downto 0);
+
+    signal pe_w         : pe_weight_t;
+    signal pe_a         : pe_act_t;
+    signal pe_sum       : pe_sum_t;
+    signal skew         : skew_t;
+    signal deskew       : deskew_t;
+    signal valid_pipe   : std_logic_vector(LATENCY-1 downto 0);
+    signal tag_pipe     : tag_pipe_t;
+
+    -- Activation entering PE (r, 0): element r delayed r cycles
+    function row_entry(s : skew_t; d : std_logic_vector; r : integer) return pixel_t is
+    begin
+        if r = 0 then
+            return signed(d(DATA_WIDTH-1 downto 0));
+        else
+            return s(r, r-1);
+        end if;
+    end function;
+
+begin
+
+    -- ==========================================================================
+    -- Weight Load
+    -- ==========================================================================
+    process(clk)
+    begin
+        if rising_edge(clk) then
+            if w_load = '1' then
+                for r in 0 to ROWS-1 loop
+                    for c in 0 to COLS-1 loop
+                        pe_w(r, c) <= signed(w_data((r*COLS+c+1)*WEIGHT_WIDTH-1 downto (r*COLS+c)*WEIGHT_WIDTH));
+                    end loop;
+                end loop;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Input Skew, PE Grid, Output De-skew
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable a_in   : pixel_t;
+        variable sum_in : acc_t;
+    begin
+        if rst_n = '0' then
+            pe_a <= (others => (others => (others => '0')));
+            pe_sum <= (others => (others => (others => '0')));
+            skew <= (others => (others => (others => '0')));
+            deskew <= (others => (others => (others => '0')));
+            valid_pipe <= (others => '0');
+            tag_pipe <= (others => (others => '0'));
+        elsif rising_edge(clk) then
+            -- Row r enters through r registers
+            for r in 1 to ROWS-1 loop
+                skew(r, 0) <= signed(in_data((r+1)*DATA_WIDTH-1 downto r*DATA_WIDTH));
+                for j in 1 to r-1 loop
+                    skew(r, j) <= skew(r, j-1);
+                end loop;
+            end loop;
+
+            for r in 0 to ROWS-1 loop
+                for c in 0 to COLS-1 loop
+                    if c = 0 then
+                        a_in := row_entry(skew, in_data, r);
+                    else
+                        a_in := pe_a(r, c-1);
+                    end if;
+                    if r = 0 then
+                        sum_in := (others => '0');
+                    else
+                        sum_in := pe_sum(r-1, c);
+                    end if;
+                    pe_a(r, c) <= a_in;
+                    pe_sum(r, c) <= sum_in + fp_mult(a_in, pe_w(r, c));
+                end loop;
+            end loop;
+
+            -- Column c finishes c cycles after column 0: delay the early ones
+            for c in 0 to COLS-2 loop
+                deskew(c, 0) <= pe_sum(ROWS-1, c);
+                for j in 1 to COLS-2-c loop
+                    deskew(c, j) <= deskew(c, j-1);
+                end loop;
+            end loop;
+
+            valid_pipe <= valid_pipe(LATENCY-2 downto 0) & in_valid;
+            tag_pipe(0) <= in_tag;
+            for i in 1 to LATENCY-1 loop
+                tag_pipe(i) <= tag_pipe(i-1);
+            end loop;
+        end if;
+    end process;
+
+    gen_out: for c in 0 to COLS-1 generate
+        gen_last: if c = COLS-1 generate
+            out_data((c+1)*ACC_WIDTH-1 downto c*ACC_WIDTH) <= std_logic_vector(pe_sum(ROWS-1, c));
+        end generate;
+        gen_early: if c < COLS-1 generate
+            out_data((c+1)*ACC_WIDTH-1 downto c*ACC_WIDTH) <= std_logic_vector(deskew(c, COLS-2-c));
+        end generate;
+    end generate;
+
+    out_valid <= valid_pipe(LATENCY-1);
+    out_tag <= tag_pipe(LATENCY-1);
+
+end rtl;
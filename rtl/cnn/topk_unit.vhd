@@ -0,0 +1,149 @@
+-- =============================================================================
+-- Top-K Unit - Streaming Argmax / Top-K on the Result Stream
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Watches the result stream handshake; beat n of a frame is class n
+--   - Keeps the TOPK largest (class, logit) pairs in a sorted register list:
+--     every beat is compared against all entries at once and inserted in
+--     one cycle, so the stream never waits
+--   - Ties keep the lower class index first
+--   - At the end-of-frame beat the list is copied to the result registers,
+--     which hold until the next frame ends
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+library work;
+use work.cnn_pkg.all;
+
+entity topk_unit is
+    generic (
+        TOPK            : integer := 5
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+        flush           : in  std_logic;    -- Drop the frame in progress
+
+        -- Result stream beats (valid and ready already combined)
+        in_valid        : in  std_logic;
+        in_data         : in  std_logic_vector(DATA_WIDTH-1 downto 0);
+        in_eof          : in  std_logic;    -- Last beat of the frame
+
+        -- Last completed frame; entry k at [32*k +: 32] = class (31:16), logit (15:0)
+        topk_entries    : out std_logic_vector(32*TOPK-1 downto 0);
+        topk_valid      : out std_logic_vector(3 downto 0);   -- Entries in use
+        topk_classes    : out std_logic_vector(15 downto 0)   -- Logits in the frame
+    );
+end topk_unit;
+
+architecture rtl of topk_unit is
+
+    type logit_list_t is array (0 to TOPK-1) of pixel_t;
+    type class_list_t is array (0 to TOPK-1) of unsigned(15 downto 0);
+
+    -- Working list (sorted, largest first)
+    signal w_logit      : logit_list_t;
+    signal w_class      : class_list_t;
+    signal w_used       : std_logic_vector(TOPK-1 downto 0);
+    signal class_idx    : unsigned(15 downto 0);
+
+    -- Result registers
+    signal r_logit      : logit_list_t;
+    signal r_class      : class_list_t;
+    signal r_used       : std_logic_vector(TOPK-1 downto 0);
+    signal r_classes    : unsigned(15 downto 0);
+
+begin
+
+    process(clk, rst_n)
+        variable ins    : std_logic_vector(TOPK-1 downto 0);
+        variable n_logit: logit_list_t;
+        variable n_class: class_list_t;
+        variable n_used : std_logic_vector(TOPK-1 downto 0);
+    begin
+        if rst_n = '0' then
+            w_logit <= (others => (others => '0'));
+            w_class <= (others => (others => '0'));
+            w_used <= (others => '0');
+            class_idx <= (others => '0');
+            r_logit <= (others => (others => '0'));
+            r_class <= (others => (others => '0'));
+            r_used <= (others => '0');
+            r_classes <= (others => '0');
+        elsif rising_edge(clk) then
+            if flush = '1' then
+                w_used <= (others => '0');
+                class_idx <= (others => '0');
+            elsif in_valid = '1' then
+                -- Insert where the new logit beats the entry (or the entry
+                -- is free); the entries from there on move down one place
+                for i in 0 to TOPK-1 loop
+                    if w_used(i) = '0' or signed(in_data) > w_logit(i) then
+                        ins(i) := '1';
+                    else
+                        ins(i) := '0';
+                    end if;
+                end loop;
+
+                n_logit := w_logit;
+                n_class := w_class;
+                n_used := w_used;
+                for i in 0 to TOPK-1 loop
+                    if ins(i) = '1' then
+                        if i = 0 then
+                            n_logit(i) := signed(in_data);
+                            n_class(i) := class_idx;
+                            n_used(i) := '1';
+                        elsif ins(i-1) = '0' then
+                            n_logit(i) := signed(in_data);
+                            n_class(i) := class_idx;
+                            n_used(i) := '1';
+                        else
+                            n_logit(i) := w_logit(i-1);
+                            n_class(i) := w_class(i-1);
+                            n_used(i) := w_used(i-1);
+                        end if;
+                    end if;
+                end loop;
+
+                if in_eof = '1' then
+                    r_logit <= n_logit;
+                    r_class <= n_class;
+                    r_used <= n_used;
+                    r_classes <= class_idx + 1;
+                    w_used <= (others => '0');
+                    class_idx <= (others => '0');
+                else
+                    w_logit <= n_logit;
+                    w_class <= n_class;
+                    w_used <= n_used;
+                    class_idx <= class_idx + 1;
+                end if;
+            end if;
+        end if;
+    end process;
+
+    gen_entries: for k in 0 to TOPK-1 generate
+        topk_entries(32*k+31 downto 32*k+16) <= std_logic_vector(r_class(k));
+        topk_entries(32*k+15 downto 32*k) <= std_logic_vector(resize(r_logit(k), 16));
+    end generate;
+
+    process(r_used)
+        variable n : integer range 0 to TOPK;
+    begin
+        n := 0;
+        for k in 0 to TOPK-1 loop
+            if r_used(k) = '1' then
+                n := n + 1;
+            end if;
+        end loop;
+        topk_valid <= std_logic_vector(to_unsigned(n, 4));
+    end process;
+
+    topk_classes <= std_logic_vector(r_classes);
+
+end rtl;
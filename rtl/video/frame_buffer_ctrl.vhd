@@ -1,13 +1,19 @@
 -- =============================================================================
 -- Frame Buffer Controller with Triple Buffering
 -- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
--- 
+--
 -- Features:
 --   - Triple buffering for glitch-free frame switching
 --   - AXI-Stream input from camera/DMA
 --   - AXI-Stream output to CNN pipeline
 --   - Configurable frame dimensions
 --   - DDR memory interface via AXI4
+--   - Frame policy: latest frame wins (drop stale frames) or process
+--     every frame (backpressure the source when the CNN falls behind)
+--   - Drop and overrun counters
+--
+-- Buffers are placed back to back at cfg_base_addr, one 32-bit word per
+-- pixel (RGB888 in the low bytes), two pixels per 64-bit beat.
 -- =============================================================================
 
 library IEEE;
@@ -23,33 +29,36 @@ entity frame_buffer_ctrl is
         FRAME_HEIGHT    : integer := 128;
         PIXEL_WIDTH     : integer := 24;        -- RGB888
         NUM_BUFFERS     : integer := 3;         -- Triple buffering
-        BASE_ADDR       : std_logic_vector(31 downto 0) := x"10000000";
-        BURST_LEN       : integer := 16
+        BURST_LEN       : integer := 16;
+        MAX_OUTSTANDING : integer := 4
     );
     port (
         clk             : in  std_logic;
         rst_n           : in  std_logic;
-        
+
         -- Configuration
         cfg_enable      : in  std_logic;
+        cfg_latest_wins : in  std_logic;  -- '1' = drop stale frames, '0' = every frame
+        cfg_base_addr   : in  std_logic_vector(31 downto 0);
         cfg_frame_width : in  std_logic_vector(11 downto 0);
         cfg_frame_height: in  std_logic_vector(11 downto 0);
-        
+        stats_clear     : in  std_logic;
+
         -- AXI-Stream Input (from camera/DMA)
         s_axis_tdata    : in  std_logic_vector(PIXEL_WIDTH-1 downto 0);
         s_axis_tvalid   : in  std_logic;
         s_axis_tready   : out std_logic;
         s_axis_tlast    : in  std_logic;
         s_axis_tuser    : in  std_logic;  -- SOF
-        
+
         -- AXI-Stream Output (to CNN pipeline)
         m_axis_tdata    : out std_logic_vector(PIXEL_WIDTH-1 downto 0);
         m_axis_tvalid   : out std_logic;
         m_axis_tready   : in  std_logic;
         m_axis_tlast    : out std_logic;
         m_axis_tuser    : out std_logic;  -- SOF
-        
-        -- AXI4 Memory Interface (simplified)
+
+        -- AXI4 Memory Interface
         m_axi_awaddr    : out std_logic_vector(31 downto 0);
         m_axi_awlen     : out std_logic_vector(7 downto 0);
         m_axi_awsize    : out std_logic_vector(2 downto 0);
@@ -64,7 +73,7 @@ entity frame_buffer_ctrl is
         m_axi_bresp     : in  std_logic_vector(1 downto 0);
         m_axi_bvalid    : in  std_logic;
         m_axi_bready    : out std_logic;
-        
+
         m_axi_araddr    : out std_logic_vector(31 downto 0);
         m_axi_arlen     : out std_logic_vector(7 downto 0);
         m_axi_arsize    : out std_logic_vector(2 downto 0);
@@ -76,283 +85,455 @@ entity frame_buffer_ctrl is
         m_axi_rlast     : in  std_logic;
         m_axi_rvalid    : in  std_logic;
         m_axi_rready    : out std_logic;
-        
+
         -- Status
         write_buf_idx   : out std_logic_vector(1 downto 0);
         read_buf_idx    : out std_logic_vector(1 downto 0);
-        frame_complete  : out std_logic
+        frame_complete  : out std_logic;
+        drop_count      : out std_logic_vector(15 downto 0);  -- Frames replaced unprocessed
+        overrun_count   : out std_logic_vector(15 downto 0)   -- Frames that stalled the source
     );
 end frame_buffer_ctrl;
 
 architecture rtl of frame_buffer_ctrl is
 
-    -- Frame size calculation
-    constant FRAME_SIZE : integer := FRAME_WIDTH * FRAME_HEIGHT;
-    constant BYTES_PER_PIXEL : integer := (PIXEL_WIDTH + 7) / 8;
-    constant FRAME_BYTES : integer := FRAME_SIZE * BYTES_PER_PIXEL;
-    
-    -- Buffer addresses (each buffer is FRAME_BYTES apart)
-    type buf_addr_array_t is array (0 to NUM_BUFFERS-1) of std_logic_vector(31 downto 0);
-    signal buf_base_addr : buf_addr_array_t;
-    
+    constant BEAT_BYTES  : integer := 8;
+    constant PX_PER_BEAT : integer := 2;
+
     -- Buffer management
+    signal frame_bytes  : unsigned(31 downto 0);
+    signal frame_beats  : unsigned(23 downto 0);
     signal wr_buf       : unsigned(1 downto 0);
     signal rd_buf       : unsigned(1 downto 0);
     signal ready_buf    : unsigned(1 downto 0);
-    
+    signal ready_valid  : std_logic;   -- A complete frame is waiting
+    signal rd_take      : std_logic;   -- Reader claims the waiting frame
+
     -- Write FSM
-    type wr_state_t is (WR_IDLE, WR_WAIT_SOF, WR_WRITE_ADDR, WR_WRITE_DATA, WR_WAIT_RESP);
+    type wr_state_t is (WR_IDLE, WR_WAIT_SOF, WR_STREAM, WR_FLUSH, WR_HOLD);
     signal wr_state     : wr_state_t;
-    
+
+    -- Ping-pong burst banks (fill one while the other is written out)
+    type bank_t is array (0 to BURST_LEN-1) of std_logic_vector(63 downto 0);
+    type bank_pair_t is array (0 to 1) of bank_t;
+    type bank_addr_t is array (0 to 1) of unsigned(31 downto 0);
+    type bank_len_t is array (0 to 1) of unsigned(7 downto 0);
+    signal banks        : bank_pair_t;
+    signal bank_addr    : bank_addr_t;
+    signal bank_beats   : bank_len_t;
+    signal bank_full    : std_logic_vector(1 downto 0);
+    signal fill_bank    : integer range 0 to 1;
+    signal fill_idx     : unsigned(7 downto 0);
+    signal fill_addr    : unsigned(31 downto 0);
+    signal pack_word    : std_logic_vector(63 downto 0);
+    signal pack_lane    : std_logic;
+    signal wr_px_left   : unsigned(23 downto 0);
+
+    -- AXI write engine
+    type aw_state_t is (AW_IDLE, AW_ADDR, AW_DATA, AW_RESP);
+    signal aw_state     : aw_state_t;
+    signal send_bank    : integer range 0 to 1;
+    signal send_beat    : unsigned(7 downto 0);
+
     -- Read FSM
-    type rd_state_t is (RD_IDLE, RD_SEND_SOF, RD_READ_ADDR, RD_READ_DATA, RD_OUTPUT);
+    type rd_state_t is (RD_IDLE, RD_ISSUE, RD_NEXT, RD_DRAIN);
     signal rd_state     : rd_state_t;
-    
-    -- Write position tracking
-    signal wr_x         : unsigned(11 downto 0);
-    signal wr_y         : unsigned(11 downto 0);
-    signal wr_addr      : unsigned(31 downto 0);
-    signal wr_burst_cnt : unsigned(7 downto 0);
-    
-    -- Read position tracking
+    signal rd_addr      : unsigned(31 downto 0);
+    signal rd_remain    : unsigned(23 downto 0);   -- Beats left to request
+    signal rd_len       : unsigned(7 downto 0);
+    signal outstanding  : unsigned(3 downto 0);
+
+    -- Read data unpacking and position tracking
+    signal rd_word      : std_logic_vector(63 downto 0);
+    signal rd_lane      : std_logic;
+    signal rd_full      : std_logic;
+    signal rd_ready     : std_logic;
+    signal beat_take    : std_logic;
     signal rd_x         : unsigned(11 downto 0);
     signal rd_y         : unsigned(11 downto 0);
-    signal rd_addr      : unsigned(31 downto 0);
-    signal rd_burst_cnt : unsigned(7 downto 0);
-    
-    -- FIFO for pixel packing (input)
-    signal wr_fifo_data : std_logic_vector(63 downto 0);
-    signal wr_fifo_wr   : std_logic;
-    signal wr_fifo_rd   : std_logic;
-    signal wr_fifo_cnt  : unsigned(3 downto 0);
-    
-    -- FIFO for pixel unpacking (output)
-    signal rd_fifo_data : std_logic_vector(63 downto 0);
-    signal rd_fifo_valid: std_logic;
-    signal rd_pixel_idx : unsigned(1 downto 0);
-    
+    signal rd_first     : std_logic;
+    signal out_accept   : std_logic;
+
+    -- Statistics
+    signal drop_cnt     : unsigned(15 downto 0);
+    signal overrun_cnt  : unsigned(15 downto 0);
+
     -- Internal signals
     signal input_ready  : std_logic;
-    signal output_valid : std_logic;
     signal frame_done   : std_logic;
 
+    -- Buffer that is neither a nor b
+    function other_buf(a, b : unsigned(1 downto 0)) return unsigned is
+    begin
+        for i in 0 to NUM_BUFFERS-1 loop
+            if to_unsigned(i, 2) /= a and to_unsigned(i, 2) /= b then
+                return to_unsigned(i, 2);
+            end if;
+        end loop;
+        return to_unsigned(0, 2);
+    end function;
+
+    -- Base address of buffer idx
+    function buf_addr(base : std_logic_vector; bytes : unsigned; idx : unsigned) return unsigned is
+    begin
+        return unsigned(base) + resize(bytes * idx, 32);
+    end function;
+
 begin
 
     -- ==========================================================================
-    -- Buffer Address Calculation
+    -- Frame Geometry
     -- ==========================================================================
-    gen_buf_addr: for i in 0 to NUM_BUFFERS-1 generate
-        buf_base_addr(i) <= std_logic_vector(unsigned(BASE_ADDR) + to_unsigned(i * FRAME_BYTES, 32));
-    end generate;
+    process(clk)
+    begin
+        if rising_edge(clk) then
+            frame_beats <= resize(shift_right(unsigned(cfg_frame_width) * unsigned(cfg_frame_height) + 1, 1), 24);
+            frame_bytes <= shift_left(resize(unsigned(cfg_frame_width) * unsigned(cfg_frame_height), 32), 2);
+        end if;
+    end process;
 
     -- ==========================================================================
-    -- Write State Machine (Camera to DDR)
+    -- Write State Machine (Camera to DDR) and Buffer Policy
     -- ==========================================================================
     process(clk, rst_n)
+        variable word    : std_logic_vector(63 downto 0);
+        variable publish : boolean;
+        variable nxt     : unsigned(1 downto 0);
     begin
         if rst_n = '0' then
             wr_state <= WR_IDLE;
-            wr_x <= (others => '0');
-            wr_y <= (others => '0');
-            wr_addr <= (others => '0');
-            wr_burst_cnt <= (others => '0');
             wr_buf <= (others => '0');
+            ready_buf <= (others => '0');
+            ready_valid <= '0';
+            bank_full <= (others => '0');
+            bank_addr <= (others => (others => '0'));
+            bank_beats <= (others => (others => '0'));
+            fill_bank <= 0;
+            fill_idx <= (others => '0');
+            fill_addr <= (others => '0');
+            pack_word <= (others => '0');
+            pack_lane <= '0';
+            wr_px_left <= (others => '0');
+            aw_state <= AW_IDLE;
+            send_bank <= 0;
+            send_beat <= (others => '0');
+            drop_cnt <= (others => '0');
+            overrun_cnt <= (others => '0');
         elsif rising_edge(clk) then
+            publish := false;
+
+            if stats_clear = '1' then
+                drop_cnt <= (others => '0');
+                overrun_cnt <= (others => '0');
+            end if;
+
+            -- Reader claimed the waiting frame
+            if rd_take = '1' then
+                ready_valid <= '0';
+            end if;
+
             case wr_state is
                 when WR_IDLE =>
                     if cfg_enable = '1' then
                         wr_state <= WR_WAIT_SOF;
                     end if;
-                    
+
                 when WR_WAIT_SOF =>
-                    if s_axis_tvalid = '1' and s_axis_tuser = '1' then
-                        -- Start of frame detected
-                        wr_state <= WR_WRITE_ADDR;
-                        wr_x <= (others => '0');
-                        wr_y <= (others => '0');
-                        wr_addr <= unsigned(buf_base_addr(to_integer(wr_buf)));
-                    end if;
-                    
-                when WR_WRITE_ADDR =>
-                    if m_axi_awready = '1' then
-                        wr_state <= WR_WRITE_DATA;
-                        wr_burst_cnt <= to_unsigned(BURST_LEN - 1, 8);
+                    -- Pixels ahead of SOF are discarded; the SOF pixel is kept
+                    if cfg_enable = '1' and s_axis_tvalid = '1' and s_axis_tuser = '1' then
+                        -- Start of frame: write into the free buffer
+                        fill_addr <= buf_addr(cfg_base_addr, frame_bytes, wr_buf);
+                        wr_px_left <= resize(unsigned(cfg_frame_width) * unsigned(cfg_frame_height), 24);
+                        fill_idx <= (others => '0');
+                        pack_lane <= '0';
+                        wr_state <= WR_STREAM;
                     end if;
-                    
-                when WR_WRITE_DATA =>
-                    if m_axi_wready = '1' then
-                        if wr_burst_cnt = 0 then
-                            wr_state <= WR_WAIT_RESP;
+
+                when WR_STREAM =>
+                    if s_axis_tvalid = '1' and input_ready = '1' then
+                        -- Two pixels per beat, each in its own 32-bit word
+                        word := pack_word;
+                        if pack_lane = '0' then
+                            word := (others => '0');
+                            word(PIXEL_WIDTH-1 downto 0) := s_axis_tdata;
                         else
-                            wr_burst_cnt <= wr_burst_cnt - 1;
+                            word(32+PIXEL_WIDTH-1 downto 32) := s_axis_tdata;
                         end if;
-                        
-                        -- Update position
-                        if wr_x = unsigned(cfg_frame_width) - 1 then
-                            wr_x <= (others => '0');
-                            if wr_y = unsigned(cfg_frame_height) - 1 then
-                                -- Frame complete
-                                wr_y <= (others => '0');
-                            else
-                                wr_y <= wr_y + 1;
+                        pack_word <= word;
+                        pack_lane <= not pack_lane;
+                        wr_px_left <= wr_px_left - 1;
+
+                        if pack_lane = '1' or wr_px_left = 1 then
+                            banks(fill_bank)(to_integer(fill_idx)) <= word;
+                            fill_idx <= fill_idx + 1;
+                            pack_lane <= '0';
+
+                            -- Hand a full (or final) bank to the write engine
+                            if fill_idx = BURST_LEN-1 or wr_px_left = 1 then
+                                bank_full(fill_bank) <= '1';
+                                bank_addr(fill_bank) <= fill_addr;
+                                bank_beats(fill_bank) <= fill_idx + 1;
+                                fill_addr <= fill_addr + resize(resize(fill_idx + 1, 16) * BEAT_BYTES, 32);
+                                fill_bank <= 1 - fill_bank;
+                                fill_idx <= (others => '0');
                             end if;
-                        else
-                            wr_x <= wr_x + 1;
+                        end if;
+
+                        if wr_px_left = 1 then
+                            wr_state <= WR_FLUSH;
                         end if;
                     end if;
-                    
-                when WR_WAIT_RESP =>
-                    if m_axi_bvalid = '1' then
-                        if wr_x = 0 and wr_y = 0 then
-                            -- Frame complete, switch buffers
-                            wr_state <= WR_WAIT_SOF;
-                            ready_buf <= wr_buf;
-                            if wr_buf = NUM_BUFFERS - 1 then
-                                wr_buf <= (others => '0');
-                            else
-                                wr_buf <= wr_buf + 1;
-                            end if;
+
+                when WR_FLUSH =>
+                    -- Frame in DDR once both banks have drained
+                    if bank_full = "00" and aw_state = AW_IDLE then
+                        if cfg_latest_wins = '1' or ready_valid = '0' or rd_take = '1' then
+                            publish := true;
                         else
-                            -- Continue with next burst
-                            wr_state <= WR_WRITE_ADDR;
-                            wr_addr <= wr_addr + to_unsigned(BURST_LEN * 8, 32);
+                            -- Every-frame policy with a frame still waiting
+                            wr_state <= WR_HOLD;
+                            overrun_cnt <= overrun_cnt + 1;
                         end if;
                     end if;
-                    
+
+                when WR_HOLD =>
+                    -- Source is backpressured until the reader takes the waiting frame
+                    if rd_take = '1' or ready_valid = '0' then
+                        publish := true;
+                    end if;
+
                 when others =>
                     wr_state <= WR_IDLE;
             end case;
+
+            -- Publish the completed frame and move to a free buffer
+            if publish then
+                if ready_valid = '1' and rd_take = '0' then
+                    -- Latest frame wins: the waiting frame is dropped
+                    drop_cnt <= drop_cnt + 1;
+                end if;
+                ready_buf <= wr_buf;
+                ready_valid <= '1';
+                if rd_take = '1' then
+                    nxt := other_buf(wr_buf, ready_buf);
+                else
+                    nxt := other_buf(wr_buf, rd_buf);
+                end if;
+                wr_buf <= nxt;
+                wr_state <= WR_WAIT_SOF;
+            end if;
+
+            -- ------------------------------------------------------------------
+            -- AXI write engine: one burst per bank
+            -- ------------------------------------------------------------------
+            case aw_state is
+                when AW_IDLE =>
+                    if bank_full(send_bank) = '1' then
+                        aw_state <= AW_ADDR;
+                    end if;
+
+                when AW_ADDR =>
+                    if m_axi_awready = '1' then
+                        send_beat <= (others => '0');
+                        aw_state <= AW_DATA;
+                    end if;
+
+                when AW_DATA =>
+                    if m_axi_wready = '1' then
+                        send_beat <= send_beat + 1;
+                        if send_beat = bank_beats(send_bank) - 1 then
+                            aw_state <= AW_RESP;
+                        end if;
+                    end if;
+
+                when AW_RESP =>
+                    if m_axi_bvalid = '1' then
+                        bank_full(send_bank) <= '0';
+                        send_bank <= 1 - send_bank;
+                        aw_state <= AW_IDLE;
+                    end if;
+
+                when others =>
+                    aw_state <= AW_IDLE;
+            end case;
         end if;
     end process;
 
+    -- ==========================================================================
+    -- AXI Write Channel Signals
+    -- ==========================================================================
+    m_axi_awaddr <= std_logic_vector(bank_addr(send_bank));
+    m_axi_awlen <= std_logic_vector(bank_beats(send_bank) - 1);
+    m_axi_awsize <= "011";  -- 8 bytes
+    m_axi_awburst <= "01";  -- INCR
+    m_axi_awvalid <= '1' when aw_state = AW_ADDR else '0';
+    m_axi_wdata <= banks(send_bank)(to_integer(send_beat) mod BURST_LEN);
+    m_axi_wstrb <= (others => '1');
+    m_axi_wlast <= '1' when send_beat = bank_beats(send_bank) - 1 else '0';
+    m_axi_wvalid <= '1' when aw_state = AW_DATA else '0';
+    m_axi_bready <= '1' when aw_state = AW_RESP else '0';
+
     -- ==========================================================================
     -- Read State Machine (DDR to CNN)
     -- ==========================================================================
+    rd_take <= '1' when rd_state = RD_IDLE and ready_valid = '1' and cfg_enable = '1' else '0';
+
     process(clk, rst_n)
+        variable to_4k : unsigned(12 downto 0);
+        variable len   : unsigned(23 downto 0);
     begin
         if rst_n = '0' then
             rd_state <= RD_IDLE;
-            rd_x <= (others => '0');
-            rd_y <= (others => '0');
-            rd_addr <= (others => '0');
-            rd_burst_cnt <= (others => '0');
             rd_buf <= (others => '0');
+            rd_addr <= (others => '0');
+            rd_remain <= (others => '0');
+            rd_len <= (others => '0');
         elsif rising_edge(clk) then
             case rd_state is
                 when RD_IDLE =>
-                    if cfg_enable = '1' and ready_buf /= rd_buf then
-                        -- New frame available
-                        rd_state <= RD_SEND_SOF;
+                    if rd_take = '1' then
+                        -- Claim the most recent complete frame
                         rd_buf <= ready_buf;
-                        rd_x <= (others => '0');
-                        rd_y <= (others => '0');
-                        rd_addr <= unsigned(buf_base_addr(to_integer(ready_buf)));
+                        rd_addr <= buf_addr(cfg_base_addr, frame_bytes, ready_buf);
+                        rd_remain <= frame_beats;
+                        rd_state <= RD_NEXT;
                     end if;
-                    
-                when RD_SEND_SOF =>
-                    if m_axis_tready = '1' then
-                        rd_state <= RD_READ_ADDR;
+
+                when RD_NEXT =>
+                    if rd_remain = 0 then
+                        rd_state <= RD_DRAIN;
+                    elsif outstanding < MAX_OUTSTANDING then
+                        -- Burst length capped by BURST_LEN and the 4KB boundary
+                        to_4k := resize((4096 - resize(rd_addr(11 downto 0), 13)) / BEAT_BYTES, 13);
+                        len := rd_remain;
+                        if len > BURST_LEN then
+                            len := to_unsigned(BURST_LEN, 24);
+                        end if;
+                        if len > resize(to_4k, 24) then
+                            len := resize(to_4k, 24);
+                        end if;
+                        rd_len <= len(7 downto 0);
+                        rd_state <= RD_ISSUE;
                     end if;
-                    
-                when RD_READ_ADDR =>
+
+                when RD_ISSUE =>
                     if m_axi_arready = '1' then
-                        rd_state <= RD_READ_DATA;
-                        rd_burst_cnt <= to_unsigned(BURST_LEN - 1, 8);
-                    end if;
-                    
-                when RD_READ_DATA =>
-                    if m_axi_rvalid = '1' then
-                        if m_axi_rlast = '1' then
-                            rd_state <= RD_OUTPUT;
-                        end if;
+                        rd_addr <= rd_addr + resize(resize(rd_len, 16) * BEAT_BYTES, 32);
+                        rd_remain <= rd_remain - rd_len;
+                        rd_state <= RD_NEXT;
                     end if;
-                    
-                when RD_OUTPUT =>
-                    if m_axis_tready = '1' then
-                        -- Update position
-                        if rd_x = unsigned(cfg_frame_width) - 1 then
-                            rd_x <= (others => '0');
-                            if rd_y = unsigned(cfg_frame_height) - 1 then
-                                -- Frame complete
-                                rd_state <= RD_IDLE;
-                                frame_done <= '1';
-                            else
-                                rd_y <= rd_y + 1;
-                                rd_state <= RD_READ_ADDR;
-                                rd_addr <= rd_addr + to_unsigned(BURST_LEN * 8, 32);
-                            end if;
-                        else
-                            rd_x <= rd_x + 1;
-                        end if;
+
+                when RD_DRAIN =>
+                    if frame_done = '1' then
+                        rd_state <= RD_IDLE;
                     end if;
-                    
+
                 when others =>
                     rd_state <= RD_IDLE;
             end case;
         end if;
     end process;
 
-    -- ==========================================================================
-    -- AXI Write Channel Signals
-    -- ==========================================================================
-    m_axi_awaddr <= std_logic_vector(wr_addr);
-    m_axi_awlen <= std_logic_vector(to_unsigned(BURST_LEN - 1, 8));
-    m_axi_awsize <= "011";  -- 8 bytes
-    m_axi_awburst <= "01";  -- INCR
-    m_axi_awvalid <= '1' when wr_state = WR_WRITE_ADDR else '0';
-    
-    -- Pack pixels into 64-bit word (2 RGB pixels)
-    process(clk)
+    -- Outstanding read bursts
+    process(clk, rst_n)
+        variable issued    : std_logic;
+        variable completed : std_logic;
     begin
-        if rising_edge(clk) then
-            if s_axis_tvalid = '1' and input_ready = '1' then
-                wr_fifo_data(23 downto 0) <= s_axis_tdata;
-                wr_fifo_data(47 downto 24) <= wr_fifo_data(23 downto 0);
-                wr_fifo_data(63 downto 48) <= (others => '0');
+        if rst_n = '0' then
+            outstanding <= (others => '0');
+        elsif rising_edge(clk) then
+            issued := '0';
+            completed := '0';
+            if rd_state = RD_ISSUE and m_axi_arready = '1' then
+                issued := '1';
+            end if;
+            if beat_take = '1' and m_axi_rlast = '1' then
+                completed := '1';
+            end if;
+            if issued = '1' and completed = '0' then
+                outstanding <= outstanding + 1;
+            elsif issued = '0' and completed = '1' then
+                outstanding <= outstanding - 1;
             end if;
         end if;
     end process;
-    
-    m_axi_wdata <= wr_fifo_data;
-    m_axi_wstrb <= (others => '1');
-    m_axi_wlast <= '1' when wr_burst_cnt = 0 else '0';
-    m_axi_wvalid <= '1' when wr_state = WR_WRITE_DATA else '0';
-    m_axi_bready <= '1';
 
     -- ==========================================================================
     -- AXI Read Channel Signals
     -- ==========================================================================
     m_axi_araddr <= std_logic_vector(rd_addr);
-    m_axi_arlen <= std_logic_vector(to_unsigned(BURST_LEN - 1, 8));
+    m_axi_arlen <= std_logic_vector(rd_len - 1);
     m_axi_arsize <= "011";  -- 8 bytes
     m_axi_arburst <= "01";  -- INCR
-    m_axi_arvalid <= '1' when rd_state = RD_READ_ADDR else '0';
-    m_axi_rready <= '1' when rd_state = RD_READ_DATA else '0';
-    
-    -- Store read data
-    process(clk)
+    m_axi_arvalid <= '1' when rd_state = RD_ISSUE else '0';
+
+    -- ==========================================================================
+    -- Read Data Unpacking (2 pixels per beat)
+    -- ==========================================================================
+    out_accept <= rd_full and m_axis_tready;
+    rd_ready <= '1' when rd_full = '0' or (m_axis_tready = '1' and rd_lane = '1') else '0';
+    beat_take <= m_axi_rvalid and rd_ready;
+
+    process(clk, rst_n)
     begin
-        if rising_edge(clk) then
-            if m_axi_rvalid = '1' and rd_state = RD_READ_DATA then
-                rd_fifo_data <= m_axi_rdata;
-                rd_fifo_valid <= '1';
-            elsif m_axis_tready = '1' then
-                rd_fifo_valid <= '0';
+        if rst_n = '0' then
+            rd_word <= (others => '0');
+            rd_lane <= '0';
+            rd_full <= '0';
+            rd_x <= (others => '0');
+            rd_y <= (others => '0');
+            rd_first <= '1';
+            frame_done <= '0';
+        elsif rising_edge(clk) then
+            frame_done <= '0';
+
+            if out_accept = '1' then
+                rd_first <= '0';
+                rd_lane <= not rd_lane;
+                if rd_lane = '1' then
+                    rd_full <= '0';
+                end if;
+
+                if rd_x = unsigned(cfg_frame_width) - 1 then
+                    rd_x <= (others => '0');
+                    if rd_y = unsigned(cfg_frame_height) - 1 then
+                        -- Frame complete (odd trailing lane is discarded)
+                        rd_y <= (others => '0');
+                        rd_first <= '1';
+                        rd_full <= '0';
+                        frame_done <= '1';
+                    else
+                        rd_y <= rd_y + 1;
+                    end if;
+                else
+                    rd_x <= rd_x + 1;
+                end if;
+            end if;
+
+            -- Load the next beat (overrides the lane/full update above)
+            if beat_take = '1' then
+                rd_word <= m_axi_rdata;
+                rd_lane <= '0';
+                rd_full <= '1';
             end if;
         end if;
     end process;
 
+    m_axi_rready <= rd_ready;
+
     -- ==========================================================================
     -- Stream Interface Signals
     -- ==========================================================================
-    input_ready <= '1' when (wr_state = WR_WAIT_SOF) or (wr_state = WR_WRITE_DATA and m_axi_wready = '1') else '0';
+    -- Input accepted while the current fill bank is free
+    input_ready <= '1' when (wr_state = WR_WAIT_SOF and s_axis_tuser = '0') or
+                            (wr_state = WR_STREAM and bank_full(fill_bank) = '0') else '0';
     s_axis_tready <= input_ready and cfg_enable;
-    
-    output_valid <= rd_fifo_valid when rd_state = RD_OUTPUT else '0';
-    m_axis_tdata <= rd_fifo_data(23 downto 0) when rd_pixel_idx = 0 else rd_fifo_data(47 downto 24);
-    m_axis_tvalid <= output_valid;
+
+    m_axis_tdata <= rd_word(PIXEL_WIDTH-1 downto 0) when rd_lane = '0' else
+                    rd_word(32+PIXEL_WIDTH-1 downto 32);
+    m_axis_tvalid <= rd_full;
     m_axis_tlast <= '1' when rd_x = unsigned(cfg_frame_width) - 1 else '0';
-    m_axis_tuser <= '1' when rd_state = RD_SEND_SOF else '0';
+    m_axis_tuser <= rd_first;
 
     -- ==========================================================================
     -- Status Outputs
@@ -360,5 +541,7 @@ begin
     write_buf_idx <= std_logic_vector(wr_buf);
     read_buf_idx <= std_logic_vector(rd_buf);
     frame_complete <= frame_done;
+    drop_count <= std_logic_vector(drop_cnt);
+    overrun_count <= std_logic_vector(overrun_cnt);
 
 end rtl;
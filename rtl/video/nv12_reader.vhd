@@ -0,0 +1,334 @@
+-- =============================================================================
+-- NV12 Frame Reader (AXI4 Read Master)
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Fetches one NV12 frame from DDR per start pulse
+--   - Emits it as a YUV 4:2:2 stream (Y[7:0], chroma[15:8]) for the
+--     front-end color converter, 1.5 bytes per pixel of DDR traffic
+--   - Each chroma row is read once into a line buffer and reused for the
+--     two luma rows it covers
+--   - Incrementing bursts of up to BURST_LEN beats, never crossing 4KB
+--
+-- Memory layout at cfg_base_addr: Y plane (width x height bytes), then the
+-- interleaved CbCr plane (width x ceil(height / 2) bytes).
+-- Requires cfg_width to be a multiple of 8 (one beat per 8 bytes).
+-- Read order: CbCr row 0, Y row 0, Y row 1, CbCr row 1, Y row 2, ...
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+entity nv12_reader is
+    generic (
+        MAX_WIDTH       : integer := 4096;
+        BURST_LEN       : integer := 16;
+        MAX_OUTSTANDING : integer := 4
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+
+        -- Configuration
+        cfg_start       : in  std_logic;    -- Fetch one frame
+        cfg_base_addr   : in  std_logic_vector(31 downto 0);
+        cfg_width       : in  std_logic_vector(11 downto 0);
+        cfg_height      : in  std_logic_vector(11 downto 0);
+
+        -- AXI-Stream Output (YUV 4:2:2)
+        m_axis_tdata    : out std_logic_vector(15 downto 0);
+        m_axis_tvalid   : out std_logic;
+        m_axis_tready   : in  std_logic;
+        m_axis_tlast    : out std_logic;
+        m_axis_tuser    : out std_logic;
+
+        -- AXI4 Master (read only)
+        m_axi_araddr    : out std_logic_vector(31 downto 0);
+        m_axi_arlen     : out std_logic_vector(7 downto 0);
+        m_axi_arsize    : out std_logic_vector(2 downto 0);
+        m_axi_arburst   : out std_logic_vector(1 downto 0);
+        m_axi_arvalid   : out std_logic;
+        m_axi_arready   : in  std_logic;
+        m_axi_rdata     : in  std_logic_vector(63 downto 0);
+        m_axi_rresp     : in  std_logic_vector(1 downto 0);
+        m_axi_rlast     : in  std_logic;
+        m_axi_rvalid    : in  std_logic;
+        m_axi_rready    : out std_logic;
+
+        -- Status
+        busy            : out std_logic;
+        dma_error       : out std_logic
+    );
+end nv12_reader;
+
+architecture rtl of nv12_reader is
+
+    constant BEAT_BYTES  : integer := 8;
+
+    -- Chroma line buffer, one 64-bit word per 8 bytes (4 CbCr pairs)
+    type uv_buf_t is array (0 to MAX_WIDTH/BEAT_BYTES-1) of std_logic_vector(63 downto 0);
+    signal uv_buf       : uv_buf_t;
+
+    -- Plane geometry
+    signal row_beats    : unsigned(8 downto 0);
+    signal uv_plane     : unsigned(31 downto 0);
+
+    -- Read address path
+    type ar_state_t is (AR_IDLE, AR_SEGMENT, AR_NEXT, AR_ISSUE);
+    signal ar_state     : ar_state_t;
+    signal ar_row       : unsigned(11 downto 0);
+    signal ar_uv        : std_logic;   -- Current segment is a chroma row
+    signal ar_addr      : unsigned(31 downto 0);
+    signal ar_remain    : unsigned(8 downto 0);
+    signal ar_len       : unsigned(7 downto 0);
+    signal outstanding  : unsigned(3 downto 0);
+
+    -- Read data path (follows the same segment order)
+    signal rd_active    : std_logic;
+    signal rd_uv        : std_logic;
+    signal rd_row       : unsigned(11 downto 0);
+    signal rd_beat      : unsigned(8 downto 0);
+    signal rd_word      : std_logic_vector(63 downto 0);
+    signal rd_cword     : std_logic_vector(63 downto 0);
+    signal rd_lane      : unsigned(2 downto 0);
+    signal rd_full      : std_logic;
+    signal rd_ready     : std_logic;
+    signal beat_take    : std_logic;
+
+    -- Output position
+    signal out_x        : unsigned(11 downto 0);
+    signal out_first    : std_logic;
+    signal out_accept   : std_logic;
+
+    signal start_frame  : std_logic;
+    signal axi_error    : std_logic;
+
+begin
+
+    -- Starts are ignored while a frame is still in flight
+    start_frame <= '1' when cfg_start = '1' and ar_state = AR_IDLE and rd_active = '0' and
+                            rd_full = '0' else '0';
+
+    -- ==========================================================================
+    -- Plane Geometry
+    -- ==========================================================================
+    process(clk)
+    begin
+        if rising_edge(clk) then
+            row_beats <= resize(shift_right(unsigned(cfg_width), 3), 9);
+            uv_plane <= unsigned(cfg_base_addr) +
+                        resize(unsigned(cfg_width) * unsigned(cfg_height), 32);
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Read Address Generation: one segment per row
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable to_4k : unsigned(12 downto 0);
+        variable len   : unsigned(8 downto 0);
+    begin
+        if rst_n = '0' then
+            ar_state <= AR_IDLE;
+            ar_row <= (others => '0');
+            ar_uv <= '1';
+            ar_addr <= (others => '0');
+            ar_remain <= (others => '0');
+            ar_len <= (others => '0');
+        elsif rising_edge(clk) then
+            case ar_state is
+                when AR_IDLE =>
+                    if start_frame = '1' then
+                        ar_row <= (others => '0');
+                        ar_uv <= '1';
+                        ar_state <= AR_SEGMENT;
+                    end if;
+
+                when AR_SEGMENT =>
+                    if ar_uv = '1' then
+                        ar_addr <= uv_plane + resize(shift_right(ar_row, 1) * unsigned(cfg_width), 32);
+                    else
+                        ar_addr <= unsigned(cfg_base_addr) + resize(ar_row * unsigned(cfg_width), 32);
+                    end if;
+                    ar_remain <= row_beats;
+                    ar_state <= AR_NEXT;
+
+                when AR_NEXT =>
+                    if ar_remain = 0 then
+                        -- Next segment: luma after chroma, chroma before even rows
+                        if ar_uv = '1' then
+                            ar_uv <= '0';
+                            ar_state <= AR_SEGMENT;
+                        elsif ar_row = unsigned(cfg_height) - 1 then
+                            ar_state <= AR_IDLE;
+                        else
+                            ar_row <= ar_row + 1;
+                            ar_uv <= ar_row(0);
+                            ar_state <= AR_SEGMENT;
+                        end if;
+                    elsif outstanding < MAX_OUTSTANDING then
+                        to_4k := resize((4096 - resize(ar_addr(11 downto 0), 13)) / BEAT_BYTES, 13);
+                        len := ar_remain;
+                        if len > BURST_LEN then
+                            len := to_unsigned(BURST_LEN, 9);
+                        end if;
+                        if len > resize(to_4k, 9) then
+                            len := resize(to_4k, 9);
+                        end if;
+                        ar_len <= len(7 downto 0);
+                        ar_state <= AR_ISSUE;
+                    end if;
+
+                when AR_ISSUE =>
+                    if m_axi_arready = '1' then
+                        ar_addr <= ar_addr + resize(resize(ar_len, 24) * BEAT_BYTES, 32);
+                        ar_remain <= ar_remain - ar_len;
+                        ar_state <= AR_NEXT;
+                    end if;
+
+                when others =>
+                    ar_state <= AR_IDLE;
+            end case;
+        end if;
+    end process;
+
+    -- Outstanding read bursts (issued minus completed)
+    process(clk, rst_n)
+        variable issued    : std_logic;
+        variable completed : std_logic;
+    begin
+        if rst_n = '0' then
+            outstanding <= (others => '0');
+        elsif rising_edge(clk) then
+            issued := '0';
+            completed := '0';
+            if ar_state = AR_ISSUE and m_axi_arready = '1' then
+                issued := '1';
+            end if;
+            if beat_take = '1' and m_axi_rlast = '1' then
+                completed := '1';
+            end if;
+            if issued = '1' and completed = '0' then
+                outstanding <= outstanding + 1;
+            elsif issued = '0' and completed = '1' then
+                outstanding <= outstanding - 1;
+            end if;
+        end if;
+    end process;
+
+    m_axi_araddr <= std_logic_vector(ar_addr);
+    m_axi_arlen <= std_logic_vector(ar_len - 1);
+    m_axi_arsize <= "011";  -- 8 bytes per beat
+    m_axi_arburst <= "01";  -- INCR
+    m_axi_arvalid <= '1' when ar_state = AR_ISSUE else '0';
+
+    -- ==========================================================================
+    -- Read Data: chroma beats fill the line buffer, luma beats are unpacked
+    -- 8 pixels per beat alongside the matching chroma word
+    -- ==========================================================================
+    out_accept <= rd_full and m_axis_tready;
+
+    rd_ready <= '1' when rd_uv = '1' or rd_full = '0' or
+                         (m_axis_tready = '1' and rd_lane = BEAT_BYTES-1) else '0';
+    beat_take <= m_axi_rvalid and rd_ready and rd_active;
+
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            rd_active <= '0';
+            rd_uv <= '1';
+            rd_row <= (others => '0');
+            rd_beat <= (others => '0');
+            rd_word <= (others => '0');
+            rd_cword <= (others => '0');
+            rd_lane <= (others => '0');
+            rd_full <= '0';
+            axi_error <= '0';
+        elsif rising_edge(clk) then
+            if start_frame = '1' then
+                rd_active <= '1';
+                rd_uv <= '1';
+                rd_row <= (others => '0');
+                rd_beat <= (others => '0');
+                axi_error <= '0';
+            end if;
+
+            if out_accept = '1' then
+                if rd_lane = BEAT_BYTES-1 then
+                    rd_full <= '0';
+                end if;
+                rd_lane <= rd_lane + 1;
+            end if;
+
+            if beat_take = '1' then
+                if m_axi_rresp /= "00" then
+                    axi_error <= '1';
+                end if;
+
+                if rd_uv = '1' then
+                    uv_buf(to_integer(rd_beat)) <= m_axi_rdata;
+                else
+                    -- Overrides the lane/full update above
+                    rd_word <= m_axi_rdata;
+                    rd_cword <= uv_buf(to_integer(rd_beat));
+                    rd_lane <= (others => '0');
+                    rd_full <= '1';
+                end if;
+
+                -- Segment walk, mirroring the address path
+                if rd_beat = row_beats - 1 then
+                    rd_beat <= (others => '0');
+                    if rd_uv = '1' then
+                        rd_uv <= '0';
+                    elsif rd_row = unsigned(cfg_height) - 1 then
+                        rd_active <= '0';
+                    else
+                        rd_row <= rd_row + 1;
+                        rd_uv <= rd_row(0);
+                    end if;
+                else
+                    rd_beat <= rd_beat + 1;
+                end if;
+            end if;
+        end if;
+    end process;
+
+    m_axi_rready <= rd_ready and rd_active;
+
+    -- ==========================================================================
+    -- Output Position (SOF on the first pixel, EOL on the last of each row)
+    -- ==========================================================================
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            out_x <= (others => '0');
+            out_first <= '1';
+        elsif rising_edge(clk) then
+            if start_frame = '1' then
+                out_x <= (others => '0');
+                out_first <= '1';
+            elsif out_accept = '1' then
+                out_first <= '0';
+                if out_x = unsigned(cfg_width) - 1 then
+                    out_x <= (others => '0');
+                else
+                    out_x <= out_x + 1;
+                end if;
+            end if;
+        end if;
+    end process;
+
+    m_axis_tdata <= rd_cword(8*to_integer(rd_lane)+7 downto 8*to_integer(rd_lane)) &
+                    rd_word(8*to_integer(rd_lane)+7 downto 8*to_integer(rd_lane));
+    m_axis_tvalid <= rd_full;
+    m_axis_tlast <= '1' when out_x = unsigned(cfg_width) - 1 else '0';
+    m_axis_tuser <= out_first;
+
+    -- ==========================================================================
+    -- Status
+    -- ==========================================================================
+    busy <= '1' when ar_state /= AR_IDLE or rd_active = '1' or rd_full = '1' else '0';
+    dma_error <= axi_error;
+
+end rtl;
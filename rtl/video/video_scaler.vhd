@@ -0,0 +1,295 @@
+-- =============================================================================
+-- Streaming Crop and Bilinear Downscaler
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - Programmable crop ROI inside the source frame
+--   - Separable bilinear downscale to the CNN input resolution
+--   - One line buffer of output width (horizontal results of the last row)
+--   - At most one output pixel per input pixel, no stalls on the source
+--
+-- Source position of output pixel o on each axis:
+--   s = o * step + (step - 1) / 2     (step in Q16.16, step >= 1.0)
+-- The output is blended from source pixels floor(s) and floor(s) + 1, so
+-- the driver sets step = (crop - 1) / out to keep both inside the crop.
+-- A step of 0 disables scaling on that axis (crop only).
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+entity video_scaler is
+    generic (
+        MAX_OUT_WIDTH   : integer := 128    -- Line buffer depth
+    );
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+
+        -- Configuration (stable while a frame is in flight)
+        cfg_crop_x      : in  std_logic_vector(11 downto 0);
+        cfg_crop_y      : in  std_logic_vector(11 downto 0);
+        cfg_crop_width  : in  std_logic_vector(11 downto 0);
+        cfg_crop_height : in  std_logic_vector(11 downto 0);
+        cfg_out_width   : in  std_logic_vector(11 downto 0);
+        cfg_out_height  : in  std_logic_vector(11 downto 0);
+        cfg_step_x      : in  std_logic_vector(31 downto 0);  -- Q16.16, 0 = no scaling
+        cfg_step_y      : in  std_logic_vector(31 downto 0);  -- Q16.16, 0 = no scaling
+
+        -- AXI-Stream Input (RGB888, source resolution)
+        s_axis_tdata    : in  std_logic_vector(23 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;    -- End of line
+        s_axis_tuser    : in  std_logic;    -- Start of frame
+
+        -- AXI-Stream Output (RGB888, output resolution)
+        m_axis_tdata    : out std_logic_vector(23 downto 0);
+        m_axis_tvalid   : out std_logic;
+        m_axis_tready   : in  std_logic;
+        m_axis_tlast    : out std_logic;
+        m_axis_tuser    : out std_logic
+    );
+end video_scaler;
+
+architecture rtl of video_scaler is
+
+    subtype rgb_t is std_logic_vector(23 downto 0);
+    type line_buf_t is array (0 to MAX_OUT_WIDTH-1) of rgb_t;
+
+    -- Per-channel linear blend: a + (b - a) * f / 256
+    function lerp(a, b : rgb_t; f : unsigned(7 downto 0)) return rgb_t is
+        variable res  : rgb_t;
+        variable diff : signed(8 downto 0);
+        variable prod : signed(17 downto 0);
+        variable sum  : signed(9 downto 0);
+    begin
+        for c in 0 to 2 loop
+            diff := signed('0' & b(8*c+7 downto 8*c)) - signed('0' & a(8*c+7 downto 8*c));
+            prod := diff * signed('0' & f);
+            sum := signed("00" & a(8*c+7 downto 8*c)) + resize(shift_right(prod, 8), 10);
+            res(8*c+7 downto 8*c) := std_logic_vector(sum(7 downto 0));
+        end loop;
+        return res;
+    end function;
+
+    -- Initial phase (step - 1) / 2 of a scaled axis
+    function phase0(step : unsigned(31 downto 0)) return unsigned is
+    begin
+        if step = 0 then
+            return to_unsigned(0, 32);
+        end if;
+        return shift_right(step - 65536, 1);
+    end function;
+
+    -- Pipeline advance (whole pipeline stalls on output backpressure)
+    signal adv          : std_logic;
+    signal in_accept    : std_logic;
+
+    -- Source position (registers hold the position of the next pixel)
+    signal src_x        : unsigned(11 downto 0);
+    signal src_y        : unsigned(11 downto 0);
+    signal cur_x        : unsigned(11 downto 0);
+    signal cur_y        : unsigned(11 downto 0);
+    signal cx           : unsigned(11 downto 0);
+    signal cy           : unsigned(11 downto 0);
+    signal in_crop      : std_logic;
+
+    -- Horizontal resampler
+    signal hx_acc       : unsigned(31 downto 0);   -- Q16.16 source x of next output
+    signal ox           : unsigned(11 downto 0);
+    signal prev_px      : rgb_t;
+
+    -- Vertical resampler
+    signal vy_acc       : unsigned(31 downto 0);   -- Q16.16 source y of next output
+    signal oy           : unsigned(11 downto 0);
+    signal vy_cur       : unsigned(31 downto 0);
+    signal oy_cur       : unsigned(11 downto 0);
+    signal row_emit     : std_logic;
+
+    -- Stage A: horizontal result
+    signal a_valid      : std_logic;
+    signal a_data       : rgb_t;
+    signal a_x          : unsigned(11 downto 0);
+    signal a_emit       : std_logic;
+    signal a_fy         : unsigned(7 downto 0);
+    signal a_sof        : std_logic;
+    signal a_eol        : std_logic;
+
+    -- Stage B: vertical result
+    signal line_buf     : line_buf_t;
+    signal out_valid    : std_logic;
+    signal out_data     : rgb_t;
+    signal out_last     : std_logic;
+    signal out_user     : std_logic;
+
+begin
+
+    -- ==========================================================================
+    -- Source Position and Crop Window
+    -- ==========================================================================
+    -- SOF restarts the frame at (0, 0) and resets the vertical phase
+    cur_x <= (others => '0') when s_axis_tuser = '1' else src_x;
+    cur_y <= (others => '0') when s_axis_tuser = '1' else src_y;
+    vy_cur <= phase0(unsigned(cfg_step_y)) when s_axis_tuser = '1' else vy_acc;
+    oy_cur <= (others => '0') when s_axis_tuser = '1' else oy;
+
+    cx <= cur_x - unsigned(cfg_crop_x);
+    cy <= cur_y - unsigned(cfg_crop_y);
+    in_crop <= '1' when cur_x >= unsigned(cfg_crop_x) and cx < unsigned(cfg_crop_width) and
+                        cur_y >= unsigned(cfg_crop_y) and cy < unsigned(cfg_crop_height) else '0';
+
+    -- Current crop row produces an output row (bottom neighbour of the next
+    -- output row when scaling)
+    row_emit <= '0' when oy_cur >= unsigned(cfg_out_height) else
+                '1' when unsigned(cfg_step_y) = 0 else
+                '1' when cy = vy_cur(27 downto 16) + 1 else
+                '0';
+
+    -- ==========================================================================
+    -- Stage A: Crop and Horizontal Resample
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable hx_use : unsigned(31 downto 0);
+        variable ox_use : unsigned(11 downto 0);
+        variable emit   : boolean;
+        variable x_out  : unsigned(11 downto 0);
+        variable h_px   : rgb_t;
+    begin
+        if rst_n = '0' then
+            src_x <= (others => '0');
+            src_y <= (others => '0');
+            hx_acc <= (others => '0');
+            ox <= (others => '0');
+            prev_px <= (others => '0');
+            vy_acc <= (others => '0');
+            oy <= (others => '0');
+            a_valid <= '0';
+            a_data <= (others => '0');
+            a_x <= (others => '0');
+            a_emit <= '0';
+            a_fy <= (others => '0');
+            a_sof <= '0';
+            a_eol <= '0';
+        elsif rising_edge(clk) then
+            if adv = '1' then
+                a_valid <= '0';
+            end if;
+
+            if in_accept = '1' then
+                if s_axis_tlast = '1' then
+                    src_x <= (others => '0');
+                    src_y <= cur_y + 1;
+                else
+                    src_x <= cur_x + 1;
+                    src_y <= cur_y;
+                end if;
+                vy_acc <= vy_cur;
+                oy <= oy_cur;
+
+                if in_crop = '1' then
+                    -- Each crop row restarts the horizontal phase
+                    if cx = 0 then
+                        hx_use := phase0(unsigned(cfg_step_x));
+                        ox_use := (others => '0');
+                    else
+                        hx_use := hx_acc;
+                        ox_use := ox;
+                    end if;
+
+                    emit := false;
+                    x_out := cx;
+                    h_px := s_axis_tdata;
+                    if unsigned(cfg_step_x) = 0 then
+                        -- Crop only
+                        emit := cx < unsigned(cfg_out_width);
+                    elsif cx /= 0 and ox_use < unsigned(cfg_out_width) and
+                          cx = hx_use(27 downto 16) + 1 then
+                        -- Right neighbour of the next output sample
+                        emit := true;
+                        x_out := ox_use;
+                        h_px := lerp(prev_px, s_axis_tdata, hx_use(15 downto 8));
+                        hx_use := hx_use + unsigned(cfg_step_x);
+                        ox_use := ox_use + 1;
+                    end if;
+                    hx_acc <= hx_use;
+                    ox <= ox_use;
+                    prev_px <= s_axis_tdata;
+
+                    if emit then
+                        a_valid <= '1';
+                        a_data <= h_px;
+                        a_x <= x_out;
+                        a_emit <= row_emit;
+                        a_fy <= vy_cur(15 downto 8);
+                        if x_out = 0 and oy_cur = 0 then
+                            a_sof <= '1';
+                        else
+                            a_sof <= '0';
+                        end if;
+                        if x_out = unsigned(cfg_out_width) - 1 then
+                            a_eol <= '1';
+                        else
+                            a_eol <= '0';
+                        end if;
+                    end if;
+
+                    -- End of crop row: advance the vertical phase
+                    if cx = unsigned(cfg_crop_width) - 1 and row_emit = '1' then
+                        oy <= oy_cur + 1;
+                        if unsigned(cfg_step_y) /= 0 then
+                            vy_acc <= vy_cur + unsigned(cfg_step_y);
+                        end if;
+                    end if;
+                end if;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Stage B: Vertical Resample against the previous row
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable above : rgb_t;
+    begin
+        if rst_n = '0' then
+            out_valid <= '0';
+            out_data <= (others => '0');
+            out_last <= '0';
+            out_user <= '0';
+        elsif rising_edge(clk) then
+            if adv = '1' then
+                out_valid <= '0';
+                if a_valid = '1' then
+                    above := line_buf(to_integer(a_x) mod MAX_OUT_WIDTH);
+                    line_buf(to_integer(a_x) mod MAX_OUT_WIDTH) <= a_data;
+
+                    if a_emit = '1' then
+                        out_valid <= '1';
+                        if unsigned(cfg_step_y) = 0 then
+                            out_data <= a_data;
+                        else
+                            out_data <= lerp(above, a_data, a_fy);
+                        end if;
+                        out_last <= a_eol;
+                        out_user <= a_sof;
+                    end if;
+                end if;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Flow Control and Outputs
+    -- ==========================================================================
+    adv <= m_axis_tready or not out_valid;
+    in_accept <= s_axis_tvalid and adv;
+    s_axis_tready <= adv;
+
+    m_axis_tdata <= out_data;
+    m_axis_tvalid <= out_valid;
+    m_axis_tlast <= out_last;
+    m_axis_tuser <= out_user;
+
+end rtl;
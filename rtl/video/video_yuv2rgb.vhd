@@ -0,0 +1,245 @@
+-- =============================================================================
+-- YUV 4:2:2 to RGB888 Color Converter
+-- Target: ZUBoard 1CG (xczu1cg-sbva484-1-e)
+--
+-- Features:
+--   - 4:2:2 input, one pixel per beat: Y[7:0], chroma[15:8]
+--     (Cb on even columns, Cr on odd columns, as in AXI4-Stream video)
+--   - Both pixels of a pair are converted with the pair's Cb / Cr
+--   - BT.601 or BT.709 matrix, limited (16-235) or full range
+--   - Fixed-point Q2.10 coefficients, rounded and clamped to 0..255
+--
+-- Throughput is two pixels every three cycles: the odd pixel of each pair
+-- completes the chroma and both pixels leave back to back. The CNN front end
+-- serializes three channels per pixel, so this never limits the pipeline.
+-- =============================================================================
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+entity video_yuv2rgb is
+    port (
+        clk             : in  std_logic;
+        rst_n           : in  std_logic;
+
+        -- Configuration
+        cfg_bt709       : in  std_logic;    -- '0' = BT.601
+        cfg_full_range  : in  std_logic;    -- '0' = limited (video) range
+
+        -- AXI-Stream Input (YUV 4:2:2)
+        s_axis_tdata    : in  std_logic_vector(15 downto 0);
+        s_axis_tvalid   : in  std_logic;
+        s_axis_tready   : out std_logic;
+        s_axis_tlast    : in  std_logic;    -- End of line
+        s_axis_tuser    : in  std_logic;    -- Start of frame
+
+        -- AXI-Stream Output (RGB888: R[23:16], G[15:8], B[7:0])
+        m_axis_tdata    : out std_logic_vector(23 downto 0);
+        m_axis_tvalid   : out std_logic;
+        m_axis_tready   : in  std_logic;
+        m_axis_tlast    : out std_logic;
+        m_axis_tuser    : out std_logic
+    );
+end video_yuv2rgb;
+
+architecture rtl of video_yuv2rgb is
+
+    subtype coef_t is signed(12 downto 0);
+
+    -- Round Q2.10 and clamp to an 8-bit channel
+    function clamp8(acc : signed) return std_logic_vector is
+        variable v : signed(acc'length-1 downto 0);
+    begin
+        v := shift_right(acc + 512, 10);
+        if v < 0 then
+            return x"00";
+        elsif v > 255 then
+            return x"FF";
+        end if;
+        return std_logic_vector(v(7 downto 0));
+    end function;
+
+    -- Matrix coefficients (x1024), selected once per configuration
+    signal k_y, k_rv, k_gu, k_gv, k_bu : coef_t;
+    signal y_off        : signed(9 downto 0);
+
+    -- Pairing stage
+    signal even_y       : std_logic_vector(7 downto 0);
+    signal even_u       : std_logic_vector(7 downto 0);
+    signal even_user    : std_logic;
+    signal have_even    : std_logic;
+    signal last_v       : std_logic_vector(7 downto 0);
+    signal pend         : std_logic;   -- Odd pixel waiting behind its partner
+    signal pend_y       : std_logic_vector(7 downto 0);
+    signal pend_last    : std_logic;
+
+    -- Matrix stage input (one pixel with full chroma)
+    signal c_valid      : std_logic;
+    signal c_y          : std_logic_vector(7 downto 0);
+    signal c_u          : std_logic_vector(7 downto 0);
+    signal c_v          : std_logic_vector(7 downto 0);
+    signal c_last       : std_logic;
+    signal c_user       : std_logic;
+
+    -- Output
+    signal out_valid    : std_logic;
+    signal out_data     : std_logic_vector(23 downto 0);
+    signal out_last     : std_logic;
+    signal out_user     : std_logic;
+
+    signal adv          : std_logic;
+    signal in_accept    : std_logic;
+
+begin
+
+    -- ==========================================================================
+    -- Coefficient Selection
+    -- ==========================================================================
+    process(cfg_bt709, cfg_full_range)
+    begin
+        if cfg_full_range = '1' then
+            k_y <= to_signed(1024, 13);
+            y_off <= to_signed(0, 10);
+            if cfg_bt709 = '1' then
+                k_rv <= to_signed(1613, 13);
+                k_gu <= to_signed(192, 13);
+                k_gv <= to_signed(479, 13);
+                k_bu <= to_signed(1900, 13);
+            else
+                k_rv <= to_signed(1436, 13);
+                k_gu <= to_signed(352, 13);
+                k_gv <= to_signed(731, 13);
+                k_bu <= to_signed(1815, 13);
+            end if;
+        else
+            k_y <= to_signed(1192, 13);
+            y_off <= to_signed(16, 10);
+            if cfg_bt709 = '1' then
+                k_rv <= to_signed(1836, 13);
+                k_gu <= to_signed(218, 13);
+                k_gv <= to_signed(546, 13);
+                k_bu <= to_signed(2163, 13);
+            else
+                k_rv <= to_signed(1634, 13);
+                k_gu <= to_signed(401, 13);
+                k_gv <= to_signed(833, 13);
+                k_bu <= to_signed(2066, 13);
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Pairing: hold the even pixel until the odd one brings Cr
+    -- ==========================================================================
+    process(clk, rst_n)
+    begin
+        if rst_n = '0' then
+            even_y <= (others => '0');
+            even_u <= x"80";
+            even_user <= '0';
+            have_even <= '0';
+            last_v <= x"80";
+            pend <= '0';
+            pend_y <= (others => '0');
+            pend_last <= '0';
+            c_valid <= '0';
+            c_y <= (others => '0');
+            c_u <= x"80";
+            c_v <= x"80";
+            c_last <= '0';
+            c_user <= '0';
+        elsif rising_edge(clk) then
+            if adv = '1' then
+                c_valid <= '0';
+
+                if pend = '1' then
+                    -- Second pixel of the pair, same chroma
+                    c_valid <= '1';
+                    c_y <= pend_y;
+                    c_last <= pend_last;
+                    c_user <= '0';
+                    pend <= '0';
+                elsif in_accept = '1' then
+                    if have_even = '0' or s_axis_tuser = '1' then
+                        -- Even column: Y0 / Cb
+                        even_y <= s_axis_tdata(7 downto 0);
+                        even_u <= s_axis_tdata(15 downto 8);
+                        even_user <= s_axis_tuser;
+                        have_even <= '1';
+                        if s_axis_tlast = '1' then
+                            -- Odd-width row: no partner, reuse the last Cr
+                            c_valid <= '1';
+                            c_y <= s_axis_tdata(7 downto 0);
+                            c_u <= s_axis_tdata(15 downto 8);
+                            c_v <= last_v;
+                            c_last <= '1';
+                            c_user <= s_axis_tuser;
+                            have_even <= '0';
+                        end if;
+                    else
+                        -- Odd column: Y1 / Cr completes the pair
+                        c_valid <= '1';
+                        c_y <= even_y;
+                        c_u <= even_u;
+                        c_v <= s_axis_tdata(15 downto 8);
+                        c_last <= '0';
+                        c_user <= even_user;
+                        last_v <= s_axis_tdata(15 downto 8);
+                        pend <= '1';
+                        pend_y <= s_axis_tdata(7 downto 0);
+                        pend_last <= s_axis_tlast;
+                        have_even <= '0';
+                    end if;
+                end if;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Matrix
+    --   R = k_y (Y - off) + k_rv (Cr - 128)
+    --   G = k_y (Y - off) - k_gu (Cb - 128) - k_gv (Cr - 128)
+    --   B = k_y (Y - off) + k_bu (Cb - 128)
+    -- ==========================================================================
+    process(clk, rst_n)
+        variable yy     : signed(22 downto 0);
+        variable cb, cr : signed(9 downto 0);
+        variable r, g, b: signed(24 downto 0);
+    begin
+        if rst_n = '0' then
+            out_valid <= '0';
+            out_data <= (others => '0');
+            out_last <= '0';
+            out_user <= '0';
+        elsif rising_edge(clk) then
+            if adv = '1' then
+                out_valid <= c_valid;
+                out_last <= c_last;
+                out_user <= c_user;
+                if c_valid = '1' then
+                    yy := (signed("00" & c_y) - y_off) * k_y;
+                    cb := signed("00" & c_u) - 128;
+                    cr := signed("00" & c_v) - 128;
+                    r := resize(yy, 25) + resize(cr * k_rv, 25);
+                    g := resize(yy, 25) - resize(cb * k_gu, 25) - resize(cr * k_gv, 25);
+                    b := resize(yy, 25) + resize(cb * k_bu, 25);
+                    out_data <= clamp8(r) & clamp8(g) & clamp8(b);
+                end if;
+            end if;
+        end if;
+    end process;
+
+    -- ==========================================================================
+    -- Flow Control and Outputs
+    -- ==========================================================================
+    adv <= m_axis_tready or not out_valid;
+    in_accept <= s_axis_tvalid and adv and not pend;
+    s_axis_tready <= adv and not pend;
+
+    m_axis_tdata <= out_data;
+    m_axis_tvalid <= out_valid;
+    m_axis_tlast <= out_last;
+    m_axis_tuser <= out_user;
+
+end rtl;
@@ -42,15 +42,64 @@
 #define CNN_REG_IRQ_STATUS      0x24
 #define CNN_REG_PERF_CYCLES     0x28
 #define CNN_REG_PERF_OPS        0x2C
+#define CNN_REG_FMAP_ADDR       0x30
+#define CNN_REG_TILE_CFG        0x34
+#define CNN_REG_FB_CTRL         0x38
+#define CNN_REG_FB_STATS        0x3C
+#define CNN_REG_SRC_DIM         0x40
+#define CNN_REG_CROP_ORIGIN     0x44
+#define CNN_REG_CROP_DIM        0x48
+#define CNN_REG_SCALE_X         0x4C
+#define CNN_REG_SCALE_Y         0x50
+#define CNN_REG_NORM_R          0x54
+#define CNN_REG_NORM_G          0x58
+#define CNN_REG_NORM_B          0x5C
+#define CNN_REG_INPUT_FMT       0x60
+#define CNN_REG_RING_BASE       0x64
+#define CNN_REG_RING_CFG        0x68
+#define CNN_REG_RING_HEAD       0x6C
+#define CNN_REG_RING_TAIL       0x70
+#define CNN_REG_COMPLETIONS     0x74
+#define CNN_REG_IRQ_COALESCE    0x78
+#define CNN_REG_IRQ_TIMEOUT     0x7C
+#define CNN_REG_STREAM_CTRL     0x80
+#define CNN_REG_FRAME_TAG       0x84
+#define CNN_REG_TOPK_STATUS     0x88
+#define CNN_REG_TOPK(k)         (0x8C + (k) * 4)
+#define CNN_REG_DET_CFG         0xA0
+#define CNN_REG_DET_CELL        0xA4
+#define CNN_REG_DET_ANCHOR      0xA8
+#define CNN_REG_DET_THRESH      0xAC
+#define CNN_REG_DET_ADDR        0xB0
+#define CNN_REG_DET_STATUS      0xB4
+
+/* Identification bank (read-only) */
+#define CNN_REG_CORE_ID         0x100
+#define CNN_REG_CORE_VERSION    0x104
+#define CNN_REG_CAPABILITIES    0x108
+#define CNN_REG_ENGINE          0x10C
+#define CNN_REG_BUILD_DIM       0x110
+
+/* Per conv layer bank: 0x200 + layer * 0x20 */
+#define CNN_REG_LAYER(n, off)   (0x200 + (uint32_t)(n) * 0x20 + (off))
+#define CNN_LAYER_CFG           0x00
+#define CNN_LAYER_CYCLES        0x04
+#define CNN_LAYER_STALLS        0x08
+#define CNN_LAYER_BEATS         0x0C
+#define CNN_LAYER_FIFO_HWM      0x10
+#define CNN_LAYER_QUANT         0x14
+#define CNN_MAX_LAYERS          8
 
 /* Control register bits */
 #define CNN_CTRL_START          0x01
 #define CNN_CTRL_STOP           0x02
 #define CNN_CTRL_RESET          0x04
+#define CNN_CTRL_COMMIT         0x08    /* Apply shadowed config at the next frame boundary */
 
 /* Status register bits */
 #define CNN_STAT_BUSY           0x01
 #define CNN_STAT_DONE           0x02
+#define CNN_STAT_COMMIT_PENDING 0x08
 #define CNN_STAT_ERROR_MASK     0xF0
 
 /* Config register bits */
@@ -58,11 +107,162 @@
 #define CNN_CFG_ACT_MASK        0x00000700
 #define CNN_CFG_ACT_SHIFT       8
 #define CNN_CFG_POOL_TYPE       0x00000800
+#define CNN_CFG_BN_ENABLE       0x00001000
+
+/* Layer config register bits (CONFIG fields apply unless OVERRIDE is set) */
+#define CNN_LAYER_ACT_MASK      0x00000007
+#define CNN_LAYER_BN_ENABLE     0x00000008
+#define CNN_LAYER_POOL_TYPE     0x00000010
+#define CNN_LAYER_INT8          0x00000020
+#define CNN_LAYER_SPARSE        0x00000040
+#define CNN_LAYER_GEMM          0x00000080  /* im2col + systolic backend */
+#define CNN_LAYER_OVERRIDE      0x80000000
+
+/* Identification */
+#define CNN_CORE_ID_VALUE       0x434E4E41  /* "CNNA" */
+#define CNN_VERSION_MAJOR(v)    ((v) >> 24)
+#define CNN_VERSION_MINOR(v)    (((v) >> 16) & 0xFF)
+#define CNN_VERSION_PATCH(v)    ((v) & 0xFFFF)
+
+/* Capability bits */
+#define CNN_CAP_BATCHNORM       0x00000001
+#define CNN_CAP_FUSED_POOL      0x00000002
+#define CNN_CAP_TILING          0x00000004
+#define CNN_CAP_FRAME_BUFFER    0x00000008
+#define CNN_CAP_SCALER          0x00000010
+#define CNN_CAP_NORM            0x00000020
+#define CNN_CAP_YUV             0x00000040
+#define CNN_CAP_NV12            0x00000080
+#define CNN_CAP_CMD_RING        0x00000100
+#define CNN_CAP_IRQ_COALESCE    0x00000200
+#define CNN_CAP_LAYER_CFG       0x00000400
+#define CNN_CAP_SHADOW_CFG      0x00000800
+#define CNN_CAP_STREAMING       0x00001000
+#define CNN_CAP_FRAME_OVERLAP   0x00002000
+#define CNN_CAP_LINK_FIFO       0x00004000
+#define CNN_CAP_INT8            0x00008000
+#define CNN_CAP_SPARSE          0x00010000
+#define CNN_CAP_WINOGRAD        0x00020000  /* Weights packed with --winograd */
+#define CNN_CAP_GEMM            0x00040000  /* GEMM backend on the last layer */
+#define CNN_CAP_TOPK            0x00080000  /* Top-K result registers */
+#define CNN_CAP_NMS             0x00100000  /* Box decode + NMS to DDR */
+
+/* Streaming control register bits */
+#define CNN_STREAM_ENABLE       0x00000001
+#define CNN_STREAM_OVERLAP      0x00000002
+
+/* Frame tag register fields */
+#define CNN_FRAME_TAG_DONE_MASK 0x0000FFFF
+#define CNN_FRAME_TAG_FRONT_SHIFT 16
+
+/* Tiling register bits */
+#define CNN_TILE_ENABLE         0x00000001
+#define CNN_TILE_ROWS_MASK      0x0000FF00
+#define CNN_TILE_ROWS_SHIFT     8
+
+/* On-chip budget for one refilled stripe and its halo rows */
+#define CNN_TILE_HALO_ROWS      1
+#define CNN_TILE_BUDGET_BYTES   (64 * 1024)
+
+/* Frame buffer register bits */
+#define CNN_FB_ENABLE           0x00000001
+#define CNN_FB_LATEST_WINS      0x00000002
+#define CNN_FB_DROPS_MASK       0x0000FFFF
+#define CNN_FB_OVERRUNS_SHIFT   16
+
+/* Top-K registers (last completed frame, best entry first) */
+#define CNN_TOPK_MAX            5
+#define CNN_TOPK_CLASSES_MASK   0x0000FFFF  /* Logits in the frame */
+#define CNN_TOPK_VALID_MASK     0x000F0000  /* Entries in use */
+#define CNN_TOPK_VALID_SHIFT    16
+#define CNN_TOPK_CLASS_SHIFT    16          /* Entry: class (31:16), logit (15:0) */
+
+/* Detection registers */
+#define CNN_DET_ENABLE          0x00000001
+#define CNN_DET_GRID_W_SHIFT    8
+#define CNN_DET_IOU_SHIFT       16          /* DET_THRESH: IoU Q0.8 (23:16), score Q8.8 (15:0) */
+#define CNN_DET_COUNT_MASK      0x000000FF  /* DET_STATUS: boxes in the last frame */
+#define CNN_DET_CANDIDATES_SHIFT 16         /* DET_STATUS: boxes over the threshold */
+
+/* Detection output: one 8-byte header, then 16 bytes per box */
+#define CNN_DET_ALIGN           512
+#define CNN_DET_BYTES           (8 + 16 * CNN_MAX_DETECTIONS)
+#define CNN_DET_FIELDS          6           /* score, class, tx, ty, tw, th per cell */
+
+/* Frame buffer: 3 buffers of one 32-bit word per pixel at INPUT_ADDR */
+#define CNN_FB_NUM_BUFFERS      3
+#define CNN_FB_BYTES(w, h)      (CNN_FB_NUM_BUFFERS * (uint32_t)(w) * (h) * 4)
+
+/* Crop/scale: steps are Q16.16 source pixels per output pixel */
+#define CNN_SCALE_ONE           0x00010000
+#define CNN_MAX_SRC_DIM         4095
+
+/* Normalization: out = (pixel - mean) * scale, per channel.
+ * [15:0] mean in Q8.8 pixel units (0..255), [31:16] scale in Q1.15.
+ * The reset value maps [0, 255] to [-1, 1]. */
+#define CNN_NORM_MEAN_MASK      0x0000FFFF
+#define CNN_NORM_SCALE_SHIFT    16
+#define CNN_NORM_DEFAULT        0x01008000
+
+/* Input format register bits */
+#define CNN_FMT_MASK            0x00000003
+#define CNN_FMT_BT709           0x00000010
+#define CNN_FMT_FULL_RANGE      0x00000020
+
+/* NV12 at INPUT_ADDR: Y plane, then interleaved CbCr at half height */
+#define CNN_NV12_BYTES(w, h)    ((uint32_t)(w) * (h) + (uint32_t)(w) * (((h) + 1) / 2))
+
+/* Command ring register bits */
+#define CNN_RING_SIZE_MASK      0x0000FFFF
+#define CNN_RING_ENABLE         0x80000000
+
+/* Descriptor status, written back by the hardware on completion */
+#define CNN_DESC_DONE           0x00000001
+#define CNN_DESC_ERROR_MASK     0x000000F0
+#define CNN_DESC_ERROR_SHIFT    4
 
 /* Interrupt bits */
 #define CNN_IRQ_DONE            0x01
 #define CNN_IRQ_ERROR           0x02
 
+/* ============================================================================
+ * Parameter Stream Format (weight DMA -> accelerator)
+ * ============================================================================ */
+
+/* Section header: [31:28] section, [27:24] conv layer, [23:16] filter or
+ * start channel, [15:0] number of values. Weights and biases follow packed
+ * two Q8.8 values per word (low half first); batchnorm follows one channel
+ * per word (scale in the low half, bias in the high half). Int8 weights
+ * follow four per word (low byte first); quantization follows two words
+ * per channel, int32 bias then CNN_QUANT_WORD(), and counts words.
+ * Sparse weights follow in groups of 32 taps: a bitmask word (bit i set =
+ * tap i nonzero), then that group's nonzero Q8.8 values two per word; the
+ * count is the dense number of taps. Builds with CNN_CAP_WINOGRAD take 16
+ * transformed weights per input channel (cnn_pack.py --winograd). */
+#define CNN_PARAM_SEC_WEIGHTS   0x1
+#define CNN_PARAM_SEC_BIASES    0x2
+#define CNN_PARAM_SEC_BN        0x3
+#define CNN_PARAM_SEC_WEIGHTS8  0x4
+#define CNN_PARAM_SEC_QUANT     0x5
+#define CNN_PARAM_SEC_SPARSE    0x6
+
+/* Requantization word: multiplier in Q0.24 ([23:0]), power-of-two shift
+ * ([31:24], positive = left), i.e. scale = mult * 2^(shift - 24) */
+#define CNN_QUANT_WORD(mult, shift) \
+    ((((uint32_t)(int8_t)(shift) & 0xFF) << 24) | ((uint32_t)(mult) & 0xFFFFFF))
+
+#define CNN_PARAM_HDR(sec, layer, index, count) \
+    ((((uint32_t)(sec) & 0xF) << 28) | (((uint32_t)(layer) & 0xF) << 24) | \
+     (((uint32_t)(index) & 0xFF) << 16) | ((uint32_t)(count) & 0xFFFF))
+
+/* AXI DMA (simple mode) MM2S registers used to stream parameters */
+#define CNN_DMA_MM2S_CR         0x00
+#define CNN_DMA_MM2S_SR         0x04
+#define CNN_DMA_MM2S_SA         0x18
+#define CNN_DMA_MM2S_LENGTH     0x28
+#define CNN_DMA_CR_RUN          0x01
+#define CNN_DMA_SR_IDLE         0x02
+
 /* ============================================================================
  * Activation Functions
  * ============================================================================ */
@@ -74,7 +274,8 @@ typedef enum {
     CNN_ACT_LEAKY_RELU = 3,
     CNN_ACT_SIGMOID = 4,
     CNN_ACT_TANH = 5,
-    CNN_ACT_SWISH = 6
+    CNN_ACT_SWISH = 6,
+    CNN_ACT_EXT = 7         /* Build-time table: GELU (default) or hard-swish */
 } CnnActivation_t;
 
 /* ============================================================================
@@ -86,6 +287,31 @@ typedef enum {
     CNN_POOL_AVG = 1
 } CnnPoolType_t;
 
+/* ============================================================================
+ * Frame Policies
+ * ============================================================================ */
+
+typedef enum {
+    CNN_FRAME_DIRECT = 0,   /* No frame buffer: camera streams into the pipeline */
+    CNN_FRAME_EVERY = 1,    /* Buffer every frame, stall the camera when behind */
+    CNN_FRAME_LATEST = 2    /* Buffer, always process the newest complete frame */
+} CnnFramePolicy_t;
+
+/* ============================================================================
+ * Input Formats
+ * ============================================================================ */
+
+typedef enum {
+    CNN_INPUT_RGB888 = 0,   /* Camera/DMA stream, one RGB888 pixel per beat */
+    CNN_INPUT_YUV422 = 1,   /* Camera stream, Y[7:0] + Cb/Cr[15:8] per beat */
+    CNN_INPUT_NV12 = 2      /* NV12 frame read from INPUT_ADDR on each start */
+} CnnInputFormat_t;
+
+typedef enum {
+    CNN_CSC_BT601 = 0,
+    CNN_CSC_BT709 = 1
+} CnnColorMatrix_t;
+
 /* ============================================================================
  * CNN Configuration Structure
  * ============================================================================ */
@@ -98,6 +324,18 @@ typedef struct {
     uint8_t layer_enable;       /* Bitmask for enabled layers */
     CnnActivation_t activation;
     CnnPoolType_t pool_type;
+    uint8_t bn_enable;          /* Inline batchnorm (0 when BN is folded) */
+    uint8_t stripe_rows;        /* Tiled layer-1 stripe height (0 = untiled) */
+    CnnFramePolicy_t frame_policy;
+    uint16_t src_width;         /* Camera frame size (0 = input size) */
+    uint16_t src_height;
+    uint16_t crop_x;            /* Crop ROI in the camera frame, scaled */
+    uint16_t crop_y;            /* to input_width x input_height */
+    uint16_t crop_width;        /* (0 = no crop/scale) */
+    uint16_t crop_height;
+    CnnInputFormat_t input_format;
+    CnnColorMatrix_t color_matrix;  /* YUV inputs only */
+    uint8_t full_range;         /* YUV 0..255 instead of 16..235 */
 } CnnConfig_t;
 
 /* ============================================================================
@@ -110,6 +348,8 @@ typedef struct {
     uint8_t error_code;
     uint32_t cycles;
     uint32_t operations;
+    uint16_t frames_dropped;    /* Frames replaced before processing */
+    uint16_t frame_overruns;    /* Frames that stalled the camera */
 } CnnStatus_t;
 
 /* ============================================================================
@@ -133,6 +373,12 @@ typedef struct {
     float y_max;
 } DetectionResult_t;
 
+/* Top-K register entry (CNN_CAP_TOPK): raw Q8.8 logit, best first */
+typedef struct {
+    int class_id;
+    int16_t logit;
+} CnnTopKEntry_t;
+
 typedef struct {
     int num_results;
     union {
@@ -141,6 +387,79 @@ typedef struct {
     };
 } InferenceResult_t;
 
+/* ============================================================================
+ * Command Ring Descriptor (64 bytes, 64-byte aligned: one A53 cache line,
+ * so cache maintenance on one descriptor never touches its neighbour)
+ * ============================================================================ */
+
+#define CNN_DESC_ALIGN          64
+
+typedef struct {
+    uint32_t input_addr;        /* Frame for the NV12 reader / frame buffer */
+    uint32_t output_addr;       /* Result map destination (128-byte aligned) */
+    uint32_t model_addr;        /* Parameter blob, returned for bookkeeping */
+    uint32_t flags;
+    uint32_t reserved[2];
+    volatile uint32_t status;   /* CNN_DESC_DONE | error code */
+    volatile uint32_t cycles;   /* Pipeline cycles for this job */
+    uint32_t pad[8];            /* Fill the cache line */
+} CnnDescriptor_t;
+
+/* ============================================================================
+ * Per-Layer Configuration and Telemetry
+ * ============================================================================ */
+
+typedef struct {
+    CnnActivation_t activation;
+    CnnPoolType_t pool_type;
+    uint8_t bn_enable;
+    uint8_t int8;               /* Int8 datapath, see CNN_SetLayerQuant */
+    uint8_t sparse;             /* Skip zero taps on the MAC lanes (sparse builds) */
+    uint8_t gemm;               /* GEMM backend (last layer, Q8.8, no inline BN) */
+} CnnLayerConfig_t;
+
+/* Detection head decoded in hardware: CNN_DET_FIELDS results per grid cell,
+ * cells in raster order, one anchor per cell */
+typedef struct {
+    uint8_t grid_w;             /* Cells per row */
+    uint8_t grid_h;             /* Cell rows */
+    float anchor_w;             /* Anchor size as a fraction of the image */
+    float anchor_h;
+    float score_threshold;      /* Minimum sigmoid(score) */
+    float iou_threshold;        /* Overlap that suppresses a lower-scored box */
+    uint32_t output_addr;       /* Box list destination (512-byte aligned) */
+} CnnDetectConfig_t;
+
+/* Int8 layer quantization (TFLite asymmetric activations, symmetric weights) */
+typedef struct {
+    int8_t input_zero_point;
+    int8_t output_zero_point;
+    int8_t act_min;             /* Fused activation clamp, quantized */
+    int8_t act_max;
+} CnnLayerQuant_t;
+
+typedef struct {
+    uint32_t cycles;            /* Busy cycles in the last run */
+    uint32_t stalls;            /* Cycles the output was held off downstream */
+    uint32_t beats;             /* Output pixels produced */
+    uint16_t fifo_high_water;   /* Peak input FIFO occupancy since last clear */
+} CnnLayerStats_t;
+
+/* ============================================================================
+ * Hardware Description (read at CNN_Init)
+ * ============================================================================ */
+
+typedef struct {
+    uint32_t version;           /* [31:24] major, [23:16] minor, [15:0] patch */
+    uint32_t caps;              /* CNN_CAP_* */
+    uint8_t num_layers;         /* Conv layers in the pipeline */
+    uint8_t mac_units;          /* Parallel MACs per conv engine */
+    uint8_t data_width;
+    uint8_t frac_bits;
+    uint16_t max_width;         /* Largest input the line buffers hold */
+    uint16_t max_height;
+} CnnHwInfo_t;
+
 /* ============================================================================
  * CNN Accelerator Handle
  * ============================================================================ */
@@ -150,11 +469,20 @@ typedef struct {
     uint32_t dma_video_addr;
     uint32_t dma_weights_addr;
     CnnConfig_t config;
+    CnnHwInfo_t hw;
     uint32_t weight_mem_addr;
     uint32_t bias_mem_addr;
     uint32_t input_frame_addr;
     uint32_t output_result_addr;
+    uint32_t fmap_mem_addr;     /* DDR scratch for spilled feature maps */
+    uint32_t det_result_addr;   /* Box list from the NMS unit (0 = off) */
     volatile int inference_done;
+    CnnDescriptor_t *ring;      /* Command ring (NULL = register-driven) */
+    uint16_t ring_size;
+    uint16_t ring_tail;         /* Next descriptor to fill */
+    uint16_t ring_reap;         /* Next descriptor to reap */
+    void (*ring_handler)(void *ref, const CnnDescriptor_t *desc);
+    void *ring_handler_ref;     /* Passed back to ring_handler */
 } CnnAccelerator_t;
 
 /* ============================================================================
@@ -169,13 +497,70 @@ typedef struct {
 int CNN_Init(CnnAccelerator_t *cnn);
 
 /**
- * Configure the CNN accelerator
+ * Check whether the loaded bitstream implements a feature
+ * @param cnn Pointer to CNN accelerator handle
+ * @param cap CNN_CAP_* bit(s)
+ * @return 1 if all requested capabilities are present, 0 otherwise
+ */
+int CNN_HasCapability(const CnnAccelerator_t *cnn, uint32_t cap);
+
+/**
+ * Override activation / pooling / batchnorm for one conv layer
+ * @param cnn Pointer to CNN accelerator handle
+ * @param layer Conv layer index (0 .. hw.num_layers - 1)
+ * @param layer_cfg Layer settings, or NULL to follow the global CONFIG
+ * @return XST_SUCCESS or XST_FAILURE
+ */
+int CNN_SetLayerConfig(CnnAccelerator_t *cnn, uint8_t layer, const CnnLayerConfig_t *layer_cfg);
+
+/**
+ * Set the zero points and activation clamp of an int8 conv layer
+ * (per-channel bias / multiplier / shift come from the parameter blob)
+ * @param cnn Pointer to CNN accelerator handle
+ * @param layer Conv layer index (0 .. hw.num_layers - 1)
+ * @param quant Quantization settings, or NULL for zero points 0, full range
+ * @return XST_SUCCESS or XST_FAILURE
+ */
+int CNN_SetLayerQuant(CnnAccelerator_t *cnn, uint8_t layer, const CnnLayerQuant_t *quant);
+
+/**
+ * Read the per-layer counters of the last run
+ * @param cnn Pointer to CNN accelerator handle
+ * @param layer Conv layer index (0 .. hw.num_layers - 1)
+ * @param stats Receives the counters
+ * @return XST_SUCCESS or XST_FAILURE
+ */
+int CNN_GetLayerStats(CnnAccelerator_t *cnn, uint8_t layer, CnnLayerStats_t *stats);
+
+/**
+ * Reset the input FIFO high-water marks of all conv layers
+ * @param cnn Pointer to CNN accelerator handle
+ */
+void CNN_ClearFifoHighWater(CnnAccelerator_t *cnn);
+
+/**
+ * Configure the CNN accelerator; safe while a frame is in flight, the new
+ * settings apply from the next frame on
  * @param cnn Pointer to CNN accelerator handle
  * @param config Pointer to configuration structure
  * @return XST_SUCCESS or XST_FAILURE
  */
 int CNN_Configure(CnnAccelerator_t *cnn, const CnnConfig_t *config);
 
+/**
+ * Commit the shadowed configuration registers as one set. Applied at once
+ * when idle, else when the current frame finishes.
+ * @param cnn Pointer to CNN accelerator handle
+ */
+void CNN_Commit(CnnAccelerator_t *cnn);
+
+/**
+ * Check whether a commit is still waiting for the frame in flight
+ * @param cnn Pointer to CNN accelerator handle
+ * @return 1 if pending, 0 once the new configuration is active
+ */
+int CNN_CommitPending(CnnAccelerator_t *cnn);
+
 /**
  * Reset the CNN accelerator
  * @param cnn Pointer to CNN accelerator handle
@@ -200,6 +585,128 @@ int CNN_LoadWeights(CnnAccelerator_t *cnn, const int16_t *weights, uint32_t size
  */
 int CNN_LoadBiases(CnnAccelerator_t *cnn, const int16_t *biases, uint32_t size);
 
+/**
+ * Stream a packed parameter blob (see cnn_pack.py) through the weight DMA
+ * @param cnn Pointer to CNN accelerator handle
+ * @param params Pointer to packed parameter words
+ * @param size Size of parameter blob in bytes
+ * @return XST_SUCCESS or XST_FAILURE
+ */
+int CNN_LoadParams(CnnAccelerator_t *cnn, const uint32_t *params, uint32_t size);
+
+/**
+ * Pack a batchnorm section for the inline BN stage
+ * @param dst Destination buffer (count + 1 words)
+ * @param layer Conv layer index
+ * @param scale Per-channel scale in Q8.8 (gamma / sqrt(var + eps))
+ * @param bias Per-channel bias in Q8.8 (beta - mean * scale)
+ * @param count Number of channels
+ * @return Number of words written
+ */
+uint32_t CNN_PackBatchNorm(uint32_t *dst, uint8_t layer, const int16_t *scale,
+                           const int16_t *bias, uint16_t count);
+
+/**
+ * Pack one filter as a sparse weight section (bitmask plus nonzeros)
+ * @param dst Destination buffer (at most 1 + 2 * ceil(count / 32) + count / 2 words)
+ * @param layer Conv layer index
+ * @param filter Output channel
+ * @param weights Dense Q8.8 weights of the filter (ch_in, ky, kx order)
+ * @param count Number of weights in the filter
+ * @return Number of words written
+ */
+uint32_t CNN_PackSparseWeights(uint32_t *dst, uint8_t layer, uint8_t filter,
+                               const int16_t *weights, uint16_t count);
+
+/**
+ * Choose a stripe height for a tiled layer so that one stripe plus its
+ * halo rows fits the on-chip budget
+ * @param width Feature map width in pixels
+ * @param height Feature map height in rows
+ * @param channels Feature map channels
+ * @param budget_bytes On-chip bytes available for the stripe
+ * @return Even stripe height in rows (2..254), or 0 if the map fits untiled
+ */
+uint8_t CNN_ChooseStripeRows(uint16_t width, uint16_t height, uint16_t channels,
+                             uint32_t budget_bytes);
+
+/**
+ * Program per-channel input normalization: (pixel / 255 - mean) / std
+ * @param cnn Pointer to CNN accelerator handle
+ * @param mean Per-channel mean (R, G, B) on the [0, 1] pixel scale
+ * @param std Per-channel standard deviation (R, G, B) on the [0, 1] scale
+ * @return XST_SUCCESS or XST_FAILURE (value out of register range)
+ */
+int CNN_SetNormalization(CnnAccelerator_t *cnn, const float mean[3], const float std[3]);
+
+/**
+ * Compute the crop/scale step for one axis
+ * @param crop Crop size in camera pixels
+ * @param out Output size in pixels
+ * @return Step in Q16.16, or 0 when no scaling is needed
+ */
+uint32_t CNN_ScaleStep(uint16_t crop, uint16_t out);
+
+/**
+ * Enable the hardware command ring
+ * @param cnn Pointer to CNN accelerator handle
+ * @param ring Descriptor storage in DDR (64-byte aligned)
+ * @param entries Number of descriptors (2..65535; one slot stays free)
+ * @return XST_SUCCESS or XST_FAILURE
+ */
+int CNN_RingInit(CnnAccelerator_t *cnn, CnnDescriptor_t *ring, uint16_t entries);
+
+/**
+ * Queue one inference on the command ring
+ * @param cnn Pointer to CNN accelerator handle
+ * @param frame_addr Input frame address
+ * @param output_addr Result map address (128-byte aligned)
+ * @param model_addr Parameter blob the frame is meant for
+ * @return XST_SUCCESS or XST_FAILURE (ring full or not enabled)
+ */
+int CNN_RingSubmit(CnnAccelerator_t *cnn, uint32_t frame_addr, uint32_t output_addr,
+                   uint32_t model_addr);
+
+/**
+ * Reap the oldest completed descriptor (non-blocking)
+ * @param cnn Pointer to CNN accelerator handle
+ * @param done Receives a copy of the completed descriptor
+ * @return 1 if a descriptor was reaped, 0 if none has completed
+ */
+int CNN_RingReap(CnnAccelerator_t *cnn, CnnDescriptor_t *done);
+
+/**
+ * Disable the command ring and return to register-driven starts
+ * @param cnn Pointer to CNN accelerator handle
+ */
+void CNN_RingDisable(CnnAccelerator_t *cnn);
+
+/**
+ * Install the per-job completion handler used by CNN_InterruptHandler
+ * @param cnn Pointer to CNN accelerator handle
+ * @param handler Called once per reaped descriptor (NULL to reap silently)
+ * @param ref Opaque pointer passed back to the handler
+ */
+void CNN_SetRingHandler(CnnAccelerator_t *cnn,
+                        void (*handler)(void *ref, const CnnDescriptor_t *desc),
+                        void *ref);
+
+/**
+ * Configure interrupt coalescing
+ * @param cnn Pointer to CNN accelerator handle
+ * @param count Raise the IRQ once this many jobs have completed (0/1 = every job)
+ * @param timeout_cycles Or this many cycles after the first unreported one (0 = never)
+ */
+void CNN_SetCoalescing(CnnAccelerator_t *cnn, uint16_t count, uint32_t timeout_cycles);
+
+/**
+ * Read the hardware completion counter
+ * @param cnn Pointer to CNN accelerator handle
+ * @param clear 1 to reset the counter after reading
+ * @return Number of completed inferences since the last clear
+ */
+uint32_t CNN_GetCompletionCount(CnnAccelerator_t *cnn, int clear);
+
 /**
  * Start inference on a frame (non-blocking)
  * @param cnn Pointer to CNN accelerator handle
@@ -208,6 +715,32 @@ int CNN_LoadBiases(CnnAccelerator_t *cnn, const int16_t *biases, uint32_t size);
  */
 int CNN_StartInference(CnnAccelerator_t *cnn, uint32_t frame_addr);
 
+/**
+ * Free-running mode: every start of frame on the video input starts the next
+ * inference. Completions arrive through the result stream, COMPLETIONS and
+ * the (coalesced) done interrupt.
+ * With overlap, conv0 starts frame N+1 while conv1 finishes frame N; it is
+ * ignored while tiling is enabled.
+ * @param cnn Pointer to CNN accelerator handle
+ * @param overlap 1 to pipeline consecutive frames across the conv layers
+ * @return XST_SUCCESS or XST_FAILURE (NV12 input, command ring or no support)
+ */
+int CNN_StartStreaming(CnnAccelerator_t *cnn, int overlap);
+
+/**
+ * Leave streaming mode; the frame in flight still completes
+ * @param cnn Pointer to CNN accelerator handle
+ */
+void CNN_StopStreaming(CnnAccelerator_t *cnn);
+
+/**
+ * Tag of the last completed frame. Tags count started frames from 0 (reset
+ * or CONTROL.reset) and wrap at 16 bits.
+ * @param cnn Pointer to CNN accelerator handle
+ * @return Frame tag
+ */
+uint16_t CNN_GetFrameTag(CnnAccelerator_t *cnn);
+
 /**
  * Wait for inference to complete
  * @param cnn Pointer to CNN accelerator handle
@@ -224,13 +757,41 @@ int CNN_WaitForCompletion(CnnAccelerator_t *cnn, uint32_t timeout_ms);
 int CNN_IsComplete(CnnAccelerator_t *cnn);
 
 /**
- * Get inference results
+ * Get inference results (top-5 classes, softmax over all logits)
  * @param cnn Pointer to CNN accelerator handle
  * @param result Pointer to result structure
  * @return XST_SUCCESS or XST_FAILURE
  */
 int CNN_GetResult(CnnAccelerator_t *cnn, InferenceResult_t *result);
 
+/**
+ * Read the best classes of the last frame from the top-K registers
+ * (CNN_CAP_TOPK), with their raw logits; no output buffer access
+ * @param cnn Pointer to CNN accelerator handle
+ * @param entries Output array of CNN_TOPK_MAX entries, best first
+ * @param count Number of entries filled
+ * @return XST_SUCCESS or XST_FAILURE
+ */
+int CNN_ReadTopK(CnnAccelerator_t *cnn, CnnTopKEntry_t *entries, int *count);
+
+/**
+ * Decode the result stream as a detection head in hardware (box decode,
+ * score threshold, NMS); a frame then completes once its boxes are in DDR
+ * @param cnn Pointer to CNN accelerator handle
+ * @param det_cfg Detection settings, or NULL to turn detection off
+ * @return XST_SUCCESS or XST_FAILURE
+ */
+int CNN_SetDetection(CnnAccelerator_t *cnn, const CnnDetectConfig_t *det_cfg);
+
+/**
+ * Get the boxes of the last completed frame (best score first,
+ * coordinates as fractions of the image)
+ * @param cnn Pointer to CNN accelerator handle
+ * @param result Pointer to result structure (detections)
+ * @return XST_SUCCESS or XST_FAILURE
+ */
+int CNN_GetDetections(CnnAccelerator_t *cnn, InferenceResult_t *result);
+
 /**
  * Get accelerator status
  * @param cnn Pointer to CNN accelerator handle
@@ -238,6 +799,12 @@ int CNN_GetResult(CnnAccelerator_t *cnn, InferenceResult_t *result);
  */
 void CNN_GetStatus(CnnAccelerator_t *cnn, CnnStatus_t *status);
 
+/**
+ * Clear the frame buffer drop/overrun counters
+ * @param cnn Pointer to CNN accelerator handle
+ */
+void CNN_ClearFrameStats(CnnAccelerator_t *cnn);
+
 /**
  * Stop ongoing inference
  * @param cnn Pointer to CNN accelerator handle
@@ -258,7 +825,8 @@ void CNN_EnableInterrupt(CnnAccelerator_t *cnn, int enable);
 void CNN_ClearInterrupt(CnnAccelerator_t *cnn);
 
 /**
- * Interrupt handler (to be called from ISR)
+ * Interrupt handler (to be called from ISR); with the command ring enabled
+ * it reaps every finished descriptor, so one coalesced IRQ covers many jobs
  * @param cnn Pointer to CNN accelerator handle
  */
 void CNN_InterruptHandler(CnnAccelerator_t *cnn);
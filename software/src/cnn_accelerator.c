@@ -40,6 +40,8 @@ int CNN_Init(CnnAccelerator_t *cnn)
     cnn->bias_mem_addr = 0x18000000;    /* 384MB offset */
     cnn->input_frame_addr = 0x20000000; /* 512MB offset */
     cnn->output_result_addr = 0x28000000; /* 640MB offset */
+    cnn->fmap_mem_addr = 0x30000000;    /* 768MB offset */
+    cnn->det_result_addr = 0;           /* Detection off */
     
     /* Default configuration */
     cnn->config.input_width = 128;
@@ -49,8 +51,27 @@ int CNN_Init(CnnAccelerator_t *cnn)
     cnn->config.layer_enable = 0xFF;    /* All layers enabled */
     cnn->config.activation = CNN_ACT_RELU;
     cnn->config.pool_type = CNN_POOL_MAX;
+    cnn->config.bn_enable = 0;
+    cnn->config.stripe_rows = 0;
+    cnn->config.frame_policy = CNN_FRAME_DIRECT;
+    cnn->config.src_width = 0;
+    cnn->config.src_height = 0;
+    cnn->config.crop_x = 0;
+    cnn->config.crop_y = 0;
+    cnn->config.crop_width = 0;
+    cnn->config.crop_height = 0;
+    cnn->config.input_format = CNN_INPUT_RGB888;
+    cnn->config.color_matrix = CNN_CSC_BT601;
+    cnn->config.full_range = 0;
     
+    memset(&cnn->hw, 0, sizeof(CnnHwInfo_t));
     cnn->inference_done = 0;
+    cnn->ring = NULL;
+    cnn->ring_size = 0;
+    cnn->ring_tail = 0;
+    cnn->ring_reap = 0;
+    cnn->ring_handler = NULL;
+    cnn->ring_handler_ref = NULL;
     
     /* Reset the accelerator */
     CNN_Reset(cnn);
@@ -62,9 +83,42 @@ int CNN_Init(CnnAccelerator_t *cnn)
         return XST_FAILURE;
     }
     
+    /* Discover the build; the register map is only known from 2.x on */
+    if (CNN_READ_REG(cnn, CNN_REG_CORE_ID) != CNN_CORE_ID_VALUE) {
+        return XST_FAILURE;
+    }
+    cnn->hw.version = CNN_READ_REG(cnn, CNN_REG_CORE_VERSION);
+    if (CNN_VERSION_MAJOR(cnn->hw.version) != 2) {
+        return XST_FAILURE;
+    }
+    cnn->hw.caps = CNN_READ_REG(cnn, CNN_REG_CAPABILITIES);
+    
+    uint32_t engine = CNN_READ_REG(cnn, CNN_REG_ENGINE);
+    cnn->hw.num_layers = engine & 0xFF;
+    cnn->hw.mac_units = (engine >> 8) & 0xFF;
+    cnn->hw.data_width = (engine >> 16) & 0xFF;
+    cnn->hw.frac_bits = (engine >> 24) & 0xFF;
+    
+    uint32_t build_dim = CNN_READ_REG(cnn, CNN_REG_BUILD_DIM);
+    cnn->hw.max_width = build_dim & 0xFFFF;
+    cnn->hw.max_height = build_dim >> 16;
+    
+    cnn->config.input_width = cnn->hw.max_width;
+    cnn->config.input_height = cnn->hw.max_height;
+    
     return XST_SUCCESS;
 }
 
+/* ============================================================================
+ * CNN_HasCapability - Check for a feature of the loaded bitstream
+ * ============================================================================ */
+int CNN_HasCapability(const CnnAccelerator_t *cnn, uint32_t cap)
+{
+    if (cnn == NULL) return 0;
+    
+    return (cnn->hw.caps & cap) == cap;
+}
+
 /* ============================================================================
  * CNN_Configure - Configure the CNN accelerator
  * ============================================================================ */
@@ -74,9 +128,49 @@ int CNN_Configure(CnnAccelerator_t *cnn, const CnnConfig_t *config)
         return XST_FAILURE;
     }
     
-    /* Check for valid configuration */
+    /* Check for valid configuration; the line buffers are sized per build */
     if (config->input_width == 0 || config->input_height == 0 ||
-        config->input_width > 224 || config->input_height > 224) {
+        config->input_width > cnn->hw.max_width || config->input_height > cnn->hw.max_height) {
+        return XST_FAILURE;
+    }
+    
+    /* Features the bitstream was built without */
+    if ((config->bn_enable && !CNN_HasCapability(cnn, CNN_CAP_BATCHNORM)) ||
+        (config->stripe_rows != 0 && !CNN_HasCapability(cnn, CNN_CAP_TILING)) ||
+        (config->frame_policy != CNN_FRAME_DIRECT && !CNN_HasCapability(cnn, CNN_CAP_FRAME_BUFFER)) ||
+        (config->crop_width != 0 && !CNN_HasCapability(cnn, CNN_CAP_SCALER)) ||
+        (config->input_format == CNN_INPUT_YUV422 && !CNN_HasCapability(cnn, CNN_CAP_YUV)) ||
+        (config->input_format == CNN_INPUT_NV12 && !CNN_HasCapability(cnn, CNN_CAP_NV12))) {
+        return XST_FAILURE;
+    }
+    
+    /* Tiled refill moves 4 pixels per beat: layer-1 width must be a
+     * multiple of 4. Stripe k yields conv rows k*S .. k*S+S-1, so an even
+     * stripe keeps the fused 2x2 pool pairing the rows of the untiled pass */
+    if (config->stripe_rows != 0 &&
+        (((config->input_width / 2) & 3) || (config->stripe_rows & 1))) {
+        return XST_FAILURE;
+    }
+    
+    /* Crop ROI must lie inside the camera frame and only downscale */
+    uint16_t src_w = config->src_width ? config->src_width : config->input_width;
+    uint16_t src_h = config->src_height ? config->src_height : config->input_height;
+    if (src_w > CNN_MAX_SRC_DIM || src_h > CNN_MAX_SRC_DIM) {
+        return XST_FAILURE;
+    }
+    if (config->crop_width != 0 &&
+        (config->crop_height == 0 ||
+         (uint32_t)config->crop_x + config->crop_width > src_w ||
+         (uint32_t)config->crop_y + config->crop_height > src_h ||
+         config->crop_width < config->input_width ||
+         config->crop_height < config->input_height)) {
+        return XST_FAILURE;
+    }
+    
+    /* NV12 is fetched 8 bytes per beat by its own reader, which takes over
+     * the frame buffer's AXI master */
+    if (config->input_format == CNN_INPUT_NV12 &&
+        ((src_w & 7) || config->frame_policy != CNN_FRAME_DIRECT)) {
         return XST_FAILURE;
     }
     
@@ -90,6 +184,9 @@ int CNN_Configure(CnnAccelerator_t *cnn, const CnnConfig_t *config)
     if (config->pool_type == CNN_POOL_AVG) {
         cfg_reg |= CNN_CFG_POOL_TYPE;
     }
+    if (config->bn_enable) {
+        cfg_reg |= CNN_CFG_BN_ENABLE;
+    }
     
     /* Write configuration registers */
     CNN_WRITE_REG(cnn, CNN_REG_CONFIG, cfg_reg);
@@ -104,9 +201,257 @@ int CNN_Configure(CnnAccelerator_t *cnn, const CnnConfig_t *config)
     CNN_WRITE_REG(cnn, CNN_REG_INPUT_ADDR, cnn->input_frame_addr);
     CNN_WRITE_REG(cnn, CNN_REG_OUTPUT_ADDR, cnn->output_result_addr);
     
+    /* Row-band tiling through the DDR scratch area */
+    uint32_t tile_reg = 0;
+    if (config->stripe_rows != 0) {
+        tile_reg = CNN_TILE_ENABLE |
+                   (((uint32_t)config->stripe_rows << CNN_TILE_ROWS_SHIFT) & CNN_TILE_ROWS_MASK);
+    }
+    CNN_WRITE_REG(cnn, CNN_REG_FMAP_ADDR, cnn->fmap_mem_addr);
+    CNN_WRITE_REG(cnn, CNN_REG_TILE_CFG, tile_reg);
+    
+    /* Frame buffer at INPUT_ADDR (CNN_FB_BYTES reserved) */
+    uint32_t fb_reg = 0;
+    if (config->frame_policy != CNN_FRAME_DIRECT) {
+        fb_reg = CNN_FB_ENABLE;
+        if (config->frame_policy == CNN_FRAME_LATEST) {
+            fb_reg |= CNN_FB_LATEST_WINS;
+        }
+    }
+    CNN_WRITE_REG(cnn, CNN_REG_FB_CTRL, fb_reg);
+    
+    /* Crop and downscale in the video front end */
+    CNN_WRITE_REG(cnn, CNN_REG_SRC_DIM, ((uint32_t)config->src_height << 16) | config->src_width);
+    CNN_WRITE_REG(cnn, CNN_REG_CROP_ORIGIN, ((uint32_t)config->crop_y << 16) | config->crop_x);
+    CNN_WRITE_REG(cnn, CNN_REG_SCALE_X,
+                  CNN_ScaleStep(config->crop_width, config->input_width));
+    CNN_WRITE_REG(cnn, CNN_REG_SCALE_Y,
+                  CNN_ScaleStep(config->crop_height, config->input_height));
+    CNN_WRITE_REG(cnn, CNN_REG_CROP_DIM, ((uint32_t)config->crop_height << 16) | config->crop_width);
+    
+    /* Input format and YUV -> RGB matrix */
+    uint32_t fmt_reg = (uint32_t)config->input_format & CNN_FMT_MASK;
+    if (config->color_matrix == CNN_CSC_BT709) {
+        fmt_reg |= CNN_FMT_BT709;
+    }
+    if (config->full_range) {
+        fmt_reg |= CNN_FMT_FULL_RANGE;
+    }
+    CNN_WRITE_REG(cnn, CNN_REG_INPUT_FMT, fmt_reg);
+    
+    /* Everything above lands together at the next frame boundary */
+    CNN_Commit(cnn);
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_Commit - Apply the shadowed configuration registers
+ * ============================================================================ */
+void CNN_Commit(CnnAccelerator_t *cnn)
+{
+    if (cnn == NULL) return;
+    
+    CNN_WRITE_REG(cnn, CNN_REG_CONTROL, CNN_CTRL_COMMIT);
+}
+
+/* ============================================================================
+ * CNN_CommitPending - Check for a commit waiting on the frame in flight
+ * ============================================================================ */
+int CNN_CommitPending(CnnAccelerator_t *cnn)
+{
+    if (cnn == NULL) return 0;
+    
+    return (CNN_READ_REG(cnn, CNN_REG_STATUS) & CNN_STAT_COMMIT_PENDING) ? 1 : 0;
+}
+
+/* ============================================================================
+ * CNN_SetLayerConfig - Override the global CONFIG for one conv layer
+ * ============================================================================ */
+int CNN_SetLayerConfig(CnnAccelerator_t *cnn, uint8_t layer, const CnnLayerConfig_t *layer_cfg)
+{
+    if (cnn == NULL || layer >= cnn->hw.num_layers ||
+        !CNN_HasCapability(cnn, CNN_CAP_LAYER_CFG)) {
+        return XST_FAILURE;
+    }
+    
+    uint32_t reg = 0;
+    if (layer_cfg != NULL) {
+        if (layer_cfg->bn_enable && !CNN_HasCapability(cnn, CNN_CAP_BATCHNORM)) {
+            return XST_FAILURE;
+        }
+        reg = CNN_LAYER_OVERRIDE | ((uint32_t)layer_cfg->activation & CNN_LAYER_ACT_MASK);
+        if (layer_cfg->bn_enable) {
+            reg |= CNN_LAYER_BN_ENABLE;
+        }
+        if (layer_cfg->pool_type == CNN_POOL_AVG) {
+            reg |= CNN_LAYER_POOL_TYPE;
+        }
+        if (layer_cfg->int8) {
+            if (!CNN_HasCapability(cnn, CNN_CAP_INT8)) {
+                return XST_FAILURE;
+            }
+            reg |= CNN_LAYER_INT8;
+        }
+        if (layer_cfg->sparse) {
+            if (!CNN_HasCapability(cnn, CNN_CAP_SPARSE)) {
+                return XST_FAILURE;
+            }
+            reg |= CNN_LAYER_SPARSE;
+        }
+        if (layer_cfg->gemm) {
+            /* Only the last layer has the backend; it has no BN stage and
+             * runs the plain Q8.8 weight sections */
+            if (!CNN_HasCapability(cnn, CNN_CAP_GEMM) ||
+                layer != cnn->hw.num_layers - 1 ||
+                layer_cfg->bn_enable || layer_cfg->int8 || layer_cfg->sparse) {
+                return XST_FAILURE;
+            }
+            reg |= CNN_LAYER_GEMM;
+        }
+    }
+    CNN_WRITE_REG(cnn, CNN_REG_LAYER(layer, CNN_LAYER_CFG), reg);
+    CNN_Commit(cnn);
+    
     return XST_SUCCESS;
 }
 
+/* ============================================================================
+ * CNN_SetLayerQuant - Zero points and activation clamp of an int8 layer
+ * ============================================================================ */
+int CNN_SetLayerQuant(CnnAccelerator_t *cnn, uint8_t layer, const CnnLayerQuant_t *quant)
+{
+    uint32_t reg = 0x7F800000;  /* Zero points 0, clamp -128..127 */
+    
+    if (cnn == NULL || layer >= cnn->hw.num_layers ||
+        !CNN_HasCapability(cnn, CNN_CAP_INT8)) {
+        return XST_FAILURE;
+    }
+    
+    if (quant != NULL) {
+        if (quant->act_min > quant->act_max) {
+            return XST_FAILURE;
+        }
+        reg = ((uint32_t)(uint8_t)quant->act_max << 24) |
+              ((uint32_t)(uint8_t)quant->act_min << 16) |
+              ((uint32_t)(uint8_t)quant->output_zero_point << 8) |
+              (uint32_t)(uint8_t)quant->input_zero_point;
+    }
+    CNN_WRITE_REG(cnn, CNN_REG_LAYER(layer, CNN_LAYER_QUANT), reg);
+    CNN_Commit(cnn);
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_GetLayerStats - Read the per-layer counters of the last run
+ * ============================================================================ */
+int CNN_GetLayerStats(CnnAccelerator_t *cnn, uint8_t layer, CnnLayerStats_t *stats)
+{
+    if (cnn == NULL || stats == NULL || layer >= cnn->hw.num_layers ||
+        !CNN_HasCapability(cnn, CNN_CAP_LAYER_CFG)) {
+        return XST_FAILURE;
+    }
+    
+    stats->cycles = CNN_READ_REG(cnn, CNN_REG_LAYER(layer, CNN_LAYER_CYCLES));
+    stats->stalls = CNN_READ_REG(cnn, CNN_REG_LAYER(layer, CNN_LAYER_STALLS));
+    stats->beats = CNN_READ_REG(cnn, CNN_REG_LAYER(layer, CNN_LAYER_BEATS));
+    stats->fifo_high_water = 0;
+    if (CNN_HasCapability(cnn, CNN_CAP_LINK_FIFO)) {
+        stats->fifo_high_water =
+            (uint16_t)CNN_READ_REG(cnn, CNN_REG_LAYER(layer, CNN_LAYER_FIFO_HWM));
+    }
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_ClearFifoHighWater - Restart the input FIFO occupancy marks
+ * ============================================================================ */
+void CNN_ClearFifoHighWater(CnnAccelerator_t *cnn)
+{
+    uint8_t layer;
+    
+    if (cnn == NULL || !CNN_HasCapability(cnn, CNN_CAP_LINK_FIFO)) return;
+    
+    for (layer = 0; layer < cnn->hw.num_layers; layer++) {
+        CNN_WRITE_REG(cnn, CNN_REG_LAYER(layer, CNN_LAYER_FIFO_HWM), 0);
+    }
+}
+
+/* ============================================================================
+ * CNN_ChooseStripeRows - Pick a stripe height that fits the on-chip budget
+ * ============================================================================ */
+uint8_t CNN_ChooseStripeRows(uint16_t width, uint16_t height, uint16_t channels,
+                             uint32_t budget_bytes)
+{
+    uint32_t row_bytes = (uint32_t)width * channels * sizeof(int16_t);
+    
+    if (row_bytes == 0 || (uint32_t)height * row_bytes <= budget_bytes) {
+        return 0;   /* Whole map fits, no tiling needed */
+    }
+    
+    /* Rows that fit, less the halo above and below */
+    uint32_t rows = budget_bytes / row_bytes;
+    rows = (rows > 2 * CNN_TILE_HALO_ROWS) ? rows - 2 * CNN_TILE_HALO_ROWS : 0;
+    
+    rows &= ~1u;
+    if (rows < 2) {
+        rows = 2;
+    }
+    if (rows > 254) {
+        rows = 254;
+    }
+    
+    return (uint8_t)rows;
+}
+
+/* ============================================================================
+ * CNN_SetNormalization - Program per-channel mean / std
+ * ============================================================================ */
+int CNN_SetNormalization(CnnAccelerator_t *cnn, const float mean[3], const float std[3])
+{
+    static const uint32_t regs[3] = { CNN_REG_NORM_R, CNN_REG_NORM_G, CNN_REG_NORM_B };
+    uint32_t values[3];
+    
+    if (cnn == NULL || mean == NULL || std == NULL) {
+        return XST_FAILURE;
+    }
+    
+    for (int c = 0; c < 3; c++) {
+        /* Mean in Q8.8 pixel units, scale 1 / (255 * std) in Q1.15 */
+        float mean_q = mean[c] * 255.0f * 256.0f + 0.5f;
+        float scale_q = (std[c] > 0.0f) ? 32768.0f / (255.0f * std[c]) + 0.5f : 0.0f;
+        
+        if (mean_q < 0.0f || mean_q > 65535.0f || scale_q < 1.0f || scale_q > 65535.0f) {
+            return XST_FAILURE;
+        }
+        values[c] = ((uint32_t)scale_q << CNN_NORM_SCALE_SHIFT) |
+                    ((uint32_t)mean_q & CNN_NORM_MEAN_MASK);
+    }
+    
+    for (int c = 0; c < 3; c++) {
+        CNN_WRITE_REG(cnn, regs[c], values[c]);
+    }
+    CNN_Commit(cnn);
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_ScaleStep - Q16.16 scaler step for one axis
+ * ============================================================================ */
+uint32_t CNN_ScaleStep(uint16_t crop, uint16_t out)
+{
+    /* Same size (or no crop): pass pixels through */
+    if (out == 0 || crop <= out) {
+        return 0;
+    }
+    
+    /* Keep both bilinear taps inside the crop */
+    return (uint32_t)((((uint64_t)crop - 1) << 16) / out);
+}
+
 /* ============================================================================
  * CNN_Reset - Reset the CNN accelerator
  * ============================================================================ */
@@ -171,6 +516,226 @@ int CNN_LoadBiases(CnnAccelerator_t *cnn, const int16_t *biases, uint32_t size)
     return XST_SUCCESS;
 }
 
+/* ============================================================================
+ * CNN_LoadParams - Stream packed parameters through the weight DMA
+ * ============================================================================ */
+int CNN_LoadParams(CnnAccelerator_t *cnn, const uint32_t *params, uint32_t size)
+{
+    if (cnn == NULL || params == NULL || size == 0 || (size & 3)) {
+        return XST_FAILURE;
+    }
+    
+    /* Stage the blob in DDR for the DMA */
+    if ((UINTPTR)params != (UINTPTR)cnn->weight_mem_addr) {
+        memcpy((void *)(UINTPTR)cnn->weight_mem_addr, params, size);
+    }
+    Xil_DCacheFlushRange(cnn->weight_mem_addr, size);
+    
+    /* Simple-mode MM2S transfer; the length write starts the DMA */
+    Xil_Out32(cnn->dma_weights_addr + CNN_DMA_MM2S_CR, CNN_DMA_CR_RUN);
+    Xil_Out32(cnn->dma_weights_addr + CNN_DMA_MM2S_SA, cnn->weight_mem_addr);
+    Xil_Out32(cnn->dma_weights_addr + CNN_DMA_MM2S_LENGTH, size);
+    
+    /* Wait for the transfer to drain into the accelerator */
+    uint32_t timeout = 100000;
+    while (!(Xil_In32(cnn->dma_weights_addr + CNN_DMA_MM2S_SR) & CNN_DMA_SR_IDLE)) {
+        if (--timeout == 0) {
+            return XST_FAILURE;
+        }
+    }
+    
+    CNN_WRITE_REG(cnn, CNN_REG_WEIGHT_ADDR, cnn->weight_mem_addr);
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_PackBatchNorm - Build a batchnorm parameter section
+ * ============================================================================ */
+uint32_t CNN_PackBatchNorm(uint32_t *dst, uint8_t layer, const int16_t *scale,
+                           const int16_t *bias, uint16_t count)
+{
+    if (dst == NULL || scale == NULL || bias == NULL) return 0;
+    
+    dst[0] = CNN_PARAM_HDR(CNN_PARAM_SEC_BN, layer, 0, count);
+    for (uint32_t i = 0; i < count; i++) {
+        dst[i + 1] = ((uint32_t)(uint16_t)bias[i] << 16) | (uint16_t)scale[i];
+    }
+    
+    return count + 1;
+}
+
+/* ============================================================================
+ * CNN_PackSparseWeights - Build a sparse weight section for one filter
+ * ============================================================================ */
+uint32_t CNN_PackSparseWeights(uint32_t *dst, uint8_t layer, uint8_t filter,
+                               const int16_t *weights, uint16_t count)
+{
+    if (dst == NULL || weights == NULL) return 0;
+    
+    uint32_t n = 0;
+    dst[n++] = CNN_PARAM_HDR(CNN_PARAM_SEC_SPARSE, layer, filter, count);
+    
+    for (uint32_t base = 0; base < count; base += 32) {
+        uint32_t group = (count - base < 32) ? count - base : 32;
+        uint32_t mask_idx = n++;
+        uint32_t mask = 0;
+        uint32_t nonzero = 0;
+        
+        /* Nonzeros two per word, low half first; an odd one pads the word */
+        for (uint32_t i = 0; i < group; i++) {
+            uint16_t w = (uint16_t)weights[base + i];
+            if (w == 0) continue;
+            mask |= 1u << i;
+            if (nonzero & 1) {
+                dst[n - 1] |= (uint32_t)w << 16;
+            } else {
+                dst[n++] = w;
+            }
+            nonzero++;
+        }
+        dst[mask_idx] = mask;
+    }
+    
+    return n;
+}
+
+/* ============================================================================
+ * CNN_RingInit - Enable the hardware command ring
+ * ============================================================================ */
+int CNN_RingInit(CnnAccelerator_t *cnn, CnnDescriptor_t *ring, uint16_t entries)
+{
+    if (cnn == NULL || ring == NULL || entries < 2 || ((UINTPTR)ring & (CNN_DESC_ALIGN - 1)) ||
+        !CNN_HasCapability(cnn, CNN_CAP_CMD_RING)) {
+        return XST_FAILURE;
+    }
+    
+    /* Rewind head and tail before handing the ring to the hardware */
+    CNN_WRITE_REG(cnn, CNN_REG_RING_CFG, 0);
+    
+    memset(ring, 0, (uint32_t)entries * sizeof(CnnDescriptor_t));
+    Xil_DCacheFlushRange((UINTPTR)ring, (uint32_t)entries * sizeof(CnnDescriptor_t));
+    
+    cnn->ring = ring;
+    cnn->ring_size = entries;
+    cnn->ring_tail = 0;
+    cnn->ring_reap = 0;
+    
+    CNN_WRITE_REG(cnn, CNN_REG_RING_BASE, (uint32_t)(UINTPTR)ring);
+    CNN_WRITE_REG(cnn, CNN_REG_RING_CFG, CNN_RING_ENABLE | entries);
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_RingSubmit - Queue one inference on the command ring
+ * ============================================================================ */
+int CNN_RingSubmit(CnnAccelerator_t *cnn, uint32_t frame_addr, uint32_t output_addr,
+                   uint32_t model_addr)
+{
+    if (cnn == NULL || cnn->ring == NULL || (output_addr & 127)) {
+        return XST_FAILURE;
+    }
+    
+    /* Full when the next tail would catch up with the oldest unreaped slot */
+    uint16_t next = (cnn->ring_tail + 1 == cnn->ring_size) ? 0 : cnn->ring_tail + 1;
+    if (next == cnn->ring_reap) {
+        return XST_FAILURE;
+    }
+    
+    CnnDescriptor_t *desc = &cnn->ring[cnn->ring_tail];
+    desc->input_addr = frame_addr;
+    desc->output_addr = output_addr;
+    desc->model_addr = model_addr;
+    desc->flags = 0;
+    desc->status = 0;
+    desc->cycles = 0;
+    Xil_DCacheFlushRange((UINTPTR)desc, sizeof(CnnDescriptor_t));
+    
+    /* Bumping the tail hands the descriptor to the hardware */
+    cnn->ring_tail = next;
+    CNN_WRITE_REG(cnn, CNN_REG_RING_TAIL, next);
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_RingReap - Reap the oldest completed descriptor
+ * ============================================================================ */
+int CNN_RingReap(CnnAccelerator_t *cnn, CnnDescriptor_t *done)
+{
+    if (cnn == NULL || cnn->ring == NULL || cnn->ring_reap == cnn->ring_tail) {
+        return 0;
+    }
+    
+    CnnDescriptor_t *desc = &cnn->ring[cnn->ring_reap];
+    Xil_DCacheInvalidateRange((UINTPTR)desc, sizeof(CnnDescriptor_t));
+    if (!(desc->status & CNN_DESC_DONE)) {
+        return 0;
+    }
+    
+    if (done != NULL) {
+        memcpy(done, desc, sizeof(CnnDescriptor_t));
+    }
+    cnn->ring_reap = (cnn->ring_reap + 1 == cnn->ring_size) ? 0 : cnn->ring_reap + 1;
+    
+    return 1;
+}
+
+/* ============================================================================
+ * CNN_RingDisable - Return to register-driven starts
+ * ============================================================================ */
+void CNN_RingDisable(CnnAccelerator_t *cnn)
+{
+    if (cnn == NULL) return;
+    
+    CNN_WRITE_REG(cnn, CNN_REG_RING_CFG, 0);
+    cnn->ring = NULL;
+    cnn->ring_size = 0;
+    cnn->ring_tail = 0;
+    cnn->ring_reap = 0;
+}
+
+/* ============================================================================
+ * CNN_SetRingHandler - Install the per-job completion handler
+ * ============================================================================ */
+void CNN_SetRingHandler(CnnAccelerator_t *cnn,
+                        void (*handler)(void *ref, const CnnDescriptor_t *desc),
+                        void *ref)
+{
+    if (cnn == NULL) return;
+    
+    cnn->ring_handler = handler;
+    cnn->ring_handler_ref = ref;
+}
+
+/* ============================================================================
+ * CNN_SetCoalescing - Configure interrupt coalescing
+ * ============================================================================ */
+void CNN_SetCoalescing(CnnAccelerator_t *cnn, uint16_t count, uint32_t timeout_cycles)
+{
+    if (cnn == NULL) return;
+    
+    CNN_WRITE_REG(cnn, CNN_REG_IRQ_COALESCE, count);
+    CNN_WRITE_REG(cnn, CNN_REG_IRQ_TIMEOUT, timeout_cycles);
+}
+
+/* ============================================================================
+ * CNN_GetCompletionCount - Read the hardware completion counter
+ * ============================================================================ */
+uint32_t CNN_GetCompletionCount(CnnAccelerator_t *cnn, int clear)
+{
+    if (cnn == NULL) return 0;
+    
+    uint32_t count = CNN_READ_REG(cnn, CNN_REG_COMPLETIONS);
+    if (clear) {
+        /* Any write clears */
+        CNN_WRITE_REG(cnn, CNN_REG_COMPLETIONS, 0);
+    }
+    
+    return count;
+}
+
 /* ============================================================================
  * CNN_StartInference - Start inference (non-blocking)
  * ============================================================================ */
@@ -186,8 +751,9 @@ int CNN_StartInference(CnnAccelerator_t *cnn, uint32_t frame_addr)
         return XST_FAILURE;
     }
     
-    /* Update input frame address */
+    /* Update input frame address (idle, so the commit applies at once) */
     CNN_WRITE_REG(cnn, CNN_REG_INPUT_ADDR, frame_addr);
+    CNN_Commit(cnn);
     
     /* Flush input frame cache */
     uint32_t frame_size = cnn->config.input_width * cnn->config.input_height * 
@@ -295,6 +861,135 @@ int CNN_GetResult(CnnAccelerator_t *cnn, InferenceResult_t *result)
     return XST_SUCCESS;
 }
 
+/* ============================================================================
+ * CNN_ReadTopK - Read the top-K result registers of the last frame
+ * ============================================================================ */
+int CNN_ReadTopK(CnnAccelerator_t *cnn, CnnTopKEntry_t *entries, int *count)
+{
+    if (cnn == NULL || entries == NULL || count == NULL) {
+        return XST_FAILURE;
+    }
+    
+    if (!CNN_HasCapability(cnn, CNN_CAP_TOPK) || !cnn->inference_done) {
+        return XST_FAILURE;
+    }
+    
+    /* No cache maintenance and no pass over the logits: the unit has
+     * sorted the best classes already */
+    uint32_t topk_status = CNN_READ_REG(cnn, CNN_REG_TOPK_STATUS);
+    int n = (topk_status & CNN_TOPK_VALID_MASK) >> CNN_TOPK_VALID_SHIFT;
+    
+    if (n == 0 || n > CNN_TOPK_MAX) {
+        return XST_FAILURE;
+    }
+    
+    for (int k = 0; k < n; k++) {
+        uint32_t entry = CNN_READ_REG(cnn, CNN_REG_TOPK(k));
+        entries[k].class_id = entry >> CNN_TOPK_CLASS_SHIFT;
+        entries[k].logit = (int16_t)(entry & 0xFFFF);
+    }
+    *count = n;
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_SetDetection - Program the box decode / NMS unit
+ * ============================================================================ */
+int CNN_SetDetection(CnnAccelerator_t *cnn, const CnnDetectConfig_t *det_cfg)
+{
+    if (cnn == NULL || !CNN_HasCapability(cnn, CNN_CAP_NMS)) {
+        return XST_FAILURE;
+    }
+    
+    if (det_cfg == NULL) {
+        CNN_WRITE_REG(cnn, CNN_REG_DET_CFG, 0);
+        CNN_Commit(cnn);
+        cnn->det_result_addr = 0;
+        return XST_SUCCESS;
+    }
+    
+    if (det_cfg->grid_w == 0 || det_cfg->grid_h == 0 ||
+        det_cfg->anchor_w <= 0.0f || det_cfg->anchor_w >= 1.0f ||
+        det_cfg->anchor_h <= 0.0f || det_cfg->anchor_h >= 1.0f ||
+        det_cfg->score_threshold < 0.0f || det_cfg->score_threshold > 1.0f ||
+        det_cfg->iou_threshold < 0.0f || det_cfg->iou_threshold >= 1.0f ||
+        det_cfg->output_addr == 0 || (det_cfg->output_addr & (CNN_DET_ALIGN - 1))) {
+        return XST_FAILURE;
+    }
+    
+    /* Cell size and anchor in Q0.16 image fractions (a 1-cell grid spans
+     * just under the whole image) */
+    uint32_t cell_w = 65536u / det_cfg->grid_w;
+    uint32_t cell_h = 65536u / det_cfg->grid_h;
+    if (cell_w > 0xFFFF) {
+        cell_w = 0xFFFF;
+    }
+    if (cell_h > 0xFFFF) {
+        cell_h = 0xFFFF;
+    }
+    uint32_t anchor_w = (uint32_t)(det_cfg->anchor_w * 65536.0f + 0.5f) & 0xFFFF;
+    uint32_t anchor_h = (uint32_t)(det_cfg->anchor_h * 65536.0f + 0.5f) & 0xFFFF;
+    
+    /* Score in Q8.8 like the sigmoid output, IoU in Q0.8 */
+    uint32_t score_q = (uint32_t)(det_cfg->score_threshold * Q8_8_SCALE + 0.5f);
+    uint32_t iou_q = (uint32_t)(det_cfg->iou_threshold * 256.0f + 0.5f);
+    if (iou_q > 0xFF) {
+        iou_q = 0xFF;
+    }
+    
+    CNN_WRITE_REG(cnn, CNN_REG_DET_CELL, (cell_h << 16) | cell_w);
+    CNN_WRITE_REG(cnn, CNN_REG_DET_ANCHOR, (anchor_h << 16) | anchor_w);
+    CNN_WRITE_REG(cnn, CNN_REG_DET_THRESH, (iou_q << CNN_DET_IOU_SHIFT) | score_q);
+    CNN_WRITE_REG(cnn, CNN_REG_DET_ADDR, det_cfg->output_addr);
+    CNN_WRITE_REG(cnn, CNN_REG_DET_CFG,
+                  ((uint32_t)det_cfg->grid_w << CNN_DET_GRID_W_SHIFT) | CNN_DET_ENABLE);
+    CNN_Commit(cnn);
+    cnn->det_result_addr = det_cfg->output_addr;
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_GetDetections - Read the box list written by the NMS unit
+ * ============================================================================ */
+int CNN_GetDetections(CnnAccelerator_t *cnn, InferenceResult_t *result)
+{
+    if (cnn == NULL || result == NULL || cnn->det_result_addr == 0) {
+        return XST_FAILURE;
+    }
+    
+    if (!cnn->inference_done) {
+        return XST_FAILURE;
+    }
+    
+    /* The frame only completes after the burst is acknowledged */
+    Xil_DCacheInvalidateRange(cnn->det_result_addr, CNN_DET_BYTES);
+    
+    const volatile uint32_t *words = (const volatile uint32_t *)(UINTPTR)cnn->det_result_addr;
+    int n = words[0] & CNN_DET_COUNT_MASK;
+    if (n > CNN_MAX_DETECTIONS) {
+        return XST_FAILURE;
+    }
+    
+    /* Per box: x_min, y_min, x_max, y_max (Q0.16), then score (Q8.8) and
+     * class */
+    for (int k = 0; k < n; k++) {
+        const volatile uint32_t *box = &words[2 + 4 * k];
+        DetectionResult_t *det = &result->detections[k];
+        
+        det->x_min = (float)(box[0] & 0xFFFF) / 65536.0f;
+        det->y_min = (float)(box[0] >> 16) / 65536.0f;
+        det->x_max = (float)(box[1] & 0xFFFF) / 65536.0f;
+        det->y_max = (float)(box[1] >> 16) / 65536.0f;
+        det->confidence = (float)(box[2] & 0xFFFF) / Q8_8_SCALE;
+        det->class_id = (box[2] >> 16) & 0xFF;
+    }
+    result->num_results = n;
+    
+    return XST_SUCCESS;
+}
+
 /* ============================================================================
  * CNN_GetStatus - Get accelerator status
  * ============================================================================ */
@@ -309,6 +1004,21 @@ void CNN_GetStatus(CnnAccelerator_t *cnn, CnnStatus_t *status)
     status->error_code = (reg_status & CNN_STAT_ERROR_MASK) >> 4;
     status->cycles = CNN_READ_REG(cnn, CNN_REG_PERF_CYCLES);
     status->operations = CNN_READ_REG(cnn, CNN_REG_PERF_OPS);
+    
+    uint32_t fb_stats = CNN_READ_REG(cnn, CNN_REG_FB_STATS);
+    status->frames_dropped = fb_stats & CNN_FB_DROPS_MASK;
+    status->frame_overruns = fb_stats >> CNN_FB_OVERRUNS_SHIFT;
+}
+
+/* ============================================================================
+ * CNN_ClearFrameStats - Clear frame buffer counters
+ * ============================================================================ */
+void CNN_ClearFrameStats(CnnAccelerator_t *cnn)
+{
+    if (cnn == NULL) return;
+    
+    /* Any write clears both counters */
+    CNN_WRITE_REG(cnn, CNN_REG_FB_STATS, 0);
 }
 
 /* ============================================================================
@@ -322,6 +1032,51 @@ void CNN_Stop(CnnAccelerator_t *cnn)
     cnn->inference_done = 0;
 }
 
+/* ============================================================================
+ * CNN_StartStreaming - Start an inference on every video frame
+ * ============================================================================ */
+int CNN_StartStreaming(CnnAccelerator_t *cnn, int overlap)
+{
+    uint32_t ctrl = CNN_STREAM_ENABLE;
+    
+    if (cnn == NULL || !CNN_HasCapability(cnn, CNN_CAP_STREAMING) ||
+        cnn->config.input_format == CNN_INPUT_NV12 || cnn->ring != NULL) {
+        return XST_FAILURE;
+    }
+    
+    if (overlap) {
+        if (!CNN_HasCapability(cnn, CNN_CAP_FRAME_OVERLAP)) {
+            return XST_FAILURE;
+        }
+        ctrl |= CNN_STREAM_OVERLAP;
+    }
+    
+    cnn->inference_done = 0;
+    CNN_WRITE_REG(cnn, CNN_REG_STREAM_CTRL, ctrl);
+    
+    return XST_SUCCESS;
+}
+
+/* ============================================================================
+ * CNN_StopStreaming - Return to one inference per start
+ * ============================================================================ */
+void CNN_StopStreaming(CnnAccelerator_t *cnn)
+{
+    if (cnn == NULL) return;
+    
+    CNN_WRITE_REG(cnn, CNN_REG_STREAM_CTRL, 0);
+}
+
+/* ============================================================================
+ * CNN_GetFrameTag - Tag of the last completed frame
+ * ============================================================================ */
+uint16_t CNN_GetFrameTag(CnnAccelerator_t *cnn)
+{
+    if (cnn == NULL) return 0;
+    
+    return (uint16_t)(CNN_READ_REG(cnn, CNN_REG_FRAME_TAG) & CNN_FRAME_TAG_DONE_MASK);
+}
+
 /* ============================================================================
  * CNN_EnableInterrupt - Enable/disable interrupt
  * ============================================================================ */
@@ -357,12 +1112,22 @@ void CNN_InterruptHandler(CnnAccelerator_t *cnn)
     
     uint32_t irq_status = CNN_READ_REG(cnn, CNN_REG_IRQ_STATUS);
     
+    /* Clear first so completions landing while we reap raise a new IRQ */
+    CNN_WRITE_REG(cnn, CNN_REG_IRQ_STATUS, irq_status);
+    
     if (irq_status & CNN_IRQ_DONE) {
         cnn->inference_done = 1;
+        
+        /* One coalesced interrupt may cover several ring jobs */
+        if (cnn->ring != NULL) {
+            CnnDescriptor_t desc;
+            while (CNN_RingReap(cnn, &desc)) {
+                if (cnn->ring_handler != NULL) {
+                    cnn->ring_handler(cnn->ring_handler_ref, &desc);
+                }
+            }
+        }
     }
-    
-    /* Clear handled interrupts */
-    CNN_WRITE_REG(cnn, CNN_REG_IRQ_STATUS, irq_status);
 }
 
 /* ============================================================================
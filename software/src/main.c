@@ -148,6 +148,8 @@ void PrintStatus(CnnAccelerator_t *cnn)
     xil_printf("  Error: %d\r\n", status.error_code);
     xil_printf("  Cycles: %lu\r\n", status.cycles);
     xil_printf("  Operations: %lu\r\n", status.operations);
+    xil_printf("  Frames dropped: %d, overruns: %d\r\n",
+               status.frames_dropped, status.frame_overruns);
     
     if (status.cycles > 0) {
         float mops = (float)status.operations / (float)status.cycles;
@@ -261,6 +263,10 @@ int main()
         return XST_FAILURE;
     }
     xil_printf("  CNN Accelerator initialized successfully.\r\n");
+    xil_printf("  Core v%d.%d, %d conv layers x %d MACs, max input %dx%d, caps 0x%08x\r\n",
+               (int)CNN_VERSION_MAJOR(cnn.hw.version), (int)CNN_VERSION_MINOR(cnn.hw.version),
+               cnn.hw.num_layers, cnn.hw.mac_units, cnn.hw.max_width, cnn.hw.max_height,
+               (unsigned int)cnn.hw.caps);
     
     /* ========================================================================
      * Step 2: Configure CNN
@@ -275,6 +281,32 @@ int main()
     config.layer_enable = 0x0F;         /* Enable first 4 layers */
     config.activation = CNN_ACT_RELU;
     config.pool_type = CNN_POOL_MAX;
+    config.bn_enable = 0;               /* BN folded by cnn_pack.py */
+    
+    /* Layer 1 sees the pooled layer-0 map (W/2 x H/2 x 16); tile it through
+     * DDR only when it does not fit on chip */
+    config.stripe_rows = CNN_ChooseStripeRows(INPUT_WIDTH / 2, INPUT_HEIGHT / 2, 16,
+                                              CNN_TILE_BUDGET_BYTES);
+    
+    /* Test frames are pushed by the video DMA from INPUT_ADDR, so bypass the
+     * frame buffer; a live camera would use CNN_FRAME_LATEST */
+    config.frame_policy = CNN_FRAME_DIRECT;
+    
+    /* Test frames are already INPUT_WIDTH x INPUT_HEIGHT: no crop/scale.
+     * A 1280x720 camera would set src 1280x720 and e.g. a centred
+     * 720x720 crop to feed the network without a CPU resize. */
+    config.src_width = INPUT_WIDTH;
+    config.src_height = INPUT_HEIGHT;
+    config.crop_x = 0;
+    config.crop_y = 0;
+    config.crop_width = 0;
+    config.crop_height = 0;
+    
+    /* Test frames are RGB888; a YUV sensor would select CNN_INPUT_YUV422
+     * (or CNN_INPUT_NV12 for ISP frames in DDR) and skip CPU conversion */
+    config.input_format = CNN_INPUT_RGB888;
+    config.color_matrix = CNN_CSC_BT601;
+    config.full_range = 0;
     
     status = CNN_Configure(&cnn, &config);
     if (status != XST_SUCCESS) {
@@ -285,6 +317,18 @@ int main()
     xil_printf("  Classes: %d\r\n", NUM_CLASSES);
     xil_printf("  Activation: ReLU\r\n");
     xil_printf("  Pooling: Max\r\n");
+    if (config.stripe_rows) {
+        xil_printf("  Tiling: %d-row stripes\r\n", config.stripe_rows);
+    }
+    
+    /* ImageNet per-channel statistics, applied in the video front end */
+    const float norm_mean[3] = { 0.485f, 0.456f, 0.406f };
+    const float norm_std[3] = { 0.229f, 0.224f, 0.225f };
+    if (CNN_SetNormalization(&cnn, norm_mean, norm_std) != XST_SUCCESS) {
+        xil_printf("ERROR: Failed to set input normalization!\r\n");
+        return XST_FAILURE;
+    }
+    xil_printf("  Normalization: ImageNet mean/std\r\n");
     
     /* ========================================================================
      * Step 3: Load Weights and Biases
@@ -387,7 +431,8 @@ int main()
     xil_printf("  Demo completed successfully!          \r\n");
     xil_printf("========================================\r\n");
     
-    /* Continuous inference loop (for real-time demo) */
+    /* Continuous inference loop (for real-time demo). Test frames come from
+     * software here; a live camera would use CNN_StartStreaming() instead. */
     xil_printf("\r\nEntering continuous inference mode...\r\n");
     xil_printf("Press Ctrl+C to stop.\r\n\r\n");
     
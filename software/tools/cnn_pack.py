@@ -0,0 +1,343 @@
+#!/usr/bin/env python3
+"""
+CNN Parameter Packer
+AI Edge Accelerator for ZUBoard 1CG
+
+Converts trained float32 conv parameters into the packed parameter stream
+consumed by the accelerator's weight DMA (see CNN_LoadParams).
+
+  - Folds batch normalization into conv weights/biases (default), or
+  - Emits separate BN sections for the inline batchnorm stage (--keep-bn)
+  - Passes int8 post-training-quantized layers through as packed int8
+    weights plus per-channel requantization (int32 bias, multiplier, shift)
+  - Compresses pruned Q8.8 filters to bitmask + nonzeros (--sparse); the
+    loader expands them, and on builds with MAC lanes (SPARSE_MACS > 0)
+    layers run with CnnLayerConfig_t.sparse skip the zero products
+  - Emits Winograd F(2x2,3x3) transformed weights (U = G g G^T, 16 per
+    input channel in Q6.10) for builds with USE_WINOGRAD (--winograd)
+
+Model manifest (JSON), one entry per conv layer in pipeline order:
+
+  {
+    "layers": [
+      {
+        "weights": "conv0_w.f32",      # float32, [out][in][ky][kx]
+        "bias": "conv0_b.f32",         # float32, [out] (optional)
+        "out_channels": 16,
+        "in_channels": 3,
+        "kernel": 3,
+        "bn": {                        # optional
+          "gamma": "bn0_gamma.f32",
+          "beta": "bn0_beta.f32",
+          "mean": "bn0_mean.f32",
+          "var": "bn0_var.f32",
+          "eps": 1e-5
+        }
+      }
+    ]
+  }
+
+An int8 layer replaces "weights" / "bias" / "bn" with a "quant" entry
+(TFLite scheme: symmetric per-channel weights, asymmetric activations):
+
+      "quant": {
+        "weights": "conv0_w.s8",       # int8, [out][in][ky][kx]
+        "bias": "conv0_b.s32",         # int32, [out] (optional)
+        "weight_scales": "conv0_ws.f32",  # float32, [out]
+        "input_scale": 0.0078125, "input_zero_point": 0,
+        "output_scale": 0.0235, "output_zero_point": -128,
+        "activation": "relu6"          # none | relu | relu6 (optional)
+      }
+
+Tensor files are raw little-endian (e.g. numpy's tofile()), with paths
+relative to the manifest. The zero points and activation clamp of int8
+layers are printed for CNN_SetLayerQuant().
+
+Usage:
+  python3 cnn_pack.py model.json -o params.bin [--keep-bn] [--sparse | --winograd]
+"""
+
+import argparse
+import array
+import json
+import math
+import os
+import struct
+import sys
+
+# Section types (must match PARAM_SEC_* in cnn_pkg.vhd)
+SEC_WEIGHTS = 0x1
+SEC_BIASES = 0x2
+SEC_BN = 0x3
+SEC_WEIGHTS8 = 0x4
+SEC_QUANT = 0x5
+SEC_SPARSE = 0x6
+
+SPARSE_GROUP = 32
+
+# Winograd F(2x2,3x3) weight transform, scaled by 2 so 2G g (2G)^T = 4U is
+# integral in Q8.8, i.e. U in Q6.10
+WINO_G2 = ((2, 0, 0), (1, 1, 1), (1, -1, 1), (0, 0, 2))
+
+Q8_8_SCALE = 256.0
+QUANT_MULT_BITS = 24
+
+
+def load_f32(path, count, typecode='f'):
+    """Load a raw float32 (or other typecode) tensor and check its element count."""
+    data = array.array(typecode)
+    with open(path, 'rb') as f:
+        data.frombytes(f.read())
+    if sys.byteorder != 'little':
+        data.byteswap()
+    if len(data) != count:
+        raise ValueError("%s: expected %d values, found %d" % (path, count, len(data)))
+    return list(data)
+
+
+def to_q8_8(value):
+    """Convert float to saturated Q8.8."""
+    q = int(round(value * Q8_8_SCALE))
+    return max(-32768, min(32767, q))
+
+
+def bn_scale_bias(bn, channels):
+    """Reduce BN statistics to per-channel (scale, bias)."""
+    gamma = bn['gamma']
+    beta = bn['beta']
+    mean = bn['mean']
+    var = bn['var']
+    eps = bn.get('eps', 1e-5)
+    scale = [gamma[c] / math.sqrt(var[c] + eps) for c in range(channels)]
+    bias = [beta[c] - mean[c] * scale[c] for c in range(channels)]
+    return scale, bias
+
+
+def fold_batchnorm(weights, bias, bn, out_ch, per_filter):
+    """Fold BN into conv: w' = w * s, b' = (b - mean) * s + beta."""
+    scale, bn_bias = bn_scale_bias(bn, out_ch)
+    folded_w = []
+    for f in range(out_ch):
+        folded_w.extend(w * scale[f] for w in weights[f * per_filter:(f + 1) * per_filter])
+    folded_b = [bias[f] * scale[f] + bn_bias[f] for f in range(out_ch)]
+    return folded_w, folded_b
+
+
+def pack_halves(values):
+    """Pack Q8.8 values two per word, low half first."""
+    words = []
+    for i in range(0, len(values), 2):
+        lo = values[i] & 0xFFFF
+        hi = (values[i + 1] & 0xFFFF) if i + 1 < len(values) else 0
+        words.append((hi << 16) | lo)
+    return words
+
+
+def pack_bytes(values):
+    """Pack int8 values four per word, low byte first."""
+    words = []
+    for i in range(0, len(values), 4):
+        word = 0
+        for lane, v in enumerate(values[i:i + 4]):
+            word |= (v & 0xFF) << (8 * lane)
+        words.append(word)
+    return words
+
+
+def pack_sparse(values):
+    """Pack Q8.8 values as groups of a bitmask word plus their nonzeros."""
+    words = []
+    for base in range(0, len(values), SPARSE_GROUP):
+        group = values[base:base + SPARSE_GROUP]
+        mask = 0
+        for i, v in enumerate(group):
+            if v != 0:
+                mask |= 1 << i
+        words.append(mask)
+        words.extend(pack_halves([v for v in group if v != 0]))
+    return words
+
+
+def winograd_filter(q, in_ch):
+    """Transform one filter's Q8.8 3x3 kernels to 4x4 Q6.10 tiles."""
+    out = []
+    for c in range(in_ch):
+        g = [q[c * 9 + 3 * ky:c * 9 + 3 * ky + 3] for ky in range(3)]
+        t = [[sum(WINO_G2[i][k] * g[k][j] for k in range(3)) for j in range(3)] for i in range(4)]
+        for i in range(4):
+            for j in range(4):
+                u = sum(t[i][k] * WINO_G2[j][k] for k in range(3))
+                out.append(max(-32768, min(32767, u)))
+    return out
+
+
+def quantize_multiplier(real):
+    """Split a positive real multiplier into (Q0.24 mantissa, shift)."""
+    if real <= 0.0:
+        return 0, 0
+    mant, shift = math.frexp(real)  # real = mant * 2^shift, mant in [0.5, 1)
+    q = int(round(mant * (1 << QUANT_MULT_BITS)))
+    if q == 1 << QUANT_MULT_BITS:
+        q //= 2
+        shift += 1
+    if shift < -128 or shift > 127:
+        raise ValueError("requantization scale %g out of range" % real)
+    return q, shift
+
+
+def activation_range(quant):
+    """Quantized clamp for the fused activation (TFLite semantics)."""
+    zp = quant['output_zero_point']
+    scale = quant['output_scale']
+    act = quant.get('activation', 'none')
+    lo, hi = -128, 127
+    if act in ('relu', 'relu6'):
+        lo = max(lo, zp)
+    if act == 'relu6':
+        hi = min(hi, zp + int(round(6.0 / scale)))
+    elif act != 'relu' and act != 'none':
+        raise ValueError("int8 layers support none/relu/relu6, not %s" % act)
+    return lo, hi
+
+
+def pack_layer_int8(layer_idx, layer):
+    quant = layer['quant']
+    out_ch = layer['out_channels']
+    per_filter = layer['in_channels'] * layer['kernel'] * layer['kernel']
+    weights = quant['weights']
+    bias = quant.get('bias') or [0] * out_ch
+
+    words = []
+    for f in range(out_ch):
+        words.append(header(SEC_WEIGHTS8, layer_idx, f, per_filter))
+        words.extend(pack_bytes(weights[f * per_filter:(f + 1) * per_filter]))
+
+    words.append(header(SEC_QUANT, layer_idx, 0, 2 * out_ch))
+    for c in range(out_ch):
+        real = quant['input_scale'] * quant['weight_scales'][c] / quant['output_scale']
+        mult, shift = quantize_multiplier(real)
+        words.append(bias[c] & 0xFFFFFFFF)
+        words.append(((shift & 0xFF) << 24) | mult)
+
+    return words
+
+
+def header(sec, layer, index, count):
+    return ((sec & 0xF) << 28) | ((layer & 0xF) << 24) | ((index & 0xFF) << 16) | (count & 0xFFFF)
+
+
+def pack_layer(layer_idx, layer, keep_bn, sparse, winograd):
+    if 'quant' in layer:
+        return pack_layer_int8(layer_idx, layer)
+
+    out_ch = layer['out_channels']
+    per_filter = layer['in_channels'] * layer['kernel'] * layer['kernel']
+    weights = layer['weights']
+    bias = layer.get('bias') or [0.0] * out_ch
+    bn = layer.get('bn')
+
+    if bn is not None and not keep_bn:
+        weights, bias = fold_batchnorm(weights, bias, bn, out_ch, per_filter)
+
+    words = []
+    for f in range(out_ch):
+        q = [to_q8_8(w) for w in weights[f * per_filter:(f + 1) * per_filter]]
+        if winograd:
+            q = winograd_filter(q, layer['in_channels'])
+        dense = pack_halves(q)
+        compressed = pack_sparse(q) if sparse else None
+        if compressed is not None and len(compressed) < len(dense):
+            words.append(header(SEC_SPARSE, layer_idx, f, len(q)))
+            words.extend(compressed)
+        else:
+            words.append(header(SEC_WEIGHTS, layer_idx, f, len(q)))
+            words.extend(dense)
+
+    words.append(header(SEC_BIASES, layer_idx, 0, out_ch))
+    words.extend(pack_halves([to_q8_8(b) for b in bias]))
+
+    if bn is not None and keep_bn:
+        scale, bn_bias = bn_scale_bias(bn, out_ch)
+        words.append(header(SEC_BN, layer_idx, 0, out_ch))
+        for c in range(out_ch):
+            words.append(((to_q8_8(bn_bias[c]) & 0xFFFF) << 16) | (to_q8_8(scale[c]) & 0xFFFF))
+
+    return words
+
+
+def load_manifest(path):
+    base = os.path.dirname(os.path.abspath(path))
+    with open(path) as f:
+        manifest = json.load(f)
+
+    layers = []
+    for layer in manifest['layers']:
+        out_ch = layer['out_channels']
+        count = out_ch * layer['in_channels'] * layer['kernel'] * layer['kernel']
+        entry = dict(layer)
+        if 'quant' in layer:
+            quant = dict(layer['quant'])
+            quant['weights'] = load_f32(os.path.join(base, quant['weights']), count, 'b')
+            if 'bias' in quant:
+                quant['bias'] = load_f32(os.path.join(base, quant['bias']), out_ch, 'i')
+            quant['weight_scales'] = load_f32(os.path.join(base, quant['weight_scales']), out_ch)
+            entry['quant'] = quant
+            layers.append(entry)
+            continue
+        entry['weights'] = load_f32(os.path.join(base, layer['weights']), count)
+        if 'bias' in layer:
+            entry['bias'] = load_f32(os.path.join(base, layer['bias']), out_ch)
+        if 'bn' in layer:
+            bn = dict(layer['bn'])
+            for key in ('gamma', 'beta', 'mean', 'var'):
+                bn[key] = load_f32(os.path.join(base, layer['bn'][key]), out_ch)
+            entry['bn'] = bn
+        layers.append(entry)
+    return layers
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack CNN parameters for the weight DMA")
+    parser.add_argument('manifest', help="model manifest (JSON)")
+    parser.add_argument('-o', '--output', required=True, help="packed parameter blob")
+    parser.add_argument('--keep-bn', action='store_true',
+                        help="emit BN sections for the inline BN stage instead of folding")
+    parser.add_argument('--sparse', action='store_true',
+                        help="compress Q8.8 filters to bitmask + nonzeros where smaller")
+    parser.add_argument('--winograd', action='store_true',
+                        help="transform 3x3 weights for Winograd F(2x2,3x3) engines")
+    args = parser.parse_args()
+
+    layers = load_manifest(args.manifest)
+    if len(layers) > 16:
+        parser.error("at most 16 conv layers are addressable")
+    if args.winograd:
+        if args.sparse:
+            parser.error("--winograd and --sparse are exclusive")
+        for layer in layers:
+            if 'quant' in layer or layer['kernel'] != 3:
+                parser.error("--winograd needs Q8.8 layers with 3x3 kernels")
+
+    words = []
+    for idx, layer in enumerate(layers):
+        words.extend(pack_layer(idx, layer, args.keep_bn, args.sparse, args.winograd))
+
+    with open(args.output, 'wb') as f:
+        f.write(struct.pack('<%dI' % len(words), *words))
+
+    print("Packed %d layers: %d words (%d bytes)%s" % (
+        len(layers), len(words), 4 * len(words),
+        ", BN kept inline" if args.keep_bn else ""))
+    for idx, layer in enumerate(layers):
+        if 'quant' in layer:
+            lo, hi = activation_range(layer['quant'])
+            print("  layer %d int8: input_zero_point %d, output_zero_point %d, act %d..%d" % (
+                idx, layer['quant']['input_zero_point'], layer['quant']['output_zero_point'], lo, hi))
+        elif args.sparse:
+            zeros = sum(1 for w in layer['weights'] if to_q8_8(w) == 0)
+            print("  layer %d: %.0f%% zero weights" % (idx, 100.0 * zeros / len(layer['weights'])))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
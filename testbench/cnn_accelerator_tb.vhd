@@ -4,6 +4,7 @@
 -- 
 -- Verifies:
 --   - Conv2D computation correctness
+--   - Int8 conv outputs against a reference model, window by window
 --   - Pooling operations
 --   - AXI-Stream data flow
 --   - End-to-end inference pipeline
@@ -31,6 +32,7 @@ architecture sim of cnn_accelerator_tb is
     -- Configuration
     signal cfg_enable   : std_logic := '0';
     signal cfg_activation : std_logic_vector(2 downto 0) := ACT_RELU;
+    signal cfg_bn_enable : std_logic := '0';
     
     -- Weight loading interface
     signal weight_valid : std_logic := '0';
@@ -43,6 +45,12 @@ architecture sim of cnn_accelerator_tb is
     signal bias_data    : std_logic_vector(BIAS_WIDTH-1 downto 0) := (others => '0');
     signal bias_addr    : std_logic_vector(7 downto 0) := (others => '0');
     
+    -- Batchnorm parameter interface
+    signal bn_valid     : std_logic := '0';
+    signal bn_channel   : std_logic_vector(9 downto 0) := (others => '0');
+    signal bn_scale     : std_logic_vector(DATA_WIDTH-1 downto 0) := (others => '0');
+    signal bn_bias      : std_logic_vector(DATA_WIDTH-1 downto 0) := (others => '0');
+    
     -- AXI-Stream input
     signal s_axis_tdata : std_logic_vector(DATA_WIDTH-1 downto 0) := (others => '0');
     signal s_axis_tvalid: std_logic := '0';
@@ -71,6 +79,59 @@ architecture sim of cnn_accelerator_tb is
     signal test_pass    : boolean := true;
     signal test_done    : boolean := false;
     signal output_count : integer := 0;
+    
+    -- Int8 check: one input channel, so every output window is final
+    constant I8_ZP_IN   : integer := 3;
+    constant I8_BIAS    : integer := 500;
+    constant I8_RSHIFT  : integer := 6;  -- Multiplier 0.5, shift -5: acc / 64
+    constant I8_MULT    : std_logic_vector(31 downto 0) := x"FB800000";
+    constant I8_QUANT   : std_logic_vector(31 downto 0) := x"7F800003";  -- Clamp [-128, 127], zp_in 3
+    
+    signal i8_enable    : std_logic := '0';
+    signal i8_weight_valid : std_logic := '0';
+    signal i8_weight_data  : std_logic_vector(WEIGHT_WIDTH-1 downto 0) := (others => '0');
+    signal i8_weight_addr  : std_logic_vector(15 downto 0) := (others => '0');
+    signal i8_quant_valid  : std_logic := '0';
+    signal i8_quant_sel    : std_logic := '0';
+    signal i8_quant_data   : std_logic_vector(31 downto 0) := (others => '0');
+    signal i8_s_tdata   : std_logic_vector(DATA_WIDTH-1 downto 0) := (others => '0');
+    signal i8_s_tvalid  : std_logic := '0';
+    signal i8_s_tready  : std_logic;
+    signal i8_s_tlast   : std_logic := '0';
+    signal i8_s_tuser   : std_logic := '0';
+    signal i8_m_tdata   : std_logic_vector(DATA_WIDTH-1 downto 0);
+    signal i8_m_tvalid  : std_logic;
+    
+    -- Int8 test pattern: neighbouring pixels and taps all differ
+    function i8_pixel(x, y : integer) return integer is
+    begin
+        return ((x * 37 + y * 11) mod 256) - 128;
+    end function;
+    
+    function i8_weight(t : integer) return integer is
+    begin
+        return ((t * 5) mod 17) - 8;
+    end function;
+    
+    -- Reference: requantized output of the window ending at column x, row y
+    function i8_ref(x, y : integer) return integer is
+        variable acc : integer;
+        variable q   : integer;
+    begin
+        acc := I8_BIAS;
+        for ky in 0 to 2 loop
+            for kx in 0 to 2 loop
+                acc := acc + (i8_pixel(x - 2 + kx, y - 2 + ky) - I8_ZP_IN) * i8_weight(ky * 3 + kx);
+            end loop;
+        end loop;
+        q := to_integer(shift_right(to_signed(acc + 2**(I8_RSHIFT-1), 32), I8_RSHIFT));
+        if q < -128 then
+            q := -128;
+        elsif q > 127 then
+            q := 127;
+        end if;
+        return q;
+    end function;
 
 begin
 
@@ -91,13 +152,20 @@ begin
             INPUT_HEIGHT    => TEST_HEIGHT,
             STRIDE          => 1,
             PADDING         => 1,
-            NUM_MAC_UNITS   => 9
+            NUM_MAC_UNITS   => 9,
+            USE_BATCHNORM   => true
         )
         port map (
             clk             => clk,
             rst_n           => rst_n,
             cfg_enable      => cfg_enable,
             cfg_activation  => cfg_activation,
+            cfg_bn_enable   => cfg_bn_enable,
+            cfg_pool_type   => '0',
+            cfg_rows        => (others => '0'),
+            cfg_int8        => '0',
+            cfg_sparse      => '0',
+            cfg_quant       => (others => '0'),
             weight_valid    => weight_valid,
             weight_data     => weight_data,
             weight_addr     => weight_addr,
@@ -105,6 +173,14 @@ begin
             bias_valid      => bias_valid,
             bias_data       => bias_data,
             bias_addr       => bias_addr,
+            bn_valid        => bn_valid,
+            bn_channel      => bn_channel,
+            bn_scale        => bn_scale,
+            bn_bias         => bn_bias,
+            quant_valid     => '0',
+            quant_channel   => (others => '0'),
+            quant_sel       => '0',
+            quant_data      => (others => '0'),
             s_axis_tdata    => s_axis_tdata,
             s_axis_tvalid   => s_axis_tvalid,
             s_axis_tready   => s_axis_tready,
@@ -119,6 +195,62 @@ begin
             done            => done
         );
 
+    -- ==========================================================================
+    -- DUT: Conv2D Engine, int8 layer
+    -- ==========================================================================
+    dut_int8 : entity work.conv2d_engine
+        generic map (
+            KERNEL_SIZE     => 3,
+            INPUT_CHANNELS  => 1,
+            OUTPUT_CHANNELS => 1,
+            INPUT_WIDTH     => TEST_WIDTH,
+            INPUT_HEIGHT    => TEST_HEIGHT,
+            STRIDE          => 1,
+            PADDING         => 1,
+            NUM_MAC_UNITS   => 9,
+            USE_BATCHNORM   => true,
+            USE_INT8        => true
+        )
+        port map (
+            clk             => clk,
+            rst_n           => rst_n,
+            cfg_enable      => i8_enable,
+            cfg_activation  => ACT_NONE,
+            cfg_bn_enable   => '0',
+            cfg_pool_type   => '0',
+            cfg_rows        => (others => '0'),
+            cfg_int8        => '1',
+            cfg_sparse      => '0',
+            cfg_quant       => I8_QUANT,
+            weight_valid    => i8_weight_valid,
+            weight_data     => i8_weight_data,
+            weight_addr     => i8_weight_addr,
+            weight_filter   => (others => '0'),
+            bias_valid      => '0',
+            bias_data       => (others => '0'),
+            bias_addr       => (others => '0'),
+            bn_valid        => '0',
+            bn_channel      => (others => '0'),
+            bn_scale        => (others => '0'),
+            bn_bias         => (others => '0'),
+            quant_valid     => i8_quant_valid,
+            quant_channel   => (others => '0'),
+            quant_sel       => i8_quant_sel,
+            quant_data      => i8_quant_data,
+            s_axis_tdata    => i8_s_tdata,
+            s_axis_tvalid   => i8_s_tvalid,
+            s_axis_tready   => i8_s_tready,
+            s_axis_tlast    => i8_s_tlast,
+            s_axis_tuser    => i8_s_tuser,
+            m_axis_tdata    => i8_m_tdata,
+            m_axis_tvalid   => i8_m_tvalid,
+            m_axis_tready   => '1',
+            m_axis_tlast    => open,
+            m_axis_tuser    => open,
+            busy            => open,
+            done            => open
+        );
+
     -- ==========================================================================
     -- Main Test Process
     -- ==========================================================================
@@ -336,6 +468,107 @@ begin
         wait;
     end process;
 
+    -- ==========================================================================
+    -- Int8 Stimulus: parameters, then one frame with a full handshake
+    -- ==========================================================================
+    int8_stim : process
+    begin
+        wait until rising_edge(clk) and rst_n = '1';
+        
+        for t in 0 to 8 loop
+            i8_weight_valid <= '1';
+            i8_weight_addr <= std_logic_vector(to_unsigned(t, 16));
+            i8_weight_data <= std_logic_vector(to_signed(i8_weight(t), WEIGHT_WIDTH));
+            wait until rising_edge(clk);
+        end loop;
+        i8_weight_valid <= '0';
+        
+        i8_quant_valid <= '1';
+        i8_quant_sel <= '0';
+        i8_quant_data <= std_logic_vector(to_signed(I8_BIAS, 32));
+        wait until rising_edge(clk);
+        i8_quant_sel <= '1';
+        i8_quant_data <= I8_MULT;
+        wait until rising_edge(clk);
+        i8_quant_valid <= '0';
+        i8_enable <= '1';
+        wait until rising_edge(clk);
+        
+        for y in 0 to TEST_HEIGHT-1 loop
+            for x in 0 to TEST_WIDTH-1 loop
+                i8_s_tvalid <= '1';
+                i8_s_tdata <= std_logic_vector(to_signed(i8_pixel(x, y), DATA_WIDTH));
+                if x = 0 and y = 0 then
+                    i8_s_tuser <= '1';
+                else
+                    i8_s_tuser <= '0';
+                end if;
+                if x = TEST_WIDTH-1 then
+                    i8_s_tlast <= '1';
+                else
+                    i8_s_tlast <= '0';
+                end if;
+                loop
+                    wait until rising_edge(clk);
+                    exit when i8_s_tready = '1';
+                end loop;
+            end loop;
+        end loop;
+        i8_s_tvalid <= '0';
+        i8_s_tlast <= '0';
+        i8_s_tuser <= '0';
+        
+        wait;
+    end process;
+
+    -- ==========================================================================
+    -- Int8 Checker: outputs in raster order of the valid windows, so each
+    -- pair of neighbours is compared against its own reference
+    -- ==========================================================================
+    int8_check : process
+        variable x, y    : integer;
+        variable got     : integer;
+        variable errors  : integer := 0;
+        variable cycles  : integer := 0;
+    begin
+        x := 2;
+        y := 2;
+        while y < TEST_HEIGHT loop
+            wait until rising_edge(clk);
+            cycles := cycles + 1;
+            if cycles > 10000 then
+                report "Int8 check: output timeout at window (" & integer'image(x) & ", " &
+                       integer'image(y) & ")" severity error;
+                errors := errors + 1;
+                exit;
+            end if;
+            
+            if i8_m_tvalid = '1' then
+                got := to_integer(signed(i8_m_tdata));
+                if got /= i8_ref(x, y) then
+                    report "Int8 check: window (" & integer'image(x) & ", " & integer'image(y) &
+                           ") got " & integer'image(got) & ", expected " &
+                           integer'image(i8_ref(x, y)) severity error;
+                    errors := errors + 1;
+                end if;
+                if x = TEST_WIDTH-1 then
+                    x := 2;
+                    y := y + 1;
+                else
+                    x := x + 1;
+                end if;
+            end if;
+        end loop;
+        
+        if errors = 0 then
+            report "Int8 check PASSED: " & integer'image((TEST_WIDTH-2) * (TEST_HEIGHT-2)) &
+                   " windows match the reference" severity note;
+        else
+            report "Int8 check FAILED: " & integer'image(errors) & " mismatches" severity error;
+        end if;
+        wait;
+    end process;
+
     -- ==========================================================================
     -- Output Monitor Process
     -- ==========================================================================
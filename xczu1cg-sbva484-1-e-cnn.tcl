@@ -94,8 +94,9 @@ set_property -dict [list \
     CONFIG.PSU__DDRC__BUS_WIDTH {32 Bit} \
     ] [get_bd_cells zynq_ultra_ps_e_0]
 
-# Configure Clocks - 100MHz for logic, 200MHz for high-speed processing
+# Configure Clocks - 100MHz for logic, 200MHz for the CNN compute datapath
 set_property -dict [list \
+    CONFIG.PSU__FPGA_PL1_ENABLE {1} \
     CONFIG.PSU__CRL_APB__PL0_REF_CTRL__FREQMHZ {100} \
     CONFIG.PSU__CRL_APB__PL1_REF_CTRL__FREQMHZ {200} \
     CONFIG.PSU__USE__FABRIC__RST {1} \
@@ -140,7 +141,7 @@ set_property -dict [list \
 create_bd_cell -type ip -vlnv xilinx.com:ip:axi_interconnect:2.1 axi_mem_intercon
 
 set_property -dict [list \
-    CONFIG.NUM_SI {3} \
+    CONFIG.NUM_SI {7} \
     CONFIG.NUM_MI {1} \
     ] [get_bd_cells axi_mem_intercon]
 
@@ -159,6 +160,9 @@ set_property -dict [list \
 # ==================================================================================
 create_bd_cell -type ip -vlnv xilinx.com:ip:proc_sys_reset:5.0 proc_sys_reset_0
 
+# Reset for the compute clock domain (pl_clk1)
+create_bd_cell -type ip -vlnv xilinx.com:ip:proc_sys_reset:5.0 proc_sys_reset_1
+
 # ==================================================================================
 # Add CNN Accelerator as RTL Module
 # ==================================================================================
@@ -208,6 +212,9 @@ connect_bd_net [get_bd_pins zynq_ultra_ps_e_0/pl_clk0] \
     [get_bd_pins axi_mem_intercon/S00_ACLK] \
     [get_bd_pins axi_mem_intercon/S01_ACLK] \
     [get_bd_pins axi_mem_intercon/S02_ACLK] \
+    [get_bd_pins axi_mem_intercon/S04_ACLK] \
+    [get_bd_pins axi_mem_intercon/S05_ACLK] \
+    [get_bd_pins axi_mem_intercon/S06_ACLK] \
     [get_bd_pins axi_mem_intercon/M00_ACLK] \
     [get_bd_pins axi_periph_intercon/ACLK] \
     [get_bd_pins axi_periph_intercon/S00_ACLK] \
@@ -219,8 +226,19 @@ connect_bd_net [get_bd_pins zynq_ultra_ps_e_0/pl_clk0] \
     [get_bd_pins axi_intc_0/s_axi_aclk] \
     [get_bd_pins proc_sys_reset_0/slowest_sync_clk]
 
+# Connect compute clock: CNN datapath and its feature-map spill master
+connect_bd_net [get_bd_pins zynq_ultra_ps_e_0/pl_clk1] \
+    [get_bd_pins cnn_accelerator_0/compute_clk] \
+    [get_bd_pins axi_mem_intercon/S03_ACLK] \
+    [get_bd_pins proc_sys_reset_1/slowest_sync_clk]
+
 connect_bd_net [get_bd_pins zynq_ultra_ps_e_0/pl_resetn0] \
-    [get_bd_pins proc_sys_reset_0/ext_reset_in]
+    [get_bd_pins proc_sys_reset_0/ext_reset_in] \
+    [get_bd_pins proc_sys_reset_1/ext_reset_in]
+
+connect_bd_net [get_bd_pins proc_sys_reset_1/peripheral_aresetn] \
+    [get_bd_pins cnn_accelerator_0/compute_aresetn] \
+    [get_bd_pins axi_mem_intercon/S03_ARESETN]
 
 # Connect synchronized resets
 connect_bd_net [get_bd_pins proc_sys_reset_0/peripheral_aresetn] \
@@ -231,6 +249,9 @@ connect_bd_net [get_bd_pins proc_sys_reset_0/peripheral_aresetn] \
     [get_bd_pins axi_mem_intercon/S00_ARESETN] \
     [get_bd_pins axi_mem_intercon/S01_ARESETN] \
     [get_bd_pins axi_mem_intercon/S02_ARESETN] \
+    [get_bd_pins axi_mem_intercon/S04_ARESETN] \
+    [get_bd_pins axi_mem_intercon/S05_ARESETN] \
+    [get_bd_pins axi_mem_intercon/S06_ARESETN] \
     [get_bd_pins axi_mem_intercon/M00_ARESETN] \
     [get_bd_pins axi_periph_intercon/ARESETN] \
     [get_bd_pins axi_periph_intercon/S00_ARESETN] \
@@ -267,6 +288,22 @@ connect_bd_intf_net [get_bd_intf_pins axi_dma_video/M_AXI_S2MM] \
 connect_bd_intf_net [get_bd_intf_pins axi_dma_weights/M_AXI_MM2S] \
     [get_bd_intf_pins axi_mem_intercon/S02_AXI]
 
+# CNN feature-map spill/refill (tiled execution) to Memory Interconnect
+connect_bd_intf_net [get_bd_intf_pins cnn_accelerator_0/m_axi] \
+    [get_bd_intf_pins axi_mem_intercon/S03_AXI]
+
+# CNN frame buffer (camera frames staged in DDR) to Memory Interconnect
+connect_bd_intf_net [get_bd_intf_pins cnn_accelerator_0/m_axi_fb] \
+    [get_bd_intf_pins axi_mem_intercon/S04_AXI]
+
+# CNN command ring (descriptors and results) to Memory Interconnect
+connect_bd_intf_net [get_bd_intf_pins cnn_accelerator_0/m_axi_cmd] \
+    [get_bd_intf_pins axi_mem_intercon/S05_AXI]
+
+# CNN detection boxes (NMS output) to Memory Interconnect
+connect_bd_intf_net [get_bd_intf_pins cnn_accelerator_0/m_axi_det] \
+    [get_bd_intf_pins axi_mem_intercon/S06_AXI]
+
 # Memory Interconnect to PS HP Slave
 connect_bd_intf_net [get_bd_intf_pins axi_mem_intercon/M00_AXI] \
     [get_bd_intf_pins zynq_ultra_ps_e_0/S_AXI_HP0_FPD]
@@ -281,6 +318,10 @@ connect_bd_intf_net [get_bd_intf_pins axi_dma_video/M_AXIS_MM2S] \
 connect_bd_intf_net [get_bd_intf_pins axis_dwidth_video/M_AXIS] \
     [get_bd_intf_pins cnn_accelerator_0/s_axis_video]
 
+# Weight DMA MM2S -> CNN parameter loader (weights, biases, batchnorm)
+connect_bd_intf_net [get_bd_intf_pins axi_dma_weights/M_AXIS_MM2S] \
+    [get_bd_intf_pins cnn_accelerator_0/s_axis_weights]
+
 # CNN Result Output -> DMA S2MM (would need width converter in full implementation)
 # For now, connect result directly to provide classification output
 # connect_bd_intf_net [get_bd_intf_pins cnn_accelerator_0/m_axis_result] \
@@ -348,6 +389,14 @@ puts $constr_fh ""
 puts $constr_fh "# Timing Constraints"
 puts $constr_fh "# PL Clock is 100MHz from PS"
 puts $constr_fh "create_clock -period 10.000 -name pl_clk0 \[get_pins cnn_system_i/zynq_ultra_ps_e_0/inst/PS8_i/PLCLK\[0\]\]"
+puts $constr_fh "# CNN compute clock is 200MHz from PS"
+puts $constr_fh "create_clock -period 5.000 -name pl_clk1 \[get_pins cnn_system_i/zynq_ultra_ps_e_0/inst/PS8_i/PLCLK\[1\]\]"
+puts $constr_fh ""
+puts $constr_fh "# Clock domain crossings between pl_clk0 and pl_clk1: Gray-coded FIFO"
+puts $constr_fh "# pointers, two-flop synchronizers and configuration / counter registers"
+puts $constr_fh "# that are stable while sampled. Bound the skew to one compute period."
+puts $constr_fh "set_max_delay -datapath_only -from \[get_clocks pl_clk0\] -to \[get_clocks pl_clk1\] 5.000"
+puts $constr_fh "set_max_delay -datapath_only -from \[get_clocks pl_clk1\] -to \[get_clocks pl_clk0\] 5.000"
 puts $constr_fh ""
 puts $constr_fh "# False paths for asynchronous resets"
 puts $constr_fh "set_false_path -from \[get_pins cnn_system_i/proc_sys_reset_0/U0/ACTIVE_LOW_PR_OUT_DFF\[0\].peripheral_aresetn_reg/C\]"